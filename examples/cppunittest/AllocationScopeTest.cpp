@@ -0,0 +1,338 @@
+#include <cppunit/AllocationCountXmlHook.h>
+#include <cppunit/AllocationScope.h>
+#include <cppunit/Exception.h>
+#include <cppunit/ExpectationCollector.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/XmlOutputter.h>
+#include <cppunit/portability/Stream.h>
+#include "AllocationScopeTest.h"
+#include "CoreSuite.h"
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( AllocationScopeTest,
+                                       coreSuiteName() );
+
+
+/// Keeps the compiler from removing the allocations of allocate().
+static char *volatile lastAllocation = NULL;
+
+
+/*! Makes one allocation of the specified size.
+ */
+static void
+allocate( int byteCount )
+{
+  lastAllocation = new char[ byteCount ];
+  delete [] lastAllocation;
+  lastAllocation = NULL;
+}
+
+
+/*! Test case running a function.
+ */
+class AllocatingTestCase : public CPPUNIT_NS::TestCase
+{
+public:
+  AllocatingTestCase( void (*testMethod)() )
+      : CPPUNIT_NS::TestCase( "AllocatingTestCase" )
+      , m_testMethod( testMethod )
+  {
+  }
+
+  void setUp()
+  {
+    allocate( 8 );
+  }
+
+  void runTest()
+  {
+    m_testMethod();
+  }
+
+private:
+  void (*m_testMethod)();
+};
+
+
+static void
+allocateTwice()
+{
+  allocate( 16 );
+  allocate( 16 );
+}
+
+
+static void
+failAfterAllocating()
+{
+  CPPUNIT_EXPECT( 1 == 2 );
+  CPPUNIT_EXPECT_EQUAL( std::string( "expected" ), std::string( "actual" ) );
+  CPPUNIT_EXPECT_DOUBLES_EQUAL( 1.0, 2.0, 0.1 );
+  allocate( 16 );
+  CPPUNIT_ASSERT_EQUAL( 1, 2 );
+}
+
+
+/*! Same assertions as failAfterAllocating(), passing.
+ */
+static void
+passAfterAllocating()
+{
+  CPPUNIT_EXPECT( 1 == 1 );
+  CPPUNIT_EXPECT_EQUAL( std::string( "expected" ), std::string( "expected" ) );
+  CPPUNIT_EXPECT_DOUBLES_EQUAL( 1.0, 1.0, 0.1 );
+  allocate( 16 );
+  CPPUNIT_ASSERT_EQUAL( 1, 1 );
+}
+
+
+AllocationScopeTest::AllocationScopeTest()
+    : m_result( NULL )
+    , m_collector( NULL )
+{
+}
+
+
+AllocationScopeTest::~AllocationScopeTest()
+{
+}
+
+
+void 
+AllocationScopeTest::setUp()
+{
+  m_result = new CPPUNIT_NS::TestResult();
+  m_collector = new CPPUNIT_NS::TestResultCollector();
+  m_result->addListener( m_collector );
+}
+
+
+void 
+AllocationScopeTest::tearDown()
+{
+  delete m_collector;
+  delete m_result;
+}
+
+
+void 
+AllocationScopeTest::testCountAllocations()
+{
+  CPPUNIT_ASSERT( CPPUNIT_NS::AllocationScope::isCountingInstalled() );
+
+  CPPUNIT_NS::AllocationScope scope;
+  allocate( 10 );
+  allocate( 20 );
+  scope.end();
+  allocate( 30 );
+
+  CPPUNIT_ASSERT_EQUAL( 2L, scope.allocationCount() );
+  CPPUNIT_ASSERT_EQUAL( 30L, scope.allocatedByteCount() );
+}
+
+
+void 
+AllocationScopeTest::testDisabledCounting()
+{
+  CPPUNIT_NS::AllocationScope::setCountingEnabled( false );
+  bool isCountingInstalled = CPPUNIT_NS::AllocationScope::isCountingInstalled();
+  CPPUNIT_NS::AllocationScope scope;
+  allocate( 10 );
+  scope.end();
+  CPPUNIT_NS::AllocationScope::setCountingEnabled( true );
+
+  CPPUNIT_ASSERT( !isCountingInstalled );
+  CPPUNIT_ASSERT( CPPUNIT_NS::AllocationScope::isCountingInstalled() );
+  CPPUNIT_ASSERT_EQUAL( 0L, scope.allocationCount() );
+}
+
+
+void 
+AllocationScopeTest::testNestedScopes()
+{
+  CPPUNIT_NS::AllocationScope outerScope;
+  allocate( 10 );
+  long innerAllocationCount;
+  {
+    CPPUNIT_NS::AllocationScope innerScope;
+    allocate( 20 );
+    innerScope.end();
+    innerAllocationCount = innerScope.allocationCount();
+  }
+  outerScope.end();
+
+  CPPUNIT_ASSERT_EQUAL( 1L, innerAllocationCount );
+  CPPUNIT_ASSERT_EQUAL( 2L, outerScope.allocationCount() );
+  CPPUNIT_ASSERT_EQUAL( 30L, outerScope.allocatedByteCount() );
+}
+
+
+void 
+AllocationScopeTest::testPauseExcludesAllocations()
+{
+  CPPUNIT_NS::AllocationScope scope;
+  {
+    CPPUNIT_NS::AllocationCountingPause pause;
+    allocate( 10 );
+  }
+  allocate( 20 );
+  scope.end();
+
+  CPPUNIT_ASSERT_EQUAL( 1L, scope.allocationCount() );
+  CPPUNIT_ASSERT_EQUAL( 20L, scope.allocatedByteCount() );
+}
+
+
+void 
+AllocationScopeTest::testPassingAssertionsDoNotAllocate()
+{
+  int value = 1;
+  CPPUNIT_ASSERT_NO_ALLOCATIONS
+  {
+    CPPUNIT_ASSERT( value == 1 );
+    CPPUNIT_ASSERT_EQUAL( 1, value );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 1.0, 1.0, 0.1 );
+    CPPUNIT_EXPECT( value == 1 );
+    CPPUNIT_EXPECT_EQUAL( 1, value );
+    CPPUNIT_EXPECT_DOUBLES_EQUAL( 1.0, 1.0, 0.1 );
+  }
+}
+
+
+void 
+AllocationScopeTest::testFailedAssertionsAreNotCounted()
+{
+  int value = 3;
+  CPPUNIT_NS::AllocationScope passing;
+  CPPUNIT_ASSERT_MESSAGE( "message", value == 3 );
+  CPPUNIT_ASSERT_EQUAL( 3, value );
+  passing.end();
+
+  CPPUNIT_NS::AllocationScope failing;
+  try
+  {
+    CPPUNIT_ASSERT_MESSAGE( "message", value == 4 );
+  }
+  catch ( CPPUNIT_NS::Exception & )
+  {
+  }
+  try
+  {
+    CPPUNIT_ASSERT_EQUAL( 4, value );
+  }
+  catch ( CPPUNIT_NS::Exception & )
+  {
+  }
+  failing.end();
+
+  // Only the arguments of the assertions are counted, not their failure.
+  CPPUNIT_ASSERT_EQUAL( passing.allocationCount(), failing.allocationCount() );
+}
+
+
+void 
+AllocationScopeTest::testFailedExpectationsAreNotCounted()
+{
+  int value = 3;
+  CPPUNIT_NS::ExpectationCollector expectations;
+  CPPUNIT_NS::ExpectationCollector *previousExpectations = 
+      CPPUNIT_NS::ExpectationCollector::setCurrent( &expectations );
+
+  CPPUNIT_NS::AllocationScope passing;
+  CPPUNIT_EXPECT( value == 3 );
+  passing.end();
+
+  CPPUNIT_NS::AllocationScope failing;
+  CPPUNIT_EXPECT( value == 4 );
+  failing.end();
+
+  CPPUNIT_NS::ExpectationCollector::setCurrent( previousExpectations );
+  CPPUNIT_ASSERT_EQUAL( passing.allocationCount(), failing.allocationCount() );
+}
+
+
+void 
+AllocationScopeTest::testMaxAllocations()
+{
+  CPPUNIT_ASSERT_MAX_ALLOCATIONS( 2 )
+  {
+    allocate( 10 );
+    allocate( 10 );
+  }
+}
+
+
+void 
+AllocationScopeTest::testTooManyAllocations()
+{
+  bool hasFailed = false;
+  try
+  {
+    CPPUNIT_ASSERT_MAX_ALLOCATIONS( 1 )
+    {
+      allocate( 10 );
+      allocate( 20 );
+    }
+  }
+  catch ( CPPUNIT_NS::Exception &e )
+  {
+    hasFailed = true;
+    CPPUNIT_ASSERT_EQUAL( std::string( "too many allocations" ),
+                          e.message().shortDescription() );
+    CPPUNIT_ASSERT_EQUAL( std::string( "Expected: at most 1 allocation(s)" ),
+                          e.message().detailAt( 0 ) );
+    CPPUNIT_ASSERT_EQUAL( std::string( "Actual  : 2 allocation(s) of 30 bytes" ),
+                          e.message().detailAt( 1 ) );
+  }
+  CPPUNIT_ASSERT( hasFailed );
+}
+
+
+void 
+AllocationScopeTest::testCountPerTest()
+{
+  AllocatingTestCase test( &allocateTwice );
+  test.run( m_result );
+
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+  CPPUNIT_ASSERT_EQUAL( 3L, m_collector->allocationCount( &test ) );
+  CPPUNIT_ASSERT_EQUAL( 40L, m_collector->allocatedByteCount( &test ) );
+  CPPUNIT_ASSERT_EQUAL( 3L, m_collector->allocationCount() );
+  CPPUNIT_ASSERT_EQUAL( 40L, m_collector->allocatedByteCount() );
+}
+
+
+void 
+AllocationScopeTest::testFailuresNotCounted()
+{
+  AllocatingTestCase failingTest( &failAfterAllocating );
+  failingTest.run( m_result );
+  AllocatingTestCase passingTest( &passAfterAllocating );
+  passingTest.run( m_result );
+
+  // Only the allocations of setUp() and allocate() are counted.
+  CPPUNIT_ASSERT_EQUAL( 4, m_collector->testFailuresTotal() );
+  CPPUNIT_ASSERT_EQUAL( m_collector->allocationCount( &passingTest ),
+                        m_collector->allocationCount( &failingTest ) );
+  CPPUNIT_ASSERT_EQUAL( m_collector->allocatedByteCount( &passingTest ),
+                        m_collector->allocatedByteCount( &failingTest ) );
+  CPPUNIT_ASSERT_EQUAL( 2L, m_collector->allocationCount( &failingTest ) );
+}
+
+
+void 
+AllocationScopeTest::testXmlHook()
+{
+  AllocatingTestCase test( &allocateTwice );
+  test.run( m_result );
+
+  CPPUNIT_NS::OStringStream stream;
+  CPPUNIT_NS::XmlOutputter outputter( m_collector, stream );
+  CPPUNIT_NS::AllocationCountXmlHook hook( m_collector );
+  outputter.addHook( &hook );
+  outputter.write();
+
+  std::string xml = stream.str();
+  CPPUNIT_ASSERT( xml.find( "<Allocations>3</Allocations>" ) != std::string::npos );
+  CPPUNIT_ASSERT( xml.find( "<AllocatedBytes>40</AllocatedBytes>" ) != std::string::npos );
+}
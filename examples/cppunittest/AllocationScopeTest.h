@@ -0,0 +1,55 @@
+#ifndef ALLOCATIONSCOPETEST_H
+#define ALLOCATIONSCOPETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+
+
+class AllocationScopeTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( AllocationScopeTest );
+  CPPUNIT_TEST( testCountAllocations );
+  CPPUNIT_TEST( testDisabledCounting );
+  CPPUNIT_TEST( testNestedScopes );
+  CPPUNIT_TEST( testPauseExcludesAllocations );
+  CPPUNIT_TEST( testPassingAssertionsDoNotAllocate );
+  CPPUNIT_TEST( testFailedAssertionsAreNotCounted );
+  CPPUNIT_TEST( testFailedExpectationsAreNotCounted );
+  CPPUNIT_TEST( testMaxAllocations );
+  CPPUNIT_TEST( testTooManyAllocations );
+  CPPUNIT_TEST( testCountPerTest );
+  CPPUNIT_TEST( testFailuresNotCounted );
+  CPPUNIT_TEST( testXmlHook );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  AllocationScopeTest();
+  virtual ~AllocationScopeTest();
+
+  void setUp();
+  void tearDown();
+
+  void testCountAllocations();
+  void testDisabledCounting();
+  void testNestedScopes();
+  void testPauseExcludesAllocations();
+  void testPassingAssertionsDoNotAllocate();
+  void testFailedAssertionsAreNotCounted();
+  void testFailedExpectationsAreNotCounted();
+  void testMaxAllocations();
+  void testTooManyAllocations();
+  void testCountPerTest();
+  void testFailuresNotCounted();
+  void testXmlHook();
+
+private:
+  AllocationScopeTest( const AllocationScopeTest &copy );
+  void operator =( const AllocationScopeTest &copy );
+
+private:
+  CPPUNIT_NS::TestResult *m_result;
+  CPPUNIT_NS::TestResultCollector *m_collector;
+};
+
+#endif  // ALLOCATIONSCOPETEST_H
@@ -0,0 +1,250 @@
+#include <cppunit/RangeAssert.h>
+#include "ArraysNearAssertTest.h"
+#include "CoreSuite.h"
+#include <float.h>
+#include <limits>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( ArraysNearAssertTest,
+                                       coreSuiteName() );
+
+
+/*! Runs an assertion that must fail and stores the message of its failure.
+ */
+#define ARRAYS_NEAR_MESSAGE( assertion, message )                         \
+  do {                                                                     \
+    bool hasFailed = false;                                                \
+    try                                                                    \
+    {                                                                      \
+      assertion;                                                           \
+    }                                                                      \
+    catch ( CPPUNIT_NS::Exception &e )                                     \
+    {                                                                      \
+      hasFailed = true;                                                    \
+      message = e.message();                                               \
+    }                                                                      \
+    CPPUNIT_ASSERT_MESSAGE( "expected assertion failure", hasFailed );     \
+  } while ( false )
+
+
+ArraysNearAssertTest::ArraysNearAssertTest()
+{
+}
+
+
+ArraysNearAssertTest::~ArraysNearAssertTest()
+{
+}
+
+
+void 
+ArraysNearAssertTest::testAbsolute()
+{
+  double expected[] = { 1.0, 2.0, 100.0 };
+  double actual[] = { 1.0005, 1.9995, 100.0 };
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 3, 
+                                  CPPUNIT_NS::Tolerance::absolute( 1e-3 ) ) );
+
+  actual[2] = 100.01;
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 3, 
+                                  CPPUNIT_NS::Tolerance::absolute( 1e-3 ) ) );
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 0, 
+                                  CPPUNIT_NS::Tolerance::absolute( 0 ) ) );
+}
+
+
+void 
+ArraysNearAssertTest::testRelative()
+{
+  double expected[] = { 1e-10, 1e10, 0.0 };
+  double actual[] = { 1.000001e-10, 1.000001e10, 0.0 };
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 3, 
+                                  CPPUNIT_NS::Tolerance::relative( 1e-5 ) ) );
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 3, 
+                                  CPPUNIT_NS::Tolerance::relative( 1e-7 ) ) );
+
+  // The error of the small values is not hidden by the large ones.
+  actual[0] = 2e-10;
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 3, 
+                                  CPPUNIT_NS::Tolerance::relative( 1e-5 ) ) );
+}
+
+
+void 
+ArraysNearAssertTest::testUlps()
+{
+  double expected[] = { 1.0, 1024.0, -3.0 };
+  double actual[] = { 1.0 + 2 * DBL_EPSILON, 
+                      1024.0 + 1024.0 * 4 * DBL_EPSILON, 
+                      -3.0 };
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 3, 
+                                  CPPUNIT_NS::Tolerance::ulps( 4 ) ) );
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 3, 
+                                  CPPUNIT_NS::Tolerance::ulps( 3 ) ) );
+}
+
+
+void 
+ArraysNearAssertTest::testUlpsOfSubnormals()
+{
+  double smallest = DBL_MIN * DBL_EPSILON;   // smallest subnormal
+  double expected[] = { 0.0, smallest };
+  double actual[] = { smallest, 3 * smallest };
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::ulps( 2 ) ) );
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::ulps( 1 ) ) );
+}
+
+
+void 
+ArraysNearAssertTest::testFloatArrays()
+{
+  float expected[] = { 1.0f, 0.5f };
+  float actual[] = { 1.0f + FLT_EPSILON, 0.5f };
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::ulps( 1 ) ) );
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::ulps( 0.5 ) ) );
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::relative( 1e-6 ) ) );
+}
+
+
+void 
+ArraysNearAssertTest::testNanPolicy()
+{
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  double expected[] = { 1.0, nan };
+  double actual[] = { 1.0, nan };
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::absolute( 1 ) ) );
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::absolute( 1 ).setNanPolicy( 
+                                      CPPUNIT_NS::Tolerance::nanIsNearNan ) ) );
+
+  actual[1] = 1.0;
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::absolute( 1 ).setNanPolicy( 
+                                      CPPUNIT_NS::Tolerance::nanIsNearNan ) ) );
+}
+
+
+void 
+ArraysNearAssertTest::testInfinityPolicy()
+{
+  double inf = std::numeric_limits<double>::infinity();
+  double expected[] = { inf, -inf };
+  double actual[] = { inf, -inf };
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::relative( 1e-6 ) ) );
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::relative( 1e-6 ).setInfinityPolicy( 
+                                      CPPUNIT_NS::Tolerance::infinityIsNeverNear ) ) );
+
+  actual[1] = inf;
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::ulps( 1000 ) ) );
+  actual[1] = DBL_MAX;
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 2, 
+                                  CPPUNIT_NS::Tolerance::absolute( 1 ) ) );
+}
+
+
+void 
+ArraysNearAssertTest::testFailureDetails()
+{
+  std::vector<double> expected( 100000, 0.5 );
+  std::vector<double> actual( expected );
+  actual[1024] = 0.5000021;
+  actual[70000] = 0.625;
+
+  CPPUNIT_NS::Message message;
+  ARRAYS_NEAR_MESSAGE( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( &expected[0], &actual[0], expected.size(),
+                                  CPPUNIT_NS::Tolerance::relative( 1e-6 ) ),
+      message );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "arrays not near" ), 
+                        message.shortDescription() );
+  CPPUNIT_ASSERT_EQUAL( 4, message.detailCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Tolerance       : relative 1e-06" ), 
+                        message.detailAt(0) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Out of tolerance: 2 of 100000, first at index 1024 "
+                                     "(expected 0.5, actual 0.5000021)" ), 
+                        message.detailAt(1) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Maximum error   : 0.2 at index 70000 "
+                                     "(expected 0.5, actual 0.625)" ), 
+                        message.detailAt(2) );
+}
+
+
+void 
+ArraysNearAssertTest::testHistogram()
+{
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  double expected[] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  double actual[] = { 0.5, 1.5, 1.5, 5, 50, 500, 5000, nan };
+
+  CPPUNIT_NS::Message message;
+  ARRAYS_NEAR_MESSAGE( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, 8,
+                                  CPPUNIT_NS::Tolerance::absolute( 1 ) ),
+      message );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Error histogram : 1-2x: 2, 2-10x: 1, 10-100x: 1, "
+                                     "100-1000x: 1, >1000x: 1, not finite: 1" ), 
+                        message.detailAt(3) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Maximum error   : 5000 at index 6 "
+                                     "(expected 0, actual 5000)" ), 
+                        message.detailAt(2) );
+}
+
+
+void 
+ArraysNearAssertTest::testToleranceToString()
+{
+  CPPUNIT_ASSERT_EQUAL( std::string( "absolute 0.001" ), 
+                        CPPUNIT_NS::Tolerance::absolute( 1e-3 ).toString() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "4 ulps, NaN near NaN, infinities never near" ), 
+                        CPPUNIT_NS::Tolerance::ulps( 4 )
+                            .setNanPolicy( CPPUNIT_NS::Tolerance::nanIsNearNan )
+                            .setInfinityPolicy( CPPUNIT_NS::Tolerance::infinityIsNeverNear )
+                            .toString() );
+}
+
+
+void 
+ArraysNearAssertTest::testMessage()
+{
+  double expected[] = { 1 };
+  double actual[] = { 2 };
+
+  CPPUNIT_NS::Message message;
+  ARRAYS_NEAR_MESSAGE( 
+      CPPUNIT_ASSERT_ARRAYS_NEAR_MESSAGE( "filter response", expected, actual, 1,
+                                          CPPUNIT_NS::Tolerance::absolute( 0.1 ) ),
+      message );
+  CPPUNIT_ASSERT_EQUAL( std::string( "filter response" ), 
+                        message.detailAt( message.detailCount() - 1 ) );
+}
@@ -0,0 +1,44 @@
+#ifndef ARRAYSNEARASSERTTEST_H
+#define ARRAYSNEARASSERTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class ArraysNearAssertTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( ArraysNearAssertTest );
+  CPPUNIT_TEST( testAbsolute );
+  CPPUNIT_TEST( testRelative );
+  CPPUNIT_TEST( testUlps );
+  CPPUNIT_TEST( testUlpsOfSubnormals );
+  CPPUNIT_TEST( testFloatArrays );
+  CPPUNIT_TEST( testNanPolicy );
+  CPPUNIT_TEST( testInfinityPolicy );
+  CPPUNIT_TEST( testFailureDetails );
+  CPPUNIT_TEST( testHistogram );
+  CPPUNIT_TEST( testToleranceToString );
+  CPPUNIT_TEST( testMessage );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  ArraysNearAssertTest();
+  virtual ~ArraysNearAssertTest();
+
+  void testAbsolute();
+  void testRelative();
+  void testUlps();
+  void testUlpsOfSubnormals();
+  void testFloatArrays();
+  void testNanPolicy();
+  void testInfinityPolicy();
+  void testFailureDetails();
+  void testHistogram();
+  void testToleranceToString();
+  void testMessage();
+
+private:
+  ArraysNearAssertTest( const ArraysNearAssertTest &copy );
+  void operator =( const ArraysNearAssertTest &copy );
+};
+
+#endif  // ARRAYSNEARASSERTTEST_H
@@ -0,0 +1,267 @@
+#include <cppunit/AssertionCountXmlHook.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/Exception.h>
+#include <cppunit/RangeAssert.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFailure.h>
+#include <cppunit/TestThreadContext.h>
+#include <cppunit/TextOutputter.h>
+#include <cppunit/XmlOutputter.h>
+#include <cppunit/portability/Stream.h>
+#include "AssertionCountTest.h"
+#include "CoreSuite.h"
+#include <stdexcept>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( AssertionCountTest,
+                                       coreSuiteName() );
+
+
+/*! Test case running a function.
+ */
+class CountedTestCase : public CPPUNIT_NS::TestCase
+{
+public:
+  CountedTestCase( void (*testMethod)() )
+      : CPPUNIT_NS::TestCase( "CountedTestCase" )
+      , m_testMethod( testMethod )
+  {
+  }
+
+  void runTest()
+  {
+    m_testMethod();
+  }
+
+private:
+  void (*m_testMethod)();
+};
+
+
+static void
+checkEightAssertions()
+{
+  int values[] = { 1, 2, 3 };
+  CPPUNIT_ASSERT( true );
+  CPPUNIT_ASSERT_MESSAGE( "message", true );
+  CPPUNIT_ASSERT_EQUAL( 1, 1 );
+  CPPUNIT_ASSERT_EQUAL( std::string( "a" ), std::string( "a" ) );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL( 1.0, 1.0, 0.1 );
+  CPPUNIT_ASSERT_THROW( throw std::runtime_error( "" ), std::runtime_error );
+  CPPUNIT_ASSERT_NO_THROW( values[0] = 1 );
+  CPPUNIT_ASSERT_RANGES_EQUAL( values, values + 3, values, values + 3 );
+}
+
+
+static void
+checkOneFailingAssertion()
+{
+  CPPUNIT_ASSERT( true );
+  CPPUNIT_ASSERT_EQUAL( 1, 2 );
+  CPPUNIT_ASSERT( true );
+}
+
+
+static void
+checkTwoExpectations()
+{
+  CPPUNIT_EXPECT( false );
+  CPPUNIT_EXPECT_EQUAL( 1, 1 );
+}
+
+
+static void
+checkNothing()
+{
+}
+
+
+static void
+throwError()
+{
+  throw std::runtime_error( "not an assertion" );
+}
+
+
+/*! Task checking two assertions.
+ */
+class CheckingTask : public CPPUNIT_NS::Functor
+{
+public:
+  bool operator()() const
+  {
+    CPPUNIT_ASSERT( true );
+    CPPUNIT_EXPECT_EQUAL( 2, 2 );
+    return true;
+  }
+};
+
+
+static void
+runCheckingTask()
+{
+  CPPUNIT_ASSERT( CPPUNIT_NS::TestThreadContext::current().run( CheckingTask() ) );
+}
+
+
+AssertionCountTest::AssertionCountTest()
+    : m_result( NULL )
+    , m_collector( NULL )
+{
+}
+
+
+AssertionCountTest::~AssertionCountTest()
+{
+}
+
+
+void 
+AssertionCountTest::setUp()
+{
+  m_result = new CPPUNIT_NS::TestResult();
+  m_collector = new CPPUNIT_NS::TestResultCollector();
+  m_result->addListener( m_collector );
+}
+
+
+void 
+AssertionCountTest::tearDown()
+{
+  delete m_collector;
+  delete m_result;
+}
+
+
+void 
+AssertionCountTest::runFixtureTest( void (*testMethod)() )
+{
+  CountedTestCase test( testMethod );
+  test.run( m_result );
+}
+
+
+void 
+AssertionCountTest::testCountPassingAssertions()
+{
+  runFixtureTest( &checkEightAssertions );
+
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+  CPPUNIT_ASSERT_EQUAL( 8, m_collector->assertionCount() );
+}
+
+
+void 
+AssertionCountTest::testCountFailedAssertion()
+{
+  runFixtureTest( &checkOneFailingAssertion );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+  CPPUNIT_ASSERT_EQUAL( 2, m_collector->assertionCount() );
+}
+
+
+void 
+AssertionCountTest::testCountPerTest()
+{
+  CountedTestCase test1( &checkEightAssertions );
+  CountedTestCase test2( &checkTwoExpectations );
+  test1.run( m_result );
+  test2.run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( 10, m_collector->assertionCount() );
+  CPPUNIT_ASSERT_EQUAL( 8, m_collector->assertionCount( &test1 ) );
+  CPPUNIT_ASSERT_EQUAL( 2, m_collector->assertionCount( &test2 ) );
+  CPPUNIT_ASSERT_EQUAL( 0, m_collector->assertionCount( NULL ) );
+}
+
+
+void 
+AssertionCountTest::testCountAssertionsOfTasks()
+{
+  runFixtureTest( &runCheckingTask );
+
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+  CPPUNIT_ASSERT_EQUAL( 3, m_collector->assertionCount() );
+}
+
+
+void 
+AssertionCountTest::testNoCountWithoutTest()
+{
+  CPPUNIT_NS::ExpectationCollector *previous = 
+      CPPUNIT_NS::ExpectationCollector::setCurrent( NULL );
+  CPPUNIT_NS::Asserter::countAssertion();
+  CPPUNIT_NS::ExpectationCollector::setCurrent( previous );
+}
+
+
+void 
+AssertionCountTest::testFailTestsWithoutAssertions()
+{
+  runFixtureTest( &checkNothing );
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+
+  m_result->setFailsTestsWithoutAssertions( true );
+  CPPUNIT_ASSERT( m_result->failsTestsWithoutAssertions() );
+  runFixtureTest( &checkNothing );
+  runFixtureTest( &checkEightAssertions );
+
+  CPPUNIT_ASSERT_EQUAL( 3, m_collector->runTests() );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "no assertion checked" ),
+                        m_collector->failures()[0]->thrownException()->message().shortDescription() );
+}
+
+
+void 
+AssertionCountTest::testErrorNotReportedAsWithoutAssertions()
+{
+  m_result->setFailsTestsWithoutAssertions( true );
+  runFixtureTest( &throwError );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailuresTotal() );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testErrors() );
+}
+
+
+void 
+AssertionCountTest::testOutputters()
+{
+  CountedTestCase test1( &checkEightAssertions );
+  test1.run( m_result );
+
+  CPPUNIT_NS::OStringStream textStream;
+  CPPUNIT_NS::TextOutputter textOutputter( m_collector, textStream );
+  textOutputter.write();
+  CPPUNIT_ASSERT( textStream.str().find( "OK (1 tests, 8 assertions)" ) != std::string::npos );
+
+  CountedTestCase test2( &checkOneFailingAssertion );
+  test2.run( m_result );
+
+  CPPUNIT_NS::OStringStream compilerStream;
+  CPPUNIT_NS::CompilerOutputter compilerOutputter( m_collector, compilerStream );
+  compilerOutputter.write();
+  CPPUNIT_ASSERT( compilerStream.str().find( "Assertions: 10\n" ) != std::string::npos );
+}
+
+
+void 
+AssertionCountTest::testXmlHook()
+{
+  CountedTestCase test1( &checkEightAssertions );
+  CountedTestCase test2( &checkOneFailingAssertion );
+  test1.run( m_result );
+  test2.run( m_result );
+
+  CPPUNIT_NS::OStringStream stream;
+  CPPUNIT_NS::XmlOutputter outputter( m_collector, stream );
+  CPPUNIT_NS::AssertionCountXmlHook hook( m_collector );
+  outputter.addHook( &hook );
+  outputter.write();
+
+  std::string xml = stream.str();
+  CPPUNIT_ASSERT( xml.find( "<Assertions>8</Assertions>" ) != std::string::npos );
+  CPPUNIT_ASSERT( xml.find( "<Assertions>2</Assertions>" ) != std::string::npos );
+  CPPUNIT_ASSERT( xml.find( "<Assertions>10</Assertions>" ) != std::string::npos );
+}
@@ -0,0 +1,51 @@
+#ifndef ASSERTIONCOUNTTEST_H
+#define ASSERTIONCOUNTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+
+
+class AssertionCountTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( AssertionCountTest );
+  CPPUNIT_TEST( testCountPassingAssertions );
+  CPPUNIT_TEST( testCountFailedAssertion );
+  CPPUNIT_TEST( testCountPerTest );
+  CPPUNIT_TEST( testCountAssertionsOfTasks );
+  CPPUNIT_TEST( testNoCountWithoutTest );
+  CPPUNIT_TEST( testFailTestsWithoutAssertions );
+  CPPUNIT_TEST( testErrorNotReportedAsWithoutAssertions );
+  CPPUNIT_TEST( testOutputters );
+  CPPUNIT_TEST( testXmlHook );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  AssertionCountTest();
+  virtual ~AssertionCountTest();
+
+  void setUp();
+  void tearDown();
+
+  void testCountPassingAssertions();
+  void testCountFailedAssertion();
+  void testCountPerTest();
+  void testCountAssertionsOfTasks();
+  void testNoCountWithoutTest();
+  void testFailTestsWithoutAssertions();
+  void testErrorNotReportedAsWithoutAssertions();
+  void testOutputters();
+  void testXmlHook();
+
+private:
+  AssertionCountTest( const AssertionCountTest &copy );
+  void operator =( const AssertionCountTest &copy );
+
+  void runFixtureTest( void (*testMethod)() );
+
+private:
+  CPPUNIT_NS::TestResult *m_result;
+  CPPUNIT_NS::TestResultCollector *m_collector;
+};
+
+#endif  // ASSERTIONCOUNTTEST_H
@@ -0,0 +1,190 @@
+#include <cppunit/tools/BoundedText.h>
+#include "BoundedTextTest.h"
+#include "CoreSuite.h"
+#include <limits.h>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( BoundedTextTest,
+                                       coreSuiteName() );
+
+
+/*! Returns a text of the specified length made of the letters of the alphabet.
+ */
+static std::string
+makeText( unsigned int length )
+{
+  std::string text;
+  for ( unsigned int index = 0; index < length; ++index )
+    text += char( 'a' + index % 26 );
+  return text;
+}
+
+
+BoundedTextTest::BoundedTextTest()
+    : m_maximumLength( 0 )
+{
+}
+
+
+BoundedTextTest::~BoundedTextTest()
+{
+}
+
+
+void
+BoundedTextTest::setUp()
+{
+  m_maximumLength = CPPUNIT_NS::BoundedText::maximumLength();
+}
+
+
+void
+BoundedTextTest::tearDown()
+{
+  CPPUNIT_NS::BoundedText::setMaximumLength( m_maximumLength );
+}
+
+
+void
+BoundedTextTest::testShortTextKept()
+{
+  std::string expected = makeText( 200 );
+  CPPUNIT_NS::BoundedText text( 200 );
+  text.append( expected.c_str(), 150 );
+  text.append( expected.c_str() + 150, 50 );
+  CPPUNIT_ASSERT_EQUAL( expected, text.str() );
+  CPPUNIT_ASSERT_EQUAL( 200UL, text.length() );
+}
+
+
+void
+BoundedTextTest::testLongTextElided()
+{
+  std::string value = makeText( 10000 );
+  CPPUNIT_NS::BoundedText text( 200 );
+  text.append( value.c_str(), value.length() );
+
+  std::string elided = text.str();
+  CPPUNIT_ASSERT( elided.length() <= 200 );
+  CPPUNIT_ASSERT_EQUAL( 10000UL, text.length() );
+  CPPUNIT_ASSERT( elided.find( " of 10000 characters elided, hash " ) != std::string::npos );
+
+  std::string::size_type markerStart = elided.find( "[..." );
+  std::string::size_type markerEnd = elided.find( "...]" ) + 4;
+  CPPUNIT_ASSERT( markerStart > 0 );
+  CPPUNIT_ASSERT_EQUAL( value.substr( 0, markerStart ), elided.substr( 0, markerStart ) );
+  std::string tail = elided.substr( markerEnd );
+  CPPUNIT_ASSERT( !tail.empty() );
+  CPPUNIT_ASSERT_EQUAL( value.substr( value.length() - tail.length() ), tail );
+}
+
+
+void
+BoundedTextTest::testCharactersAppendedOneByOne()
+{
+  std::string value = makeText( 1000 );
+  CPPUNIT_NS::BoundedText bulk( 200 );
+  bulk.append( value.c_str(), value.length() );
+  CPPUNIT_NS::BoundedText oneByOne( 200 );
+  for ( unsigned int index = 0; index < value.length(); ++index )
+    oneByOne.append( value[index] );
+
+  CPPUNIT_ASSERT_EQUAL( bulk.str(), oneByOne.str() );
+}
+
+
+void
+BoundedTextTest::testHashTellsApartMiddles()
+{
+  std::string value = makeText( 1000 );
+  CPPUNIT_NS::BoundedText expected( 200 );
+  expected.append( value.c_str(), value.length() );
+  value[500] = '*';
+  CPPUNIT_NS::BoundedText actual( 200 );
+  actual.append( value.c_str(), value.length() );
+
+  CPPUNIT_ASSERT( expected.str() != actual.str() );
+}
+
+
+void
+BoundedTextTest::testUnbounded()
+{
+  std::string value = makeText( 100000 );
+  CPPUNIT_NS::BoundedText text( 0 );
+  text.append( value.c_str(), value.length() );
+  CPPUNIT_ASSERT( value == text.str() );
+}
+
+
+void
+BoundedTextTest::testMinimumMaximumLength()
+{
+  CPPUNIT_NS::BoundedText::setMaximumLength( 10 );
+  CPPUNIT_ASSERT_EQUAL( 128U, CPPUNIT_NS::BoundedText::maximumLength() );
+
+  std::string value = makeText( 1000 );
+  CPPUNIT_NS::BoundedText text( 10 );
+  text.append( value.c_str(), value.length() );
+  CPPUNIT_ASSERT( text.str().length() <= 128 );
+  CPPUNIT_ASSERT( text.str().length() > 100 );
+}
+
+
+void
+BoundedTextTest::testElide()
+{
+  CPPUNIT_NS::BoundedText::setMaximumLength( 300 );
+  std::string value = makeText( 300 );
+  CPPUNIT_ASSERT_EQUAL( value, CPPUNIT_NS::BoundedText::elide( value ) );
+
+  value += "z";
+  std::string elided = CPPUNIT_NS::BoundedText::elide( value );
+  CPPUNIT_ASSERT( elided.length() <= 300 );
+  CPPUNIT_ASSERT( elided.find( " of 301 characters elided" ) != std::string::npos );
+  CPPUNIT_ASSERT_EQUAL( elided, CPPUNIT_NS::BoundedText::elide( elided ) );
+}
+
+
+void
+BoundedTextTest::testRenderValues()
+{
+  CPPUNIT_ASSERT_EQUAL( std::string( "-42" ),
+                        CPPUNIT_NS::assertion_traits<int>::toString( -42 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "4294967295" ),
+                        CPPUNIT_NS::assertion_traits<unsigned int>::toString( 4294967295U ) );
+  CPPUNIT_NS::OStringStream longMinimum;
+  longMinimum << LONG_MIN;
+  CPPUNIT_ASSERT_EQUAL( longMinimum.str(),
+                        CPPUNIT_NS::assertion_traits<long>::toString( LONG_MIN ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "0.1" ),
+                        CPPUNIT_NS::assertion_traits<float>::toString( 0.1f ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "x" ),
+                        CPPUNIT_NS::assertion_traits<char>::toString( 'x' ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "abc" ),
+                        CPPUNIT_NS::assertion_traits<std::string>::toString( "abc" ) );
+}
+
+
+void
+BoundedTextTest::testAssertEqualOnLongStrings()
+{
+  CPPUNIT_NS::BoundedText::setMaximumLength( 1024 );
+  std::string expected = makeText( 1000000 );
+  std::string actual = expected;
+  actual[500000] = '*';
+
+  try
+  {
+    CPPUNIT_ASSERT_EQUAL( expected, actual );
+  }
+  catch ( CPPUNIT_NS::Exception &e )
+  {
+    CPPUNIT_NS::Message message = e.message();
+    CPPUNIT_ASSERT( message.detailAt(0).length() <= 1024 + 10 );
+    CPPUNIT_ASSERT( message.detailAt(1).length() <= 1024 + 10 );
+    CPPUNIT_ASSERT( message.detailAt(0) != message.detailAt(1) );
+    return;
+  }
+  CPPUNIT_FAIL( "CPPUNIT_ASSERT_EQUAL() should have failed" );
+}
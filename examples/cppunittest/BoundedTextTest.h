@@ -0,0 +1,46 @@
+#ifndef BOUNDEDTEXTTEST_H
+#define BOUNDEDTEXTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class BoundedTextTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( BoundedTextTest );
+  CPPUNIT_TEST( testShortTextKept );
+  CPPUNIT_TEST( testLongTextElided );
+  CPPUNIT_TEST( testCharactersAppendedOneByOne );
+  CPPUNIT_TEST( testHashTellsApartMiddles );
+  CPPUNIT_TEST( testUnbounded );
+  CPPUNIT_TEST( testMinimumMaximumLength );
+  CPPUNIT_TEST( testElide );
+  CPPUNIT_TEST( testRenderValues );
+  CPPUNIT_TEST( testAssertEqualOnLongStrings );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  BoundedTextTest();
+  virtual ~BoundedTextTest();
+
+  void setUp();
+  void tearDown();
+
+  void testShortTextKept();
+  void testLongTextElided();
+  void testCharactersAppendedOneByOne();
+  void testHashTellsApartMiddles();
+  void testUnbounded();
+  void testMinimumMaximumLength();
+  void testElide();
+  void testRenderValues();
+  void testAssertEqualOnLongStrings();
+
+private:
+  BoundedTextTest( const BoundedTextTest &copy );
+  void operator =( const BoundedTextTest &copy );
+
+private:
+  unsigned int m_maximumLength;
+};
+
+#endif  // BOUNDEDTEXTTEST_H
@@ -0,0 +1,240 @@
+#include "ExtensionSuite.h"
+#include "ConcurrentRepeatedTestTest.h"
+#include <cppunit/Mutex.h>
+#include <cppunit/Protector.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/ConcurrentRepeatedTest.h>
+#include <cppunit/extensions/TestFactory.h>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( ConcurrentRepeatedTestTest,
+                                       extensionSuiteName() );
+
+
+/*! \brief Test that counts its runs, and fails every other run if requested.
+ */
+class ConcurrentCountTest : public CPPUNIT_NS::TestCase
+{
+public:
+  ConcurrentCountTest( bool failEveryOtherRun = false,
+                       int waitedRunCount = 0 )
+      : CPPUNIT_NS::TestCase( "ConcurrentCountTest" )
+      , m_failEveryOtherRun( failEveryOtherRun )
+      , m_waitedRunCount( waitedRunCount )
+      , m_runCount( 0 )
+  {
+  }
+
+  void runTest()
+  {
+    int runCount;
+    {
+      CPPUNIT_NS::MutexLock lock( m_mutex );
+      runCount = ++m_runCount;
+    }
+
+    // Waits until the other threads are running too.
+    for ( int spin = 0; spin < 100000000  &&  getRunCount() < m_waitedRunCount; ++spin )
+      ;
+    CPPUNIT_ASSERT( getRunCount() >= m_waitedRunCount );
+
+    if ( m_failEveryOtherRun  &&  runCount % 2 == 0 )
+      CPPUNIT_FAIL( "even run" );
+  }
+
+  int getRunCount()
+  {
+    CPPUNIT_NS::MutexLock lock( m_mutex );
+    return m_runCount;
+  }
+
+private:
+  CPPUNIT_NS::Mutex m_mutex;
+  bool m_failEveryOtherRun;
+  int m_waitedRunCount;
+  int m_runCount;
+};
+
+
+/*! \brief Makes a ConcurrentCountTest for each thread.
+ */
+class ConcurrentCountTestFactory : public CPPUNIT_NS::TestFactory
+{
+public:
+  ConcurrentCountTestFactory()
+      : m_madeTestCount( 0 )
+  {
+  }
+
+  CPPUNIT_NS::Test *makeTest()
+  {
+    ++m_madeTestCount;
+    return new ConcurrentCountTest();
+  }
+
+  int m_madeTestCount;
+};
+
+
+/*! \brief Test that checks nothing.
+ */
+class NoAssertionTest : public CPPUNIT_NS::TestCase
+{
+public:
+  NoAssertionTest()
+      : CPPUNIT_NS::TestCase( "NoAssertionTest" )
+  {
+  }
+
+  void runTest()
+  {
+  }
+};
+
+
+/*! \brief Protector that counts the calls it protects.
+ */
+class CountingProtector : public CPPUNIT_NS::Protector
+{
+public:
+  CountingProtector( CPPUNIT_NS::Mutex &mutex,
+                     int &protectedCount )
+      : m_mutex( mutex )
+      , m_protectedCount( protectedCount )
+  {
+  }
+
+  bool protect( const CPPUNIT_NS::Functor &functor,
+                const CPPUNIT_NS::ProtectorContext & )
+  {
+    {
+      CPPUNIT_NS::MutexLock lock( m_mutex );
+      ++m_protectedCount;
+    }
+    return functor();
+  }
+
+private:
+  CPPUNIT_NS::Mutex &m_mutex;
+  int &m_protectedCount;
+};
+
+
+ConcurrentRepeatedTestTest::ConcurrentRepeatedTestTest()
+{
+}
+
+
+ConcurrentRepeatedTestTest::~ConcurrentRepeatedTestTest()
+{
+}
+
+
+void 
+ConcurrentRepeatedTestTest::testRunsAllRepetitions()
+{
+  ConcurrentCountTest *test = new ConcurrentCountTest();
+  CPPUNIT_NS::ConcurrentRepeatedTest repeatedTest( test, 4, 5 );
+  CPPUNIT_NS::TestResult result;
+  repeatedTest.run( &result );
+
+  CPPUNIT_ASSERT_EQUAL( 20, repeatedTest.countTestCases() );
+  CPPUNIT_ASSERT_EQUAL( 4, repeatedTest.getThreadCount() );
+  CPPUNIT_ASSERT_EQUAL( 20, test->getRunCount() );
+  CPPUNIT_ASSERT_EQUAL( 20, repeatedTest.getRepetitionCount() );
+  CPPUNIT_ASSERT_EQUAL( 0, repeatedTest.getFailedRepetitionCount() );
+  CPPUNIT_ASSERT( repeatedTest.getElapsedTime() >= 0 );
+  CPPUNIT_ASSERT( repeatedTest.getThroughput() >= 0 );
+}
+
+
+void 
+ConcurrentRepeatedTestTest::testThreadsRunConcurrently()
+{
+#if defined(CPPUNIT_HAVE_PTHREAD_H)  ||  defined(_WIN32)
+  // Each run only completes once all the threads started their run.
+  ConcurrentCountTest *test = new ConcurrentCountTest( false, 3 );
+  CPPUNIT_NS::ConcurrentRepeatedTest repeatedTest( test, 3 );
+  CPPUNIT_NS::TestResult controller;
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+  repeatedTest.run( &controller );
+
+  CPPUNIT_ASSERT_EQUAL( 3, result.runTests() );
+  CPPUNIT_ASSERT( result.wasSuccessful() );
+#endif
+}
+
+
+void 
+ConcurrentRepeatedTestTest::testCollectsFailures()
+{
+  CPPUNIT_NS::ConcurrentRepeatedTest repeatedTest( new ConcurrentCountTest( true ), 
+                                                   3, 4 );
+  CPPUNIT_NS::TestResult controller;
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+  repeatedTest.run( &controller );
+
+  CPPUNIT_ASSERT_EQUAL( 12, result.runTests() );
+  CPPUNIT_ASSERT_EQUAL( 6, result.testFailures() );
+  CPPUNIT_ASSERT_EQUAL( 0, result.testErrors() );
+  CPPUNIT_ASSERT_EQUAL( 12, repeatedTest.getRepetitionCount() );
+  CPPUNIT_ASSERT_EQUAL( 6, repeatedTest.getFailedRepetitionCount() );
+}
+
+
+void 
+ConcurrentRepeatedTestTest::testFactoryMakesTestPerThread()
+{
+  ConcurrentCountTestFactory factory;
+  CPPUNIT_NS::ConcurrentRepeatedTest repeatedTest( &factory, 3, 2 );
+  CPPUNIT_ASSERT_EQUAL( 1, factory.m_madeTestCount );
+
+  CPPUNIT_NS::TestResult controller;
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+  repeatedTest.run( &controller );
+  repeatedTest.run( &controller );
+
+  CPPUNIT_ASSERT_EQUAL( 3, factory.m_madeTestCount );
+  CPPUNIT_ASSERT_EQUAL( 12, result.runTests() );
+  CPPUNIT_ASSERT_EQUAL( 6, repeatedTest.getRepetitionCount() );
+  for ( int index = 0; index < result.runTests(); ++index )
+    CPPUNIT_ASSERT_EQUAL( 4, ((ConcurrentCountTest *)result.tests()[index])->getRunCount() );
+}
+
+
+void 
+ConcurrentRepeatedTestTest::testForwardsAssertions()
+{
+  CPPUNIT_NS::ConcurrentRepeatedTest repeatedTest( new ConcurrentCountTest(), 
+                                                   3, 4 );
+  CPPUNIT_NS::TestResult controller;
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+  repeatedTest.run( &controller );
+
+  CPPUNIT_ASSERT_EQUAL( 12, result.assertionCount() );
+}
+
+
+void 
+ConcurrentRepeatedTestTest::testUsesSettingsOfResult()
+{
+  CPPUNIT_NS::ConcurrentRepeatedTest repeatedTest( new NoAssertionTest(), 2, 3 );
+  CPPUNIT_NS::TestResult controller;
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+  controller.setFailsTestsWithoutAssertions( true );
+  CPPUNIT_NS::Mutex mutex;
+  int protectedCount = 0;
+  controller.pushProtector( new CountingProtector( mutex, protectedCount ) );
+  repeatedTest.run( &controller );
+
+  CPPUNIT_ASSERT_EQUAL( 6, result.runTests() );
+  CPPUNIT_ASSERT_EQUAL( 6, result.testFailures() );
+  // setUp(), runTest() and tearDown() of each repetition.
+  CPPUNIT_ASSERT_EQUAL( 18, protectedCount );
+}
@@ -0,0 +1,46 @@
+#ifndef CONCURRENTREPEATEDTESTTEST_H
+#define CONCURRENTREPEATEDTESTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+/*! \class ConcurrentRepeatedTestTest
+ * \brief Unit tests for class ConcurrentRepeatedTest.
+ */
+class ConcurrentRepeatedTestTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( ConcurrentRepeatedTestTest );
+  CPPUNIT_TEST( testRunsAllRepetitions );
+  CPPUNIT_TEST( testThreadsRunConcurrently );
+  CPPUNIT_TEST( testCollectsFailures );
+  CPPUNIT_TEST( testFactoryMakesTestPerThread );
+  CPPUNIT_TEST( testForwardsAssertions );
+  CPPUNIT_TEST( testUsesSettingsOfResult );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a ConcurrentRepeatedTestTest object.
+   */
+  ConcurrentRepeatedTestTest();
+
+  /// Destructor.
+  virtual ~ConcurrentRepeatedTestTest();
+
+  void testRunsAllRepetitions();
+  void testThreadsRunConcurrently();
+  void testCollectsFailures();
+  void testFactoryMakesTestPerThread();
+  void testForwardsAssertions();
+  void testUsesSettingsOfResult();
+
+private:
+  /// Prevents the use of the copy constructor.
+  ConcurrentRepeatedTestTest( const ConcurrentRepeatedTestTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const ConcurrentRepeatedTestTest &copy );
+};
+
+
+
+#endif  // CONCURRENTREPEATEDTESTTEST_H
@@ -1,3 +1,4 @@
+#include <cppunit/AllocationScope.h>
 #include <cppunit/CompilerOutputter.h>
 #include <cppunit/TestResult.h>
 #include <cppunit/TestResultCollector.h>
@@ -10,6 +11,10 @@
 #include <fstream>
 
 
+// Counts the allocations made by the tests, see CppUnit::AllocationScope.
+CPPUNIT_INSTALL_ALLOCATION_COUNTING()
+
+
 int 
 main( int argc, char* argv[] )
 {
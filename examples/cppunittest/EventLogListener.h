@@ -0,0 +1,57 @@
+#ifndef EVENTLOGLISTENER_H
+#define EVENTLOGLISTENER_H
+
+#include <cppunit/Test.h>
+#include <cppunit/TestFailure.h>
+#include <cppunit/TestListener.h>
+#include <string>
+
+
+/*! \class EventLogListener
+ * \brief Listener that records the events it receives in a string.
+ *
+ * Each event is logged as "<event>:<test name>;", for example
+ * "startSuite:All;startTest:test1;endTest:test1;endSuite:All;".
+ */
+class EventLogListener : public CPPUNIT_NS::TestListener
+{
+public:
+  void startTest( CPPUNIT_NS::Test *test )
+  {
+    log( "startTest", test );
+  }
+
+  void addFailure( const CPPUNIT_NS::TestFailure &failure )
+  {
+    log( failure.isError() ? "error" : "failure", failure.failedTest() );
+  }
+
+  void endTest( CPPUNIT_NS::Test *test )
+  {
+    log( "endTest", test );
+  }
+
+  void startSuite( CPPUNIT_NS::Test *suite )
+  {
+    log( "startSuite", suite );
+  }
+
+  void endSuite( CPPUNIT_NS::Test *suite )
+  {
+    log( "endSuite", suite );
+  }
+
+  std::string m_log;
+
+private:
+  void log( const char *event, CPPUNIT_NS::Test *test )
+  {
+    m_log += event;
+    m_log += ':';
+    m_log += test->getNameRef();
+    m_log += ';';
+  }
+};
+
+
+#endif  // EVENTLOGLISTENER_H
@@ -0,0 +1,277 @@
+#include <cppunit/Exception.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFailure.h>
+#include <cppunit/TestListener.h>
+#include <cppunit/TestResult.h>
+#include "CoreSuite.h"
+#include "ExpectationTest.h"
+#include <stdexcept>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( ExpectationTest,
+                                       coreSuiteName() );
+
+
+/// Reached when the test goes on after failed expectations.
+static bool testEnded = false;
+
+/// Checks done by the tearDown() of ExpectingTestCase, if any.
+static void (*tearDownChecks)() = NULL;
+
+
+/*! Test case running a function, then tearDownChecks.
+ */
+class ExpectingTestCase : public CPPUNIT_NS::TestCase
+{
+public:
+  ExpectingTestCase( void (*testMethod)() )
+      : CPPUNIT_NS::TestCase( "ExpectingTestCase" )
+      , m_testMethod( testMethod )
+  {
+  }
+
+  void runTest()
+  {
+    m_testMethod();
+  }
+
+  void tearDown()
+  {
+    if ( tearDownChecks != NULL )
+      tearDownChecks();
+  }
+
+private:
+  void (*m_testMethod)();
+};
+
+
+static void
+expectNothingWrong()
+{
+  CPPUNIT_EXPECT( 1 + 1 == 2 );
+  CPPUNIT_EXPECT_MESSAGE( "arithmetic", 2 * 2 == 4 );
+  CPPUNIT_EXPECT_EQUAL( 3, 3 );
+  CPPUNIT_EXPECT_EQUAL( std::string( "abc" ), std::string( "abc" ) );
+  CPPUNIT_EXPECT_DOUBLES_EQUAL( 1.0, 1.05, 0.1 );
+  testEnded = true;
+}
+
+
+static void
+expectThreeWrongThings()
+{
+  CPPUNIT_EXPECT( 1 + 1 == 3 );
+  CPPUNIT_EXPECT_EQUAL_MESSAGE( "row 2", 5, 6 );
+  CPPUNIT_EXPECT_DOUBLES_EQUAL( 1.0, 2.0, 0.5 );
+  testEnded = true;
+}
+
+
+static void
+expectManyWrongThings()
+{
+  for ( int index = 0; index < 250; ++index )
+    CPPUNIT_EXPECT_EQUAL( index, index + 1 );
+  testEnded = true;
+}
+
+
+static void
+expectWrongThingInTearDown()
+{
+  CPPUNIT_EXPECT( false );
+}
+
+
+static void
+expectThenAssert()
+{
+  CPPUNIT_EXPECT_EQUAL( 1, 2 );
+  CPPUNIT_ASSERT_EQUAL( 3, 4 );
+  testEnded = true;
+}
+
+
+/*! Listener that throws when a failure is reported.
+ */
+class ThrowingListener : public CPPUNIT_NS::TestListener
+{
+public:
+  void addFailure( const CPPUNIT_NS::TestFailure & )
+  {
+    throw std::runtime_error( "addFailure" );
+  }
+};
+
+
+ExpectationTest::ExpectationTest()
+    : m_collector( NULL )
+{
+}
+
+
+ExpectationTest::~ExpectationTest()
+{
+}
+
+
+void 
+ExpectationTest::setUp()
+{
+  m_collector = new CPPUNIT_NS::TestResultCollector();
+  testEnded = false;
+  tearDownChecks = NULL;
+}
+
+
+void 
+ExpectationTest::tearDown()
+{
+  tearDownChecks = NULL;
+  delete m_collector;
+}
+
+
+void 
+ExpectationTest::runFixtureTest( void (*testMethod)() )
+{
+  CPPUNIT_NS::TestResult result;
+  result.addListener( m_collector );
+  ExpectingTestCase test( testMethod );
+  test.run( &result );
+}
+
+
+std::string 
+ExpectationTest::failureMessage( int index ) const
+{
+  return m_collector->failures()[ index ]->thrownException()->message().details();
+}
+
+
+void 
+ExpectationTest::testPassingExpectations()
+{
+  runFixtureTest( &expectNothingWrong );
+
+  CPPUNIT_ASSERT( testEnded );
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+}
+
+
+void 
+ExpectationTest::testFailuresRecordedAndTestGoesOn()
+{
+  runFixtureTest( &expectThreeWrongThings );
+
+  CPPUNIT_ASSERT( testEnded );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->runTests() );
+  CPPUNIT_ASSERT_EQUAL( 3, m_collector->testFailures() );
+  CPPUNIT_ASSERT_EQUAL( 0, m_collector->testErrors() );
+}
+
+
+void 
+ExpectationTest::testFailureDetails()
+{
+  runFixtureTest( &expectThreeWrongThings );
+
+  CPPUNIT_ASSERT_EQUAL( 3, m_collector->testFailuresTotal() );
+  const CPPUNIT_NS::Exception *first = 
+      m_collector->failures()[0]->thrownException();
+  CPPUNIT_ASSERT_EQUAL( std::string( "expectation failed" ), 
+                        first->message().shortDescription() );
+  CPPUNIT_ASSERT( failureMessage( 0 ).find( "1 + 1 == 3" ) != std::string::npos );
+  CPPUNIT_ASSERT( first->sourceLine().isValid() );
+  CPPUNIT_ASSERT( failureMessage( 1 ).find( "Expected: 5" ) != std::string::npos );
+  CPPUNIT_ASSERT( failureMessage( 1 ).find( "row 2" ) != std::string::npos );
+  CPPUNIT_ASSERT( failureMessage( 2 ).find( "Delta   : 0.5" ) != std::string::npos );
+  CPPUNIT_ASSERT( m_collector->failures()[0]->sourceLine().lineNumber() <
+                  m_collector->failures()[2]->sourceLine().lineNumber() );
+}
+
+
+void 
+ExpectationTest::testFailureCountBounded()
+{
+  runFixtureTest( &expectManyWrongThings );
+
+  CPPUNIT_ASSERT( testEnded );
+  CPPUNIT_ASSERT_EQUAL( 
+      int(CPPUNIT_NS::ExpectationCollector::defaultMaximumFailureCount) + 1,
+      m_collector->testFailuresTotal() );
+  const CPPUNIT_NS::Exception *last = 
+      m_collector->failures().back()->thrownException();
+  CPPUNIT_ASSERT_EQUAL( std::string( "too many failed expectations" ), 
+                        last->message().shortDescription() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "150 more failed expectations were not kept" ),
+                        last->message().detailAt( 0 ) );
+}
+
+
+void 
+ExpectationTest::testExpectationsInTearDown()
+{
+  tearDownChecks = &expectWrongThingInTearDown;
+  runFixtureTest( &expectThreeWrongThings );
+
+  CPPUNIT_ASSERT_EQUAL( 4, m_collector->testFailuresTotal() );
+  CPPUNIT_ASSERT( failureMessage( 3 ).find( "false" ) != std::string::npos );
+}
+
+
+void 
+ExpectationTest::testFatalAssertionAfterExpectations()
+{
+  runFixtureTest( &expectThenAssert );
+
+  CPPUNIT_ASSERT( !testEnded );
+  CPPUNIT_ASSERT_EQUAL( 2, m_collector->testFailuresTotal() );
+  CPPUNIT_ASSERT( failureMessage( 0 ).find( "Expected: 3" ) != std::string::npos );
+  CPPUNIT_ASSERT( failureMessage( 1 ).find( "Expected: 1" ) != std::string::npos );
+}
+
+
+void 
+ExpectationTest::testThrowsWithoutCollector()
+{
+  CPPUNIT_NS::ExpectationCollector *previous = 
+      CPPUNIT_NS::ExpectationCollector::setCurrent( NULL );
+  bool hasThrown = false;
+  try
+  {
+    CPPUNIT_EXPECT_EQUAL( 1, 2 );
+  }
+  catch ( CPPUNIT_NS::Exception & )
+  {
+    hasThrown = true;
+  }
+  CPPUNIT_NS::ExpectationCollector::setCurrent( previous );
+
+  CPPUNIT_ASSERT( hasThrown );
+}
+
+
+void 
+ExpectationTest::testCollectorRestoredOnException()
+{
+  CPPUNIT_NS::ExpectationCollector *previous = 
+      CPPUNIT_NS::ExpectationCollector::current();
+  CPPUNIT_NS::TestResult result;
+  ThrowingListener listener;
+  result.addListener( &listener );
+  ExpectingTestCase test( &expectWrongThingInTearDown );
+  bool hasThrown = false;
+  try
+  {
+    test.run( &result );
+  }
+  catch ( std::runtime_error & )
+  {
+    hasThrown = true;
+  }
+
+  CPPUNIT_ASSERT( hasThrown );
+  CPPUNIT_ASSERT( CPPUNIT_NS::ExpectationCollector::current() == previous );
+}
@@ -0,0 +1,49 @@
+#ifndef EXPECTATIONTEST_H
+#define EXPECTATIONTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestResultCollector.h>
+
+
+class ExpectationTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( ExpectationTest );
+  CPPUNIT_TEST( testPassingExpectations );
+  CPPUNIT_TEST( testFailuresRecordedAndTestGoesOn );
+  CPPUNIT_TEST( testFailureDetails );
+  CPPUNIT_TEST( testFailureCountBounded );
+  CPPUNIT_TEST( testExpectationsInTearDown );
+  CPPUNIT_TEST( testFatalAssertionAfterExpectations );
+  CPPUNIT_TEST( testThrowsWithoutCollector );
+  CPPUNIT_TEST( testCollectorRestoredOnException );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  ExpectationTest();
+  virtual ~ExpectationTest();
+
+  void setUp();
+  void tearDown();
+
+  void testPassingExpectations();
+  void testFailuresRecordedAndTestGoesOn();
+  void testFailureDetails();
+  void testFailureCountBounded();
+  void testExpectationsInTearDown();
+  void testFatalAssertionAfterExpectations();
+  void testThrowsWithoutCollector();
+  void testCollectorRestoredOnException();
+
+private:
+  ExpectationTest( const ExpectationTest &copy );
+  void operator =( const ExpectationTest &copy );
+
+  void runFixtureTest( void (*testMethod)() );
+
+  std::string failureMessage( int index ) const;
+
+private:
+  CPPUNIT_NS::TestResultCollector *m_collector;
+};
+
+#endif  // EXPECTATIONTEST_H
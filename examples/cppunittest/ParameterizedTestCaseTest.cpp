@@ -0,0 +1,240 @@
+#include "CoreSuite.h"
+#include "ParameterizedTestCaseTest.h"
+#include "TestDataTableTest.h"
+#include <cppunit/ParameterizedTestCase.h>
+#include <cppunit/TestFailure.h>
+#include <cppunit/TestPath.h>
+#include <cppunit/TestPlan.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <fstream>
+#include <memory>
+#include <stdio.h>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( ParameterizedTestCaseTest,
+                                       coreSuiteName() );
+
+
+/*! \brief Fixture whose test method checks the sum of two numbers.
+ */
+class SumFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( SumFixture );
+  CPPUNIT_TEST_DATA( testSum, new CPPUNIT_NS::CsvTestDataTable( dataFileName() ) );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  SumFixture()
+  {
+    ++s_fixtureCount;
+    if ( s_fixtureCount > s_maxFixtureCount )
+      s_maxFixtureCount = s_fixtureCount;
+  }
+
+  ~SumFixture()
+  {
+    --s_fixtureCount;
+  }
+
+  void testSum( std::istream &parameters, std::istream &expected )
+  {
+    int left, right, sum;
+    parameters >> left >> right;
+    expected >> sum;
+    CPPUNIT_ASSERT_EQUAL( sum, left + right );
+  }
+
+  static std::string dataFileName()
+  {
+    return "ParameterizedTestCaseTest.csv";
+  }
+
+  static int s_fixtureCount;
+  static int s_maxFixtureCount;
+};
+
+int SumFixture::s_fixtureCount = 0;
+int SumFixture::s_maxFixtureCount = 0;
+
+
+ParameterizedTestCaseTest::ParameterizedTestCaseTest()
+{
+}
+
+
+ParameterizedTestCaseTest::~ParameterizedTestCaseTest()
+{
+}
+
+
+void 
+ParameterizedTestCaseTest::setUp()
+{
+  m_fileName = TestDataTableTest::writeDataFile( "zero,0 0,0\n"
+                                                 ",1 2,3\n"
+                                                 "wrong,2 2,5\n"
+                                                 ",3 4,7\n"
+                                                 ",5 6,11\n" );
+  SumFixture::s_fixtureCount = 0;
+  SumFixture::s_maxFixtureCount = 0;
+}
+
+
+void 
+ParameterizedTestCaseTest::tearDown()
+{
+  TestDataTableTest::removeDataFile();
+  ::remove( SumFixture::dataFileName().c_str() );
+}
+
+
+CPPUNIT_NS::Test *
+ParameterizedTestCaseTest::makeSumTest( const std::string &fileName )
+{
+  return new CPPUNIT_NS::ParameterizedTestCase<SumFixture>( 
+      "SumFixture::testSum",
+      &SumFixture::testSum,
+      new CPPUNIT_NS::CsvTestDataTable( fileName ) );
+}
+
+
+void 
+ParameterizedTestCaseTest::testRowNames()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> test( makeSumTest( m_fileName ) );
+
+  CPPUNIT_ASSERT_EQUAL( 5, test->getChildTestCount() );
+  CPPUNIT_ASSERT_EQUAL( 5, test->countTestCases() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "SumFixture::testSum[zero]" ),
+                        test->getChildTestAt( 0 )->getName() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "SumFixture::testSum[1]" ),
+                        test->getChildTestAt( 1 )->getNameRef() );
+  CPPUNIT_ASSERT( test->getChildTestAt( 1 ) == test->getChildTestAt( 1 ) );
+}
+
+
+void 
+ParameterizedTestCaseTest::testRun()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> test( makeSumTest( m_fileName ) );
+  CPPUNIT_NS::TestResult result;
+  CPPUNIT_NS::TestResultCollector collector;
+  result.addListener( &collector );
+
+  test->run( &result );
+
+  CPPUNIT_ASSERT_EQUAL( 5, collector.runTests() );
+  CPPUNIT_ASSERT_EQUAL( 1, collector.testFailures() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "SumFixture::testSum[wrong]" ),
+                        collector.failures()[0]->failedTestName() );
+}
+
+
+void 
+ParameterizedTestCaseTest::testOneFixturePerRow()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> test( makeSumTest( m_fileName ) );
+  CPPUNIT_NS::TestResult result;
+
+  test->run( &result );
+
+  CPPUNIT_ASSERT_EQUAL( 0, SumFixture::s_fixtureCount );
+  CPPUNIT_ASSERT_EQUAL( 1, SumFixture::s_maxFixtureCount );
+}
+
+
+void 
+ParameterizedTestCaseTest::testFindRowTest()
+{
+  CPPUNIT_NS::TestSuite suite( "All" );
+  suite.addTest( makeSumTest( m_fileName ) );
+
+  CPPUNIT_NS::TestPath path( &suite, "SumFixture::testSum/SumFixture::testSum[3]" );
+  CPPUNIT_ASSERT_EQUAL( std::string( "SumFixture::testSum[3]" ),
+                        path.getChildTest()->getName() );
+  CPPUNIT_ASSERT( suite.findTest( "SumFixture::testSum[wrong]" ) != NULL );
+}
+
+
+void 
+ParameterizedTestCaseTest::testRunPlan()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> test( makeSumTest( m_fileName ) );
+  CPPUNIT_NS::TestPlan plan( test.get() );
+  CPPUNIT_NS::TestResult result;
+  CPPUNIT_NS::TestResultCollector collector;
+  result.addListener( &collector );
+
+  plan.run( &result );
+
+  CPPUNIT_ASSERT_EQUAL( 6, plan.getEntryCount() );
+  CPPUNIT_ASSERT_EQUAL( 5, plan.countTestCases() );
+  CPPUNIT_ASSERT_EQUAL( 5, collector.runTests() );
+  CPPUNIT_ASSERT_EQUAL( 1, collector.testFailures() );
+  CPPUNIT_ASSERT_EQUAL( 1, SumFixture::s_maxFixtureCount );
+}
+
+
+void 
+ParameterizedTestCaseTest::testShard()
+{
+  CPPUNIT_NS::ParameterizedTestCase<SumFixture> test( 
+      "SumFixture::testSum",
+      &SumFixture::testSum,
+      new CPPUNIT_NS::CsvTestDataTable( m_fileName ) );
+  test.setShard( 1, 2 );
+
+  CPPUNIT_ASSERT_EQUAL( 2, test.getChildTestCount() );
+  CPPUNIT_ASSERT_EQUAL( 3, test.getRowIndex( 1 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "SumFixture::testSum[1]" ),
+                        test.getChildTestAt( 0 )->getName() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "SumFixture::testSum[3]" ),
+                        test.getChildTestAt( 1 )->getName() );
+  CPPUNIT_ASSERT_THROW( test.setShard( 0, 2 ), std::logic_error );
+  CPPUNIT_ASSERT_THROW( test.setShard( 2, 2 ), std::invalid_argument );
+}
+
+
+void 
+ParameterizedTestCaseTest::testDefaultShard()
+{
+  CPPUNIT_NS::ParameterizedTest::setDefaultShard( 2, 3 );
+  std::auto_ptr<CPPUNIT_NS::Test> test( makeSumTest( m_fileName ) );
+  CPPUNIT_NS::ParameterizedTest::setDefaultShard( 0, 1 );
+
+  CPPUNIT_ASSERT_EQUAL( 1, test->getChildTestCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "SumFixture::testSum[wrong]" ),
+                        test->getChildTestAt( 0 )->getName() );
+}
+
+
+void 
+ParameterizedTestCaseTest::testMissingTable()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> test( makeSumTest( "ParameterizedTestCaseTest.missing" ) );
+  CPPUNIT_NS::TestResult result;
+  CPPUNIT_NS::TestResultCollector collector;
+  result.addListener( &collector );
+
+  test->run( &result );
+
+  CPPUNIT_ASSERT_EQUAL( 1, collector.runTests() );
+  CPPUNIT_ASSERT_EQUAL( 1, collector.testErrors() + collector.testFailures() );
+  CPPUNIT_ASSERT_EQUAL( 0, SumFixture::s_fixtureCount );
+}
+
+
+void 
+ParameterizedTestCaseTest::testTestDataMacro()
+{
+  TestDataTableTest::removeDataFile();
+  std::ofstream stream( SumFixture::dataFileName().c_str() );
+  stream  <<  "a,1 1,2\nb,2 3,5\n";
+  stream.close();
+
+  std::auto_ptr<CPPUNIT_NS::Test> suite( SumFixture::suite() );
+  CPPUNIT_ASSERT_EQUAL( 2, suite->countTestCases() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "SumFixture::testSum[b]" ),
+                        suite->getChildTestAt( 0 )->getChildTestAt( 1 )->getName() );
+}
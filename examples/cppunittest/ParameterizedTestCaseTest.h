@@ -0,0 +1,60 @@
+#ifndef PARAMETERIZEDTESTCASETEST_H
+#define PARAMETERIZEDTESTCASETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+/*! \class ParameterizedTestCaseTest
+ * \brief Unit tests for class ParameterizedTestCase.
+ */
+class ParameterizedTestCaseTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( ParameterizedTestCaseTest );
+  CPPUNIT_TEST( testRowNames );
+  CPPUNIT_TEST( testRun );
+  CPPUNIT_TEST( testOneFixturePerRow );
+  CPPUNIT_TEST( testFindRowTest );
+  CPPUNIT_TEST( testRunPlan );
+  CPPUNIT_TEST( testShard );
+  CPPUNIT_TEST( testDefaultShard );
+  CPPUNIT_TEST( testMissingTable );
+  CPPUNIT_TEST( testTestDataMacro );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a ParameterizedTestCaseTest object.
+   */
+  ParameterizedTestCaseTest();
+
+  /// Destructor.
+  virtual ~ParameterizedTestCaseTest();
+
+  void setUp();
+  void tearDown();
+
+  void testRowNames();
+  void testRun();
+  void testOneFixturePerRow();
+  void testFindRowTest();
+  void testRunPlan();
+  void testShard();
+  void testDefaultShard();
+  void testMissingTable();
+  void testTestDataMacro();
+
+private:
+  /// Prevents the use of the copy constructor.
+  ParameterizedTestCaseTest( const ParameterizedTestCaseTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const ParameterizedTestCaseTest &copy );
+
+  CPPUNIT_NS::Test *makeSumTest( const std::string &fileName );
+
+private:
+  std::string m_fileName;
+};
+
+
+
+#endif  // PARAMETERIZEDTESTCASETEST_H
@@ -0,0 +1,191 @@
+#include <cppunit/PeakMemoryXmlHook.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFailure.h>
+#include <cppunit/XmlOutputter.h>
+#include <cppunit/portability/Stream.h>
+#include <cppunit/tools/PeakMemory.h>
+#include <string.h>
+#include "PeakMemoryTest.h"
+#include "CoreSuite.h"
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( PeakMemoryTest,
+                                       coreSuiteName() );
+
+
+/// Keeps the compiler from removing the memory touched by touchMemory().
+static volatile char touchedByte = 0;
+
+
+/*! Makes the specified number of megabytes resident, then frees them.
+ */
+static void
+touchMemory( int megabytes )
+{
+  char *memory = new char[ megabytes * 1024 * 1024 ];
+  ::memset( memory, 1, megabytes * 1024 * 1024 );
+  touchedByte = memory[ megabytes * 1024 * 1024 - 1 ];
+  delete [] memory;
+}
+
+
+/*! Test case making 128 MB resident.
+ */
+class TouchingTestCase : public CPPUNIT_NS::TestCase
+{
+public:
+  TouchingTestCase()
+      : CPPUNIT_NS::TestCase( "TouchingTestCase" )
+  {
+  }
+
+  void runTest()
+  {
+    touchMemory( 128 );
+  }
+};
+
+
+/*! Fixture whose suite has a budget of 16 MB.
+ */
+class BudgetedFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( BudgetedFixture );
+  CPPUNIT_TEST_SUITE_PROPERTY( "max_rss_mb", "16" );
+  CPPUNIT_TEST( testTouchMemory );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testTouchMemory()
+  {
+    touchMemory( 128 );
+  }
+};
+
+
+PeakMemoryTest::PeakMemoryTest()
+    : m_result( NULL )
+    , m_collector( NULL )
+{
+}
+
+
+PeakMemoryTest::~PeakMemoryTest()
+{
+}
+
+
+void 
+PeakMemoryTest::setUp()
+{
+  m_result = new CPPUNIT_NS::TestResult();
+  m_collector = new CPPUNIT_NS::TestResultCollector();
+  m_result->addListener( m_collector );
+}
+
+
+void 
+PeakMemoryTest::tearDown()
+{
+  delete m_collector;
+  delete m_result;
+}
+
+
+void 
+PeakMemoryTest::testMeasure()
+{
+  CPPUNIT_ASSERT( CPPUNIT_NS::PeakMemory::kilobytes() > 0 );
+}
+
+
+void 
+PeakMemoryTest::testBudgetExceeded()
+{
+  m_result->setPeakMemoryBudget( 16 * 1024 );
+  TouchingTestCase test;
+  test.run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "memory budget exceeded" ),
+                        m_collector->failures()[0]->thrownException()->message().shortDescription() );
+  CPPUNIT_ASSERT( m_collector->peakMemory( &test ) > 16 * 1024 );
+}
+
+
+void 
+PeakMemoryTest::testWithinBudget()
+{
+  m_result->setPeakMemoryBudget( 16 * 1024 * 1024 );
+  TouchingTestCase test;
+  test.run( m_result );
+
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+  CPPUNIT_ASSERT( m_collector->peakMemory( &test ) > 0 );
+  CPPUNIT_ASSERT_EQUAL( m_collector->peakMemory( &test ), m_collector->peakMemory() );
+}
+
+
+void 
+PeakMemoryTest::testNotTrackedByDefault()
+{
+  TouchingTestCase test;
+  test.run( m_result );
+
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+  CPPUNIT_ASSERT_EQUAL( -1L, m_collector->peakMemory( &test ) );
+  CPPUNIT_ASSERT_EQUAL( -1L, m_collector->peakMemory() );
+}
+
+
+void 
+PeakMemoryTest::testSuiteProperty()
+{
+  CPPUNIT_NS::TestSuite *suite = BudgetedFixture::suite();
+  long budget = suite->getPeakMemoryBudget();
+  delete suite;
+
+  CPPUNIT_ASSERT_EQUAL( 16 * 1024L, budget );
+}
+
+
+void 
+PeakMemoryTest::testSuiteBudgetOverridesResultBudget()
+{
+  m_result->setPeakMemoryBudget( 16 * 1024 * 1024 );
+  CPPUNIT_NS::TestSuite *suite = BudgetedFixture::suite();
+  suite->run( m_result );
+
+  int failureCount = m_collector->testFailures();
+  std::string description;
+  if ( failureCount > 0 )
+    description = m_collector->failures()[0]->thrownException()->message().shortDescription();
+  long resultBudget = m_result->peakMemoryBudget();
+  delete suite;
+
+  CPPUNIT_ASSERT_EQUAL( 1, failureCount );
+  CPPUNIT_ASSERT_EQUAL( std::string( "memory budget exceeded" ), description );
+  CPPUNIT_ASSERT_EQUAL( 16 * 1024 * 1024L, resultBudget );
+}
+
+
+void 
+PeakMemoryTest::testXmlHook()
+{
+  m_result->setTracksPeakMemory( true );
+  TouchingTestCase test;
+  test.run( m_result );
+
+  CPPUNIT_NS::OStringStream stream;
+  CPPUNIT_NS::XmlOutputter outputter( m_collector, stream );
+  CPPUNIT_NS::PeakMemoryXmlHook hook( m_collector );
+  outputter.addHook( &hook );
+  outputter.write();
+
+  std::string xml = stream.str();
+  CPPUNIT_NS::OStringStream expected;
+  expected  <<  "<PeakMemoryKilobytes>"  <<  m_collector->peakMemory( &test )
+            <<  "</PeakMemoryKilobytes>";
+  CPPUNIT_ASSERT( m_collector->peakMemory( &test ) > 0 );
+  CPPUNIT_ASSERT( xml.find( expected.str() ) != std::string::npos );
+}
@@ -0,0 +1,45 @@
+#ifndef PEAKMEMORYTEST_H
+#define PEAKMEMORYTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+
+
+class PeakMemoryTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( PeakMemoryTest );
+  CPPUNIT_TEST( testMeasure );
+  CPPUNIT_TEST( testBudgetExceeded );
+  CPPUNIT_TEST( testWithinBudget );
+  CPPUNIT_TEST( testNotTrackedByDefault );
+  CPPUNIT_TEST( testSuiteProperty );
+  CPPUNIT_TEST( testSuiteBudgetOverridesResultBudget );
+  CPPUNIT_TEST( testXmlHook );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  PeakMemoryTest();
+  virtual ~PeakMemoryTest();
+
+  void setUp();
+  void tearDown();
+
+  void testMeasure();
+  void testBudgetExceeded();
+  void testWithinBudget();
+  void testNotTrackedByDefault();
+  void testSuiteProperty();
+  void testSuiteBudgetOverridesResultBudget();
+  void testXmlHook();
+
+private:
+  PeakMemoryTest( const PeakMemoryTest &copy );
+  void operator =( const PeakMemoryTest &copy );
+
+private:
+  CPPUNIT_NS::TestResult *m_result;
+  CPPUNIT_NS::TestResultCollector *m_collector;
+};
+
+#endif  // PEAKMEMORYTEST_H
@@ -0,0 +1,248 @@
+#include <cppunit/RangeAssert.h>
+#include "CoreSuite.h"
+#include "RangeAssertTest.h"
+#include <list>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( RangeAssertTest,
+                                       coreSuiteName() );
+
+
+/*! Runs an assertion that must fail and stores the message of its failure.
+ */
+#define RANGE_ASSERTION_MESSAGE( assertion, message )                     \
+  do {                                                                     \
+    bool hasFailed = false;                                                \
+    try                                                                    \
+    {                                                                      \
+      assertion;                                                           \
+    }                                                                      \
+    catch ( CPPUNIT_NS::Exception &e )                                     \
+    {                                                                      \
+      hasFailed = true;                                                    \
+      message = e.message();                                               \
+    }                                                                      \
+    CPPUNIT_ASSERT_MESSAGE( "expected assertion failure", hasFailed );     \
+  } while ( false )
+
+
+RangeAssertTest::RangeAssertTest()
+{
+}
+
+
+RangeAssertTest::~RangeAssertTest()
+{
+}
+
+
+void 
+RangeAssertTest::testEqualRanges()
+{
+  int expected[] = { 1, 2, 3, 4 };
+  int actual[] = { 1, 2, 3, 4 };
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected, expected + 4, actual, actual + 4 ) );
+
+  const int *constActual = actual;
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected, expected + 4, 
+                                   constActual, constActual + 4 ) );
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected, expected, actual, actual ) );
+}
+
+
+void 
+RangeAssertTest::testEqualContainers()
+{
+  std::vector<std::string> expected;
+  expected.push_back( "a" );
+  expected.push_back( "b" );
+  std::list<std::string> actual( expected.begin(), expected.end() );
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected.begin(), expected.end(), 
+                                   actual.begin(), actual.end() ) );
+
+  actual.back() = "c";
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected.begin(), expected.end(), 
+                                   actual.begin(), actual.end() ) );
+}
+
+
+void 
+RangeAssertTest::testFirstMismatchReported()
+{
+  std::vector<int> expected( 1000 );
+  for ( int index = 0; index < 1000; ++index )
+    expected[index] = index;
+  std::vector<int> actual( expected );
+  actual[500] = -1;
+  actual[900] = -2;
+
+  CPPUNIT_NS::Message message;
+  RANGE_ASSERTION_MESSAGE( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( &expected[0], &expected[0] + 1000, 
+                                   &actual[0], &actual[0] + 1000 ),
+      message );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "ranges not equal" ), 
+                        message.shortDescription() );
+  CPPUNIT_ASSERT_EQUAL( 6, message.detailCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Expected size: 1000" ), message.detailAt( 0 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Actual size  : 1000" ), message.detailAt( 1 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Mismatches   : 2, first at index 500" ), 
+                        message.detailAt( 2 ) );
+  CPPUNIT_ASSERT_EQUAL( 
+      std::string( "Expected [496..504]: 496, 497, 498, 499, [500], 501, 502, 503, 504" ),
+      message.detailAt( 3 ) );
+  CPPUNIT_ASSERT_EQUAL( 
+      std::string( "Actual   [496..504]: 496, 497, 498, 499, [-1], 501, 502, 503, 504" ),
+      message.detailAt( 4 ) );
+}
+
+
+void 
+RangeAssertTest::testMismatchesCountedAcrossBlocks()
+{
+  std::vector<unsigned short> expected( 20000, 7 );
+  std::vector<unsigned short> actual( expected );
+  actual[4095] = 0;
+  actual[4096] = 0;
+  actual[19999] = 0;
+
+  CPPUNIT_NS::Message message;
+  RANGE_ASSERTION_MESSAGE( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( &expected[0], &expected[0] + expected.size(), 
+                                   &actual[0], &actual[0] + actual.size() ),
+      message );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Mismatches   : 3, first at index 4095" ), 
+                        message.detailAt( 2 ) );
+}
+
+
+void 
+RangeAssertTest::testMismatchAtStart()
+{
+  int expected[] = { 1, 2, 3 };
+  int actual[] = { 0, 2, 3 };
+
+  CPPUNIT_NS::Message message;
+  RANGE_ASSERTION_MESSAGE( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected, expected + 3, actual, actual + 3 ),
+      message );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Expected [0..2]: [1], 2, 3" ), 
+                        message.detailAt( 3 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Actual   [0..2]: [0], 2, 3" ), 
+                        message.detailAt( 4 ) );
+}
+
+
+void 
+RangeAssertTest::testSizesDiffer()
+{
+  int expected[] = { 1, 2, 3, 4 };
+  int actual[] = { 1, 2, 3 };
+
+  CPPUNIT_NS::Message message;
+  RANGE_ASSERTION_MESSAGE( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected, expected + 4, actual, actual + 3 ),
+      message );
+  CPPUNIT_ASSERT_EQUAL( 5, message.detailCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Expected size: 4" ), message.detailAt( 0 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Actual size  : 3" ), message.detailAt( 1 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Expected [0..3]: 1, 2, 3, [4]" ), 
+                        message.detailAt( 2 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Actual   [0..3]: 1, 2, 3" ), 
+                        message.detailAt( 3 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Difference: 1 element removed, 0 elements added\n"
+                                     "@@ -1,4 +1,3 @@\n"
+                                     " 1\n"
+                                     " 2\n"
+                                     " 3\n"
+                                     "-4" ),
+                        message.detailAt( 4 ) );
+}
+
+
+void 
+RangeAssertTest::testNotBitwiseComparableType()
+{
+  // -0.0 and 0.0 have different bytes but are equal.
+  double expected[] = { 0.0, 1.5 };
+  double actual[] = { -0.0, 1.5 };
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected, expected + 2, actual, actual + 2 ) );
+
+  actual[1] = 2.5;
+  CPPUNIT_ASSERT_ASSERTION_FAIL( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected, expected + 2, actual, actual + 2 ) );
+}
+
+
+void 
+RangeAssertTest::testLongElementsTruncated()
+{
+  std::string expected[] = { std::string( 100, 'a' ) };
+  std::string actual[] = { std::string( 100, 'b' ) };
+
+  CPPUNIT_NS::Message message;
+  RANGE_ASSERTION_MESSAGE( 
+      CPPUNIT_ASSERT_RANGES_EQUAL( expected, expected + 1, actual, actual + 1 ),
+      message );
+  CPPUNIT_ASSERT_EQUAL( "Expected [0..0]: [" + std::string( 40, 'a' ) + "...]", 
+                        message.detailAt( 3 ) );
+}
+
+
+void 
+RangeAssertTest::testMessage()
+{
+  int expected[] = { 1 };
+  int actual[] = { 2 };
+
+  CPPUNIT_NS::Message message;
+  RANGE_ASSERTION_MESSAGE( 
+      CPPUNIT_ASSERT_RANGES_EQUAL_MESSAGE( "decoded samples", 
+                                           expected, expected + 1, 
+                                           actual, actual + 1 ),
+      message );
+  CPPUNIT_ASSERT_EQUAL( std::string( "decoded samples" ), 
+                        message.detailAt( message.detailCount() - 1 ) );
+}
+
+
+void 
+RangeAssertTest::testBuffersEqual()
+{
+  const char expected[] = "abcdef";
+  const char actual[] = "abcdef";
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_BUFFERS_EQUAL( expected, actual, sizeof(expected) ) );
+  CPPUNIT_ASSERT_ASSERTION_PASS( 
+      CPPUNIT_ASSERT_BUFFERS_EQUAL( expected, "abcxyz", 3 ) );
+}
+
+
+void 
+RangeAssertTest::testBuffersNotEqual()
+{
+  unsigned char expected[] = { 0x00, 0x10, 0xff };
+  unsigned char actual[] = { 0x00, 0x1f, 0xff };
+
+  CPPUNIT_NS::Message message;
+  RANGE_ASSERTION_MESSAGE( 
+      CPPUNIT_ASSERT_BUFFERS_EQUAL_MESSAGE( "frame 3", expected, actual, 3 ),
+      message );
+  CPPUNIT_ASSERT_EQUAL( std::string( "buffers not equal" ), 
+                        message.shortDescription() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Mismatches   : 1, first at index 1" ), 
+                        message.detailAt( 2 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Expected [0..2]: 0x00, [0x10], 0xff" ), 
+                        message.detailAt( 3 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Actual   [0..2]: 0x00, [0x1f], 0xff" ), 
+                        message.detailAt( 4 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "frame 3" ), message.detailAt( 5 ) );
+}
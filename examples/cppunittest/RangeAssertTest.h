@@ -0,0 +1,45 @@
+#ifndef RANGEASSERTTEST_H
+#define RANGEASSERTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+
+
+class RangeAssertTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( RangeAssertTest );
+  CPPUNIT_TEST( testEqualRanges );
+  CPPUNIT_TEST( testEqualContainers );
+  CPPUNIT_TEST( testFirstMismatchReported );
+  CPPUNIT_TEST( testMismatchesCountedAcrossBlocks );
+  CPPUNIT_TEST( testMismatchAtStart );
+  CPPUNIT_TEST( testSizesDiffer );
+  CPPUNIT_TEST( testNotBitwiseComparableType );
+  CPPUNIT_TEST( testLongElementsTruncated );
+  CPPUNIT_TEST( testMessage );
+  CPPUNIT_TEST( testBuffersEqual );
+  CPPUNIT_TEST( testBuffersNotEqual );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  RangeAssertTest();
+  virtual ~RangeAssertTest();
+
+  void testEqualRanges();
+  void testEqualContainers();
+  void testFirstMismatchReported();
+  void testMismatchesCountedAcrossBlocks();
+  void testMismatchAtStart();
+  void testSizesDiffer();
+  void testNotBitwiseComparableType();
+  void testLongElementsTruncated();
+  void testMessage();
+  void testBuffersEqual();
+  void testBuffersNotEqual();
+
+private:
+  RangeAssertTest( const RangeAssertTest &copy );
+  void operator =( const RangeAssertTest &copy );
+};
+
+#endif  // RANGEASSERTTEST_H
@@ -0,0 +1,331 @@
+#include <cppunit/RangeAssert.h>
+#include <cppunit/tools/SequenceDiff.h>
+#include <cppunit/tools/StringTools.h>
+#include "CoreSuite.h"
+#include "SequenceDiffTest.h"
+#include <algorithm>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( SequenceDiffTest,
+                                       coreSuiteName() );
+
+
+/*! Characters of two strings.
+ */
+class CharacterSequences : public CPPUNIT_NS::DiffSequences
+{
+public:
+  CharacterSequences( const std::string &expected,
+                      const std::string &actual )
+      : m_expected( expected )
+      , m_actual( actual )
+  {
+  }
+
+  bool areEqual( int expectedIndex, int actualIndex ) const
+  {
+    return m_expected[ expectedIndex ] == m_actual[ actualIndex ];
+  }
+
+  std::string expectedElement( int index ) const
+  {
+    return std::string( 1, m_expected[ index ] );
+  }
+
+  std::string actualElement( int index ) const
+  {
+    return std::string( 1, m_actual[ index ] );
+  }
+
+  /// Applies the edits of a diff to the expected string.
+  std::string applyEdits( const CPPUNIT_NS::SequenceDiff &diff ) const
+  {
+    std::string result;
+    int expectedIndex = 0;
+    for ( int index = 0; index < diff.editCount(); ++index )
+    {
+      const CPPUNIT_NS::SequenceDiff::Edit &edit = diff.editAt( index );
+      result += m_expected.substr( expectedIndex, edit.m_expectedIndex - expectedIndex );
+      expectedIndex = edit.m_expectedIndex;
+      if ( edit.m_kind == CPPUNIT_NS::SequenceDiff::removal )
+        ++expectedIndex;
+      else
+        result += m_actual[ edit.m_actualIndex ];
+    }
+    return result + m_expected.substr( expectedIndex );
+  }
+
+  /// Computes the edit distance by dynamic programming.
+  int editDistance() const
+  {
+    std::vector<int> previous( m_actual.length() + 1 );
+    for ( unsigned int actualIndex = 0; actualIndex <= m_actual.length(); ++actualIndex )
+      previous[ actualIndex ] = actualIndex;
+    for ( unsigned int expectedIndex = 1; expectedIndex <= m_expected.length(); ++expectedIndex )
+    {
+      std::vector<int> current( m_actual.length() + 1 );
+      current[0] = expectedIndex;
+      for ( unsigned int actualIndex = 1; actualIndex <= m_actual.length(); ++actualIndex )
+      {
+        if ( areEqual( expectedIndex - 1, actualIndex - 1 ) )
+          current[ actualIndex ] = previous[ actualIndex - 1 ];
+        else
+          current[ actualIndex ] = 1 + std::min( previous[ actualIndex ], 
+                                                 current[ actualIndex - 1 ] );
+      }
+      previous = current;
+    }
+    return previous[ m_actual.length() ];
+  }
+
+private:
+  std::string m_expected;
+  std::string m_actual;
+};
+
+
+/*! Returns a string of pseudo random letters among the first \a letterCount.
+ */
+static std::string
+makeRandomString( unsigned long &seed, 
+                  int length,
+                  int letterCount )
+{
+  std::string text;
+  for ( int index = 0; index < length; ++index )
+  {
+    seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+    text += char( 'a' + (seed >> 16) % letterCount );
+  }
+  return text;
+}
+
+
+/*! Returns the failure message of an assertion that must fail.
+ */
+#define DIFF_ASSERTION_MESSAGE( assertion, message )                      \
+  do {                                                                     \
+    bool hasFailed = false;                                                \
+    try                                                                    \
+    {                                                                      \
+      assertion;                                                           \
+    }                                                                      \
+    catch ( CPPUNIT_NS::Exception &e )                                     \
+    {                                                                      \
+      hasFailed = true;                                                    \
+      message = e.message();                                               \
+    }                                                                      \
+    CPPUNIT_ASSERT_MESSAGE( "expected assertion failure", hasFailed );     \
+  } while ( false )
+
+
+SequenceDiffTest::SequenceDiffTest()
+{
+}
+
+
+SequenceDiffTest::~SequenceDiffTest()
+{
+}
+
+
+void 
+SequenceDiffTest::testEqualSequences()
+{
+  CharacterSequences sequences( "abc", "abc" );
+  CPPUNIT_NS::SequenceDiff diff;
+  CPPUNIT_ASSERT( diff.compute( sequences, 3, 3 ) );
+  CPPUNIT_ASSERT_EQUAL( 0, diff.editCount() );
+  CPPUNIT_ASSERT_EQUAL( 3, diff.commonHeadLength() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "" ), diff.render( sequences, false ) );
+}
+
+
+void 
+SequenceDiffTest::testShortestEditScript()
+{
+  // Example of the paper of Eugene W. Myers.
+  CharacterSequences sequences( "abcabba", "cbabac" );
+  CPPUNIT_NS::SequenceDiff diff;
+  CPPUNIT_ASSERT( diff.compute( sequences, 7, 6 ) );
+  CPPUNIT_ASSERT_EQUAL( 5, diff.editCount() );
+  CPPUNIT_ASSERT_EQUAL( 3, diff.removalCount() );
+  CPPUNIT_ASSERT_EQUAL( 2, diff.insertionCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "cbabac" ), sequences.applyEdits( diff ) );
+}
+
+
+void 
+SequenceDiffTest::testEditsAreMinimal()
+{
+  unsigned long seed = 1;
+  for ( int trial = 0; trial < 200; ++trial )
+  {
+    std::string expected = makeRandomString( seed, trial % 40, 3 );
+    std::string actual = makeRandomString( seed, (trial * 7) % 37, 3 );
+    CharacterSequences sequences( expected, actual );
+    CPPUNIT_NS::SequenceDiff diff;
+    CPPUNIT_ASSERT( diff.compute( sequences, expected.length(), actual.length() ) );
+    CPPUNIT_ASSERT_EQUAL( actual, sequences.applyEdits( diff ) );
+    CPPUNIT_ASSERT_EQUAL( sequences.editDistance(), diff.editCount() );
+  }
+}
+
+
+void 
+SequenceDiffTest::testEditDistanceLimit()
+{
+  CharacterSequences sequences( "xxabcdefgh", "xxijklmnop" );
+  CPPUNIT_NS::SequenceDiff diff( 4 );
+  CPPUNIT_ASSERT( !diff.compute( sequences, 10, 10 ) );
+  CPPUNIT_ASSERT_EQUAL( 0, diff.editCount() );
+  CPPUNIT_ASSERT_EQUAL( 2, diff.commonHeadLength() );
+
+  CPPUNIT_NS::SequenceDiff limitedComparisons( 100, 10 );
+  CPPUNIT_ASSERT( !limitedComparisons.compute( sequences, 10, 10 ) );
+}
+
+
+void 
+SequenceDiffTest::testRenderLines()
+{
+  std::string expected = "1\n2\n3\n4\n5\n6\n7\n8\n9\n10\n11\n12\n13\n14";
+  std::string actual = "1\n2\n3\n4\n5\nsix\n7\n8\n9\n10\n11\n12\n13\n14\n15";
+  CPPUNIT_ASSERT_EQUAL( std::string( "Difference: 1 line removed, 2 lines added\n"
+                                     "@@ -3,7 +3,7 @@\n"
+                                     " 3\n"
+                                     " 4\n"
+                                     " 5\n"
+                                     "-6\n"
+                                     "+six\n"
+                                     " 7\n"
+                                     " 8\n"
+                                     " 9\n"
+                                     "@@ -12,3 +12,4 @@\n"
+                                     " 12\n"
+                                     " 13\n"
+                                     " 14\n"
+                                     "+15" ),
+                        CPPUNIT_NS::describeStringDifference( expected, actual ) );
+}
+
+
+void 
+SequenceDiffTest::testRenderCharacters()
+{
+  CPPUNIT_ASSERT_EQUAL( std::string( "Difference: 0 characters removed, 6 characters added\n"
+                                     "@@ -4,6 +4,12 @@\n"
+                                     " lo \n"
+                                     "+there \n"
+                                     " wor" ),
+                        CPPUNIT_NS::describeStringDifference( "hello world", 
+                                                              "hello there world" ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "" ),
+                        CPPUNIT_NS::describeStringDifference( "same", "same" ) );
+}
+
+
+void 
+SequenceDiffTest::testRenderTruncated()
+{
+  std::string expected;
+  std::string actual;
+  for ( int line = 0; line < 1000; ++line )
+  {
+    expected += "line\n";
+    actual += line % 10 == 0 ? "changed\n" : "line\n";
+  }
+
+  std::string description = CPPUNIT_NS::describeStringDifference( expected, actual );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Difference: 100 lines removed, 100 lines added" ),
+                        description.substr( 0, description.find( '\n' ) ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "\n..." ), 
+                        description.substr( description.length() - 4 ) );
+  CPPUNIT_NS::StringTools::Strings lines = 
+      CPPUNIT_NS::StringTools::split( description, '\n' );
+  CPPUNIT_ASSERT_EQUAL( CPPUNIT_NS::SequenceDiff::maximumLineCount + 2, (int)lines.size() );
+}
+
+
+void 
+SequenceDiffTest::testMultiMegabyteStrings()
+{
+  std::string expected;
+  std::vector<std::string::size_type> lineStarts;
+  for ( int line = 0; line < 100000; ++line )
+  {
+    lineStarts.push_back( expected.length() );
+    CPPUNIT_NS::OStringStream sample;
+    sample  <<  "<sample index=\""  <<  line  <<  "\">0123456789abcdef</sample>\n";
+    expected += sample.str();
+  }
+  std::string actual = expected;
+  actual.erase( lineStarts[90000], lineStarts[90001] - lineStarts[90000] );
+  actual.insert( lineStarts[1000], "<inserted/>\n" );
+
+  std::string description = CPPUNIT_NS::describeStringDifference( expected, actual );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Difference: 1 line removed, 1 line added" ),
+                        description.substr( 0, description.find( '\n' ) ) );
+  CPPUNIT_ASSERT( description.find( "@@ -998,6 +998,7 @@\n" ) != std::string::npos );
+  CPPUNIT_ASSERT( description.find( "@@ -89998,7 +89999,6 @@\n" ) != std::string::npos );
+  CPPUNIT_ASSERT( description.find( "\n-<sample index=\"90000\">" ) != std::string::npos );
+}
+
+
+void 
+SequenceDiffTest::testAssertEqualAddsDiff()
+{
+  std::string expected = "<total>\n  <count>3</count>\n</total>";
+  std::string actual = "<total>\n  <count>4</count>\n</total>";
+
+  CPPUNIT_NS::Message message;
+  DIFF_ASSERTION_MESSAGE( CPPUNIT_ASSERT_EQUAL_MESSAGE( "report", expected, actual ), 
+                          message );
+  CPPUNIT_ASSERT_EQUAL( 4, message.detailCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Difference: 1 line removed, 1 line added\n"
+                                     "@@ -1,3 +1,3 @@\n"
+                                     " <total>\n"
+                                     "-  <count>3</count>\n"
+                                     "+  <count>4</count>\n"
+                                     " </total>" ),
+                        message.detailAt(2) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "report" ), message.detailAt(3) );
+}
+
+
+void 
+SequenceDiffTest::testAssertEqualOnShortStrings()
+{
+  CPPUNIT_NS::Message message;
+  DIFF_ASSERTION_MESSAGE( CPPUNIT_ASSERT_EQUAL( std::string( "abc" ), 
+                                                std::string( "abd" ) ), 
+                          message );
+  CPPUNIT_ASSERT_EQUAL( 2, message.detailCount() );
+}
+
+
+void 
+SequenceDiffTest::testRangesDiff()
+{
+  std::vector<int> expected;
+  for ( int value = 0; value < 100; ++value )
+    expected.push_back( value );
+  std::vector<int> actual( expected );
+  actual.insert( actual.begin() + 50, -1 );
+
+  CPPUNIT_NS::Message message;
+  DIFF_ASSERTION_MESSAGE( CPPUNIT_ASSERT_RANGES_EQUAL( expected.begin(), expected.end(), 
+                                                       actual.begin(), actual.end() ), 
+                          message );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Difference: 0 elements removed, 1 element added\n"
+                                     "@@ -48,6 +48,7 @@\n"
+                                     " 47\n"
+                                     " 48\n"
+                                     " 49\n"
+                                     "+-1\n"
+                                     " 50\n"
+                                     " 51\n"
+                                     " 52" ),
+                        message.detailAt( message.detailCount() - 1 ) );
+}
@@ -0,0 +1,44 @@
+#ifndef SEQUENCEDIFFTEST_H
+#define SEQUENCEDIFFTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class SequenceDiffTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( SequenceDiffTest );
+  CPPUNIT_TEST( testEqualSequences );
+  CPPUNIT_TEST( testShortestEditScript );
+  CPPUNIT_TEST( testEditsAreMinimal );
+  CPPUNIT_TEST( testEditDistanceLimit );
+  CPPUNIT_TEST( testRenderLines );
+  CPPUNIT_TEST( testRenderCharacters );
+  CPPUNIT_TEST( testRenderTruncated );
+  CPPUNIT_TEST( testMultiMegabyteStrings );
+  CPPUNIT_TEST( testAssertEqualAddsDiff );
+  CPPUNIT_TEST( testAssertEqualOnShortStrings );
+  CPPUNIT_TEST( testRangesDiff );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  SequenceDiffTest();
+  virtual ~SequenceDiffTest();
+
+  void testEqualSequences();
+  void testShortestEditScript();
+  void testEditsAreMinimal();
+  void testEditDistanceLimit();
+  void testRenderLines();
+  void testRenderCharacters();
+  void testRenderTruncated();
+  void testMultiMegabyteStrings();
+  void testAssertEqualAddsDiff();
+  void testAssertEqualOnShortStrings();
+  void testRangesDiff();
+
+private:
+  SequenceDiffTest( const SequenceDiffTest &copy );
+  void operator =( const SequenceDiffTest &copy );
+};
+
+#endif  // SEQUENCEDIFFTEST_H
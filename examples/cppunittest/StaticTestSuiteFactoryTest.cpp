@@ -0,0 +1,165 @@
+#include "CoreSuite.h"
+#include "StaticTestSuiteFactoryTest.h"
+#include <cppunit/TestCase.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/AutoRegisterSuite.h>
+#include <cppunit/extensions/ConcurrentRepeatedTest.h>
+#include <cppunit/extensions/StaticTestSuiteFactory.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <memory>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( StaticTestSuiteFactoryTest,
+                                       coreSuiteName() );
+
+
+/*! \brief Fixture registered by the tests below.
+ */
+class StaticRegisteredFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( StaticRegisteredFixture );
+  CPPUNIT_TEST( testNothing );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testNothing()
+  {
+  }
+};
+
+CPPUNIT_TEST_SUITE_NAMED_STATIC_REGISTRATION( StaticRegisteredFixture,
+                                              "StaticTestSuiteFactoryTest::named" );
+
+
+static const char *const registryName = "StaticTestSuiteFactoryTest";
+
+
+static int
+registeredSuiteCount()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite(
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry( registryName ).makeTest() );
+  return suite->getChildTestCount();
+}
+
+
+/*! \brief Registers and unregisters suites like the static constructors
+ *         and destructors of a test plug-in.
+ */
+class RegisteringTestCase : public CPPUNIT_NS::TestCase
+{
+public:
+  RegisteringTestCase()
+      : CPPUNIT_NS::TestCase( "RegisteringTestCase" )
+  {
+  }
+
+  void runTest()
+  {
+    CPPUNIT_NS::StaticTestSuiteFactory factory( 
+        registryName, 
+        &CPPUNIT_NS::makeStaticTestSuite<StaticRegisteredFixture> );
+    CPPUNIT_NS::AutoRegisterSuite<StaticRegisteredFixture> autoRegister( 
+        registryName );
+
+    // The suites of the other threads may be registered too.
+    CPPUNIT_ASSERT( registeredSuiteCount() >= 2 );
+  }
+};
+
+
+StaticTestSuiteFactoryTest::StaticTestSuiteFactoryTest()
+{
+}
+
+
+StaticTestSuiteFactoryTest::~StaticTestSuiteFactoryTest()
+{
+}
+
+
+void 
+StaticTestSuiteFactoryTest::testNamedStaticRegistration()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite( CPPUNIT_NS::TestFactoryRegistry::getRegistry( 
+      "StaticTestSuiteFactoryTest::named" ).makeTest() );
+
+  CPPUNIT_ASSERT_EQUAL( 1, suite->getChildTestCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string("StaticRegisteredFixture"),
+                        suite->getChildTestAt( 0 )->getName() );
+  CPPUNIT_ASSERT_EQUAL( 1, suite->countTestCases() );
+}
+
+
+void 
+StaticTestSuiteFactoryTest::testRegisteredOnFirstUse()
+{
+  CPPUNIT_NS::StaticTestSuiteFactory factory( 
+      registryName, 
+      &CPPUNIT_NS::makeStaticTestSuite<StaticRegisteredFixture> );
+
+  CPPUNIT_ASSERT_EQUAL( 1, registeredSuiteCount() );
+}
+
+
+void 
+StaticTestSuiteFactoryTest::testRegisteredByMakeTest()
+{
+  CPPUNIT_NS::TestFactoryRegistry &registry = 
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry( registryName );
+  CPPUNIT_NS::StaticTestSuiteFactory factory( 
+      registryName, 
+      &CPPUNIT_NS::makeStaticTestSuite<StaticRegisteredFixture> );
+
+  std::auto_ptr<CPPUNIT_NS::Test> suite( registry.makeTest() );
+  CPPUNIT_ASSERT_EQUAL( 1, suite->getChildTestCount() );
+}
+
+
+void 
+StaticTestSuiteFactoryTest::testDestroyedWhilePending()
+{
+  CPPUNIT_NS::StaticTestSuiteFactory factory1( 
+      registryName, 
+      &CPPUNIT_NS::makeStaticTestSuite<StaticRegisteredFixture> );
+  std::auto_ptr<CPPUNIT_NS::StaticTestSuiteFactory> factory2( 
+      new CPPUNIT_NS::StaticTestSuiteFactory( 
+          registryName, 
+          &CPPUNIT_NS::makeStaticTestSuite<StaticRegisteredFixture> ) );
+  CPPUNIT_NS::StaticTestSuiteFactory factory3( 
+      registryName, 
+      &CPPUNIT_NS::makeStaticTestSuite<StaticRegisteredFixture> );
+
+  factory2.reset();
+
+  CPPUNIT_ASSERT_EQUAL( 2, registeredSuiteCount() );
+}
+
+
+void 
+StaticTestSuiteFactoryTest::testDestroyedAfterRegistration()
+{
+  {
+    CPPUNIT_NS::StaticTestSuiteFactory factory( 
+        registryName, 
+        &CPPUNIT_NS::makeStaticTestSuite<StaticRegisteredFixture> );
+    CPPUNIT_ASSERT_EQUAL( 1, registeredSuiteCount() );
+  }
+
+  CPPUNIT_ASSERT_EQUAL( 0, registeredSuiteCount() );
+}
+
+
+void 
+StaticTestSuiteFactoryTest::testConcurrentRegistration()
+{
+  CPPUNIT_NS::ConcurrentRepeatedTest test( new RegisteringTestCase(), 4, 200 );
+  CPPUNIT_NS::TestResult result;
+  CPPUNIT_NS::TestResultCollector collector;
+  result.addListener( &collector );
+  test.run( &result );
+
+  CPPUNIT_ASSERT( collector.wasSuccessful() );
+  CPPUNIT_ASSERT_EQUAL( 0, registeredSuiteCount() );
+}
@@ -0,0 +1,46 @@
+#ifndef STATICTESTSUITEFACTORYTEST_H
+#define STATICTESTSUITEFACTORYTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+/*! \class StaticTestSuiteFactoryTest
+ * \brief Unit tests for class StaticTestSuiteFactory.
+ */
+class StaticTestSuiteFactoryTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( StaticTestSuiteFactoryTest );
+  CPPUNIT_TEST( testNamedStaticRegistration );
+  CPPUNIT_TEST( testRegisteredOnFirstUse );
+  CPPUNIT_TEST( testRegisteredByMakeTest );
+  CPPUNIT_TEST( testDestroyedWhilePending );
+  CPPUNIT_TEST( testDestroyedAfterRegistration );
+  CPPUNIT_TEST( testConcurrentRegistration );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a StaticTestSuiteFactoryTest object.
+   */
+  StaticTestSuiteFactoryTest();
+
+  /// Destructor.
+  virtual ~StaticTestSuiteFactoryTest();
+
+  void testNamedStaticRegistration();
+  void testRegisteredOnFirstUse();
+  void testRegisteredByMakeTest();
+  void testDestroyedWhilePending();
+  void testDestroyedAfterRegistration();
+  void testConcurrentRegistration();
+
+private:
+  /// Prevents the use of the copy constructor.
+  StaticTestSuiteFactoryTest( const StaticTestSuiteFactoryTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const StaticTestSuiteFactoryTest &copy );
+};
+
+
+
+#endif  // STATICTESTSUITEFACTORYTEST_H
@@ -0,0 +1,105 @@
+#include "CoreSuite.h"
+#include "StaticTestTest.h"
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/StaticTest.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <memory>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( StaticTestTest,
+                                       coreSuiteName() );
+
+
+template<class First, class Second>
+struct SameTypes
+{
+  enum { value = 0 };
+};
+
+template<class Type>
+struct SameTypes<Type,Type>
+{
+  enum { value = 1 };
+};
+
+
+static const char *const registryName = "StaticTestTest";
+
+CPPUNIT_STATIC_TEST_NAMED_REGISTRATION( charIsOneByte, sizeof(char) == 1,
+                                        registryName );
+CPPUNIT_STATIC_TEST_NAMED_REGISTRATION( sameTypes, (SameTypes<int,int>::value),
+                                        registryName );
+
+
+static CPPUNIT_NS::StaticTest *
+findStaticTest( CPPUNIT_NS::Test *suite,
+                const std::string &name )
+{
+  for ( int index =0; index < suite->getChildTestCount(); ++index )
+  {
+    CPPUNIT_NS::Test *test = suite->getChildTestAt( index );
+    if ( test->getName() == name )
+      return dynamic_cast<CPPUNIT_NS::StaticTest *>( test );
+  }
+  return NULL;
+}
+
+
+StaticTestTest::StaticTestTest()
+{
+}
+
+
+StaticTestTest::~StaticTestTest()
+{
+}
+
+
+void 
+StaticTestTest::testRegistration()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite(
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry( registryName ).makeTest() );
+
+  CPPUNIT_ASSERT_EQUAL( 2, suite->getChildTestCount() );
+  CPPUNIT_ASSERT_EQUAL( 2, suite->countTestCases() );
+  CPPUNIT_ASSERT( findStaticTest( suite.get(), "charIsOneByte" ) != NULL );
+  CPPUNIT_ASSERT( findStaticTest( suite.get(), "sameTypes" ) != NULL );
+}
+
+
+void 
+StaticTestTest::testExpressionAndSourceLine()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite(
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry( registryName ).makeTest() );
+  CPPUNIT_NS::StaticTest *test = findStaticTest( suite.get(), "sameTypes" );
+  CPPUNIT_ASSERT( test != NULL );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "(SameTypes<int,int>::value)" ),
+                        test->getExpression() );
+  CPPUNIT_ASSERT_EQUAL( std::string( __FILE__ ),
+                        test->getSourceLine().fileName() );
+  CPPUNIT_ASSERT( test->getSourceLine().lineNumber() > 0 );
+}
+
+
+void 
+StaticTestTest::testRun()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite(
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry( registryName ).makeTest() );
+  CPPUNIT_NS::TestResult result;
+  CPPUNIT_NS::TestResultCollector collector;
+  result.addListener( &collector );
+  result.setFailsTestsWithoutAssertions( true );
+
+  suite->run( &result );
+
+  CPPUNIT_ASSERT_EQUAL( 2, collector.runTests() );
+  CPPUNIT_ASSERT( collector.wasSuccessful() );
+  CPPUNIT_ASSERT_EQUAL( 2, collector.assertionCount() );
+  CPPUNIT_ASSERT_EQUAL( 1, collector.assertionCount( 
+      findStaticTest( suite.get(), "charIsOneByte" ) ) );
+}
@@ -0,0 +1,40 @@
+#ifndef STATICTESTTEST_H
+#define STATICTESTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+/*! \class StaticTestTest
+ * \brief Unit tests for class StaticTest and CPPUNIT_STATIC_TEST().
+ */
+class StaticTestTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( StaticTestTest );
+  CPPUNIT_TEST( testRegistration );
+  CPPUNIT_TEST( testExpressionAndSourceLine );
+  CPPUNIT_TEST( testRun );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a StaticTestTest object.
+   */
+  StaticTestTest();
+
+  /// Destructor.
+  virtual ~StaticTestTest();
+
+  void testRegistration();
+  void testExpressionAndSourceLine();
+  void testRun();
+
+private:
+  /// Prevents the use of the copy constructor.
+  StaticTestTest( const StaticTestTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const StaticTestTest &copy );
+};
+
+
+
+#endif  // STATICTESTTEST_H
@@ -0,0 +1,365 @@
+#include "CoreSuite.h"
+#include "SuiteFixtureTest.h"
+#include <cppunit/SuiteFixture.h>
+#include <cppunit/TestPlan.h>
+#include <cppunit/TestRunner.h>
+#include <stdexcept>
+
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( SuiteFixtureTest,
+                                       coreSuiteName() );
+
+
+/// Events of the suite fixtures and tests below.
+static std::string fixtureLog;
+
+
+/*! \brief Fixture sharing a resource between its tests.
+ */
+class SharedResourceFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( SharedResourceFixture );
+  CPPUNIT_TEST_SUITE_SETUP( setUpResource );
+  CPPUNIT_TEST_SUITE_TEARDOWN( tearDownResource );
+  CPPUNIT_TEST( test1 );
+  CPPUNIT_TEST( test2 );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  static void setUpResource()
+  {
+    fixtureLog += "setUpSuite;";
+    s_resource = new int( 42 );
+  }
+
+  static void tearDownResource()
+  {
+    fixtureLog += "tearDownSuite;";
+    delete s_resource;
+    s_resource = NULL;
+  }
+
+  void test1()
+  {
+    fixtureLog += "test1;";
+    CPPUNIT_ASSERT( s_resource != NULL );
+  }
+
+  void test2()
+  {
+    fixtureLog += "test2;";
+    CPPUNIT_ASSERT( s_resource != NULL );
+  }
+
+protected:
+  static int *s_resource;
+};
+
+int *SharedResourceFixture::s_resource = NULL;
+
+
+/*! \brief Fixture that inherits the shared resource of its parent.
+ */
+class SubSharedResourceFixture : public SharedResourceFixture
+{
+  CPPUNIT_TEST_SUB_SUITE( SubSharedResourceFixture, SharedResourceFixture );
+  CPPUNIT_TEST( test3 );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void test3()
+  {
+    fixtureLog += "test3;";
+    CPPUNIT_ASSERT( s_resource != NULL );
+  }
+};
+
+
+/*! \brief Fixture whose shared resource can not be set up.
+ */
+class FailingSetUpFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( FailingSetUpFixture );
+  CPPUNIT_TEST_SUITE_SETUP( setUpResource );
+  CPPUNIT_TEST_SUITE_TEARDOWN( tearDownResource );
+  CPPUNIT_TEST( test );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  static void setUpResource()
+  {
+    fixtureLog += "setUpSuite;";
+    throw std::runtime_error( "server not available" );
+  }
+
+  static void tearDownResource()
+  {
+    fixtureLog += "tearDownSuite;";
+  }
+
+  void test()
+  {
+    fixtureLog += "test;";
+  }
+};
+
+
+/*! \brief Fixture whose shared resource can not be released.
+ */
+class FailingTearDownFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( FailingTearDownFixture );
+  CPPUNIT_TEST_SUITE_TEARDOWN( tearDownResource );
+  CPPUNIT_TEST( test );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  static void tearDownResource()
+  {
+    CPPUNIT_FAIL( "resource leaked" );
+  }
+
+  void test()
+  {
+  }
+};
+
+
+static int setUpCount = 0;
+static int tearDownCount = 0;
+
+static void
+countSetUp()
+{
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+  // Gives the other threads a chance to call SuiteFixture::setUp().
+  ::usleep( 10000 );
+#endif
+  ++setUpCount;
+}
+
+static void
+countTearDown()
+{
+  ++tearDownCount;
+}
+
+
+/*! \brief Parameters of a thread of testConcurrentSetUpIsOnce().
+ */
+struct ConcurrentRun
+{
+  CPPUNIT_NS::SuiteFixture *m_fixture;
+  CPPUNIT_NS::TestResult *m_result;
+  CPPUNIT_NS::Test *m_suite;
+  bool m_wasSetUp;
+};
+
+
+static void *
+runConcurrently( void *parameter )
+{
+  ConcurrentRun *run = (ConcurrentRun *)parameter;
+  run->m_wasSetUp = run->m_fixture->setUp( run->m_result, run->m_suite );
+  return NULL;
+}
+
+
+SuiteFixtureTest::SuiteFixtureTest()
+{
+}
+
+
+SuiteFixtureTest::~SuiteFixtureTest()
+{
+}
+
+
+void
+SuiteFixtureTest::setUp()
+{
+  fixtureLog = "";
+  setUpCount = 0;
+  tearDownCount = 0;
+  m_result = new CPPUNIT_NS::TestResult();
+  m_listener = new EventLogListener();
+  m_result->addListener( m_listener );
+}
+
+
+void
+SuiteFixtureTest::tearDown()
+{
+  delete m_result;
+  delete m_listener;
+}
+
+
+void
+SuiteFixtureTest::testSetUpOnceAroundTests()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite( SharedResourceFixture::suite() );
+  suite->run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "setUpSuite;test1;test2;tearDownSuite;" ),
+                        fixtureLog );
+  CPPUNIT_ASSERT_EQUAL( std::string( "startSuite:SharedResourceFixture;"
+                          "startTest:SharedResourceFixture::test1;"
+                          "endTest:SharedResourceFixture::test1;"
+                          "startTest:SharedResourceFixture::test2;"
+                          "endTest:SharedResourceFixture::test2;"
+                          "endSuite:SharedResourceFixture;" ),
+                        m_listener->m_log );
+}
+
+
+void
+SuiteFixtureTest::testPlanSetsUpOnceAroundTests()
+{
+  CPPUNIT_NS::TestSuite all( "All" );
+  all.addTest( SharedResourceFixture::suite() );
+  all.addTest( SharedResourceFixture::suite() );
+  CPPUNIT_NS::TestPlan plan( &all );
+  plan.run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "setUpSuite;test1;test2;tearDownSuite;"
+                                     "setUpSuite;test1;test2;tearDownSuite;" ),
+                        fixtureLog );
+}
+
+
+void
+SuiteFixtureTest::testSetUpAgainForEachRun()
+{
+  CPPUNIT_NS::TestRunner runner;
+  runner.addTest( SharedResourceFixture::suite() );
+  runner.run( *m_result );
+  runner.run( *m_result );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "setUpSuite;test1;test2;tearDownSuite;"
+                                     "setUpSuite;test1;test2;tearDownSuite;" ),
+                        fixtureLog );
+}
+
+
+void
+SuiteFixtureTest::testSetUpFailureSkipsTests()
+{
+  CPPUNIT_NS::TestSuite all( "All" );
+  all.addTest( FailingSetUpFixture::suite() );
+  all.addTest( SharedResourceFixture::suite() );
+  std::string expected( "startSuite:All;"
+                        "startSuite:FailingSetUpFixture;"
+                        "error:FailingSetUpFixture;"
+                        "endSuite:FailingSetUpFixture;"
+                        "startSuite:SharedResourceFixture;"
+                        "startTest:SharedResourceFixture::test1;"
+                        "endTest:SharedResourceFixture::test1;"
+                        "startTest:SharedResourceFixture::test2;"
+                        "endTest:SharedResourceFixture::test2;"
+                        "endSuite:SharedResourceFixture;"
+                        "endSuite:All;" );
+
+  all.run( m_result );
+  CPPUNIT_ASSERT_EQUAL( std::string( "setUpSuite;"
+                                     "setUpSuite;test1;test2;tearDownSuite;" ),
+                        fixtureLog );
+  CPPUNIT_ASSERT_EQUAL( expected, m_listener->m_log );
+
+  m_listener->m_log = "";
+  CPPUNIT_NS::TestPlan plan( &all );
+  plan.run( m_result );
+  CPPUNIT_ASSERT_EQUAL( expected, m_listener->m_log );
+}
+
+
+void
+SuiteFixtureTest::testTearDownFailureIsReported()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite( FailingTearDownFixture::suite() );
+  CPPUNIT_NS::TestPlan plan( suite.get() );
+  plan.run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "startSuite:FailingTearDownFixture;"
+                          "startTest:FailingTearDownFixture::test;"
+                          "endTest:FailingTearDownFixture::test;"
+                          "failure:FailingTearDownFixture;"
+                          "endSuite:FailingTearDownFixture;" ),
+                        m_listener->m_log );
+}
+
+
+void
+SuiteFixtureTest::testSubSuiteSharesParentFixture()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite( SubSharedResourceFixture::suite() );
+  suite->run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "setUpSuite;test1;test2;test3;tearDownSuite;" ),
+                        fixtureLog );
+}
+
+
+void
+SuiteFixtureTest::testNestedRunsSetUpOnce()
+{
+  CPPUNIT_NS::SuiteFixture fixture;
+  fixture.setSetUpFunction( &countSetUp );
+  fixture.setTearDownFunction( &countTearDown );
+  CPPUNIT_NS::TestSuite *inner = new CPPUNIT_NS::TestSuite( "Inner" );
+  inner->setSuiteFixture( &fixture );
+  CPPUNIT_NS::TestSuite outer( "Outer" );
+  outer.setSuiteFixture( &fixture );
+  outer.addTest( inner );
+
+  outer.run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( 1, setUpCount );
+  CPPUNIT_ASSERT_EQUAL( 1, tearDownCount );
+}
+
+
+void
+SuiteFixtureTest::testConcurrentSetUpIsOnce()
+{
+  CPPUNIT_NS::SuiteFixture fixture;
+  fixture.setSetUpFunction( &countSetUp );
+  fixture.setTearDownFunction( &countTearDown );
+  CPPUNIT_NS::TestSuite suite( "Suite" );
+
+  const int runCount = 8;
+  ConcurrentRun runs[ runCount ];
+  for ( int index = 0; index < runCount; ++index )
+  {
+    runs[ index ].m_fixture = &fixture;
+    runs[ index ].m_result = m_result;
+    runs[ index ].m_suite = &suite;
+    runs[ index ].m_wasSetUp = false;
+  }
+
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+  pthread_t threads[ runCount ];
+  for ( int startIndex = 0; startIndex < runCount; ++startIndex )
+    CPPUNIT_ASSERT_EQUAL( 0, ::pthread_create( &threads[ startIndex ], NULL,
+                                               &runConcurrently, 
+                                               &runs[ startIndex ] ) );
+  for ( int joinIndex = 0; joinIndex < runCount; ++joinIndex )
+    ::pthread_join( threads[ joinIndex ], NULL );
+#else
+  for ( int runIndex = 0; runIndex < runCount; ++runIndex )
+    runConcurrently( &runs[ runIndex ] );
+#endif
+
+  CPPUNIT_ASSERT_EQUAL( 1, setUpCount );
+  for ( int checkIndex = 0; checkIndex < runCount; ++checkIndex )
+  {
+    CPPUNIT_ASSERT( runs[ checkIndex ].m_wasSetUp );
+    fixture.tearDown( m_result, &suite );
+    CPPUNIT_ASSERT_EQUAL( checkIndex == runCount - 1 ? 1 : 0, tearDownCount );
+  }
+}
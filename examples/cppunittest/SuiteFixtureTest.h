@@ -0,0 +1,59 @@
+#ifndef SUITEFIXTURETEST_H
+#define SUITEFIXTURETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestResult.h>
+#include "EventLogListener.h"
+
+
+/*! \class SuiteFixtureTest
+ * \brief Unit tests for class SuiteFixture and CPPUNIT_TEST_SUITE_SETUP().
+ */
+class SuiteFixtureTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( SuiteFixtureTest );
+  CPPUNIT_TEST( testSetUpOnceAroundTests );
+  CPPUNIT_TEST( testPlanSetsUpOnceAroundTests );
+  CPPUNIT_TEST( testSetUpAgainForEachRun );
+  CPPUNIT_TEST( testSetUpFailureSkipsTests );
+  CPPUNIT_TEST( testTearDownFailureIsReported );
+  CPPUNIT_TEST( testSubSuiteSharesParentFixture );
+  CPPUNIT_TEST( testNestedRunsSetUpOnce );
+  CPPUNIT_TEST( testConcurrentSetUpIsOnce );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a SuiteFixtureTest object.
+   */
+  SuiteFixtureTest();
+
+  /// Destructor.
+  virtual ~SuiteFixtureTest();
+
+  void setUp();
+  void tearDown();
+
+  void testSetUpOnceAroundTests();
+  void testPlanSetsUpOnceAroundTests();
+  void testSetUpAgainForEachRun();
+  void testSetUpFailureSkipsTests();
+  void testTearDownFailureIsReported();
+  void testSubSuiteSharesParentFixture();
+  void testNestedRunsSetUpOnce();
+  void testConcurrentSetUpIsOnce();
+
+private:
+  /// Prevents the use of the copy constructor.
+  SuiteFixtureTest( const SuiteFixtureTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const SuiteFixtureTest &copy );
+
+private:
+  CPPUNIT_NS::TestResult *m_result;
+  EventLogListener *m_listener;
+};
+
+
+
+#endif  // SUITEFIXTURETEST_H
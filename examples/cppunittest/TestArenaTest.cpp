@@ -0,0 +1,201 @@
+#include "CoreSuite.h"
+#include "TestArenaTest.h"
+#include <cppunit/TestArena.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFilter.h>
+#include <cppunit/TestPlan.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <memory>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestArenaTest,
+                                       coreSuiteName() );
+
+
+/*! \brief Test case larger than a chunk of the arenas used below.
+ */
+class LargeTestCase : public CPPUNIT_NS::TestCase
+{
+public:
+  LargeTestCase()
+      : CPPUNIT_NS::TestCase( "large" )
+  {
+    m_data[0] = 1;
+    m_data[ sizeof(m_data) - 1 ] = 2;
+  }
+
+  char m_data[4096];
+};
+
+
+TestArenaTest::TestArenaTest()
+{
+}
+
+
+TestArenaTest::~TestArenaTest()
+{
+}
+
+
+void
+TestArenaTest::testTestsOutsideScopeUseHeap()
+{
+  CPPUNIT_NS::TestArena arena;
+  {
+    CPPUNIT_NS::TestArena::Scope scope( arena );
+  }
+  std::auto_ptr<CPPUNIT_NS::Test> test( new CPPUNIT_NS::TestCase( "test" ) );
+
+  CPPUNIT_ASSERT_EQUAL( 0, arena.getTestCount() );
+  CPPUNIT_ASSERT_EQUAL( size_t(0), arena.getAllocatedSize() );
+}
+
+
+void
+TestArenaTest::testPlainNewUsesHeap()
+{
+  CPPUNIT_NS::TestArena arena;
+  std::auto_ptr<CPPUNIT_NS::Test> test;
+  {
+    CPPUNIT_NS::TestArena::Scope scope( arena );
+    CPPUNIT_ASSERT( CPPUNIT_NS::TestArena::isActive() );
+    test.reset( new CPPUNIT_NS::TestCase( "test" ) );
+  }
+
+  CPPUNIT_ASSERT( !CPPUNIT_NS::TestArena::isActive() );
+  CPPUNIT_ASSERT_EQUAL( 0, arena.getTestCount() );
+}
+
+
+void
+TestArenaTest::testTestsInScopeUseArena()
+{
+  CPPUNIT_NS::TestArena arena( 1024 );
+  CPPUNIT_NS::TestSuite *suite;
+  {
+    CPPUNIT_NS::TestArena::Scope scope( arena );
+    suite = CPPUNIT_TEST_NEW( CPPUNIT_NS::TestSuite, ( "suite" ) );
+    for ( int index = 0; index < 100; ++index )
+      suite->addTest( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCase, ( "test" ) ) );
+  }
+
+  CPPUNIT_ASSERT_EQUAL( 101, arena.getTestCount() );
+  CPPUNIT_ASSERT( arena.getAllocatedSize() >= 101 * sizeof(CPPUNIT_NS::TestCase) );
+  CPPUNIT_ASSERT_EQUAL( 100, suite->countTestCases() );
+
+  delete suite;
+  CPPUNIT_ASSERT_EQUAL( 0, arena.getTestCount() );
+}
+
+
+void
+TestArenaTest::testNestedScopes()
+{
+  CPPUNIT_NS::TestArena outerArena;
+  CPPUNIT_NS::TestArena innerArena;
+  CPPUNIT_NS::TestSuite *suite;
+  {
+    CPPUNIT_NS::TestArena::Scope outerScope( outerArena );
+    suite = CPPUNIT_TEST_NEW( CPPUNIT_NS::TestSuite, ( "suite" ) );
+    {
+      CPPUNIT_NS::TestArena::Scope innerScope( innerArena );
+      suite->addTest( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCase, ( "test1" ) ) );
+      suite->addTest( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCase, ( "test2" ) ) );
+    }
+    suite->addTest( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCase, ( "test3" ) ) );
+  }
+
+  CPPUNIT_ASSERT_EQUAL( 2, outerArena.getTestCount() );
+  CPPUNIT_ASSERT_EQUAL( 2, innerArena.getTestCount() );
+  delete suite;
+}
+
+
+void
+TestArenaTest::testLargeTest()
+{
+  CPPUNIT_NS::TestArena arena( 256 );
+  LargeTestCase *test;
+  {
+    CPPUNIT_NS::TestArena::Scope scope( arena );
+    test = CPPUNIT_TEST_NEW( LargeTestCase, () );
+  }
+
+  CPPUNIT_ASSERT_EQUAL( 1, arena.getTestCount() );
+  CPPUNIT_ASSERT( arena.getAllocatedSize() >= sizeof(LargeTestCase) );
+  CPPUNIT_ASSERT_EQUAL( 2, int(test->m_data[ sizeof(test->m_data) - 1 ]) );
+  delete test;
+}
+
+
+void
+TestArenaTest::testArenaDestroyedBeforeTests()
+{
+  CPPUNIT_NS::TestSuite *suite;
+  {
+    CPPUNIT_NS::TestArena arena;
+    CPPUNIT_NS::TestArena::Scope scope( arena );
+    suite = CPPUNIT_TEST_NEW( CPPUNIT_NS::TestSuite, ( "suite" ) );
+    suite->addTest( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCase, ( "test" ) ) );
+  }
+
+  // The memory of the tests is still valid.
+  CPPUNIT_ASSERT_EQUAL( 1, suite->countTestCases() );
+  CPPUNIT_ASSERT_EQUAL( std::string("test"), suite->getChildTestAt( 0 )->getName() );
+  delete suite;
+}
+
+
+void
+TestArenaTest::testMakeTestInArena()
+{
+  CPPUNIT_NS::TestArena arena;
+  CPPUNIT_NS::Test *test;
+  {
+    CPPUNIT_NS::TestArena::Scope scope( arena );
+    test = CPPUNIT_NS::TestFactoryRegistry::getRegistry( coreSuiteName() ).makeTest();
+  }
+
+  CPPUNIT_ASSERT( arena.getTestCount() > test->countTestCases() );
+  delete test;
+  CPPUNIT_ASSERT_EQUAL( 0, arena.getTestCount() );
+}
+
+
+void
+TestArenaTest::testFilterTestsInArena()
+{
+  CPPUNIT_NS::TestArena arena;
+  std::auto_ptr<CPPUNIT_NS::TestSuite> suite;
+  {
+    CPPUNIT_NS::TestArena::Scope scope( arena );
+    suite.reset( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestSuite, ( "All" ) ) );
+    CPPUNIT_NS::TestSuite *subSuite = CPPUNIT_TEST_NEW( CPPUNIT_NS::TestSuite, ( "Sub" ) );
+    subSuite->addTest( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCase, ( "test1" ) ) );
+    subSuite->addTest( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCase, ( "test2" ) ) );
+    suite->addTest( subSuite );
+    suite->addTest( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCase, ( "test3" ) ) );
+  }
+  CPPUNIT_ASSERT( suite->canBeFlattened() );
+
+  CPPUNIT_NS::TestFilter includeFilter;
+  includeFilter.addInclude( "Sub/test2" );
+  CPPUNIT_NS::TestPlan includePlan( suite.get(), includeFilter );
+  CPPUNIT_ASSERT_EQUAL( 1, includePlan.countTestCases() );
+
+  CPPUNIT_NS::TestFilter excludeFilter;
+  excludeFilter.addExclude( "Sub" );
+  CPPUNIT_NS::TestPlan excludePlan( suite.get(), excludeFilter );
+  CPPUNIT_ASSERT_EQUAL( 1, excludePlan.countTestCases() );
+
+  CPPUNIT_NS::TestResult controller;
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+  controller.runTestPlan( includePlan );
+  CPPUNIT_ASSERT_EQUAL( 1, result.runTests() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "test2" ), result.tests()[0]->getName() );
+}
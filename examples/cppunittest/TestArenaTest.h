@@ -0,0 +1,50 @@
+#ifndef TESTARENATEST_H
+#define TESTARENATEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+/*! \class TestArenaTest
+ * \brief Unit tests for class TestArena.
+ */
+class TestArenaTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TestArenaTest );
+  CPPUNIT_TEST( testTestsOutsideScopeUseHeap );
+  CPPUNIT_TEST( testPlainNewUsesHeap );
+  CPPUNIT_TEST( testTestsInScopeUseArena );
+  CPPUNIT_TEST( testNestedScopes );
+  CPPUNIT_TEST( testLargeTest );
+  CPPUNIT_TEST( testArenaDestroyedBeforeTests );
+  CPPUNIT_TEST( testMakeTestInArena );
+  CPPUNIT_TEST( testFilterTestsInArena );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a TestArenaTest object.
+   */
+  TestArenaTest();
+
+  /// Destructor.
+  virtual ~TestArenaTest();
+
+  void testTestsOutsideScopeUseHeap();
+  void testPlainNewUsesHeap();
+  void testTestsInScopeUseArena();
+  void testNestedScopes();
+  void testLargeTest();
+  void testArenaDestroyedBeforeTests();
+  void testMakeTestInArena();
+  void testFilterTestsInArena();
+
+private:
+  /// Prevents the use of the copy constructor.
+  TestArenaTest( const TestArenaTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestArenaTest &copy );
+};
+
+
+
+#endif  // TESTARENATEST_H
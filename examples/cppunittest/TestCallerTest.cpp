@@ -2,12 +2,36 @@
 #include "HelperSuite.h"
 #include "TestCallerTest.h"
 #include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestNamer.h>
+#include <memory>
 
 
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestCallerTest, 
                                        helperSuiteName() );
 
 
+/*! \brief TestNamer that counts the names it builds.
+ */
+class CountingTestNamer : public CPPUNIT_NS::TestNamer
+{
+public:
+  CountingTestNamer()
+      : CPPUNIT_NS::TestNamer( std::string( "TrackedTestCase" ) )
+      , m_nameCount( 0 )
+  {
+  }
+
+  std::string getTestNameFor( const std::string &testMethodName ) const
+  {
+    CountingTestNamer *mutableThis = CPPUNIT_CONST_CAST( CountingTestNamer *, this );
+    ++mutableThis->m_nameCount;
+    return CPPUNIT_NS::TestNamer::getTestNameFor( testMethodName );
+  }
+
+  int m_nameCount;
+};
+
+
 void 
 TestCallerTest::ExceptionThrower::testThrowFailureException()
 {
@@ -153,6 +177,30 @@ TestCallerTest::testPointerConstructor()
   CPPUNIT_ASSERT_EQUAL( 1, m_destructorCount );
 }
 
+
+void 
+TestCallerTest::testNamerConstructor()
+{
+  std::auto_ptr<CPPUNIT_NS::TestCaller<TrackedTestCase> > caller;
+  {
+    CountingTestNamer namer;
+    caller.reset( new CPPUNIT_NS::TestCaller<TrackedTestCase>( namer,
+                                                               "test",
+                                                               &TrackedTestCase::test, 
+                                                               new TrackedTestCase() ) );
+    CPPUNIT_ASSERT_EQUAL( 1, namer.m_nameCount );
+  } // The namer is not kept by the test caller.
+  checkNothingButConstructorCalled();
+
+  caller->run( m_result );
+  checkRunningSequenceCalled();
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "TrackedTestCase::test" ), caller->getName() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "TrackedTestCase::test" ), caller->getNameRef() );
+  caller.reset();
+  CPPUNIT_ASSERT_EQUAL( 1, m_destructorCount );
+}
+
 /*
 // Now done by ExceptionTestCaseDecorator
 
@@ -15,6 +15,7 @@ class TestCallerTest : public CPPUNIT_NS::TestFixture,
   CPPUNIT_TEST( testBasicConstructor );
   CPPUNIT_TEST( testReferenceConstructor );
   CPPUNIT_TEST( testPointerConstructor );
+  CPPUNIT_TEST( testNamerConstructor );
 //  CPPUNIT_TEST( testExpectFailureException );
 //  CPPUNIT_TEST( testExpectException );
 //  CPPUNIT_TEST( testExpectedExceptionNotCaught );
@@ -29,6 +30,7 @@ public:
   void testBasicConstructor();
   void testReferenceConstructor();
   void testPointerConstructor();
+  void testNamerConstructor();
 
 //  void testExpectFailureException();
 //  void testExpectException();
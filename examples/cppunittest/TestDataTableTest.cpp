@@ -0,0 +1,185 @@
+#include "ExtensionSuite.h"
+#include "TestDataTableTest.h"
+#include <fstream>
+#include <stdio.h>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestDataTableTest,
+                                       extensionSuiteName() );
+
+
+static const char *const dataFileName = "TestDataTableTest.dat";
+
+
+TestDataTableTest::TestDataTableTest()
+{
+}
+
+
+TestDataTableTest::~TestDataTableTest()
+{
+}
+
+
+void 
+TestDataTableTest::tearDown()
+{
+  removeDataFile();
+}
+
+
+std::string 
+TestDataTableTest::writeDataFile( const std::string &content )
+{
+  std::ofstream stream( dataFileName, std::ios::out | std::ios::binary );
+  stream.write( content.data(), content.length() );
+  return dataFileName;
+}
+
+
+void 
+TestDataTableTest::removeDataFile()
+{
+  ::remove( dataFileName );
+}
+
+
+void 
+TestDataTableTest::checkRow( CPPUNIT_NS::TestDataTable &table,
+                             int index,
+                             std::string expectedKey,
+                             std::string expectedParameters,
+                             std::string expectedExpected )
+{
+  CPPUNIT_NS::TestDataRow row;
+  table.getRow( index, row );
+  CPPUNIT_ASSERT_EQUAL( expectedKey, row.m_key );
+  CPPUNIT_ASSERT_EQUAL( expectedParameters, row.m_parameters );
+  CPPUNIT_ASSERT_EQUAL( expectedExpected, row.m_expected );
+}
+
+
+void 
+TestDataTableTest::testCsvRows()
+{
+  CPPUNIT_NS::CsvTestDataTable table( writeDataFile( 
+      "# key,parameters,expected\n"
+      "zero,0 0,0\r\n"
+      "\n"
+      ",1 2,3" ) );
+
+  CPPUNIT_ASSERT_EQUAL( 2, table.getRowCount() );
+  checkRow( table, 0, "zero", "0 0", "0" );
+  checkRow( table, 1, "", "1 2", "3" );
+}
+
+
+void 
+TestDataTableTest::testCsvQuotedFields()
+{
+  CPPUNIT_NS::CsvTestDataTable table( writeDataFile( 
+      "\"a,b\",\"say \"\"hi\"\"\",\"\"\n" ) );
+
+  CPPUNIT_ASSERT_EQUAL( 1, table.getRowCount() );
+  checkRow( table, 0, "a,b", "say \"hi\"", "" );
+}
+
+
+void 
+TestDataTableTest::testCsvMissingFields()
+{
+  CPPUNIT_NS::CsvTestDataTable table( writeDataFile( "key\nkey,param\n" ) );
+
+  CPPUNIT_ASSERT_EQUAL( 2, table.getRowCount() );
+  checkRow( table, 0, "key", "", "" );
+  checkRow( table, 1, "key", "param", "" );
+}
+
+
+void 
+TestDataTableTest::testCsvInvalidRowThrow()
+{
+  CPPUNIT_NS::CsvTestDataTable table( writeDataFile( "a,b,c,d\n" ) );
+  CPPUNIT_NS::TestDataRow row;
+  table.getRow( 0, row );
+}
+
+
+void 
+TestDataTableTest::testXmlRows()
+{
+  CPPUNIT_NS::XmlTestDataTable table( writeDataFile( 
+      "<?xml version=\"1.0\" ?>\n"
+      "<rows>\n"
+      "  <row key=\"zero\"><parameters>0 0</parameters><expected>0</expected></row>\n"
+      "  <rowset/>\n"
+      "  <row monkey='x'>\n"
+      "    <parameters>1 2</parameters>\n"
+      "    <expected>3</expected>\n"
+      "  </row>\n"
+      "  <row key='empty'/>\n"
+      "</rows>\n" ) );
+
+  CPPUNIT_ASSERT_EQUAL( 3, table.getRowCount() );
+  checkRow( table, 0, "zero", "0 0", "0" );
+  checkRow( table, 1, "", "1 2", "3" );
+  checkRow( table, 2, "empty", "", "" );
+}
+
+
+void 
+TestDataTableTest::testXmlEntities()
+{
+  CPPUNIT_NS::XmlTestDataTable table( writeDataFile( 
+      "<row key=\"a&amp;b\"><parameters>&lt;x&gt; &quot;&apos;</parameters>"
+      "<expected>&#65;&#x42;</expected></row>" ) );
+
+  CPPUNIT_ASSERT_EQUAL( 1, table.getRowCount() );
+  checkRow( table, 0, "a&b", "<x> \"'", "AB" );
+}
+
+
+void 
+TestDataTableTest::testBinaryRows()
+{
+  CPPUNIT_NS::BinaryTestDataTable table( writeDataFile( std::string( "ab\0cdef", 7 ) + "g" ),
+                                         4,
+                                         3 );
+
+  CPPUNIT_ASSERT_EQUAL( 2, table.getRowCount() );
+  checkRow( table, 0, "", std::string( "ab\0", 3 ), "c" );
+  checkRow( table, 1, "", "def", "g" );
+}
+
+
+void 
+TestDataTableTest::testBinaryInvalidSizeThrow()
+{
+  CPPUNIT_NS::BinaryTestDataTable table( writeDataFile( "abcde" ), 4, 2 );
+  table.getRowCount();
+}
+
+
+void 
+TestDataTableTest::testEmptyFile()
+{
+  CPPUNIT_NS::CsvTestDataTable table( writeDataFile( "" ) );
+  CPPUNIT_ASSERT_EQUAL( 0, table.getRowCount() );
+}
+
+
+void 
+TestDataTableTest::testMissingFileThrow()
+{
+  CPPUNIT_NS::CsvTestDataTable table( "TestDataTableTest.missing" );
+  table.getRowCount();
+}
+
+
+void 
+TestDataTableTest::testRowOutOfRangeThrow()
+{
+  CPPUNIT_NS::CsvTestDataTable table( writeDataFile( "a,b,c\n" ) );
+  CPPUNIT_NS::TestDataRow row;
+  table.getRow( 1, row );
+}
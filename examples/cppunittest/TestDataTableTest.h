@@ -0,0 +1,74 @@
+#ifndef TESTDATATABLETEST_H
+#define TESTDATATABLETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/extensions/TestDataTable.h>
+#include <stdexcept>
+
+
+/*! \class TestDataTableTest
+ * \brief Unit tests for the TestDataTable classes.
+ */
+class TestDataTableTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TestDataTableTest );
+  CPPUNIT_TEST( testCsvRows );
+  CPPUNIT_TEST( testCsvQuotedFields );
+  CPPUNIT_TEST( testCsvMissingFields );
+  CPPUNIT_TEST_EXCEPTION( testCsvInvalidRowThrow, std::runtime_error );
+  CPPUNIT_TEST( testXmlRows );
+  CPPUNIT_TEST( testXmlEntities );
+  CPPUNIT_TEST( testBinaryRows );
+  CPPUNIT_TEST_EXCEPTION( testBinaryInvalidSizeThrow, std::runtime_error );
+  CPPUNIT_TEST( testEmptyFile );
+  CPPUNIT_TEST_EXCEPTION( testMissingFileThrow, std::runtime_error );
+  CPPUNIT_TEST_EXCEPTION( testRowOutOfRangeThrow, std::out_of_range );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a TestDataTableTest object.
+   */
+  TestDataTableTest();
+
+  /// Destructor.
+  virtual ~TestDataTableTest();
+
+  void tearDown();
+
+  void testCsvRows();
+  void testCsvQuotedFields();
+  void testCsvMissingFields();
+  void testCsvInvalidRowThrow();
+  void testXmlRows();
+  void testXmlEntities();
+  void testBinaryRows();
+  void testBinaryInvalidSizeThrow();
+  void testEmptyFile();
+  void testMissingFileThrow();
+  void testRowOutOfRangeThrow();
+
+  /*! Writes a data file used by the tests and returns its name.
+   */
+  static std::string writeDataFile( const std::string &content );
+
+  /*! Removes the file written by writeDataFile().
+   */
+  static void removeDataFile();
+
+private:
+  /// Prevents the use of the copy constructor.
+  TestDataTableTest( const TestDataTableTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestDataTableTest &copy );
+
+  void checkRow( CPPUNIT_NS::TestDataTable &table,
+                 int index,
+                 std::string expectedKey,
+                 std::string expectedParameters,
+                 std::string expectedExpected );
+};
+
+
+
+#endif  // TESTDATATABLETEST_H
@@ -0,0 +1,167 @@
+#include "CoreSuite.h"
+#include "TestFilterTest.h"
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestFilterTest,
+                                       coreSuiteName() );
+
+
+TestFilterTest::TestFilterTest()
+{
+}
+
+
+TestFilterTest::~TestFilterTest()
+{
+}
+
+
+void
+TestFilterTest::setUp()
+{
+  m_filter = new CPPUNIT_NS::TestFilter();
+}
+
+
+void
+TestFilterTest::tearDown()
+{
+  delete m_filter;
+}
+
+
+void
+TestFilterTest::testEmptyFilter()
+{
+  CPPUNIT_ASSERT( m_filter->isEmpty() );
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/MathTest" ) );
+  CPPUNIT_ASSERT( !m_filter->isExcluded( "/All Tests/MathTest" ) );
+  CPPUNIT_ASSERT( m_filter->mayIncludeBelow( "/All Tests" ) );
+}
+
+
+void
+TestFilterTest::testRelativeGlobMatchesTrailingComponents()
+{
+  m_filter->addInclude( "Network*::*Timeout*" );
+
+  CPPUNIT_ASSERT( !m_filter->isEmpty() );
+  CPPUNIT_ASSERT( m_filter->isIncluded(
+      "/All Tests/NetworkTest/NetworkTest::testConnectTimeout" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded(
+      "/All Tests/NetworkTest/NetworkTest::testConnect" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/All Tests/NetworkTest" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded(
+      "/All Tests/MyNetworkTest/MyNetworkTest::testTimeout" ) );
+}
+
+
+void
+TestFilterTest::testStarDoesNotMatchSlash()
+{
+  m_filter->addInclude( "All*::testAdd" );
+
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/AllMath::testAdd" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/All Tests/MathTest/MathTest::testAdd" ) );
+}
+
+
+void
+TestFilterTest::testDoubleStarMatchesSlash()
+{
+  m_filter->addInclude( "All**::testAdd" );
+
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/MathTest/MathTest::testAdd" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/All Tests/MathTest/MathTest::testSub" ) );
+}
+
+
+void
+TestFilterTest::testQuestionMark()
+{
+  m_filter->addInclude( "Test?" );
+
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/Test1" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/All Tests/Test12" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/All Tests/Test" ) );
+}
+
+
+void
+TestFilterTest::testAnchoredGlob()
+{
+  m_filter->addInclude( "/All Tests/Math*" );
+
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/MathTest" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/All Tests/MathTest/MathTest::testAdd" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/Other/All Tests/MathTest" ) );
+}
+
+
+void
+TestFilterTest::testExclude()
+{
+  m_filter->addExclude( "*::testSlow*" );
+
+  CPPUNIT_ASSERT( !m_filter->isEmpty() );
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/Math/Math::testSlowAdd" ) );
+  CPPUNIT_ASSERT( m_filter->isExcluded( "/All Tests/Math/Math::testSlowAdd" ) );
+  CPPUNIT_ASSERT( !m_filter->isExcluded( "/All Tests/Math/Math::testAdd" ) );
+}
+
+
+void
+TestFilterTest::testMayIncludeBelow()
+{
+  m_filter->addInclude( "/All Tests/Core/Math*" );
+
+  CPPUNIT_ASSERT( m_filter->mayIncludeBelow( "/All Tests" ) );
+  CPPUNIT_ASSERT( m_filter->mayIncludeBelow( "/All Tests/Core" ) );
+  CPPUNIT_ASSERT( !m_filter->mayIncludeBelow( "/All Tests/Helper" ) );
+  CPPUNIT_ASSERT( !m_filter->mayIncludeBelow( "/All Tests/Core/Math/Sub" ) );
+
+  m_filter->addInclude( "Sub" );
+  CPPUNIT_ASSERT( m_filter->mayIncludeBelow( "/All Tests/Helper" ) );
+}
+
+
+void
+TestFilterTest::testRegex()
+{
+#if defined(CPPUNIT_HAVE_REGEX_H)
+  m_filter->addInclude( "regex:Math(Test)?::test(Add|Sub)$" );
+
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/Math/Math::testAdd" ) );
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/MathTest/MathTest::testSub" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/All Tests/Math/Math::testAddLarge" ) );
+  CPPUNIT_ASSERT( m_filter->mayIncludeBelow( "/All Tests/Helper" ) );
+#endif
+}
+
+
+void
+TestFilterTest::testIncludePath()
+{
+  m_filter->addIncludePath( "/All Tests/Math/Math::test*" );
+
+  CPPUNIT_ASSERT( !m_filter->isEmpty() );
+  CPPUNIT_ASSERT( m_filter->isIncluded( "/All Tests/Math/Math::test*" ) );
+  CPPUNIT_ASSERT( !m_filter->isIncluded( "/All Tests/Math/Math::testAdd" ) );
+  CPPUNIT_ASSERT( m_filter->mayIncludeBelow( "/All Tests/Math" ) );
+  CPPUNIT_ASSERT( !m_filter->mayIncludeBelow( "/All Tests/Mat" ) );
+  CPPUNIT_ASSERT( !m_filter->mayIncludeBelow( "/All Tests/Math/Math::test*" ) );
+}
+
+
+void
+TestFilterTest::testEmptyPatternThrow()
+{
+  m_filter->addInclude( "" );
+}
+
+
+void
+TestFilterTest::testBadRegexThrow()
+{
+  m_filter->addExclude( "regex:(unbalanced" );
+}
@@ -0,0 +1,65 @@
+#ifndef TESTFILTERTEST_H
+#define TESTFILTERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFilter.h>
+#include <stdexcept>
+
+
+/*! \class TestFilterTest
+ * \brief Unit tests for class TestFilter.
+ */
+class TestFilterTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TestFilterTest );
+  CPPUNIT_TEST( testEmptyFilter );
+  CPPUNIT_TEST( testRelativeGlobMatchesTrailingComponents );
+  CPPUNIT_TEST( testStarDoesNotMatchSlash );
+  CPPUNIT_TEST( testDoubleStarMatchesSlash );
+  CPPUNIT_TEST( testQuestionMark );
+  CPPUNIT_TEST( testAnchoredGlob );
+  CPPUNIT_TEST( testExclude );
+  CPPUNIT_TEST( testMayIncludeBelow );
+  CPPUNIT_TEST( testRegex );
+  CPPUNIT_TEST( testIncludePath );
+  CPPUNIT_TEST_EXCEPTION( testEmptyPatternThrow, std::invalid_argument );
+  CPPUNIT_TEST_EXCEPTION( testBadRegexThrow, std::invalid_argument );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a TestFilterTest object.
+   */
+  TestFilterTest();
+
+  /// Destructor.
+  virtual ~TestFilterTest();
+
+  void setUp();
+  void tearDown();
+
+  void testEmptyFilter();
+  void testRelativeGlobMatchesTrailingComponents();
+  void testStarDoesNotMatchSlash();
+  void testDoubleStarMatchesSlash();
+  void testQuestionMark();
+  void testAnchoredGlob();
+  void testExclude();
+  void testMayIncludeBelow();
+  void testRegex();
+  void testIncludePath();
+  void testEmptyPatternThrow();
+  void testBadRegexThrow();
+
+private:
+  /// Prevents the use of the copy constructor.
+  TestFilterTest( const TestFilterTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestFilterTest &copy );
+
+private:
+  CPPUNIT_NS::TestFilter *m_filter;
+};
+
+
+#endif  // TESTFILTERTEST_H
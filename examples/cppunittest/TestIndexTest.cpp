@@ -0,0 +1,125 @@
+#include "CoreSuite.h"
+#include "TestIndexTest.h"
+#include <cppunit/TestPath.h>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestIndexTest,
+                                       coreSuiteName() );
+
+
+TestIndexTest::TestIndexTest()
+{
+}
+
+
+TestIndexTest::~TestIndexTest()
+{
+}
+
+
+void
+TestIndexTest::setUp()
+{
+  m_suite = new CPPUNIT_NS::TestSuite( "All" );
+  m_subSuite = new CPPUNIT_NS::TestSuite( "Sub" );
+  m_test1 = new MockTestCase( "test1" );
+  m_test2 = new MockTestCase( "test2" );
+  m_subSuite->addTest( m_test1 );
+  m_suite->addTest( m_subSuite );
+  m_suite->addTest( m_test2 );
+
+  m_index = new CPPUNIT_NS::TestIndex( m_suite );
+}
+
+
+void
+TestIndexTest::tearDown()
+{
+  delete m_index;
+  delete m_suite;
+}
+
+
+void
+TestIndexTest::testIndexesAllTests()
+{
+  CPPUNIT_ASSERT_EQUAL( 4, m_index->getTestCount() );
+  CPPUNIT_ASSERT( m_suite == m_index->getRootTest() );
+  CPPUNIT_ASSERT( m_suite == m_index->getTestAt( 0 ) );
+  CPPUNIT_ASSERT( m_subSuite == m_index->getTestAt( 1 ) );
+  CPPUNIT_ASSERT( m_test1 == m_index->getTestAt( 2 ) );
+  CPPUNIT_ASSERT( m_test2 == m_index->getTestAt( 3 ) );
+}
+
+
+void
+TestIndexTest::testFindTest()
+{
+  CPPUNIT_ASSERT( m_test1 == m_index->findTest( m_test1->getId() ) );
+  CPPUNIT_ASSERT( m_subSuite == m_index->findTest( m_subSuite->getId() ) );
+  CPPUNIT_ASSERT_EQUAL( 3, m_index->indexOf( m_test2->getId() ) );
+
+  MockTestCase other( "other" );
+  CPPUNIT_ASSERT( NULL == m_index->findTest( other.getId() ) );
+  CPPUNIT_ASSERT_EQUAL( -1, m_index->indexOf( other.getId() ) );
+}
+
+
+void
+TestIndexTest::testGetParentTest()
+{
+  CPPUNIT_ASSERT( NULL == m_index->getParentTest( m_suite ) );
+  CPPUNIT_ASSERT( m_suite == m_index->getParentTest( m_subSuite ) );
+  CPPUNIT_ASSERT( m_subSuite == m_index->getParentTest( m_test1 ) );
+  CPPUNIT_ASSERT( m_suite == m_index->getParentTest( m_test2 ) );
+}
+
+
+void
+TestIndexTest::testGetPath()
+{
+  CPPUNIT_ASSERT_EQUAL( std::string( "/All" ), m_index->getPath( m_suite ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/All/Sub/test1" ),
+                        m_index->getPath( m_test1 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string( "/All/test2" ),
+                        m_index->getPath( m_test2 ) );
+
+  CPPUNIT_NS::TestPath path( m_suite, "/All/Sub/test1" );
+  CPPUNIT_ASSERT_EQUAL( path.toString(), m_index->getPath( m_test1 ) );
+}
+
+
+void
+TestIndexTest::testMakeTestPath()
+{
+  CPPUNIT_NS::TestPath path = m_index->makeTestPath( m_test1 );
+  CPPUNIT_ASSERT_EQUAL( 3, path.getTestCount() );
+  CPPUNIT_ASSERT( m_suite == path.getTestAt( 0 ) );
+  CPPUNIT_ASSERT( m_subSuite == path.getTestAt( 1 ) );
+  CPPUNIT_ASSERT( m_test1 == path.getTestAt( 2 ) );
+}
+
+
+void
+TestIndexTest::testContains()
+{
+  CPPUNIT_ASSERT( m_index->contains( m_test1 ) );
+
+  MockTestCase other( "other" );
+  CPPUNIT_ASSERT( !m_index->contains( &other ) );
+}
+
+
+void
+TestIndexTest::testGetPathThrow()
+{
+  MockTestCase other( "other" );
+  m_index->getPath( &other );
+}
+
+
+void
+TestIndexTest::testGetTestAtThrow()
+{
+  m_index->getTestAt( 4 );
+}
@@ -0,0 +1,63 @@
+#ifndef TESTINDEXTEST_H
+#define TESTINDEXTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestIndex.h>
+#include <cppunit/TestSuite.h>
+#include "MockTestCase.h"
+#include <stdexcept>
+
+
+/*! \class TestIndexTest
+ * \brief Unit tests for class TestIndex.
+ */
+class TestIndexTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TestIndexTest );
+  CPPUNIT_TEST( testIndexesAllTests );
+  CPPUNIT_TEST( testFindTest );
+  CPPUNIT_TEST( testGetParentTest );
+  CPPUNIT_TEST( testGetPath );
+  CPPUNIT_TEST( testMakeTestPath );
+  CPPUNIT_TEST( testContains );
+  CPPUNIT_TEST_EXCEPTION( testGetPathThrow, std::invalid_argument );
+  CPPUNIT_TEST_EXCEPTION( testGetTestAtThrow, std::out_of_range );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a TestIndexTest object.
+   */
+  TestIndexTest();
+
+  /// Destructor.
+  virtual ~TestIndexTest();
+
+  void setUp();
+  void tearDown();
+
+  void testIndexesAllTests();
+  void testFindTest();
+  void testGetParentTest();
+  void testGetPath();
+  void testMakeTestPath();
+  void testContains();
+  void testGetPathThrow();
+  void testGetTestAtThrow();
+
+private:
+  /// Prevents the use of the copy constructor.
+  TestIndexTest( const TestIndexTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestIndexTest &copy );
+
+private:
+  CPPUNIT_NS::TestSuite *m_suite;
+  CPPUNIT_NS::TestSuite *m_subSuite;
+  MockTestCase *m_test1;
+  MockTestCase *m_test2;
+  CPPUNIT_NS::TestIndex *m_index;
+};
+
+
+#endif  // TESTINDEXTEST_H
@@ -0,0 +1,190 @@
+#include "CoreSuite.h"
+#include "TestOrderVerifierTest.h"
+#include <cppunit/TestOrderVerifier.h>
+#include <cppunit/TestRunner.h>
+#include <memory>
+#include <sstream>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestOrderVerifierTest,
+                                       coreSuiteName() );
+
+
+/*! \brief Fixture whose tests do not share any state.
+ */
+class IndependentOrderFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( IndependentOrderFixture );
+  CPPUNIT_TEST( testOne );
+  CPPUNIT_TEST( testTwo );
+  CPPUNIT_TEST( testFails );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testOne()
+  {
+  }
+
+  void testTwo()
+  {
+  }
+
+  void testFails()
+  {
+    CPPUNIT_FAIL( "always fails" );
+  }
+};
+
+
+/*! \brief Fixture with a test that leaks a state another test depends on.
+ */
+class DependentOrderFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( DependentOrderFixture );
+  CPPUNIT_TEST_SUITE_SETUP( resetState );
+  CPPUNIT_TEST( testLeakState );
+  CPPUNIT_TEST( testIndependent );
+  CPPUNIT_TEST( testExpectsInitialState );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  static void resetState()
+  {
+    state = 0;
+  }
+
+  void testLeakState()
+  {
+    state = 1;
+  }
+
+  void testIndependent()
+  {
+  }
+
+  void testExpectsInitialState()
+  {
+    CPPUNIT_ASSERT_EQUAL( 0, state );
+  }
+
+  static int state;
+};
+
+int DependentOrderFixture::state = 0;
+
+
+TestOrderVerifierTest::TestOrderVerifierTest()
+{
+}
+
+
+TestOrderVerifierTest::~TestOrderVerifierTest()
+{
+}
+
+
+void 
+TestOrderVerifierTest::testIndependentSuite()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite( IndependentOrderFixture::suite() );
+  CPPUNIT_NS::TestOrderVerifier verifier( 3, 7 );
+  verifier.verify( suite.get() );
+
+  CPPUNIT_ASSERT_EQUAL( 1, verifier.getSuiteCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string("/IndependentOrderFixture"), 
+                        verifier.getSuitePathAt( 0 ) );
+  CPPUNIT_ASSERT( verifier.isSuiteOrderIndependentAt( 0 ) );
+  CPPUNIT_ASSERT_EQUAL( 0, verifier.getDependencyCount() );
+}
+
+
+void 
+TestOrderVerifierTest::testFindsDependentPair()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite( DependentOrderFixture::suite() );
+  CPPUNIT_NS::TestOrderVerifier verifier( 3, 7 );
+  verifier.verify( suite.get(), "/All Tests" );
+
+  CPPUNIT_ASSERT_EQUAL( 1, verifier.getSuiteCount() );
+  CPPUNIT_ASSERT( !verifier.isSuiteOrderIndependentAt( 0 ) );
+  CPPUNIT_ASSERT_EQUAL( 1, verifier.getDependencyCount() );
+
+  const CPPUNIT_NS::TestOrderDependency &dependency = verifier.getDependencyAt( 0 );
+  CPPUNIT_ASSERT_EQUAL( std::string("/All Tests/DependentOrderFixture"), 
+                        dependency.m_suitePath );
+  CPPUNIT_ASSERT_EQUAL( std::string("DependentOrderFixture::testLeakState"), 
+                        dependency.m_precedingTest );
+  CPPUNIT_ASSERT_EQUAL( std::string("DependentOrderFixture::testExpectsInitialState"), 
+                        dependency.m_dependentTest );
+  CPPUNIT_ASSERT( dependency.m_succeedsAlone );
+
+  CPPUNIT_NS::OStringStream stream;
+  verifier.printDependencies( stream );
+  CPPUNIT_ASSERT_EQUAL( std::string("/All Tests/DependentOrderFixture: "
+                                    "DependentOrderFixture::testExpectsInitialState "
+                                    "fails when run after "
+                                    "DependentOrderFixture::testLeakState\n"),
+                        stream.str() );
+}
+
+
+void 
+TestOrderVerifierTest::testVerifiesSubSuites()
+{
+  CPPUNIT_NS::TestSuite suite( "Parent" );
+  suite.addTest( IndependentOrderFixture::suite() );
+  suite.addTest( DependentOrderFixture::suite() );
+  CPPUNIT_NS::TestOrderVerifier verifier;
+  verifier.verify( &suite );
+
+  CPPUNIT_ASSERT_EQUAL( 2, verifier.getSuiteCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string("/Parent/IndependentOrderFixture"), 
+                        verifier.getSuitePathAt( 0 ) );
+  CPPUNIT_ASSERT( verifier.isSuiteOrderIndependentAt( 0 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string("/Parent/DependentOrderFixture"), 
+                        verifier.getSuitePathAt( 1 ) );
+  CPPUNIT_ASSERT( !verifier.isSuiteOrderIndependentAt( 1 ) );
+}
+
+
+void 
+TestOrderVerifierTest::testWriteAndReadProperties()
+{
+  CPPUNIT_NS::TestSuite suite( "Parent" );
+  suite.addTest( IndependentOrderFixture::suite() );
+  suite.addTest( DependentOrderFixture::suite() );
+  CPPUNIT_NS::TestOrderVerifier verifier;
+  verifier.verify( &suite );
+
+  CPPUNIT_NS::OStringStream stream;
+  verifier.writeProperties( stream );
+  CPPUNIT_ASSERT_EQUAL( std::string("/Parent/IndependentOrderFixture=parallel-safe\n"
+                                    "/Parent/DependentOrderFixture=order-dependent\n"),
+                        stream.str() );
+
+  std::istringstream properties( "# verified suites\r\n" + stream.str() + 
+                                 "/Other=parallel-safe\r\n" );
+  CppUnitSet<std::string> safeSuites;
+  CPPUNIT_NS::TestOrderVerifier::readParallelSafeSuites( properties, safeSuites );
+  CPPUNIT_ASSERT_EQUAL( 2, int(safeSuites.size()) );
+  CPPUNIT_ASSERT( safeSuites.count( "/Parent/IndependentOrderFixture" ) == 1 );
+  CPPUNIT_ASSERT( safeSuites.count( "/Other" ) == 1 );
+}
+
+
+void 
+TestOrderVerifierTest::testRunnerVerifiesTestPath()
+{
+  CPPUNIT_NS::TestSuite *suite = new CPPUNIT_NS::TestSuite( "All Tests" );
+  suite->addTest( IndependentOrderFixture::suite() );
+  suite->addTest( DependentOrderFixture::suite() );
+  CPPUNIT_NS::TestRunner runner;
+  runner.addTest( suite );
+
+  CPPUNIT_NS::TestOrderVerifier verifier;
+  runner.verifyOrderIndependence( verifier, "DependentOrderFixture" );
+
+  CPPUNIT_ASSERT_EQUAL( 1, verifier.getSuiteCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string("/All Tests/DependentOrderFixture"), 
+                        verifier.getSuitePathAt( 0 ) );
+}
@@ -0,0 +1,44 @@
+#ifndef TESTORDERVERIFIERTEST_H
+#define TESTORDERVERIFIERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+/*! \class TestOrderVerifierTest
+ * \brief Unit tests for class TestOrderVerifier.
+ */
+class TestOrderVerifierTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TestOrderVerifierTest );
+  CPPUNIT_TEST( testIndependentSuite );
+  CPPUNIT_TEST( testFindsDependentPair );
+  CPPUNIT_TEST( testVerifiesSubSuites );
+  CPPUNIT_TEST( testWriteAndReadProperties );
+  CPPUNIT_TEST( testRunnerVerifiesTestPath );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a TestOrderVerifierTest object.
+   */
+  TestOrderVerifierTest();
+
+  /// Destructor.
+  virtual ~TestOrderVerifierTest();
+
+  void testIndependentSuite();
+  void testFindsDependentPair();
+  void testVerifiesSubSuites();
+  void testWriteAndReadProperties();
+  void testRunnerVerifiesTestPath();
+
+private:
+  /// Prevents the use of the copy constructor.
+  TestOrderVerifierTest( const TestOrderVerifierTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestOrderVerifierTest &copy );
+};
+
+
+
+#endif  // TESTORDERVERIFIERTEST_H
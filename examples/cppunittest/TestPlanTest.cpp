@@ -0,0 +1,353 @@
+#include "CoreSuite.h"
+#include "TestPlanTest.h"
+#include <cppunit/extensions/RepeatedTest.h>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestPlanTest,
+                                       coreSuiteName() );
+
+
+/*! \brief Listener that stops the test run after the first test.
+ */
+class StopAfterFirstTestListener : public CPPUNIT_NS::TestListener
+{
+public:
+  StopAfterFirstTestListener( CPPUNIT_NS::TestResult *result )
+      : m_result( result )
+  {
+  }
+
+  void endTest( CPPUNIT_NS::Test * )
+  {
+    m_result->stop();
+  }
+
+private:
+  CPPUNIT_NS::TestResult *m_result;
+};
+
+
+/*! \brief Suite that runs its tests in reverse order.
+ */
+class ReversedSuite : public CPPUNIT_NS::TestSuite
+{
+public:
+  ReversedSuite( const std::string &name )
+      : CPPUNIT_NS::TestSuite( name )
+  {
+  }
+
+  void run( CPPUNIT_NS::TestResult *result )
+  {
+    result->startSuite( this );
+    for ( int index = getChildTestCount() - 1; index >= 0; --index )
+      getChildTestAt( index )->run( result );
+    result->endSuite( this );
+  }
+};
+
+
+TestPlanTest::TestPlanTest()
+{
+}
+
+
+TestPlanTest::~TestPlanTest()
+{
+}
+
+
+void
+TestPlanTest::setUp()
+{
+  m_suite = new CPPUNIT_NS::TestSuite( "All" );
+  m_subSuite = new CPPUNIT_NS::TestSuite( "Sub" );
+  m_test1 = new MockTestCase( "test1" );
+  m_test2 = new MockTestCase( "test2" );
+  m_test3 = new MockTestCase( "test3" );
+  m_subSuite->addTest( m_test1 );
+  m_subSuite->addTest( m_test2 );
+  m_suite->addTest( m_subSuite );
+  m_suite->addTest( m_test3 );
+
+  m_result = new CPPUNIT_NS::TestResult();
+  m_listener = new EventLogListener();
+  m_result->addListener( m_listener );
+}
+
+
+void
+TestPlanTest::tearDown()
+{
+  delete m_result;
+  delete m_listener;
+  delete m_suite;
+}
+
+
+void
+TestPlanTest::testEntries()
+{
+  CPPUNIT_NS::TestPlan plan( m_suite );
+  CPPUNIT_ASSERT( m_suite == plan.getRootTest() );
+  CPPUNIT_ASSERT_EQUAL( 5, plan.getEntryCount() );
+
+  const CPPUNIT_NS::TestPlanEntry &root = plan.getEntryAt( 0 );
+  CPPUNIT_ASSERT( m_suite == root.m_test );
+  CPPUNIT_ASSERT_EQUAL( m_suite->getId(), root.m_id );
+  CPPUNIT_ASSERT_EQUAL( -1, root.m_parentIndex );
+  CPPUNIT_ASSERT_EQUAL( 0, root.m_depth );
+  CPPUNIT_ASSERT_EQUAL( 5, root.m_endIndex );
+  CPPUNIT_ASSERT( root.m_isSuite );
+
+  const CPPUNIT_NS::TestPlanEntry &sub = plan.getEntryAt( 1 );
+  CPPUNIT_ASSERT( m_subSuite == sub.m_test );
+  CPPUNIT_ASSERT_EQUAL( 0, sub.m_parentIndex );
+  CPPUNIT_ASSERT_EQUAL( 1, sub.m_depth );
+  CPPUNIT_ASSERT_EQUAL( 4, sub.m_endIndex );
+  CPPUNIT_ASSERT_EQUAL( 2, sub.m_testCaseCount );
+
+  const CPPUNIT_NS::TestPlanEntry &test2 = plan.getEntryAt( 3 );
+  CPPUNIT_ASSERT( m_test2 == test2.m_test );
+  CPPUNIT_ASSERT_EQUAL( 1, test2.m_parentIndex );
+  CPPUNIT_ASSERT_EQUAL( 2, test2.m_depth );
+  CPPUNIT_ASSERT_EQUAL( 4, test2.m_endIndex );
+  CPPUNIT_ASSERT( !test2.m_isSuite );
+
+  CPPUNIT_ASSERT( m_test3 == plan.getEntryAt( 4 ).m_test );
+}
+
+
+void
+TestPlanTest::testCountTestCases()
+{
+  CPPUNIT_NS::TestPlan plan( m_suite );
+  CPPUNIT_ASSERT_EQUAL( 3, plan.countTestCases() );
+  CPPUNIT_ASSERT_EQUAL( 3, plan.getEntryAt( 0 ).m_testCaseCount );
+  CPPUNIT_ASSERT_EQUAL( 1, plan.getEntryAt( 4 ).m_testCaseCount );
+}
+
+
+void
+TestPlanTest::testRunProducesSameEventsAsTestRun()
+{
+  m_suite->run( m_result );
+  std::string expected = m_listener->m_log;
+  m_listener->m_log = "";
+
+  CPPUNIT_NS::TestPlan plan( m_suite );
+  plan.run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "startSuite:All;startSuite:Sub;"
+                                     "startTest:test1;endTest:test1;"
+                                     "startTest:test2;endTest:test2;"
+                                     "endSuite:Sub;"
+                                     "startTest:test3;endTest:test3;"
+                                     "endSuite:All;" ),
+                        expected );
+  CPPUNIT_ASSERT_EQUAL( expected, m_listener->m_log );
+}
+
+
+void
+TestPlanTest::testRunDecoratedSuiteAsLeaf()
+{
+  CPPUNIT_NS::TestSuite *inner = new CPPUNIT_NS::TestSuite( "Inner" );
+  inner->addTest( new MockTestCase( "test" ) );
+  CPPUNIT_NS::RepeatedTest *decorated = new CPPUNIT_NS::RepeatedTest( inner, 2 );
+  m_suite->addTest( decorated );
+
+  CPPUNIT_NS::TestPlan plan( m_suite );
+  CPPUNIT_ASSERT_EQUAL( 6, plan.getEntryCount() );
+  CPPUNIT_ASSERT( !plan.getEntryAt( 5 ).m_isSuite );
+  CPPUNIT_ASSERT_EQUAL( 2, plan.getEntryAt( 5 ).m_testCaseCount );
+  CPPUNIT_ASSERT_EQUAL( 5, plan.countTestCases() );
+
+  plan.run( m_result );
+  std::string log = m_listener->m_log;
+  std::string repeatedInner = "startSuite:Inner;startTest:test;endTest:test;"
+                              "endSuite:Inner;";
+  CPPUNIT_ASSERT( log.find( repeatedInner + repeatedInner + "endSuite:All;" )
+                  != std::string::npos );
+}
+
+
+void
+TestPlanTest::testRunCustomSuiteAsLeaf()
+{
+  ReversedSuite *reversed = new ReversedSuite( "Reversed" );
+  reversed->addTest( new MockTestCase( "first" ) );
+  reversed->addTest( new MockTestCase( "second" ) );
+  m_suite->addTest( reversed );
+
+  CPPUNIT_NS::TestPlan plan( m_suite );
+  CPPUNIT_ASSERT_EQUAL( 6, plan.getEntryCount() );
+  CPPUNIT_ASSERT( !plan.getEntryAt( 5 ).m_isSuite );
+
+  plan.run( m_result );
+  CPPUNIT_ASSERT( m_listener->m_log.find( "startSuite:Reversed;"
+                                          "startTest:second;endTest:second;"
+                                          "startTest:first;endTest:first;"
+                                          "endSuite:Reversed;" )
+                  != std::string::npos );
+}
+
+
+void
+TestPlanTest::testRunLeafRoot()
+{
+  CPPUNIT_NS::TestPlan plan( m_test1 );
+  CPPUNIT_ASSERT_EQUAL( 1, plan.getEntryCount() );
+
+  plan.run( m_result );
+  CPPUNIT_ASSERT_EQUAL( std::string( "startTest:test1;endTest:test1;" ),
+                        m_listener->m_log );
+}
+
+
+void
+TestPlanTest::testRunStop()
+{
+  StopAfterFirstTestListener stopper( m_result );
+  m_result->addListener( &stopper );
+
+  CPPUNIT_NS::TestPlan plan( m_suite );
+  plan.run( m_result );
+
+  CPPUNIT_ASSERT_EQUAL( std::string( "startSuite:All;startSuite:Sub;"
+                                     "startTest:test1;endTest:test1;"
+                                     "endSuite:Sub;endSuite:All;" ),
+                        m_listener->m_log );
+  m_result->removeListener( &stopper );
+}
+
+
+void
+TestPlanTest::testRunTestPlan()
+{
+  MockTestListener listener( "mock-listener" );
+  listener.setExpectStartTestRun( m_suite, m_result );
+  listener.setExpectEndTestRun( m_suite, m_result );
+  m_result->addListener( &listener );
+
+  CPPUNIT_NS::TestPlan plan( m_suite );
+  m_result->runTestPlan( plan );
+
+  listener.verify();
+  m_result->removeListener( &listener );
+}
+
+
+void
+TestPlanTest::testFilterIncludeTest()
+{
+  CPPUNIT_NS::TestFilter filter;
+  filter.addInclude( "/All/Sub/test2" );
+  CPPUNIT_NS::TestPlan plan( m_suite, filter );
+
+  CPPUNIT_ASSERT_EQUAL( 3, plan.getEntryCount() );
+  CPPUNIT_ASSERT_EQUAL( 1, plan.countTestCases() );
+  CPPUNIT_ASSERT_EQUAL( 3, plan.getEntryAt( 0 ).m_endIndex );
+  CPPUNIT_ASSERT_EQUAL( 3, plan.getEntryAt( 1 ).m_endIndex );
+  CPPUNIT_ASSERT( m_test2 == plan.getEntryAt( 2 ).m_test );
+
+  plan.run( m_result );
+  CPPUNIT_ASSERT_EQUAL( std::string( "startSuite:All;startSuite:Sub;"
+                                     "startTest:test2;endTest:test2;"
+                                     "endSuite:Sub;endSuite:All;" ),
+                        m_listener->m_log );
+}
+
+
+void
+TestPlanTest::testFilterExcludeSuite()
+{
+  CPPUNIT_NS::TestFilter filter;
+  filter.addExclude( "Sub" );
+  CPPUNIT_NS::TestPlan plan( m_suite, filter );
+
+  CPPUNIT_ASSERT_EQUAL( 2, plan.getEntryCount() );
+  CPPUNIT_ASSERT_EQUAL( 1, plan.countTestCases() );
+
+  plan.run( m_result );
+  CPPUNIT_ASSERT_EQUAL( std::string( "startSuite:All;"
+                                     "startTest:test3;endTest:test3;"
+                                     "endSuite:All;" ),
+                        m_listener->m_log );
+}
+
+
+void
+TestPlanTest::testFilterIncludeSuite()
+{
+  CPPUNIT_NS::TestFilter filter;
+  filter.addInclude( "Sub" );
+  filter.addExclude( "test1" );
+  CPPUNIT_NS::TestPlan plan( m_subSuite, filter, "/All" );
+
+  CPPUNIT_ASSERT_EQUAL( 2, plan.getEntryCount() );
+  CPPUNIT_ASSERT( m_test2 == plan.getEntryAt( 1 ).m_test );
+}
+
+
+void
+TestPlanTest::testFilterNoMatch()
+{
+  CPPUNIT_NS::TestFilter filter;
+  filter.addInclude( "NoSuchTest" );
+  CPPUNIT_NS::TestPlan plan( m_suite, filter );
+
+  CPPUNIT_ASSERT_EQUAL( 1, plan.getEntryCount() );
+  CPPUNIT_ASSERT_EQUAL( 0, plan.countTestCases() );
+
+  plan.run( m_result );
+  CPPUNIT_ASSERT_EQUAL( std::string( "startSuite:All;endSuite:All;" ),
+                        m_listener->m_log );
+
+  CPPUNIT_NS::TestPlan leafPlan( m_test1, filter );
+  CPPUNIT_ASSERT_EQUAL( 0, leafPlan.getEntryCount() );
+  CPPUNIT_ASSERT_EQUAL( 0, leafPlan.countTestCases() );
+  CPPUNIT_ASSERT( m_test1 == leafPlan.getRootTest() );
+}
+
+
+void
+TestPlanTest::testFilterRunsCustomSuiteWhole()
+{
+  ReversedSuite *reversed = new ReversedSuite( "Reversed" );
+  reversed->addTest( new MockTestCase( "first" ) );
+  reversed->addTest( new MockTestCase( "second" ) );
+  m_suite->addTest( reversed );
+
+  CPPUNIT_NS::TestFilter filter;
+  filter.addInclude( "Reversed/second" );
+  CPPUNIT_NS::TestPlan plan( m_suite, filter );
+  CPPUNIT_ASSERT_EQUAL( 2, plan.getEntryCount() );
+  CPPUNIT_ASSERT( reversed == plan.getEntryAt( 1 ).m_test );
+  CPPUNIT_ASSERT_EQUAL( 2, plan.countTestCases() );
+
+  CPPUNIT_NS::TestPlan rootPlan( reversed, filter, "/All" );
+  CPPUNIT_ASSERT_EQUAL( 1, rootPlan.getEntryCount() );
+  CPPUNIT_ASSERT_EQUAL( 2, rootPlan.countTestCases() );
+}
+
+
+void
+TestPlanTest::testFilterNoMatchInCustomRootThrow()
+{
+  ReversedSuite *reversed = new ReversedSuite( "Reversed" );
+  reversed->addTest( new MockTestCase( "first" ) );
+  m_suite->addTest( reversed );
+
+  CPPUNIT_NS::TestFilter filter;
+  filter.addInclude( "NoSuchTest" );
+  CPPUNIT_NS::TestPlan plan( reversed, filter );
+}
+
+
+void
+TestPlanTest::testGetEntryAtThrow()
+{
+  CPPUNIT_NS::TestPlan plan( m_suite );
+  plan.getEntryAt( 5 );
+}
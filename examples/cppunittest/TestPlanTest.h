@@ -0,0 +1,83 @@
+#ifndef TESTPLANTEST_H
+#define TESTPLANTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFilter.h>
+#include <cppunit/TestPlan.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestSuite.h>
+#include "EventLogListener.h"
+#include "MockTestCase.h"
+#include "MockTestListener.h"
+#include <stdexcept>
+
+
+/*! \class TestPlanTest
+ * \brief Unit tests for class TestPlan.
+ */
+class TestPlanTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TestPlanTest );
+  CPPUNIT_TEST( testEntries );
+  CPPUNIT_TEST( testCountTestCases );
+  CPPUNIT_TEST( testRunProducesSameEventsAsTestRun );
+  CPPUNIT_TEST( testRunDecoratedSuiteAsLeaf );
+  CPPUNIT_TEST( testRunCustomSuiteAsLeaf );
+  CPPUNIT_TEST( testRunLeafRoot );
+  CPPUNIT_TEST( testRunStop );
+  CPPUNIT_TEST( testRunTestPlan );
+  CPPUNIT_TEST( testFilterIncludeTest );
+  CPPUNIT_TEST( testFilterExcludeSuite );
+  CPPUNIT_TEST( testFilterIncludeSuite );
+  CPPUNIT_TEST( testFilterNoMatch );
+  CPPUNIT_TEST( testFilterRunsCustomSuiteWhole );
+  CPPUNIT_TEST_EXCEPTION( testFilterNoMatchInCustomRootThrow, std::invalid_argument );
+  CPPUNIT_TEST_EXCEPTION( testGetEntryAtThrow, std::out_of_range );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a TestPlanTest object.
+   */
+  TestPlanTest();
+
+  /// Destructor.
+  virtual ~TestPlanTest();
+
+  void setUp();
+  void tearDown();
+
+  void testEntries();
+  void testCountTestCases();
+  void testRunProducesSameEventsAsTestRun();
+  void testRunDecoratedSuiteAsLeaf();
+  void testRunCustomSuiteAsLeaf();
+  void testRunLeafRoot();
+  void testRunStop();
+  void testRunTestPlan();
+  void testFilterIncludeTest();
+  void testFilterExcludeSuite();
+  void testFilterIncludeSuite();
+  void testFilterNoMatch();
+  void testFilterRunsCustomSuiteWhole();
+  void testFilterNoMatchInCustomRootThrow();
+  void testGetEntryAtThrow();
+
+private:
+  /// Prevents the use of the copy constructor.
+  TestPlanTest( const TestPlanTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestPlanTest &copy );
+
+private:
+  CPPUNIT_NS::TestSuite *m_suite;
+  CPPUNIT_NS::TestSuite *m_subSuite;
+  MockTestCase *m_test1;
+  MockTestCase *m_test2;
+  MockTestCase *m_test3;
+  CPPUNIT_NS::TestResult *m_result;
+  EventLogListener *m_listener;
+};
+
+
+#endif  // TESTPLANTEST_H
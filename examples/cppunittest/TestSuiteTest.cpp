@@ -86,7 +86,39 @@ TestSuiteTest::testCountTestCasesWithSubSuite()
 }
 
 
-void 
+void
+TestSuiteTest::testCountTestCasesAfterAddingToSubSuite()
+{
+  CPPUNIT_NS::TestSuite *subSuite = new CPPUNIT_NS::TestSuite( "SubSuite");
+  subSuite->addTest( new MockTestCase( "test1" ) );
+  m_suite->addTest( subSuite );
+  CPPUNIT_ASSERT_EQUAL( 1, m_suite->countTestCases() );
+
+  subSuite->addTest( new MockTestCase( "test2" ) );
+  CPPUNIT_ASSERT_EQUAL( 2, m_suite->countTestCases() );
+
+  subSuite->deleteContents();
+  CPPUNIT_ASSERT_EQUAL( 0, m_suite->countTestCases() );
+}
+
+
+void
+TestSuiteTest::testCountTestCasesIsCached()
+{
+  MockTestCase *case1 = new MockTestCase( "test1" );
+  case1->setExpectedCountTestCasesCall( 2 );
+  m_suite->addTest( case1 );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_suite->countTestCases() );
+  CPPUNIT_ASSERT_EQUAL( 1, m_suite->countTestCases() );
+
+  m_suite->addTest( new MockTestCase( "test2" ) );
+  CPPUNIT_ASSERT_EQUAL( 2, m_suite->countTestCases() );
+  case1->verify();
+}
+
+
+void
 TestSuiteTest::testRunWithOneTest()
 {
   MockTestCase *case1 = new MockTestCase( "test1" );
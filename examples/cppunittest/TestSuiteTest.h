@@ -12,6 +12,8 @@ class TestSuiteTest : public CPPUNIT_NS::TestFixture
   CPPUNIT_TEST( testCountTestCasesWithNoTest );
   CPPUNIT_TEST( testCountTestCasesWithTwoTests );
   CPPUNIT_TEST( testCountTestCasesWithSubSuite );
+  CPPUNIT_TEST( testCountTestCasesAfterAddingToSubSuite );
+  CPPUNIT_TEST( testCountTestCasesIsCached );
   CPPUNIT_TEST( testRunWithOneTest );
   CPPUNIT_TEST( testRunWithOneTestAndSubSuite );
   CPPUNIT_TEST( testGetTests );
@@ -34,6 +36,8 @@ public:
   void testCountTestCasesWithNoTest();
   void testCountTestCasesWithTwoTests();
   void testCountTestCasesWithSubSuite();
+  void testCountTestCasesAfterAddingToSubSuite();
+  void testCountTestCasesIsCached();
 
   void testRunWithOneTest();
   void testRunWithOneTestAndSubSuite();
@@ -1,5 +1,30 @@
 #include "CoreSuite.h"
 #include "TestTest.h"
+#include <cppunit/TestLeaf.h>
+
+
+/*! \brief Leaf test that only implements getName().
+ */
+class NameOnlyTest : public CPPUNIT_NS::TestLeaf
+{
+public:
+  NameOnlyTest( std::string name )
+      : m_name( name )
+  {
+  }
+
+  void run( CPPUNIT_NS::TestResult * )
+  {
+  }
+
+  std::string getName() const
+  {
+    return m_name;
+  }
+
+private:
+  std::string m_name;
+};
 
 
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestTest,
@@ -131,3 +156,33 @@ TestTest::testResolveTestPath()
   CPPUNIT_ASSERT( m_suite == path2.getTestAt(0) );
   CPPUNIT_ASSERT( m_test2 == path2.getTestAt(1) );
 }
+
+
+void 
+TestTest::testGetIdIsUnique()
+{
+  CPPUNIT_ASSERT( m_suite->getId() != 0 );
+  CPPUNIT_ASSERT( m_test1->getId() != 0 );
+  CPPUNIT_ASSERT( m_suite->getId() != m_test1->getId() );
+  CPPUNIT_ASSERT( m_test1->getId() != m_test2->getId() );
+  CPPUNIT_ASSERT_EQUAL( m_test1->getId(), m_test1->getId() );
+}
+
+
+void 
+TestTest::testGetNameRef()
+{
+  CPPUNIT_ASSERT_EQUAL( std::string( "suite" ), m_suite->getNameRef() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "test1" ), m_test1->getNameRef() );
+  CPPUNIT_ASSERT( &m_test1->getNameRef() == &m_test1->getNameRef() );
+}
+
+
+void 
+TestTest::testGetNameRefInternsName()
+{
+  NameOnlyTest test1( "interned" );
+  NameOnlyTest test2( "interned" );
+  CPPUNIT_ASSERT_EQUAL( std::string( "interned" ), test1.getNameRef() );
+  CPPUNIT_ASSERT( &test1.getNameRef() == &test2.getNameRef() );
+}
@@ -23,6 +23,9 @@ class TestTest : public CPPUNIT_NS::TestFixture
   CPPUNIT_TEST( testFindTest );
   CPPUNIT_TEST_EXCEPTION( testFindTestThrow, std::invalid_argument );
   CPPUNIT_TEST( testResolveTestPath );
+  CPPUNIT_TEST( testGetIdIsUnique );
+  CPPUNIT_TEST( testGetNameRef );
+  CPPUNIT_TEST( testGetNameRefInternsName );
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -49,6 +52,10 @@ public:
 
   void testResolveTestPath();
 
+  void testGetIdIsUnique();
+  void testGetNameRef();
+  void testGetNameRefInternsName();
+
 private:
   /// Prevents the use of the copy constructor.
   TestTest( const TestTest &copy );
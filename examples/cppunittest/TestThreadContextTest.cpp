@@ -0,0 +1,385 @@
+#include <cppunit/Exception.h>
+#include <cppunit/Mutex.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestFailure.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestThreadContext.h>
+#include "CoreSuite.h"
+#include "TestThreadContextTest.h"
+#include <stdexcept>
+
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TestThreadContextTest,
+                                       coreSuiteName() );
+
+
+/*! Test case running a function.
+ */
+class FunctionTestCase : public CPPUNIT_NS::TestCase
+{
+public:
+  FunctionTestCase( void (*testMethod)() )
+      : CPPUNIT_NS::TestCase( "FunctionTestCase" )
+      , m_testMethod( testMethod )
+  {
+  }
+
+  void runTest()
+  {
+    m_testMethod();
+  }
+
+private:
+  void (*m_testMethod)();
+};
+
+
+/*! Task failing in the specified way.
+ */
+class FailingTask : public CPPUNIT_NS::Functor
+{
+public:
+  enum Failure
+  {
+    none = 0,
+    assertion,
+    expectations,
+    exception,
+    blockedAssertion
+  };
+
+  FailingTask( Failure failure )
+      : m_failure( failure )
+  {
+  }
+
+  bool operator()() const;
+
+private:
+  Failure m_failure;
+};
+
+
+/// Guards the flags shared with the tasks.
+static CPPUNIT_NS::Mutex taskLock;
+/// Set to let a blocked task finish.
+static bool isTaskReleased = false;
+
+
+static bool
+taskReleased()
+{
+  CPPUNIT_NS::MutexLock lock( taskLock );
+  return isTaskReleased;
+}
+
+
+static void
+yieldProcessor()
+{
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+  ::sched_yield();
+#endif
+}
+
+
+bool 
+FailingTask::operator()() const
+{
+  switch ( m_failure )
+  {
+  case assertion:
+    CPPUNIT_ASSERT_EQUAL( 1, 2 );
+    break;
+  case expectations:
+    CPPUNIT_EXPECT_EQUAL( 3, 4 );
+    CPPUNIT_EXPECT( 5 == 6 );
+    break;
+  case exception:
+    throw std::runtime_error( "from the thread" );
+  case blockedAssertion:
+    while ( !taskReleased() )
+      yieldProcessor();
+    CPPUNIT_ASSERT( false );
+    break;
+  default:
+    break;
+  }
+  return true;
+}
+
+
+/*! Runs a task on a thread in a test context, or on the calling thread if
+ * threads are not available.
+ */
+struct TaskThread
+{
+  CPPUNIT_NS::TestThreadContext m_context;
+  FailingTask m_task;
+  bool m_succeeded;
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+  pthread_t m_handle;
+#endif
+
+  TaskThread( FailingTask::Failure failure )
+      : m_context( CPPUNIT_NS::TestThreadContext::current() )
+      , m_task( failure )
+      , m_succeeded( false )
+  {
+  }
+
+  void run()
+  {
+    m_succeeded = m_context.run( m_task );
+  }
+
+  void start();
+
+  void join();
+};
+
+
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+
+extern "C" {
+static void *
+runTaskThread( void *thread )
+{
+  ((TaskThread *)thread)->run();
+  return NULL;
+}
+}
+
+
+void 
+TaskThread::start()
+{
+  CPPUNIT_ASSERT_EQUAL( 0, ::pthread_create( &m_handle, NULL, &runTaskThread, this ) );
+}
+
+
+void 
+TaskThread::join()
+{
+  ::pthread_join( m_handle, NULL );
+}
+
+#else
+
+void 
+TaskThread::start()
+{
+  run();
+}
+
+
+void 
+TaskThread::join()
+{
+}
+
+#endif
+
+
+/// Result of the last task run by runTask().
+static bool taskSucceeded = false;
+
+
+static void
+runTask( FailingTask::Failure failure )
+{
+  TaskThread thread( failure );
+  thread.start();
+  thread.join();
+  taskSucceeded = thread.m_succeeded;
+}
+
+
+static void
+runPassingTask()
+{
+  runTask( FailingTask::none );
+}
+
+
+static void
+runFailingTask()
+{
+  runTask( FailingTask::assertion );
+}
+
+
+static void
+runExpectingTask()
+{
+  runTask( FailingTask::expectations );
+}
+
+
+static void
+runThrowingTask()
+{
+  runTask( FailingTask::exception );
+}
+
+
+/// Thread left running by startBlockedTask().
+static TaskThread *blockedThread = NULL;
+
+
+static void
+startBlockedTask()
+{
+  blockedThread = new TaskThread( FailingTask::blockedAssertion );
+  blockedThread->start();
+  while ( blockedThread->m_context.runningTaskCount() == 0 )
+    yieldProcessor();
+}
+
+
+/// Context captured by captureContext().
+static CPPUNIT_NS::TestThreadContext capturedContext;
+
+
+static void
+captureContext()
+{
+  capturedContext = CPPUNIT_NS::TestThreadContext::current();
+  CPPUNIT_ASSERT( capturedContext.isValid() );
+}
+
+
+TestThreadContextTest::TestThreadContextTest()
+    : m_collector( NULL )
+{
+}
+
+
+TestThreadContextTest::~TestThreadContextTest()
+{
+}
+
+
+void 
+TestThreadContextTest::setUp()
+{
+  m_collector = new CPPUNIT_NS::TestResultCollector();
+  taskSucceeded = false;
+  isTaskReleased = false;
+}
+
+
+void 
+TestThreadContextTest::tearDown()
+{
+  delete m_collector;
+}
+
+
+void 
+TestThreadContextTest::runFixtureTest( void (*testMethod)() )
+{
+  CPPUNIT_NS::TestResult result;
+  result.addListener( m_collector );
+  FunctionTestCase test( testMethod );
+  test.run( &result );
+}
+
+
+void 
+TestThreadContextTest::testPassingTask()
+{
+  runFixtureTest( &runPassingTask );
+
+  CPPUNIT_ASSERT( taskSucceeded );
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+}
+
+
+void 
+TestThreadContextTest::testAssertionOnThread()
+{
+  runFixtureTest( &runFailingTask );
+
+  CPPUNIT_ASSERT( !taskSucceeded );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+  CPPUNIT_ASSERT_EQUAL( 0, m_collector->testErrors() );
+  CPPUNIT_NS::TestFailure *failure = m_collector->failures()[0];
+  CPPUNIT_ASSERT_EQUAL( std::string( "Expected: 1" ),
+                        failure->thrownException()->message().detailAt( 0 ) );
+  CPPUNIT_ASSERT( failure->sourceLine().isValid() );
+}
+
+
+void 
+TestThreadContextTest::testExpectationsOnThread()
+{
+  runFixtureTest( &runExpectingTask );
+
+  CPPUNIT_ASSERT( !taskSucceeded );
+  CPPUNIT_ASSERT_EQUAL( 2, m_collector->testFailures() );
+}
+
+
+void 
+TestThreadContextTest::testExceptionOnThread()
+{
+  runFixtureTest( &runThrowingTask );
+
+  CPPUNIT_ASSERT( !taskSucceeded );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testErrors() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "from the thread" ),
+                        m_collector->failures()[0]->thrownException()->message().detailAt( 0 ) );
+}
+
+
+void 
+TestThreadContextTest::testTaskOutlivingTest()
+{
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+  runFixtureTest( &startBlockedTask );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "threads outlived the test" ),
+                        m_collector->failures()[0]->thrownException()->message().shortDescription() );
+
+  {
+    CPPUNIT_NS::MutexLock lock( taskLock );
+    isTaskReleased = true;
+  }
+  blockedThread->join();
+  CPPUNIT_ASSERT( !blockedThread->m_succeeded );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+  delete blockedThread;
+  blockedThread = NULL;
+#endif
+}
+
+
+void 
+TestThreadContextTest::testContextEndsWithTest()
+{
+  runFixtureTest( &captureContext );
+
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+  CPPUNIT_ASSERT( !capturedContext.isValid() );
+  CPPUNIT_ASSERT( !capturedContext.run( FailingTask( FailingTask::assertion ) ) );
+  capturedContext = CPPUNIT_NS::TestThreadContext();
+}
+
+
+void 
+TestThreadContextTest::testContextWithoutTest()
+{
+  CPPUNIT_NS::TestThreadContext context;
+
+  CPPUNIT_ASSERT( !context.isValid() );
+  CPPUNIT_ASSERT( context.run( FailingTask( FailingTask::none ) ) );
+  CPPUNIT_ASSERT( !context.run( FailingTask( FailingTask::exception ) ) );
+  CPPUNIT_ASSERT_EQUAL( 0, context.runningTaskCount() );
+}
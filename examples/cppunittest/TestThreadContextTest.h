@@ -0,0 +1,45 @@
+#ifndef TESTTHREADCONTEXTTEST_H
+#define TESTTHREADCONTEXTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestResultCollector.h>
+
+
+class TestThreadContextTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TestThreadContextTest );
+  CPPUNIT_TEST( testPassingTask );
+  CPPUNIT_TEST( testAssertionOnThread );
+  CPPUNIT_TEST( testExpectationsOnThread );
+  CPPUNIT_TEST( testExceptionOnThread );
+  CPPUNIT_TEST( testTaskOutlivingTest );
+  CPPUNIT_TEST( testContextEndsWithTest );
+  CPPUNIT_TEST( testContextWithoutTest );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TestThreadContextTest();
+  virtual ~TestThreadContextTest();
+
+  void setUp();
+  void tearDown();
+
+  void testPassingTask();
+  void testAssertionOnThread();
+  void testExpectationsOnThread();
+  void testExceptionOnThread();
+  void testTaskOutlivingTest();
+  void testContextEndsWithTest();
+  void testContextWithoutTest();
+
+private:
+  TestThreadContextTest( const TestThreadContextTest &copy );
+  void operator =( const TestThreadContextTest &copy );
+
+  void runFixtureTest( void (*testMethod)() );
+
+private:
+  CPPUNIT_NS::TestResultCollector *m_collector;
+};
+
+#endif  // TESTTHREADCONTEXTTEST_H
@@ -0,0 +1,137 @@
+#include "CoreSuite.h"
+#include "TypedTestSuiteTest.h"
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/extensions/TypeList.h>
+#include <algorithm>
+#include <memory>
+
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( TypedTestSuiteTest,
+                                       coreSuiteName() );
+
+
+/*! \brief Value type of the typed fixture below.
+ */
+struct TypedTestSuiteValue
+{
+  TypedTestSuiteValue()
+      : m_value( 7 )
+  {
+  }
+
+  bool operator ==( const TypedTestSuiteValue &other ) const
+  {
+    return m_value == other.m_value;
+  }
+
+  int m_value;
+};
+
+
+/*! \brief Fixture template registered for several types by the tests below.
+ */
+template<class ValueType>
+class TypedTestSuiteFixture : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TypedTestSuiteFixture );
+  CPPUNIT_TEST( testCopy );
+  CPPUNIT_TEST( testCount );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testCopy()
+  {
+    ValueType value = ValueType();
+    ValueType copy( value );
+    CPPUNIT_ASSERT( copy == value );
+  }
+
+  void testCount()
+  {
+    ++runCount;
+  }
+
+  static int runCount;
+};
+
+
+template<class ValueType>
+int TypedTestSuiteFixture<ValueType>::runCount = 0;
+
+
+static const char *const registryName = "TypedTestSuiteTest";
+
+typedef CPPUNIT_NS::TypeList<int, double, TypedTestSuiteValue> TypedTestSuiteTypes;
+CPPUNIT_TYPED_TEST_SUITE_NAMED_REGISTRATION( TypedTestSuiteFixture,
+                                             TypedTestSuiteTypes,
+                                             registryName );
+
+
+TypedTestSuiteTest::TypedTestSuiteTest()
+{
+}
+
+
+TypedTestSuiteTest::~TypedTestSuiteTest()
+{
+}
+
+
+void 
+TypedTestSuiteTest::testRegistersSuitePerType()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite(
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry( registryName ).makeTest() );
+
+  CPPUNIT_ASSERT_EQUAL( 3, suite->getChildTestCount() );
+  for ( int index = 0; index < suite->getChildTestCount(); ++index )
+    CPPUNIT_ASSERT_EQUAL( 2, suite->getChildTestAt( index )->getChildTestCount() );
+}
+
+
+void 
+TypedTestSuiteTest::testSuitesAreNamedAfterType()
+{
+  std::auto_ptr<CPPUNIT_NS::Test> suite(
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry( registryName ).makeTest() );
+
+  CppUnitVector<std::string> names;
+  for ( int index = 0; index < suite->getChildTestCount(); ++index )
+    names.push_back( suite->getChildTestAt( index )->getName() );
+  std::sort( names.begin(), names.end() );
+
+#if CPPUNIT_USE_TYPEINFO_NAME
+  CPPUNIT_ASSERT_EQUAL( 3, int(names.size()) );
+  CPPUNIT_ASSERT_EQUAL( std::string("TypedTestSuiteFixture<TypedTestSuiteValue>"),
+                        names[0] );
+  CPPUNIT_ASSERT_EQUAL( std::string("TypedTestSuiteFixture<double>"), names[1] );
+  CPPUNIT_ASSERT_EQUAL( std::string("TypedTestSuiteFixture<int>"), names[2] );
+#else
+  for ( unsigned int index = 0; index < names.size(); ++index )
+    CPPUNIT_ASSERT_EQUAL( std::string("TypedTestSuiteFixture"), names[index] );
+#endif
+}
+
+
+void 
+TypedTestSuiteTest::testRunsEachInstantiation()
+{
+  TypedTestSuiteFixture<int>::runCount = 0;
+  TypedTestSuiteFixture<double>::runCount = 0;
+  TypedTestSuiteFixture<TypedTestSuiteValue>::runCount = 0;
+
+  std::auto_ptr<CPPUNIT_NS::Test> suite(
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry( registryName ).makeTest() );
+  CPPUNIT_NS::TestResult controller;
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+  suite->run( &controller );
+
+  CPPUNIT_ASSERT_EQUAL( 6, result.runTests() );
+  CPPUNIT_ASSERT( result.wasSuccessful() );
+  CPPUNIT_ASSERT_EQUAL( 1, TypedTestSuiteFixture<int>::runCount );
+  CPPUNIT_ASSERT_EQUAL( 1, TypedTestSuiteFixture<double>::runCount );
+  CPPUNIT_ASSERT_EQUAL( 1, TypedTestSuiteFixture<TypedTestSuiteValue>::runCount );
+}
@@ -0,0 +1,40 @@
+#ifndef TYPEDTESTSUITETEST_H
+#define TYPEDTESTSUITETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+/*! \class TypedTestSuiteTest
+ * \brief Unit tests for CPPUNIT_TYPED_TEST_SUITE_REGISTRATION.
+ */
+class TypedTestSuiteTest : public CPPUNIT_NS::TestFixture
+{
+  CPPUNIT_TEST_SUITE( TypedTestSuiteTest );
+  CPPUNIT_TEST( testRegistersSuitePerType );
+  CPPUNIT_TEST( testSuitesAreNamedAfterType );
+  CPPUNIT_TEST( testRunsEachInstantiation );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  /*! Constructs a TypedTestSuiteTest object.
+   */
+  TypedTestSuiteTest();
+
+  /// Destructor.
+  virtual ~TypedTestSuiteTest();
+
+  void testRegistersSuitePerType();
+  void testSuitesAreNamedAfterType();
+  void testRunsEachInstantiation();
+
+private:
+  /// Prevents the use of the copy constructor.
+  TypedTestSuiteTest( const TypedTestSuiteTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TypedTestSuiteTest &copy );
+};
+
+
+
+#endif  // TYPEDTESTSUITETEST_H
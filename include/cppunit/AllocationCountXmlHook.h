@@ -0,0 +1,68 @@
+#ifndef CPPUNIT_ALLOCATIONCOUNTXMLHOOK_H
+#define CPPUNIT_ALLOCATIONCOUNTXMLHOOK_H
+
+#include <cppunit/XmlOutputterHook.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+class TestResultCollector;
+
+
+/*! \brief XmlOutputterHook that adds the allocations made by the tests.
+ * \ingroup WritingTestResult
+ *
+ * \<Allocations\> and \<AllocatedBytes\> elements are added to each \<Test\>
+ * and \<FailedTest\> element, and to the \<Statistics\> element:
+ * \code
+ * XmlOutputter outputter( &result, stream );
+ * AllocationCountXmlHook allocationCountHook( &result );
+ * if ( AllocationScope::isCountingInstalled() )
+ *   outputter.addHook( &allocationCountHook );
+ * outputter.write();
+ * \endcode
+ *
+ * \see AllocationScope, TestResultCollector::allocationCount().
+ */
+class CPPUNIT_API AllocationCountXmlHook : public XmlOutputterHook
+{
+public:
+  /*! Constructs a hook that reads the counts of the specified result.
+   */
+  AllocationCountXmlHook( TestResultCollector *result );
+
+  /// Destructor.
+  virtual ~AllocationCountXmlHook();
+
+  void failTestAdded( XmlDocument *document,
+                      XmlElement *testElement,
+                      Test *test,
+                      TestFailure *failure );
+
+  void successfulTestAdded( XmlDocument *document,
+                            XmlElement *testElement,
+                            Test *test );
+
+  void statisticsAdded( XmlDocument *document,
+                        XmlElement *statisticsElement );
+
+private:
+  void addCounts( XmlElement *element,
+                  long allocationCount,
+                  long allocatedByteCount );
+
+  /// Prevents the use of the copy constructor.
+  AllocationCountXmlHook( const AllocationCountXmlHook &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const AllocationCountXmlHook &copy );
+
+private:
+  TestResultCollector *m_result;
+};
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_ALLOCATIONCOUNTXMLHOOK_H
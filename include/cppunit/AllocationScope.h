@@ -0,0 +1,308 @@
+#ifndef CPPUNIT_ALLOCATIONSCOPE_H
+#define CPPUNIT_ALLOCATIONSCOPE_H
+
+#include <cppunit/SourceLine.h>
+#include <cstddef>
+#include <new>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Counts the allocations made by the calling thread during its
+ *         lifetime.
+ * \ingroup Assertions
+ *
+ * The allocations are only counted once the test program replaced the
+ * global operators \c new and \c delete with CPPUNIT_INSTALL_ALLOCATION_COUNTING().
+ * Otherwise the counts stay at zero and isCountingInstalled() returns
+ * \c false.
+ *
+ * Scopes are nested: the innermost scope of the thread counts the
+ * allocations, and adds its counts to the enclosing scope when it ends.
+ * TestCase::run() puts a scope around setUp(), runTest() and tearDown() and
+ * reports the allocations of the test to TestListener::addAllocations().
+ *
+ * Only the allocations made with \c new are counted; \c malloc() and the
+ * allocations of the other threads are not. The allocations of the framework,
+ * such as building the message of a failed assertion, are excluded with
+ * AllocationCountingPause.
+ *
+ * \see CPPUNIT_ASSERT_NO_ALLOCATIONS, CPPUNIT_ASSERT_MAX_ALLOCATIONS.
+ */
+class CPPUNIT_API AllocationScope
+{
+public:
+  /// Constructs a scope and makes it the innermost scope of the thread.
+  AllocationScope();
+
+  /// Destructor. Ends the scope if end() was not called.
+  ~AllocationScope();
+
+  /*! \brief Stops counting and adds the counts to the enclosing scope.
+   *
+   * Does nothing if the scope already ended.
+   */
+  void end();
+
+  /// Returns the number of allocations counted.
+  long allocationCount() const;
+
+  /// Returns the number of bytes allocated.
+  long allocatedByteCount() const;
+
+  /*! \brief Indicates if the allocations are counted, that is if
+   *         CPPUNIT_INSTALL_ALLOCATION_COUNTING() is used by the program
+   *         and the counting is enabled.
+   */
+  static bool isCountingInstalled();
+
+  /*! \brief Enables or disables the counting of the operators installed by
+   *         CPPUNIT_INSTALL_ALLOCATION_COUNTING().
+   *
+   * The counting is enabled by default. A disabled counting leaves the scopes
+   * at zero, for programs that install the operators but only count on
+   * request, such as DllPlugInTester.
+   */
+  static void setCountingEnabled( bool isEnabled );
+
+  /*! \brief Allocates memory and counts the allocation.
+   *
+   * Called by the operator \c new installed by
+   * CPPUNIT_INSTALL_ALLOCATION_COUNTING().
+   * \param byteCount Size of the allocation.
+   * \param throwsOnFailure If \c true, \c std::bad_alloc is thrown if the
+   *                        memory is exhausted, otherwise \c NULL is returned.
+   */
+  static void *allocate( std::size_t byteCount,
+                         bool throwsOnFailure );
+
+  /*! \brief Frees memory returned by allocate().
+   */
+  static void deallocate( void *memory );
+
+private:
+  friend class AllocationCountingPause;
+
+  static AllocationScope *current();
+
+  void countAllocation( std::size_t byteCount );
+
+  /// Prevents the use of the copy constructor.
+  AllocationScope( const AllocationScope &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const AllocationScope &copy );
+
+private:
+  AllocationScope *m_enclosingScope;
+  long m_allocationCount;
+  long m_allocatedByteCount;
+  int m_pauseDepth;
+  bool m_hasEnded;
+};
+
+
+/*! \brief Excludes the allocations of its lifetime from the innermost
+ *         AllocationScope of the thread.
+ * \ingroup Assertions
+ *
+ * Used by the framework around its own allocations, for example while it
+ * builds the message of a failed assertion.
+ */
+class CPPUNIT_API AllocationCountingPause
+{
+public:
+  AllocationCountingPause();
+
+  ~AllocationCountingPause();
+
+private:
+  /// Prevents the use of the copy constructor.
+  AllocationCountingPause( const AllocationCountingPause &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const AllocationCountingPause &copy );
+
+private:
+  AllocationScope *m_scope;
+};
+
+
+/*! \brief Checks the number of allocations made by a block.
+ * \ingroup Assertions
+ *
+ * You should not use this class directly, use CPPUNIT_ASSERT_NO_ALLOCATIONS
+ * or CPPUNIT_ASSERT_MAX_ALLOCATIONS.
+ */
+class CPPUNIT_API AllocationAssertion
+{
+public:
+  /*! Constructs an assertion and starts counting.
+   * \param maximumAllocationCount Number of allocations allowed.
+   * \param sourceLine Location of the assertion.
+   */
+  AllocationAssertion( long maximumAllocationCount,
+                       const SourceLine &sourceLine );
+
+  /// Destructor.
+  ~AllocationAssertion();
+
+  /// Returns \c true until check() is called.
+  bool isCounting() const;
+
+  /*! \brief Stops counting and fails if the block made too many allocations,
+   *         or if the allocations are not counted.
+   */
+  void check();
+
+private:
+  /// Prevents the use of the copy constructor.
+  AllocationAssertion( const AllocationAssertion &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const AllocationAssertion &copy );
+
+private:
+  SourceLine m_sourceLine;
+  long m_maximumAllocationCount;
+  bool m_isCounting;
+  // Last member, so that the other members are not counted.
+  AllocationScope m_scope;
+};
+
+
+CPPUNIT_NS_END
+
+
+/*! \brief Asserts that the following block makes at most \a maximumCount
+ *         allocations.
+ * \ingroup Assertions
+ *
+ * The block follows the macro like the body of a loop:
+ * \code
+ * void MessageQueueTest::testSteadyStateDoesNotAllocate()
+ * {
+ *   m_queue.push( m_message );    // Grows the queue once.
+ *   m_queue.pop( m_received );
+ *
+ *   CPPUNIT_ASSERT_MAX_ALLOCATIONS( 0 )
+ *   {
+ *     m_queue.push( m_message );
+ *     m_queue.pop( m_received );
+ *   }
+ *   CPPUNIT_ASSERT_EQUAL( m_message, m_received );
+ * }
+ * \endcode
+ *
+ * Only the allocations made by the calling thread with \c new are counted.
+ * The assertion fails if the allocations are not counted, see
+ * CPPUNIT_INSTALL_ALLOCATION_COUNTING().
+ *
+ * The block is the body of a \c for loop whose increment does the check.
+ * Leaving the block with \c break, \c return, \c goto or an exception
+ * therefore skips the check silently; \c continue does not.
+ *
+ * The framework's assertions do not allocate when they pass, and their
+ * failure messages are not counted. The message given to the \c _MESSAGE
+ * forms is built by the test and is counted, so prefer checking the results
+ * after the block.
+ * \param maximumCount Number of allocations allowed.
+ */
+#define CPPUNIT_ASSERT_MAX_ALLOCATIONS( maximumCount )                       \
+  for ( CPPUNIT_NS::AllocationAssertion cpputAllocations( (maximumCount),    \
+                                                          CPPUNIT_SOURCELINE() ); \
+        cpputAllocations.isCounting();                                        \
+        cpputAllocations.check() )
+
+/*! \brief Asserts that the following block makes no allocation.
+ * \ingroup Assertions
+ * \see CPPUNIT_ASSERT_MAX_ALLOCATIONS.
+ */
+#define CPPUNIT_ASSERT_NO_ALLOCATIONS                                        \
+  CPPUNIT_ASSERT_MAX_ALLOCATIONS( 0 )
+
+
+#if __cplusplus >= 201103L
+#  define CPPUNIT_ALLOCATION_THROWS
+#  define CPPUNIT_ALLOCATION_THROWS_NOTHING noexcept
+#else
+#  define CPPUNIT_ALLOCATION_THROWS throw( std::bad_alloc )
+#  define CPPUNIT_ALLOCATION_THROWS_NOTHING throw()
+#endif
+
+#if defined(__cpp_sized_deallocation)
+#  define CPPUNIT_SIZED_DELETE_OPERATORS                                    \
+  void operator delete( void *memory,                                        \
+                        std::size_t ) CPPUNIT_ALLOCATION_THROWS_NOTHING      \
+  {                                                                          \
+    CPPUNIT_NS::AllocationScope::deallocate( memory );                       \
+  }                                                                          \
+  void operator delete[]( void *memory,                                      \
+                          std::size_t ) CPPUNIT_ALLOCATION_THROWS_NOTHING    \
+  {                                                                          \
+    CPPUNIT_NS::AllocationScope::deallocate( memory );                       \
+  }
+#else
+#  define CPPUNIT_SIZED_DELETE_OPERATORS
+#endif
+
+/*! \brief Replaces the global operators \c new and \c delete with ones that
+ *         count the allocations for AllocationScope.
+ * \ingroup Assertions
+ *
+ * Use it once in a source file of the test program, at global scope:
+ * \code
+ * #include <cppunit/AllocationScope.h>
+ *
+ * CPPUNIT_INSTALL_ALLOCATION_COUNTING()
+ *
+ * int main( int argc, char* argv[] )
+ * {
+ *   ...
+ * \endcode
+ * The test plug-ins run by DllPlugInTester are counted by the operators it
+ * installs on the platforms where the plug-ins use the operators of the
+ * program.
+ */
+#define CPPUNIT_INSTALL_ALLOCATION_COUNTING()                                \
+  void *operator new( std::size_t byteCount ) CPPUNIT_ALLOCATION_THROWS      \
+  {                                                                          \
+    return CPPUNIT_NS::AllocationScope::allocate( byteCount, true );         \
+  }                                                                          \
+  void *operator new[]( std::size_t byteCount ) CPPUNIT_ALLOCATION_THROWS    \
+  {                                                                          \
+    return CPPUNIT_NS::AllocationScope::allocate( byteCount, true );         \
+  }                                                                          \
+  void *operator new( std::size_t byteCount,                                 \
+                      const std::nothrow_t & ) CPPUNIT_ALLOCATION_THROWS_NOTHING \
+  {                                                                          \
+    return CPPUNIT_NS::AllocationScope::allocate( byteCount, false );        \
+  }                                                                          \
+  void *operator new[]( std::size_t byteCount,                               \
+                        const std::nothrow_t & ) CPPUNIT_ALLOCATION_THROWS_NOTHING \
+  {                                                                          \
+    return CPPUNIT_NS::AllocationScope::allocate( byteCount, false );        \
+  }                                                                          \
+  void operator delete( void *memory ) CPPUNIT_ALLOCATION_THROWS_NOTHING     \
+  {                                                                          \
+    CPPUNIT_NS::AllocationScope::deallocate( memory );                       \
+  }                                                                          \
+  void operator delete[]( void *memory ) CPPUNIT_ALLOCATION_THROWS_NOTHING   \
+  {                                                                          \
+    CPPUNIT_NS::AllocationScope::deallocate( memory );                       \
+  }                                                                          \
+  void operator delete( void *memory,                                        \
+                        const std::nothrow_t & ) CPPUNIT_ALLOCATION_THROWS_NOTHING \
+  {                                                                          \
+    CPPUNIT_NS::AllocationScope::deallocate( memory );                       \
+  }                                                                          \
+  void operator delete[]( void *memory,                                      \
+                          const std::nothrow_t & ) CPPUNIT_ALLOCATION_THROWS_NOTHING \
+  {                                                                          \
+    CPPUNIT_NS::AllocationScope::deallocate( memory );                       \
+  }                                                                          \
+  CPPUNIT_SIZED_DELETE_OPERATORS
+
+
+#endif  // CPPUNIT_ALLOCATIONSCOPE_H
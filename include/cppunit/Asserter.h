@@ -45,6 +45,9 @@ class Message;
 struct Asserter
 {
   /*! \brief Throws a Exception with the specified message and location.
+   *
+   * Within an ExpectationScope, the failure is recorded by the
+   * ExpectationCollector of the test instead, and fail() returns.
    */
   static void CPPUNIT_API fail( const Message &message, 
                                 const SourceLine &sourceLine = SourceLine() );
@@ -76,13 +79,24 @@ struct Asserter
                                   std::string message, 
                                   const SourceLine &sourceLine = SourceLine() );
 
+  /*! \brief Counts an assertion checked by the test running on the calling
+   *         thread.
+   *
+   * Called once by each assertion, whether it fails or not. failIf() and
+   * failNotEqualIf() count the assertion themselves. Custom assertions that
+   * only call fail() on failure should call countAssertion() first.
+   * \sa ExpectationCollector::assertionCount().
+   */
+  static void CPPUNIT_API countAssertion();
+
   /*! \brief Returns a expected value string for a message.
    * Typically used to create 'not equal' message, or to check that a message
    * contains the expected content when writing unit tests for your custom 
    * assertions.
    *
    * \param expectedValue String that represents the expected value.
-   * \return \a expectedValue prefixed with "Expected: ".
+   * \return \a expectedValue prefixed with "Expected: ", elided by
+   *         BoundedText::elide() if it is too long.
    * \see makeActual().
    */
   static std::string CPPUNIT_API makeExpected( const std::string &expectedValue );
@@ -93,7 +107,8 @@ struct Asserter
    * assertions.
    *
    * \param actualValue String that represents the actual value.
-   * \return \a actualValue prefixed with "Actual  : ".
+   * \return \a actualValue prefixed with "Actual  : ", elided by
+   *         BoundedText::elide() if it is too long.
    * \see makeExpected().
    */
   static std::string CPPUNIT_API makeActual( const std::string &actualValue );
@@ -0,0 +1,64 @@
+#ifndef CPPUNIT_ASSERTIONCOUNTXMLHOOK_H
+#define CPPUNIT_ASSERTIONCOUNTXMLHOOK_H
+
+#include <cppunit/XmlOutputterHook.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+class TestResultCollector;
+
+
+/*! \brief XmlOutputterHook that adds the number of assertions checked by the
+ *         tests.
+ * \ingroup WritingTestResult
+ *
+ * An \<Assertions\> element is added to each \<Test\> and \<FailedTest\>
+ * element, and to the \<Statistics\> element:
+ * \code
+ * XmlOutputter outputter( &result, stream );
+ * AssertionCountXmlHook assertionCountHook( &result );
+ * outputter.addHook( &assertionCountHook );
+ * outputter.write();
+ * \endcode
+ *
+ * \see TestResultCollector::assertionCount().
+ */
+class CPPUNIT_API AssertionCountXmlHook : public XmlOutputterHook
+{
+public:
+  /*! Constructs a hook that reads the counts of the specified result.
+   */
+  AssertionCountXmlHook( TestResultCollector *result );
+
+  /// Destructor.
+  virtual ~AssertionCountXmlHook();
+
+  void failTestAdded( XmlDocument *document,
+                      XmlElement *testElement,
+                      Test *test,
+                      TestFailure *failure );
+
+  void successfulTestAdded( XmlDocument *document,
+                            XmlElement *testElement,
+                            Test *test );
+
+  void statisticsAdded( XmlDocument *document,
+                        XmlElement *statisticsElement );
+
+private:
+  /// Prevents the use of the copy constructor.
+  AssertionCountXmlHook( const AssertionCountXmlHook &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const AssertionCountXmlHook &copy );
+
+private:
+  TestResultCollector *m_result;
+};
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_ASSERTIONCOUNTXMLHOOK_H
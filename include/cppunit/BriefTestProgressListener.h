@@ -2,6 +2,7 @@
 #define CPPUNIT_BRIEFTESTPROGRESSLISTENER_H
 
 #include <cppunit/TestListener.h>
+#include <cppunit/portability/Stream.h>
 
 
 CPPUNIT_NS_BEGIN
@@ -13,10 +14,15 @@ CPPUNIT_NS_BEGIN
 class CPPUNIT_API BriefTestProgressListener : public TestListener
 {
 public:
-  /*! Constructs a BriefTestProgressListener object.
+  /*! Constructs a BriefTestProgressListener object that prints to stdCOut().
    */
   BriefTestProgressListener();
 
+  /*! Constructs a BriefTestProgressListener object.
+   * \param stream Stream the test names are printed to.
+   */
+  BriefTestProgressListener( OStream &stream );
+
   /// Destructor.
   virtual ~BriefTestProgressListener();
 
@@ -34,6 +40,7 @@ private:
   void operator =( const BriefTestProgressListener &copy );
 
 private:
+  OStream &m_stream;
   bool m_lastTestFailed;
 };
 
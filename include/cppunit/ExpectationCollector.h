@@ -0,0 +1,247 @@
+#ifndef CPPUNIT_EXPECTATIONCOLLECTOR_H
+#define CPPUNIT_EXPECTATIONCOLLECTOR_H
+
+#include <cppunit/Mutex.h>
+#include <cppunit/SourceLine.h>
+#include <cppunit/TestThreadContext.h>
+#include <cppunit/portability/CppUnitDeque.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+class Exception;
+class Message;
+class Test;
+class TestResult;
+
+
+/*! \brief Collects the failed expectations of the test run by the calling thread.
+ * \ingroup Assertions
+ *
+ * The CPPUNIT_EXPECT_* macros check the same conditions as the
+ * CPPUNIT_ASSERT_* macros, but a failure is recorded instead of being thrown,
+ * and the test goes on. TestCase::run() installs a collector for each test
+ * and reports each recorded failure as a separate TestFailure once
+ * runTest() returns, then once tearDown() returns:
+ * \code
+ * void RowsTest::testAllRows()
+ * {
+ *   for ( int row = 0; row < m_table.rowCount(); ++row )
+ *     CPPUNIT_EXPECT_EQUAL_MESSAGE( m_table.rowName( row ),
+ *                                   m_expected[row], m_table.total( row ) );
+ * }
+ * \endcode
+ *
+ * Only the first failures of a test are kept (100 by default); the others
+ * are counted and reported as one more failure.
+ *
+ * Outside of a test there is no collector and a failed expectation throws
+ * like an assertion. The threads started by a test get a collector of their
+ * own by running their tasks with TestThreadContext::run(), which passes the
+ * failures on to the collector of the test.
+ *
+ * The failures may be recorded from several threads at once.
+ *
+ * The collector also counts the assertions checked by the test, see
+ * Asserter::countAssertion().
+ *
+ * \sa ExpectationScope, TestThreadContext.
+ */
+class CPPUNIT_API ExpectationCollector
+{
+public:
+  enum { defaultMaximumFailureCount = 100 };
+
+  /*! Constructs a collector.
+   * \param maximumFailureCount Number of failures kept; the following ones
+   *                            are only counted.
+   */
+  ExpectationCollector( int maximumFailureCount = defaultMaximumFailureCount );
+
+  /// Destructor. Deletes the failures that were not reported.
+  virtual ~ExpectationCollector();
+
+  /*! \brief Records a failure.
+   */
+  void addFailure( const Message &message,
+                   const SourceLine &sourceLine );
+
+  /*! \brief Records an error, such as an exception escaping a thread.
+   */
+  void addError( const Message &message,
+                 const SourceLine &sourceLine = SourceLine() );
+
+  /*! \brief Returns the number of failures recorded since the last report,
+   *         including the ones that were only counted.
+   */
+  int failureCount() const;
+
+  /*! \brief Returns the number of assertions and expectations checked by the
+   *         test, including the ones of the tasks run in its
+   *         TestThreadContext that returned.
+   */
+  int assertionCount() const;
+
+  /*! \brief Reports the recorded failures to a TestResult and forgets them.
+   * \param result Result the failures are added to.
+   * \param test Test the failures are reported for.
+   */
+  void reportFailures( TestResult *result,
+                       Test *test );
+
+  /*! \brief Ends the test and reports the remaining failures.
+   *
+   * The tasks of the test still running on other threads are reported as a
+   * failure, and their failures will be ignored.
+   * \param result Result the failures are added to.
+   * \param test Test the failures are reported for.
+   */
+  void endTest( TestResult *result,
+                Test *test );
+
+  /*! \brief Returns the context passed to the threads started by the test.
+   */
+  const TestThreadContext &threadContext() const;
+
+  /*! \brief Sets the collector of the calling thread.
+   * \param collector Collector of the calling thread, or \c NULL.
+   * \return The previous collector of the calling thread.
+   */
+  static ExpectationCollector *setCurrent( ExpectationCollector *collector );
+
+  /*! \brief Returns the collector of the calling thread, or \c NULL.
+   */
+  static ExpectationCollector *current();
+
+  /*! \brief Records a failure if an ExpectationScope is active on the
+   *         calling thread.
+   *
+   * Called by Asserter::fail().
+   * \return \c true if the failure was recorded, \c false if it should be
+   *         thrown.
+   */
+  static bool recordFailure( const Message &message,
+                             const SourceLine &sourceLine );
+
+  /*! \brief Counts an assertion for the collector of the calling thread, if
+   *         any.
+   *
+   * Called by Asserter::countAssertion().
+   */
+  static void countAssertion();
+
+private:
+  friend class ExpectationScope;
+  friend class TestThreadContext;
+
+  /// Failure or error recorded.
+  struct Failure
+  {
+    Exception *m_exception;
+    bool m_isError;
+  };
+
+  void add( const Message &message,
+            const SourceLine &sourceLine,
+            bool isError );
+
+  void endThreads();
+
+  void adoptFailures( ExpectationCollector &other );
+
+  /// Prevents the use of the copy constructor.
+  ExpectationCollector( const ExpectationCollector &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const ExpectationCollector &copy );
+
+private:
+  Mutex m_lock;
+  int m_maximumFailureCount;
+  CppUnitDeque<Failure> m_failures;
+  int m_droppedFailureCount;
+  int m_scopeDepth;
+  /// Only updated by the thread of the collector, so that counting is cheap.
+  int m_assertionCount;
+  /// Assertions of the tasks of other threads, guarded by m_lock.
+  int m_adoptedAssertionCount;
+  TestThreadContext m_threadContext;
+};
+
+
+/*! \brief Makes a collector the collector of the calling thread during its
+ *         lifetime.
+ * \ingroup Assertions
+ *
+ * The previous collector of the thread is restored by restore() or by the
+ * destructor, so it is restored even if an exception is thrown.
+ * \see ExpectationCollector::setCurrent().
+ */
+class CPPUNIT_API CurrentExpectationCollector
+{
+public:
+  /// Makes \a collector the collector of the calling thread.
+  CurrentExpectationCollector( ExpectationCollector *collector );
+
+  /// Destructor. Restores the previous collector if restore() was not called.
+  ~CurrentExpectationCollector();
+
+  /*! \brief Restores the previous collector of the calling thread.
+   *
+   * Does nothing if it was already restored.
+   */
+  void restore();
+
+private:
+  /// Prevents the use of the copy constructor.
+  CurrentExpectationCollector( const CurrentExpectationCollector &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const CurrentExpectationCollector &copy );
+
+private:
+  ExpectationCollector *m_previousCollector;
+  bool m_isRestored;
+};
+
+
+/*! \brief Records the failures of the assertions of its lifetime instead of
+ *         throwing them.
+ * \ingroup Assertions
+ *
+ * Used by the CPPUNIT_EXPECT_* macros. Only the failures raised on the
+ * calling thread while the scope exists are recorded, and only if the thread
+ * has an ExpectationCollector.
+ * \code
+ * template <class T>
+ * void expectEquals( const T &expected, const T &actual,
+ *                    SourceLine sourceLine, const std::string &message )
+ * {
+ *   ExpectationScope scope;
+ *   assertEquals( expected, actual, sourceLine, message );
+ * }
+ * \endcode
+ */
+class CPPUNIT_API ExpectationScope
+{
+public:
+  ExpectationScope();
+
+  ~ExpectationScope();
+
+private:
+  /// Prevents the use of the copy constructor.
+  ExpectationScope( const ExpectationScope &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const ExpectationScope &copy );
+
+private:
+  ExpectationCollector *m_collector;
+};
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_EXPECTATIONCOLLECTOR_H
@@ -8,7 +8,7 @@
 #pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
 #endif
 
-#include <cppunit/portability/CppUnitDeque.h>
+#include <cppunit/portability/CppUnitVector.h>
 #include <string>
 
 
@@ -57,6 +57,23 @@ public:
            const std::string &detail2,
            const std::string &detail3 );
 
+  /*! \brief Constructs a message from literals, such as the ones of the
+   *         assertion macros.
+   *
+   * The allocations made to copy the texts are not counted by
+   * AllocationScope, so that a passing assertion does not allocate.
+   */
+  explicit Message( const char *shortDescription );
+
+  /// \copydoc Message( const char * )
+  Message( const char *shortDescription,
+           const char *detail1 );
+
+  /// \copydoc Message( const char * )
+  Message( const char *shortDescription,
+           const char *detail1,
+           const std::string &detail2 );
+
   Message &operator =( const Message &other );
 
   /*! \brief Returns the short description.
@@ -141,7 +158,8 @@ public:
 private:
   std::string m_shortDescription;
 
-  typedef CppUnitDeque<std::string> Details;
+  // Unlike a deque, an empty vector does not allocate.
+  typedef CppUnitVector<std::string> Details;
   Details m_details;
 };
 
@@ -0,0 +1,75 @@
+#ifndef CPPUNIT_MUTEX_H
+#define CPPUNIT_MUTEX_H
+
+#include <cppunit/SynchronizedObject.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Mutex implemented with the threads of the platform.
+ *
+ * POSIX threads are used if available, Win32 critical sections on Windows.
+ * On other platforms lock() and unlock() do nothing.
+ *
+ * The mutex is not recursive. As a SynchronizationObject, it can be used to
+ * make a TestResult safe to use from multiple threads:
+ * \code
+ * TestResult controller( new Mutex() );
+ * \endcode
+ */
+class CPPUNIT_API Mutex : public SynchronizedObject::SynchronizationObject
+{
+public:
+  /*! Constructs an unlocked mutex.
+   */
+  Mutex();
+
+  /// Destructor. The mutex must not be locked.
+  virtual ~Mutex();
+
+  void lock();
+
+  void unlock();
+
+private:
+  /// Prevents the use of the copy constructor.
+  Mutex( const Mutex &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const Mutex &copy );
+
+private:
+  void *m_handle;
+};
+
+
+/*! \brief Locks a Mutex in the current scope.
+ */
+class MutexLock
+{
+public:
+  MutexLock( Mutex &mutex )
+      : m_mutex( mutex )
+  {
+    m_mutex.lock();
+  }
+
+  ~MutexLock()
+  {
+    m_mutex.unlock();
+  }
+
+private:
+  MutexLock( const MutexLock &copy );
+  void operator =( const MutexLock &copy );
+
+private:
+  Mutex &m_mutex;
+};
+
+
+CPPUNIT_NS_END
+
+
+#endif  // CPPUNIT_MUTEX_H
@@ -0,0 +1,222 @@
+#ifndef CPPUNIT_PARAMETERIZEDTESTCASE_H
+#define CPPUNIT_PARAMETERIZEDTESTCASE_H
+
+#include <cppunit/Portability.h>
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( push )
+#pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
+#endif
+
+#include <cppunit/Test.h>
+#include <cppunit/TestArena.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/TestDataTable.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <sstream>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Test that runs a test method once for each row of a TestDataTable.
+ * \ingroup WritingTestFixture
+ *
+ * Each row is a child test case named after the test and the key of the row,
+ * or its index if the row has no key: "MyTest::testParse[zero]",
+ * "MyTest::testParse[1]"... The rows can therefore be selected by TestPath
+ * and TestFilter like any other test.
+ *
+ * The table is only read when the children are first requested, and the
+ * test case of a row is only created when it is requested. A new fixture is
+ * created to run each row, and destroyed after the row is run, so running a
+ * large table never holds more than one fixture.
+ *
+ * If the table can not be read, a single child test fails with the reason.
+ *
+ * The rows can be distributed over several processes with setShard() or
+ * setDefaultShard(): a process then only runs the rows whose index modulo
+ * \c shardCount is \c shardIndex.
+ *
+ * Use ParameterizedTestCase and CPPUNIT_TEST_DATA() to declare a test.
+ */
+class CPPUNIT_API ParameterizedTest : public Test
+{
+public:
+  /*! Constructs a parameterized test.
+   * \param name Name of the test.
+   * \param table Rows of the test. Owned by the test. Must not be \c NULL.
+   */
+  ParameterizedTest( const std::string &name,
+                     TestDataTable *table );
+
+  /// Destructor. Destroys the test case of the rows and the table.
+  virtual ~ParameterizedTest();
+
+  void run( TestResult *result );
+
+  int countTestCases() const;
+
+  int getChildTestCount() const;
+
+  std::string getName() const;
+
+  const std::string &getNameRef() const;
+
+  /*! \brief Returns \c true.
+   * \see Test::canBeFlattened().
+   */
+  bool canBeFlattened() const;
+
+  /*! \brief Only runs the rows of the specified shard.
+   *
+   * Must be called before the children are requested.
+   * \param shardIndex Zero based index of the shard, < \a shardCount.
+   * \param shardCount Number of shards, > 0.
+   * \exception std::invalid_argument if the shard is invalid.
+   */
+  void setShard( int shardIndex,
+                 int shardCount );
+
+  /*! \brief Sets the shard of the parameterized tests constructed afterward.
+   *
+   * Test runners call this method before creating the tests to distribute
+   * the rows of every table over several processes.
+   * \see setShard().
+   */
+  static void setDefaultShard( int shardIndex,
+                               int shardCount );
+
+  /*! \brief Returns the rows of the test.
+   */
+  TestDataTable &getTable() const;
+
+  /*! \brief Returns the index in the table of the row of a child test.
+   * \param childIndex Zero based index of a child test.
+   */
+  int getRowIndex( int childIndex ) const;
+
+  /*! \brief Creates a new fixture to run a row.
+   */
+  virtual TestFixture *makeFixture() const =0;
+
+  /*! \brief Runs the test method of a row.
+   * \param fixture Fixture returned by makeFixture(), already set up.
+   * \param row Row to test.
+   */
+  virtual void runRow( TestFixture *fixture,
+                       const TestDataRow &row ) const =0;
+
+  /*! \brief Returns the reason why the table can not be read.
+   * \return Empty string if the table can be read.
+   */
+  std::string getTableError() const;
+
+protected:
+  Test *doGetChildTestAt( int index ) const;
+
+private:
+  void loadTable() const;
+
+  /// Prevents the use of the copy constructor.
+  ParameterizedTest( const ParameterizedTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const ParameterizedTest &copy );
+
+private:
+  const std::string m_name;
+  TestDataTable *m_table;
+  int m_shardIndex;
+  int m_shardCount;
+  int m_childCount;
+  std::string m_tableError;
+  typedef CppUnitVector<Test *> RowTests;
+  RowTests m_rowTests;
+};
+
+
+/*! \brief Parameterized test that calls a fixture method with the data of each row.
+ * \ingroup WritingTestFixture
+ *
+ * The test method receives the parameters and the expected result of the row
+ * as streams:
+ * \code
+ * class ParserTest : public CppUnit::TestFixture
+ * {
+ *   CPPUNIT_TEST_SUITE( ParserTest );
+ *   CPPUNIT_TEST_DATA( testParse, new CppUnit::CsvTestDataTable( "parse.csv" ) );
+ *   CPPUNIT_TEST_SUITE_END();
+ * public:
+ *   void testParse( std::istream &parameters, std::istream &expected );
+ * };
+ * \endcode
+ *
+ * The fixture is created with its default constructor.
+ *
+ * \see ParameterizedTest, TestDataTable.
+ */
+template<class Fixture>
+class ParameterizedTestCase : public ParameterizedTest
+{
+public:
+  typedef void (Fixture::*TestMethod)( std::istream &parameters,
+                                       std::istream &expected );
+
+  /*! Constructs a parameterized test.
+   * \param name Name of the test.
+   * \param method Method called for each row.
+   * \param table Rows of the test. Owned by the test.
+   */
+  ParameterizedTestCase( const std::string &name,
+                         TestMethod method,
+                         TestDataTable *table )
+      : ParameterizedTest( name, table )
+      , m_method( method )
+  {
+  }
+
+  TestFixture *makeFixture() const
+  {
+    return new Fixture();
+  }
+
+  void runRow( TestFixture *fixture,
+               const TestDataRow &row ) const
+  {
+    std::istringstream parameters( row.m_parameters );
+    std::istringstream expected( row.m_expected );
+    (CPPUNIT_STATIC_CAST( Fixture *, fixture )->*m_method)( parameters, expected );
+  }
+
+private:
+  TestMethod m_method;
+};
+
+
+CPPUNIT_NS_END
+
+
+/*! \brief Adds a parameterized test method to the suite.
+ * \ingroup WritingTestFixture
+ *
+ * The method is run once for each row of \a dataTable, see ParameterizedTestCase.
+ * \param testMethod Name of the method of the test case to add to the
+ *                   suite. The signature of the method must be of
+ *                   type: void testMethod(std::istream &parameters, std::istream &expected);
+ * \param dataTable Pointer on a new TestDataTable. Owned by the test.
+ * \see  CPPUNIT_TEST_SUITE.
+ */
+#define CPPUNIT_TEST_DATA( testMethod, dataTable )                          \
+    CPPUNIT_TEST_SUITE_ADD_TEST(                                            \
+        CPPUNIT_TEST_NEW( CPPUNIT_NS::ParameterizedTestCase<TestFixtureType>, \
+                          ( context.getTestNameFor( #testMethod ),          \
+                            &TestFixtureType::testMethod,                   \
+                            dataTable ) ) )
+
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( pop )
+#endif
+
+#endif  // CPPUNIT_PARAMETERIZEDTESTCASE_H
@@ -0,0 +1,70 @@
+#ifndef CPPUNIT_PEAKMEMORYXMLHOOK_H
+#define CPPUNIT_PEAKMEMORYXMLHOOK_H
+
+#include <cppunit/XmlOutputterHook.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+class TestResultCollector;
+
+
+/*! \brief XmlOutputterHook that adds the peak memory of the tests.
+ * \ingroup WritingTestResult
+ *
+ * A \<PeakMemoryKilobytes\> element is added to each \<Test\> and
+ * \<FailedTest\> element whose peak memory was measured, and the highest
+ * peak to the \<Statistics\> element:
+ * \code
+ * TestResult controller;
+ * controller.setTracksPeakMemory( true );
+ * ...
+ * XmlOutputter outputter( &result, stream );
+ * PeakMemoryXmlHook peakMemoryHook( &result );
+ * outputter.addHook( &peakMemoryHook );
+ * outputter.write();
+ * \endcode
+ *
+ * \see TestResult::setTracksPeakMemory(), TestResultCollector::peakMemory().
+ */
+class CPPUNIT_API PeakMemoryXmlHook : public XmlOutputterHook
+{
+public:
+  /*! Constructs a hook that reads the peaks of the specified result.
+   */
+  PeakMemoryXmlHook( TestResultCollector *result );
+
+  /// Destructor.
+  virtual ~PeakMemoryXmlHook();
+
+  void failTestAdded( XmlDocument *document,
+                      XmlElement *testElement,
+                      Test *test,
+                      TestFailure *failure );
+
+  void successfulTestAdded( XmlDocument *document,
+                            XmlElement *testElement,
+                            Test *test );
+
+  void statisticsAdded( XmlDocument *document,
+                        XmlElement *statisticsElement );
+
+private:
+  void addPeak( XmlElement *element,
+                long peakKilobytes );
+
+  /// Prevents the use of the copy constructor.
+  PeakMemoryXmlHook( const PeakMemoryXmlHook &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const PeakMemoryXmlHook &copy );
+
+private:
+  TestResultCollector *m_result;
+};
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_PEAKMEMORYXMLHOOK_H
@@ -0,0 +1,556 @@
+#ifndef CPPUNIT_RANGEASSERT_H
+#define CPPUNIT_RANGEASSERT_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <cppunit/tools/SequenceDiff.h>
+#include <iterator>
+#include <stddef.h>
+#include <string>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Traits indicating that equal objects have the same bytes.
+ *
+ * CPPUNIT_ASSERT_RANGES_EQUAL() compares arrays of such types with memcmp()
+ * before comparing the elements of the blocks that differ, which is much
+ * faster for large arrays. This is true of the integral types, but not of
+ * the floating point types (NaN, -0.0) nor of the types with padding bytes.
+ *
+ * It can be specialized for a type whose assertion_traits::equal() is
+ * \c true only for identical bytes:
+ * \code
+ * template<>
+ * struct assertion_bitwise_comparable<Rgb>
+ * {
+ *   enum { value = true };
+ * };
+ * \endcode
+ */
+template <class T>
+struct assertion_bitwise_comparable
+{
+  enum { value = false };
+};
+
+/// \cond
+#define CPPUNIT_BITWISE_COMPARABLE( Type )                \
+  template <>                                             \
+  struct assertion_bitwise_comparable<Type>               \
+  {                                                       \
+    enum { value = true };                                \
+  }
+
+CPPUNIT_BITWISE_COMPARABLE( bool );
+CPPUNIT_BITWISE_COMPARABLE( char );
+CPPUNIT_BITWISE_COMPARABLE( signed char );
+CPPUNIT_BITWISE_COMPARABLE( unsigned char );
+CPPUNIT_BITWISE_COMPARABLE( wchar_t );
+CPPUNIT_BITWISE_COMPARABLE( short );
+CPPUNIT_BITWISE_COMPARABLE( unsigned short );
+CPPUNIT_BITWISE_COMPARABLE( int );
+CPPUNIT_BITWISE_COMPARABLE( unsigned int );
+CPPUNIT_BITWISE_COMPARABLE( long );
+CPPUNIT_BITWISE_COMPARABLE( unsigned long );
+
+#undef CPPUNIT_BITWISE_COMPARABLE
+/// \endcond
+
+
+/*! \brief (Implementation) Differences found between two ranges.
+ *
+ * Only the first mismatch is located. The other ones are only counted, so
+ * that comparing very large ranges does not use memory.
+ */
+struct CPPUNIT_API RangeDifference
+{
+  RangeDifference();
+
+  /// Counts a mismatch, located if it is the first one.
+  void addMismatch( size_t index );
+
+  /// Indicates if the ranges have the same size and no mismatch.
+  bool isEqual() const;
+
+  /// Index of the first element that differs, or of the first extra element.
+  size_t firstDifference() const;
+
+  /// Index of the first element of the context window.
+  size_t windowBegin() const;
+
+  /// Index following the last element of the context window.
+  size_t windowEnd() const;
+
+  /// Number of elements shown before and after the first difference.
+  enum { contextSize = 4 };
+
+  size_t m_expectedSize;
+  size_t m_actualSize;
+  size_t m_mismatchCount;
+  size_t m_firstMismatch;
+};
+
+
+/*! \brief (Implementation) Counts the mismatches of two arrays by comparing
+ *         their bytes.
+ *
+ * Blocks of elements are compared with memcmp(). Only the elements of the
+ * blocks that differ are compared one by one.
+ */
+void CPPUNIT_API findBitwiseMismatches( const void *expected,
+                                        const void *actual,
+                                        size_t count,
+                                        size_t elementSize,
+                                        RangeDifference &difference );
+
+
+/*! \brief (Implementation) Reports the differences found between two ranges.
+ * \param difference Differences found.
+ * \param expectedWindow Rendering of the context window of the expected range.
+ * \param actualWindow Rendering of the context window of the actual range.
+ * \param elementDiff Diff of the elements of the ranges, or an empty string.
+ * \param sourceLine Location of the assertion.
+ * \param message Message of the user.
+ * \param shortDescription Short description of the failure.
+ */
+void CPPUNIT_API failRangesNotEqual( const RangeDifference &difference,
+                                     const std::string &expectedWindow,
+                                     const std::string &actualWindow,
+                                     const std::string &elementDiff,
+                                     const SourceLine &sourceLine,
+                                     const std::string &message,
+                                     const std::string &shortDescription = "ranges not equal" );
+
+
+/*! \brief (Implementation) Appends an element to the rendering of a context
+ *         window, truncated if it is too long.
+ * \param window Rendering the element is appended to.
+ * \param element String representation of the element.
+ * \param isFirstDifference \c true to mark the element as the first that
+ *                          differs.
+ */
+void CPPUNIT_API appendRangeWindowElement( std::string &window,
+                                           const std::string &element,
+                                           bool isFirstDifference );
+
+
+/// \cond
+template <class T>
+bool rangeElementsEqual( const T &expected, const T &actual )
+{
+  return assertion_traits<T>::equal( expected, actual );
+}
+
+
+template <class T>
+std::string rangeElementToString( const T &element )
+{
+  return assertion_traits<T>::toString( element );
+}
+
+
+template <class T>
+bool isRangeBitwiseComparable( const T * )
+{
+  return assertion_bitwise_comparable<T>::value != 0;
+}
+
+
+template <class ExpectedIterator, class ActualIterator>
+class RangeDiffSequences : public DiffSequences
+{
+public:
+  RangeDiffSequences( ExpectedIterator expectedBegin,
+                      size_t expectedSize,
+                      ActualIterator actualBegin,
+                      size_t actualSize )
+  {
+    m_expected.reserve( expectedSize );
+    for ( size_t index = 0; index < expectedSize; ++index, ++expectedBegin )
+      m_expected.push_back( expectedBegin );
+    m_actual.reserve( actualSize );
+    for ( size_t index = 0; index < actualSize; ++index, ++actualBegin )
+      m_actual.push_back( actualBegin );
+  }
+
+  bool areEqual( int expectedIndex, int actualIndex ) const
+  {
+    return rangeElementsEqual( *m_expected[ expectedIndex ], *m_actual[ actualIndex ] );
+  }
+
+  std::string expectedElement( int index ) const
+  {
+    return rangeElementToString( *m_expected[ index ] );
+  }
+
+  std::string actualElement( int index ) const
+  {
+    return rangeElementToString( *m_actual[ index ] );
+  }
+
+private:
+  CppUnitVector<ExpectedIterator> m_expected;
+  CppUnitVector<ActualIterator> m_actual;
+};
+
+
+template <class ExpectedIterator, class ActualIterator>
+std::string renderRangeDiff( ExpectedIterator expectedBegin,
+                             ActualIterator actualBegin,
+                             const RangeDifference &difference )
+{
+  // The context window already shows a single changed element.
+  if ( difference.m_expectedSize == difference.m_actualSize  &&  
+       difference.m_mismatchCount <= 1 )
+    return "";
+
+  RangeDiffSequences<ExpectedIterator, ActualIterator> sequences( 
+      expectedBegin, difference.m_expectedSize, 
+      actualBegin, difference.m_actualSize );
+  return describeSequenceDifference( sequences, 
+                                     (int)difference.m_expectedSize,
+                                     (int)difference.m_actualSize,
+                                     "element", false );
+}
+
+
+template <class Iterator>
+std::string renderRangeWindow( Iterator begin,
+                               size_t size,
+                               const RangeDifference &difference )
+{
+  std::string window;
+  size_t index = difference.windowBegin();
+  std::advance( begin, index );
+  for ( ; index < difference.windowEnd()  &&  index < size; ++index, ++begin )
+    appendRangeWindowElement( window,
+                              rangeElementToString( *begin ),
+                              index == difference.firstDifference() );
+  return window;
+}
+
+
+template <class ExpectedIterator, class ActualIterator>
+void checkRangesEqual( ExpectedIterator expectedBegin,
+                       ExpectedIterator expectedEnd,
+                       ActualIterator actualBegin,
+                       ActualIterator actualEnd,
+                       const SourceLine &sourceLine,
+                       const std::string &message )
+{
+  RangeDifference difference;
+  ExpectedIterator expected = expectedBegin;
+  ActualIterator actual = actualBegin;
+  size_t index = 0;
+  for ( ; expected != expectedEnd  &&  actual != actualEnd; ++expected, ++actual, ++index )
+  {
+    if ( !rangeElementsEqual( *expected, *actual ) )
+      difference.addMismatch( index );
+  }
+  difference.m_expectedSize = index + (size_t)std::distance( expected, expectedEnd );
+  difference.m_actualSize = index + (size_t)std::distance( actual, actualEnd );
+
+  if ( !difference.isEqual() )
+  {
+    failRangesNotEqual( difference,
+                        renderRangeWindow( expectedBegin, difference.m_expectedSize, difference ),
+                        renderRangeWindow( actualBegin, difference.m_actualSize, difference ),
+                        renderRangeDiff( expectedBegin, actualBegin, difference ),
+                        sourceLine,
+                        message );
+  }
+}
+/// \endcond
+
+
+/*! \brief (Implementation) Asserts that two ranges have equal elements.
+ * Use CPPUNIT_ASSERT_RANGES_EQUAL instead of this function.
+ */
+template <class ExpectedIterator, class ActualIterator>
+void assertRangesEqual( ExpectedIterator expectedBegin,
+                        ExpectedIterator expectedEnd,
+                        ActualIterator actualBegin,
+                        ActualIterator actualEnd,
+                        SourceLine sourceLine,
+                        const std::string &message )
+{
+  Asserter::countAssertion();
+  checkRangesEqual( expectedBegin, expectedEnd,
+                    actualBegin, actualEnd,
+                    sourceLine, message );
+}
+
+
+/*! \brief (Implementation) Asserts that two arrays have equal elements.
+ *
+ * Arrays of types declared by assertion_bitwise_comparable are compared
+ * block by block with memcmp().
+ */
+template <class T>
+void assertRangesEqual( T *expectedBegin,
+                        T *expectedEnd,
+                        T *actualBegin,
+                        T *actualEnd,
+                        SourceLine sourceLine,
+                        const std::string &message )
+{
+  Asserter::countAssertion();
+  if ( !isRangeBitwiseComparable( expectedBegin ) )
+  {
+    checkRangesEqual( expectedBegin, expectedEnd,
+                      actualBegin, actualEnd,
+                      sourceLine, message );
+    return;
+  }
+
+  RangeDifference difference;
+  difference.m_expectedSize = expectedEnd - expectedBegin;
+  difference.m_actualSize = actualEnd - actualBegin;
+  findBitwiseMismatches( expectedBegin, actualBegin,
+                         difference.m_expectedSize < difference.m_actualSize
+                             ? difference.m_expectedSize : difference.m_actualSize,
+                         sizeof(T),
+                         difference );
+
+  if ( !difference.isEqual() )
+  {
+    failRangesNotEqual( difference,
+                        renderRangeWindow( expectedBegin, difference.m_expectedSize, difference ),
+                        renderRangeWindow( actualBegin, difference.m_actualSize, difference ),
+                        renderRangeDiff( expectedBegin, actualBegin, difference ),
+                        sourceLine,
+                        message );
+  }
+}
+
+
+/*! \brief (Implementation) Asserts that two buffers have the same bytes.
+ * Use CPPUNIT_ASSERT_BUFFERS_EQUAL instead of this function.
+ */
+void CPPUNIT_API assertBuffersEqual( const void *expected,
+                                     const void *actual,
+                                     size_t size,
+                                     SourceLine sourceLine,
+                                     const std::string &message );
+
+
+/*! \brief Tolerance of CPPUNIT_ASSERT_ARRAYS_NEAR().
+ *
+ * The error between an expected value \c e and an actual value \c a is
+ * measured in one of the following modes:
+ * - absolute(): \c |e-a|.
+ * - relative(): \c |e-a| / \c max(|e|,|a|), 0 if both are zero.
+ * - ulps(): \c |e-a| in units in the last place of the larger of \c |e|
+ *   and \c |a|, in the precision of the compared arrays. This is the number
+ *   of representable values between \c e and \c a when they have the same
+ *   exponent.
+ *
+ * The values are near if the error is at most the maximum error. By default,
+ * a NaN is never near any value, and an infinity is only near the same
+ * infinity. This can be changed:
+ * \code
+ * CPPUNIT_ASSERT_ARRAYS_NEAR( reference, output, count,
+ *     CPPUNIT_NS::Tolerance::ulps( 4 ).setNanPolicy( 
+ *         CPPUNIT_NS::Tolerance::nanIsNearNan ) );
+ * \endcode
+ */
+class CPPUNIT_API Tolerance
+{
+public:
+  enum Mode
+  {
+    absoluteError = 0,
+    relativeError,
+    ulpError
+  };
+
+  enum NanPolicy
+  {
+    nanIsNeverNear = 0, ///< A NaN is never near any value (default).
+    nanIsNearNan        ///< A NaN is near a NaN.
+  };
+
+  enum InfinityPolicy
+  {
+    infinityIsNearSameInfinity = 0, ///< An infinity is near the same infinity (default).
+    infinityIsNeverNear             ///< An infinity is never near any value.
+  };
+
+  /// Values are near if their difference is at most \a maximumError.
+  static Tolerance absolute( double maximumError );
+
+  /// Values are near if their relative difference is at most \a maximumError.
+  static Tolerance relative( double maximumError );
+
+  /// Values are near if they are at most \a maximumUlps units in the last place apart.
+  static Tolerance ulps( double maximumUlps );
+
+  Tolerance &setNanPolicy( NanPolicy policy );
+
+  Tolerance &setInfinityPolicy( InfinityPolicy policy );
+
+  Mode mode() const;
+
+  double maximumError() const;
+
+  NanPolicy nanPolicy() const;
+
+  InfinityPolicy infinityPolicy() const;
+
+  /// Returns a description of the tolerance, such as "relative 1e-06".
+  std::string toString() const;
+
+private:
+  Tolerance( Mode mode, 
+             double maximumError );
+
+private:
+  Mode m_mode;
+  double m_maximumError;
+  NanPolicy m_nanPolicy;
+  InfinityPolicy m_infinityPolicy;
+};
+
+
+/*! \brief (Implementation) Asserts that the values of two arrays are near.
+ * Use CPPUNIT_ASSERT_ARRAYS_NEAR instead of this function.
+ */
+void CPPUNIT_API assertArraysNear( const double *expected,
+                                   const double *actual,
+                                   size_t count,
+                                   const Tolerance &tolerance,
+                                   SourceLine sourceLine,
+                                   const std::string &message );
+
+
+/*! \brief (Implementation) Asserts that the values of two arrays are near.
+ * Use CPPUNIT_ASSERT_ARRAYS_NEAR instead of this function.
+ */
+void CPPUNIT_API assertArraysNear( const float *expected,
+                                   const float *actual,
+                                   size_t count,
+                                   const Tolerance &tolerance,
+                                   SourceLine sourceLine,
+                                   const std::string &message );
+
+
+/** Asserts that two ranges have the same size and equal elements.
+ * \ingroup Assertions
+ *
+ * The ranges are given by forward iterators, or by pointers. The elements
+ * are compared with assertion_traits::equal(), or with memcmp() for arrays
+ * of types declared by assertion_bitwise_comparable, such as the integral
+ * types.
+ *
+ * On failure, the diagnostic gives the sizes of the ranges, the number of
+ * mismatches and the index of the first one, and the elements around it,
+ * converted with assertion_traits::toString():
+ * \code
+ * ranges not equal
+ * - Expected size: 1000000
+ * - Actual size  : 1000000
+ * - Mismatches   : 2, first at index 500000
+ * - Expected [499996..500004]: 4, 5, 6, 7, [8], 9, 10, 11, 12
+ * - Actual   [499996..500004]: 4, 5, 6, 7, [0], 9, 10, 11, 12
+ * \endcode
+ *
+ * Example of usage:
+ * \code
+ *   std::vector<short> decoded = decode( stream );
+ *   CPPUNIT_ASSERT_RANGES_EQUAL( reference, reference + sampleCount,
+ *                                &decoded[0], &decoded[0] + decoded.size() );
+ * \endcode
+ */
+#define CPPUNIT_ASSERT_RANGES_EQUAL( expectedBegin, expectedEnd,   \
+                                     actualBegin, actualEnd )      \
+  ( CPPUNIT_NS::assertRangesEqual( (expectedBegin), (expectedEnd), \
+                                   (actualBegin), (actualEnd),     \
+                                   CPPUNIT_SOURCELINE(),           \
+                                   "" ) )
+
+/** Asserts that two ranges have the same size and equal elements, provides
+ * additional message on failure.
+ * \ingroup Assertions
+ * \sa CPPUNIT_ASSERT_RANGES_EQUAL.
+ */
+#define CPPUNIT_ASSERT_RANGES_EQUAL_MESSAGE( message,                     \
+                                             expectedBegin, expectedEnd,  \
+                                             actualBegin, actualEnd )     \
+  ( CPPUNIT_NS::assertRangesEqual( (expectedBegin), (expectedEnd),        \
+                                   (actualBegin), (actualEnd),            \
+                                   CPPUNIT_SOURCELINE(),                  \
+                                   (message) ) )
+
+/** Asserts that two buffers have the same bytes.
+ * \ingroup Assertions
+ *
+ * The buffers are compared with memcmp(). On failure, the diagnostic gives
+ * the number of bytes that differ, the offset of the first one, and the
+ * bytes around it in hexadecimal.
+ *
+ * \param expected Address of the expected bytes.
+ * \param actual Address of the actual bytes.
+ * \param size Number of bytes to compare.
+ */
+#define CPPUNIT_ASSERT_BUFFERS_EQUAL( expected, actual, size )  \
+  ( CPPUNIT_NS::assertBuffersEqual( (expected), (actual),       \
+                                    (size),                     \
+                                    CPPUNIT_SOURCELINE(),       \
+                                    "" ) )
+
+/** Asserts that two buffers have the same bytes, provides additional message
+ * on failure.
+ * \ingroup Assertions
+ * \sa CPPUNIT_ASSERT_BUFFERS_EQUAL.
+ */
+#define CPPUNIT_ASSERT_BUFFERS_EQUAL_MESSAGE( message, expected, actual, size )  \
+  ( CPPUNIT_NS::assertBuffersEqual( (expected), (actual),                        \
+                                    (size),                                      \
+                                    CPPUNIT_SOURCELINE(),                        \
+                                    (message) ) )
+
+/** Asserts that the values of two arrays of float or double are near.
+ * \ingroup Assertions
+ *
+ * Every element is checked, in a single pass suited to large arrays. On
+ * failure, the diagnostic gives the number of values out of tolerance and
+ * the first one, the maximum error and its index, and a histogram of the
+ * errors out of tolerance, as multiples of the maximum error:
+ * \code
+ * arrays not near
+ * - Tolerance       : relative 1e-06
+ * - Out of tolerance: 3 of 1048576, first at index 1024 (expected 0.5, actual 0.5000021)
+ * - Maximum error   : 0.25 at index 70000 (expected 1, actual 1.25)
+ * - Error histogram : 1-2x: 1, 2-10x: 1, 10-100x: 0, 100-1000x: 0, >1000x: 1, not finite: 0
+ * \endcode
+ *
+ * \param expected Address of the expected values.
+ * \param actual Address of the actual values, of the same type.
+ * \param count Number of values to compare.
+ * \param tolerance Tolerance of the comparison, see Tolerance.
+ */
+#define CPPUNIT_ASSERT_ARRAYS_NEAR( expected, actual, count, tolerance )  \
+  ( CPPUNIT_NS::assertArraysNear( (expected), (actual),                   \
+                                  (count), (tolerance),                   \
+                                  CPPUNIT_SOURCELINE(),                   \
+                                  "" ) )
+
+/** Asserts that the values of two arrays of float or double are near,
+ * provides additional message on failure.
+ * \ingroup Assertions
+ * \sa CPPUNIT_ASSERT_ARRAYS_NEAR.
+ */
+#define CPPUNIT_ASSERT_ARRAYS_NEAR_MESSAGE( message, expected, actual,    \
+                                            count, tolerance )            \
+  ( CPPUNIT_NS::assertArraysNear( (expected), (actual),                   \
+                                  (count), (tolerance),                   \
+                                  CPPUNIT_SOURCELINE(),                   \
+                                  (message) ) )
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_RANGEASSERT_H
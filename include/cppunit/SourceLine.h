@@ -42,6 +42,14 @@ public:
   SourceLine( const std::string &fileName,
               int lineNumber );
 
+  /*! \brief Constructs the location expanded by CPPUNIT_SOURCELINE().
+   *
+   * The allocation made to copy the file name is not counted by
+   * AllocationScope, so that a passing assertion does not allocate.
+   */
+  SourceLine( const char *fileName,
+              int lineNumber );
+
   SourceLine &operator =( const SourceLine &other );
 
   /// Destructor.
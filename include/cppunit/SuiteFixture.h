@@ -0,0 +1,90 @@
+#ifndef CPPUNIT_SUITEFIXTURE_H
+#define CPPUNIT_SUITEFIXTURE_H
+
+#include <cppunit/Mutex.h>
+
+CPPUNIT_NS_BEGIN
+
+
+class Test;
+class TestResult;
+
+
+/*! \brief Resources set up once and shared by all the tests of a suite.
+ * \ingroup WritingTestFixture
+ *
+ * The set up function is called before the first test of the suite is run,
+ * and the tear down function after the last one. Both are called through
+ * TestResult::protect(), so an exception is reported as a failure of the
+ * suite. If the set up fails, the tests of the suite are not run, and the
+ * tear down function is not called.
+ *
+ * A suite fixture is usually a static object shared by all the instances of
+ * a fixture suite, see CPPUNIT_TEST_SUITE_SETUP(). Initialization is exactly
+ * once per run, even if the suite is run concurrently by several threads: the
+ * first thread calls the set up function while the others wait for it to
+ * complete. The tear down function is called when the last concurrent run of
+ * the suite ends. Runs that do not overlap, such as two calls to
+ * TestRunner::run(), each set up and tear down the resources again. The
+ * tests must only read the shared resources.
+ *
+ * \see TestSuite::setSuiteFixture(), Test::getSuiteFixture().
+ */
+class CPPUNIT_API SuiteFixture
+{
+public:
+  typedef void (*Function)();
+
+  /*! Constructs a fixture without set up and tear down function.
+   */
+  SuiteFixture();
+
+  /// Destructor.
+  virtual ~SuiteFixture();
+
+  /*! \brief Sets the function that sets up the shared resources.
+   *
+   * Should only be called while building the suite, before running it.
+   */
+  void setSetUpFunction( Function setUp );
+
+  /*! \brief Sets the function that releases the shared resources.
+   *
+   * Should only be called while building the suite, before running it.
+   */
+  void setTearDownFunction( Function tearDown );
+
+  /*! \brief Sets up the shared resources if they are not already set up.
+   * \param result Result to which a failure is reported.
+   * \param suite Suite that is starting. Failures are reported for this test.
+   * \return \c true if the resources are set up, \c false if the set up
+   *         failed and the tests of the suite must not be run. tearDown()
+   *         must only be called if \c true is returned.
+   */
+  bool setUp( TestResult *result, Test *suite );
+
+  /*! \brief Releases the shared resources if this is the last run of the suite.
+   * \param result Result to which a failure is reported.
+   * \param suite Suite that is ending. Failures are reported for this test.
+   */
+  void tearDown( TestResult *result, Test *suite );
+
+private:
+  /// Prevents the use of the copy constructor.
+  SuiteFixture( const SuiteFixture &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const SuiteFixture &copy );
+
+private:
+  Function m_setUp;
+  Function m_tearDown;
+  Mutex m_mutex;
+  int m_runCount;
+};
+
+
+CPPUNIT_NS_END
+
+
+#endif  // CPPUNIT_SUITEFIXTURE_H
@@ -9,6 +9,14 @@ CPPUNIT_NS_BEGIN
 
 class TestResult;
 class TestPath;
+class SuiteFixture;
+
+
+/*! \brief Stable numeric identifier of a Test.
+ * \see Test::getId().
+ */
+typedef unsigned int TestId;
+
 
 /*! \brief Base class for all test objects.
  * \ingroup BrowsingCollectedTestResult
@@ -25,7 +33,11 @@ class TestPath;
 class CPPUNIT_API Test
 {
 public:
-  virtual ~Test() {};
+  /*! \brief Constructs a test and assigns it a new identifier.
+   */
+  Test();
+
+  virtual ~Test();
 
   /*! \brief Run the test, collecting results.
    */
@@ -63,6 +75,31 @@ public:
    */
   virtual std::string getName () const =0;
 
+  /*! \brief Returns a reference on the test name.
+   *
+   * Unlike getName(), the name is not copied: listeners and outputters that
+   * only need to read the name should use this method.
+   *
+   * The default implementation calls getName() once and interns the result
+   * in a process wide name pool, from which it is removed once no test of
+   * that name exists. Subclasses that store their name should override this
+   * method to return it directly.
+   *
+   * \return Reference on the test name. It remains valid as long as the test
+   *         exists.
+   */
+  virtual const std::string &getNameRef() const;
+
+  /*! \brief Returns the identifier of the test.
+   *
+   * Each test is assigned a distinct non-zero identifier on construction. The
+   * identifier does not change during the life of the test, and can be used
+   * as a cheap key to associate data with a test (see TestIndex).
+   *
+   * \return Identifier of the test. Never 0.
+   */
+  TestId getId() const;
+
   /*! \brief Finds the test with the specified name and its parents test.
    * \param testName Name of the test to find.
    * \param testPath If the test is found, then all the tests traversed to access
@@ -96,7 +133,52 @@ public:
    */
   virtual TestPath resolveTestPath( const std::string &testPath ) const;
 
+  /*! \brief Tests if running this test is equivalent to running its children.
+   *
+   * A test that returns \c true promises that run() only calls 
+   * TestResult::startSuite(), then run() on each of its children in order
+   * (stopping if TestResult::shouldStop() returns \c true), and finally
+   * TestResult::endSuite(). TestPlan relies on this to execute the children
+   * directly instead of calling run().
+   *
+   * Subclasses that customize run() must return \c false.
+   *
+   * The only exception is the suite fixture returned by getSuiteFixture():
+   * it is set up after TestResult::startSuite() and torn down before
+   * TestResult::endSuite(). If the set up fails, the children are not run.
+   *
+   * \return \c false.
+   * \see TestPlan.
+   */
+  virtual bool canBeFlattened() const;
+
+  /*! \brief Returns the resources shared by the children of this test.
+   *
+   * Only used if canBeFlattened() returns \c true.
+   *
+   * \return Suite fixture set up before running the children, \c NULL if
+   *         there is none. Default implementation returns \c NULL.
+   * \see SuiteFixture.
+   */
+  virtual SuiteFixture *getSuiteFixture() const;
+
+  /*! \brief Returns the peak memory allowed to each test run by this test.
+   *
+   * Used by TestResult::startSuite() to find the budget of the tests of a
+   * suite, see TestResult::peakMemoryBudget().
+   *
+   * \return Peak memory in kilobytes, 0 if there is no budget. Default
+   *         implementation returns 0.
+   */
+  virtual long getPeakMemoryBudget() const;
+
 protected:
+  /*! \brief Copy constructor.
+   *
+   * The copy is assigned a new identifier.
+   */
+  Test( const Test &other );
+
   /*! Throws an exception if the specified index is invalid.
    * \param index Zero base index of a child test.
    * \exception std::out_of_range is \a index is < 0 or >= getChildTestCount().
@@ -108,6 +190,14 @@ protected:
    * \return Pointer on the test. Never \c NULL.
    */
   virtual Test *doGetChildTestAt( int index ) const =0;
+
+private:
+  /// Prevents the use of the copy operator.
+  Test &operator =( const Test &other );
+
+private:
+  TestId m_id;
+  const std::string *m_internedName;
 };
 
 
@@ -0,0 +1,207 @@
+#ifndef CPPUNIT_TESTARENA_H
+#define CPPUNIT_TESTARENA_H
+
+#include <cppunit/Portability.h>
+#include <stddef.h>
+
+CPPUNIT_NS_BEGIN
+
+
+class TestArenaPool;
+
+
+/*! \brief Arena in which the tests of a tree are allocated.
+ * \ingroup CreatingTestSuite
+ *
+ * Building a large test tree allocates each TestSuite, TestCaller and
+ * decorator separately, which scatters them across the heap. While a
+ * TestArena::Scope is active on a thread, the tests created by that thread
+ * with CPPUNIT_TEST_NEW() are instead allocated contiguously in large chunks
+ * owned by the arena. The helper macros, such as CPPUNIT_TEST(), create their
+ * tests that way:
+ *
+ * \code
+ * CppUnit::TestArena arena;
+ * CppUnit::Test *test;
+ * {
+ *   CppUnit::TestArena::Scope scope( arena );
+ *   test = CppUnit::TestFactoryRegistry::getRegistry().makeTest();
+ * }
+ * \endcode
+ *
+ * Deleting a test allocated in an arena runs its destructor, but does not
+ * free its memory. The chunks are freed at once when both the arena has
+ * been destroyed and all its tests have been deleted, so the arena and the
+ * tree can be destroyed in any order. A tree that is never deleted (for
+ * example when a test runner exits without destroying it) is simply
+ * released with the process.
+ *
+ * Only the Test objects are allocated in the arena. The fixtures, names and
+ * containers they own still use the heap, as do the tests created with a
+ * plain \c new.
+ *
+ * Several threads may create tests in the same arena, and the tests may be
+ * deleted by any thread.
+ */
+class CPPUNIT_API TestArena
+{
+public:
+  /*! \brief Constructs an empty arena.
+   * \param chunkSize Size in bytes of the chunks allocated by the arena.
+   *                  Larger tests are allocated in a chunk of their own.
+   */
+  TestArena( size_t chunkSize = 64 * 1024 );
+
+  /*! \brief Destructor.
+   *
+   * The memory of the tests still alive is freed when the last one is
+   * deleted.
+   */
+  virtual ~TestArena();
+
+  /*! \brief Returns the number of tests allocated in the arena and not
+   *         deleted yet.
+   */
+  int getTestCount() const;
+
+  /*! \brief Returns the number of bytes allocated from the heap by the arena.
+   */
+  size_t getAllocatedSize() const;
+
+  /*! \brief Activates an arena in the current scope of the calling thread.
+   *
+   * The tests created with CPPUNIT_TEST_NEW() while the scope is alive are
+   * allocated in the arena. Scopes can be nested: the previous arena (or the
+   * heap) is restored on destruction.
+   */
+  class CPPUNIT_API Scope
+  {
+  public:
+    Scope( TestArena &arena );
+
+    ~Scope();
+
+  private:
+    Scope( const Scope &copy );
+    void operator =( const Scope &copy );
+
+  private:
+    TestArenaPool *m_previousPool;
+  };
+
+  /*! \brief Indicates if a scope is active on the calling thread.
+   */
+  static bool isActive();
+
+  /*! \brief Allocates memory for a test (Implementation).
+   *
+   * The memory comes from the arena of the active scope, or from the heap if
+   * there is none.
+   * \see ArenaTest.
+   */
+  static void *allocate( size_t size );
+
+  /*! \brief Releases memory returned by allocate() (Implementation).
+   * \see ArenaTest.
+   */
+  static void deallocate( void *memory );
+
+private:
+  /// Prevents the use of the copy constructor.
+  TestArena( const TestArena &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestArena &copy );
+
+private:
+  TestArenaPool *m_pool;
+};
+
+
+/*! \brief Operators \c new and \c delete of ArenaTest (Implementation).
+ */
+class CPPUNIT_API ArenaTestAllocation
+{
+public:
+  /// Calls TestArena::allocate().
+  static void *operator new( size_t size );
+
+  /// Calls TestArena::deallocate().
+  static void operator delete( void *memory );
+};
+
+
+/*! \brief Test allocated with TestArena::allocate() (Implementation).
+ *
+ * The operators \c new and \c delete of the test are replaced, so that
+ * deleting the test through a pointer on any of its bases releases the
+ * memory to its arena. Only the constructors of up to four arguments are
+ * forwarded to \a TestType.
+ * \see CPPUNIT_TEST_NEW().
+ */
+template <class TestType>
+class ArenaTest : public TestType
+                , public ArenaTestAllocation
+{
+public:
+  using ArenaTestAllocation::operator new;
+  using ArenaTestAllocation::operator delete;
+
+  ArenaTest()
+  {
+  }
+
+  template <class Argument1>
+  ArenaTest( const Argument1 &argument1 )
+      : TestType( argument1 )
+  {
+  }
+
+  template <class Argument1, class Argument2>
+  ArenaTest( const Argument1 &argument1,
+             const Argument2 &argument2 )
+      : TestType( argument1, argument2 )
+  {
+  }
+
+  template <class Argument1, class Argument2, class Argument3>
+  ArenaTest( const Argument1 &argument1,
+             const Argument2 &argument2,
+             const Argument3 &argument3 )
+      : TestType( argument1, argument2, argument3 )
+  {
+  }
+
+  template <class Argument1, class Argument2, class Argument3, class Argument4>
+  ArenaTest( const Argument1 &argument1,
+             const Argument2 &argument2,
+             const Argument3 &argument3,
+             const Argument4 &argument4 )
+      : TestType( argument1, argument2, argument3, argument4 )
+  {
+  }
+};
+
+
+CPPUNIT_NS_END
+
+
+/*! \brief Creates a test in the arena of the active TestArena::Scope, or on
+ *         the heap if there is none.
+ * \ingroup CreatingTestSuite
+ *
+ * \code
+ * suite->addTest( CPPUNIT_TEST_NEW( CppUnit::TestSuite, ( "Math" ) ) );
+ * \endcode
+ * \param TestType Type of the test to create.
+ * \param constructorArguments Arguments of the constructor of \a TestType,
+ *                             in parentheses.
+ * \return Pointer on the new test, of type \a TestType*.
+ */
+#define CPPUNIT_TEST_NEW( TestType, constructorArguments )                    \
+  ( CPPUNIT_NS::TestArena::isActive()                                         \
+        ? new CPPUNIT_NS::ArenaTest< TestType > constructorArguments           \
+        : new TestType constructorArguments )
+
+
+#endif  // CPPUNIT_TESTARENA_H
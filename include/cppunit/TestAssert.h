@@ -2,9 +2,12 @@
 #define CPPUNIT_TESTASSERT_H
 
 #include <cppunit/Portability.h>
+#include <cppunit/AllocationScope.h>
 #include <cppunit/Exception.h>
 #include <cppunit/Asserter.h>
+#include <cppunit/ExpectationCollector.h>
 #include <cppunit/portability/Stream.h>
+#include <cppunit/tools/BoundedText.h>
 #include <stdio.h>
 #include <float.h> // For struct assertion_traits<double>
 
@@ -12,6 +15,44 @@
 CPPUNIT_NS_BEGIN
 
 
+/*! \brief (Implementation) Renders a value serialized by operator <<.
+ *
+ * The value is streamed into a BoundedText, so that only the head and the
+ * tail of a long value are kept.
+ * \sa BoundedText::setMaximumLength().
+ */
+template <class T>
+std::string renderValue( const T &value )
+{
+  BoundedText text;
+  BoundedTextStreamBuffer buffer( text );
+  OStream stream( &buffer );
+  stream << value;
+  return text.str();
+}
+
+/*! \brief (Implementation) Renders an integer without using a stream.
+ * \sa renderValue().
+ */
+std::string CPPUNIT_API renderValue( int value );
+
+/// \copydoc renderValue(int)
+std::string CPPUNIT_API renderValue( unsigned int value );
+
+/// \copydoc renderValue(int)
+std::string CPPUNIT_API renderValue( long value );
+
+/// \copydoc renderValue(int)
+std::string CPPUNIT_API renderValue( unsigned long value );
+
+/*! \brief (Implementation) Renders a float without using a stream.
+ *
+ * Same as the default formatting of a stream: 6 significant digits.
+ * \sa renderValue().
+ */
+std::string CPPUNIT_API renderValue( float value );
+
+
 /*! \brief Traits used by CPPUNIT_ASSERT_EQUAL().
  *
  * Here is an example of specialising these traits: 
@@ -34,6 +75,9 @@ CPPUNIT_NS_BEGIN
  *   }
  * };
  * \endcode
+ *
+ * The default toString() renders the value with operator <<, eliding the
+ * middle of the values longer than BoundedText::maximumLength().
  */
 template <class T>
 struct assertion_traits 
@@ -45,9 +89,7 @@ struct assertion_traits
 
     static std::string toString( const T& x )
     {
-        OStringStream ost;
-        ost << x;
-        return ost.str();
+        return renderValue( x );
     }
 };
 
@@ -96,8 +138,10 @@ void assertEquals( const T& expected,
                    SourceLine sourceLine,
                    const std::string &message )
 {
+  Asserter::countAssertion();
   if ( !assertion_traits<T>::equal(expected,actual) ) // lazy toString conversion...
   {
+    AllocationCountingPause pause;
     Asserter::failNotEqual( assertion_traits<T>::toString(expected),
                             assertion_traits<T>::toString(actual),
                             sourceLine,
@@ -106,6 +150,19 @@ void assertEquals( const T& expected,
 }
 
 
+/*! \brief (Implementation) Asserts that two strings are equals.
+ * Use CPPUNIT_ASSERT_EQUAL instead of this function.
+ *
+ * If the strings span several lines or are longer than CPPUNIT_WRAP_COLUMN,
+ * a diff of the strings is added to the message of the failure.
+ * \sa describeStringDifference().
+ */
+void CPPUNIT_API assertEquals( const std::string &expected,
+                               const std::string &actual,
+                               SourceLine sourceLine,
+                               const std::string &message );
+
+
 /*! \brief (Implementation) Asserts that two double are equals given a tolerance.
  * Use CPPUNIT_ASSERT_DOUBLES_EQUAL instead of this function.
  * \sa Asserter::failNotEqual().
@@ -118,6 +175,59 @@ void CPPUNIT_API assertDoubleEquals( double expected,
                                      const std::string &message );
 
 
+/*! \brief (Implementation) Checks that two objects of the same type are
+ *         equals, recording the failure instead of throwing it.
+ * Use CPPUNIT_EXPECT_EQUAL instead of this function.
+ * \sa ExpectationCollector.
+ */
+template <class T>
+void expectEquals( const T& expected,
+                   const T& actual,
+                   const SourceLine &sourceLine,
+                   const std::string &message )
+{
+  Asserter::countAssertion();
+  if ( !assertion_traits<T>::equal(expected,actual) )
+  {
+    ExpectationScope scope;
+    AllocationCountingPause pause;
+    Asserter::failNotEqual( assertion_traits<T>::toString(expected),
+                            assertion_traits<T>::toString(actual),
+                            sourceLine,
+                            message );
+  }
+}
+
+
+/*! \brief (Implementation) Checks that two strings are equals, recording the
+ *         failure instead of throwing it.
+ * Use CPPUNIT_EXPECT_EQUAL instead of this function.
+ */
+void CPPUNIT_API expectEquals( const std::string &expected,
+                               const std::string &actual,
+                               const SourceLine &sourceLine,
+                               const std::string &message );
+
+
+/*! \brief (Implementation) Checks that two double are equals given a
+ *         tolerance, recording the failure instead of throwing it.
+ * Use CPPUNIT_EXPECT_DOUBLES_EQUAL instead of this function.
+ */
+void CPPUNIT_API expectDoubleEquals( double expected,
+                                     double actual,
+                                     double delta,
+                                     const SourceLine &sourceLine,
+                                     const std::string &message );
+
+
+/*! \brief (Implementation) Records a failure if an expectation is not met.
+ * Use CPPUNIT_EXPECT instead of this function.
+ */
+void CPPUNIT_API expectIf( bool isMet,
+                           const Message &message,
+                           const SourceLine &sourceLine );
+
+
 /* A set of macros which allow us to get the line number
  * and file name at the point of an error.
  * Just goes to show that preprocessors do have some
@@ -285,6 +395,7 @@ void CPPUNIT_API assertDoubleEquals( double expected,
  */
 # define CPPUNIT_ASSERT_THROW_MESSAGE( message, expression, ExceptionType )   \
    do {                                                                       \
+      CPPUNIT_NS::Asserter::countAssertion();                                 \
       bool cpputCorrectExceptionThrown_ = false;                              \
       CPPUNIT_NS::Message cpputMsg_( "expected exception not thrown" );       \
       cpputMsg_.addDetail( message );                                         \
@@ -338,6 +449,7 @@ void CPPUNIT_API assertDoubleEquals( double expected,
  */
 # define CPPUNIT_ASSERT_NO_THROW_MESSAGE( message, expression )               \
    do {                                                                       \
+      CPPUNIT_NS::Asserter::countAssertion();                                 \
       CPPUNIT_NS::Message cpputMsg_( "unexpected exception caught" );         \
       cpputMsg_.addDetail( message );                                         \
                                                                               \
@@ -408,6 +520,85 @@ void CPPUNIT_API assertDoubleEquals( double expected,
    CPPUNIT_ASSERT_NO_THROW_MESSAGE( message, assertion )
 
 
+/** Expects that a condition is \c true.
+ * \ingroup Assertions
+ *
+ * Unlike CPPUNIT_ASSERT(), the test goes on if the condition is \c false:
+ * the failure is recorded by the ExpectationCollector of the test and
+ * reported once runTest() returns.
+ * \sa ExpectationCollector.
+ */
+#if CPPUNIT_HAVE_CPP_SOURCE_ANNOTATION
+#define CPPUNIT_EXPECT(condition)                                              \
+  ( CPPUNIT_NS::expectIf( (condition),                                         \
+                          CPPUNIT_NS::Message( "expectation failed",           \
+                                               "Expression: " #condition ),    \
+                          CPPUNIT_SOURCELINE() ) )
+#else
+#define CPPUNIT_EXPECT(condition)                                              \
+  ( CPPUNIT_NS::expectIf( (condition),                                         \
+                          CPPUNIT_NS::Message( "expectation failed" ),         \
+                          CPPUNIT_SOURCELINE() ) )
+#endif
+
+/** Expects that a condition is \c true, with a user specified message.
+ * \ingroup Assertions
+ * \sa CPPUNIT_EXPECT, CPPUNIT_ASSERT_MESSAGE.
+ */
+#define CPPUNIT_EXPECT_MESSAGE(message,condition)                          \
+  ( CPPUNIT_NS::expectIf( (condition),                                     \
+                          CPPUNIT_NS::Message( "expectation failed",       \
+                                               "Expression: "              \
+                                               #condition,                 \
+                                               message ),                  \
+                          CPPUNIT_SOURCELINE() ) )
+
+/** Expects that two values are equals.
+ * \ingroup Assertions
+ *
+ * Same as CPPUNIT_ASSERT_EQUAL(), but the test goes on if the values differ.
+ * \sa CPPUNIT_EXPECT.
+ */
+#define CPPUNIT_EXPECT_EQUAL(expected,actual)          \
+  ( CPPUNIT_NS::expectEquals( (expected),              \
+                              (actual),                \
+                              CPPUNIT_SOURCELINE(),    \
+                              "" ) )
+
+/** Expects that two values are equals, with a user specified message.
+ * \ingroup Assertions
+ * \sa CPPUNIT_EXPECT_EQUAL.
+ */
+#define CPPUNIT_EXPECT_EQUAL_MESSAGE(message,expected,actual)      \
+  ( CPPUNIT_NS::expectEquals( (expected),              \
+                              (actual),                \
+                              CPPUNIT_SOURCELINE(),    \
+                              (message) ) )
+
+/** Expects that two doubles are equals given a tolerance.
+ * \ingroup Assertions
+ * \sa CPPUNIT_ASSERT_DOUBLES_EQUAL, CPPUNIT_EXPECT.
+ */
+#define CPPUNIT_EXPECT_DOUBLES_EQUAL(expected,actual,delta)        \
+  ( CPPUNIT_NS::expectDoubleEquals( (expected),            \
+                                    (actual),              \
+                                    (delta),               \
+                                    CPPUNIT_SOURCELINE(),  \
+                                    "" ) )
+
+/** Expects that two doubles are equals given a tolerance, with a user
+ * specified message.
+ * \ingroup Assertions
+ * \sa CPPUNIT_EXPECT_DOUBLES_EQUAL.
+ */
+#define CPPUNIT_EXPECT_DOUBLES_EQUAL_MESSAGE(message,expected,actual,delta)  \
+  ( CPPUNIT_NS::expectDoubleEquals( (expected),            \
+                                    (actual),              \
+                                    (delta),               \
+                                    CPPUNIT_SOURCELINE(),  \
+                                    (message) ) )
+
+
 
 
 // Backwards compatibility
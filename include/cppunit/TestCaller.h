@@ -153,6 +153,27 @@ public:
 	    m_test( test )
   {
   }
+
+  /*!
+   * Constructor for TestCaller used by CPPUNIT_TEST(). 
+   * The name of the TestCaller is built by the namer, see
+   * TestCase::TestCase(const TestNamer &,const char *). The TestCaller will
+   * own the Fixture object and delete it in its destructor.
+   * \param namer namer of the fixture suite.
+   * \param testMethodName name of the test method.
+   * \param test the method this TestCaller calls in runTest()
+   * \param fixture the Fixture to invoke the test method on.
+   */
+  TestCaller(const TestNamer &namer, 
+             const char *testMethodName, 
+             TestMethod test, 
+             Fixture* fixture) :
+	    TestCase( namer, testMethodName ), 
+	    m_ownFixture( true ),
+	    m_fixture( fixture ),
+	    m_test( test )
+  {
+  }
     
   ~TestCaller() 
   {
@@ -15,6 +15,7 @@
 CPPUNIT_NS_BEGIN
 
 
+class TestNamer;
 class TestResult;
 
 
@@ -35,6 +36,16 @@ public:
 
     TestCase( const std::string &name );
 
+    /*! \brief Constructs a test case named by the namer of its fixture.
+     *
+     * The name is namer.getTestNameFor( testMethodName ). Neither the namer
+     * nor the method name are kept.
+     * \param namer Namer of the fixture.
+     * \param testMethodName Name of the test method.
+     */
+    TestCase( const TestNamer &namer, 
+              const char *testMethodName );
+
     TestCase();
 
     ~TestCase();
@@ -43,6 +54,8 @@ public:
 
     std::string getName() const;
 
+    const std::string &getNameRef() const;
+
     //! FIXME: this should probably be pure virtual.
     virtual void runTest();
     
@@ -29,9 +29,11 @@ public:
   void run( TestResult *result );
 
   int countTestCases() const;
-  
+
   std::string getName() const;
 
+  const std::string &getNameRef() const;
+
 private:
   TestComposite( const TestComposite &other );
   TestComposite &operator =( const TestComposite &other ); 
@@ -0,0 +1,140 @@
+#ifndef CPPUNIT_TESTFILTER_H
+#define CPPUNIT_TESTFILTER_H
+
+#include <cppunit/Portability.h>
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( push )
+#pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
+#endif
+
+#include <cppunit/portability/CppUnitSet.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+
+
+class TestFilterPattern;
+
+
+/*! \brief Selects tests by matching their path against include and exclude patterns.
+ * \ingroup ExecutingTest
+ *
+ * Patterns are matched against the path of a test as returned by
+ * TestPath::toString(), for example "/All Tests/NetworkTest/NetworkTest::testTimeout".
+ * Each pattern is compiled once when it is added. Two kinds of pattern are
+ * supported:
+ *
+ * - glob patterns: \c * matches any sequence of characters except '/',
+ *   \c ** matches any sequence of characters including '/', and \c ? matches
+ *   any character except '/'. A pattern starting with '/' must match the whole
+ *   path. Any other pattern must match the trailing components of the path,
+ *   so "Network*::*Timeout*" matches the test above, and "NetworkTest"
+ *   matches the suite "/All Tests/NetworkTest".
+ * - regular expressions, prefixed by "regex:". The POSIX extended regular
+ *   expression is searched anywhere in the path. Regular expressions are only
+ *   available if the platform provides \<regex.h\>.
+ *
+ * A test is selected if neither its path nor the path of one of its parent
+ * suites match an exclude pattern, and if there is no include pattern or one
+ * of the include patterns matches its path or the path of one of its parent
+ * suites.
+ *
+ * \see TestPlan, TestRunner.
+ */
+class CPPUNIT_API TestFilter
+{
+public:
+  /*! \brief Constructs a filter that selects all tests.
+   */
+  TestFilter();
+
+  /// Destructor.
+  virtual ~TestFilter();
+
+  /*! \brief Adds a pattern selecting tests to run.
+   * \param pattern Glob pattern, or regular expression prefixed by "regex:".
+   * \exception std::invalid_argument if \a pattern is not a valid pattern.
+   */
+  void addInclude( const std::string &pattern );
+
+  /*! \brief Adds the path of a test to run.
+   *
+   * Unlike a pattern, \a testPath is matched literally: '*' and '?' have no
+   * special meaning. Used to select a list of known tests.
+   *
+   * \param testPath Path of the test, as returned by TestPath::toString().
+   */
+  void addIncludePath( const std::string &testPath );
+
+  /*! \brief Adds a pattern selecting tests not to run.
+   * \param pattern Glob pattern, or regular expression prefixed by "regex:".
+   * \exception std::invalid_argument if \a pattern is not a valid pattern.
+   */
+  void addExclude( const std::string &pattern );
+
+  /*! \brief Indicates if the filter selects all tests.
+   * \return \c true if no pattern was added, \c false otherwise.
+   */
+  bool isEmpty() const;
+
+  /*! \brief Indicates if a test path matches one of the include patterns.
+   * \param testPath Path of the test, as returned by TestPath::toString().
+   * \return \c true if \a testPath matches an include pattern or path, or if
+   *         there is neither include pattern nor include path, \c false
+   *         otherwise.
+   */
+  bool isIncluded( const std::string &testPath ) const;
+
+  /*! \brief Indicates if a test path matches one of the exclude patterns.
+   * \param testPath Path of the test, as returned by TestPath::toString().
+   * \return \c true if \a testPath matches an exclude pattern, \c false otherwise.
+   */
+  bool isExcluded( const std::string &testPath ) const;
+
+  /*! \brief Indicates if a test below the specified suite may be included.
+   *
+   * Used to skip a suite which does not match any include pattern without
+   * visiting its children. The result is conservative: \c true is returned
+   * when it can not be decided from the suite path alone.
+   *
+   * \param suitePath Path of the suite, as returned by TestPath::toString().
+   * \return \c false if no test below \a suitePath can match an include
+   *         pattern, \c true otherwise.
+   */
+  bool mayIncludeBelow( const std::string &suitePath ) const;
+
+private:
+  typedef CppUnitVector<TestFilterPattern *> Patterns;
+
+  static void addPattern( Patterns &patterns,
+                          const std::string &pattern );
+
+  static bool matchesAny( const Patterns &patterns,
+                          const std::string &testPath );
+
+  static void deletePatterns( Patterns &patterns );
+
+  /// Prevents the use of the copy constructor.
+  TestFilter( const TestFilter &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestFilter &copy );
+
+private:
+  Patterns m_includes;
+  Patterns m_excludes;
+
+  typedef CppUnitSet<std::string, std::less<std::string> > TestPaths;
+  TestPaths m_includePaths;
+};
+
+
+CPPUNIT_NS_END
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( pop )
+#endif
+
+#endif // CPPUNIT_TESTFILTER_H
@@ -0,0 +1,153 @@
+#ifndef CPPUNIT_TESTINDEX_H
+#define CPPUNIT_TESTINDEX_H
+
+#include <cppunit/Portability.h>
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( push )
+#pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
+#endif
+
+#include <cppunit/Test.h>
+#include <cppunit/portability/CppUnitMap.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+
+
+class TestPath;
+
+
+/*! \brief Identity of all the tests of a test hierarchy.
+ * \ingroup BrowsingCollectedTestResult
+ *
+ * The hierarchy is traversed once on construction. For each test, the index
+ * records its parent and its full path string (as returned by
+ * TestPath::toString()), keyed by the test identifier (see Test::getId()).
+ *
+ * Listeners and outputters can use it to retrieve the path of a test without
+ * walking the hierarchy or building a string for each event:
+ * \code
+ * void MyListener::startTest( CppUnit::Test *test )
+ * {
+ *   m_output << m_index.getPath( test ) << "\n";
+ * }
+ * \endcode
+ *
+ * The index does not own the tests. The hierarchy must not be modified while
+ * the index is used.
+ *
+ * \see Test::getId(), TestPath.
+ */
+class CPPUNIT_API TestIndex
+{
+public:
+  /*! \brief Indexes the specified test hierarchy.
+   * \param root Root of the hierarchy. Must not be \c NULL.
+   */
+  TestIndex( Test *root );
+
+  /// Destructor.
+  virtual ~TestIndex();
+
+  /*! \brief Returns the root of the indexed hierarchy.
+   * \return Root test. Never \c NULL.
+   */
+  Test *getRootTest() const;
+
+  /*! \brief Returns the number of indexed tests.
+   *
+   * This includes the root, the suites and the test cases.
+   * \return Number of indexed tests.
+   */
+  int getTestCount() const;
+
+  /*! \brief Returns the indexed test at the specified position.
+   *
+   * Tests are stored in the order they are found by a depth first traversal
+   * of the hierarchy: the root is at index 0, and a suite always precedes
+   * its children.
+   *
+   * \param index Zero based index of the test.
+   * \return Test at \a index. Never \c NULL.
+   * \exception std::out_of_range if \a index < 0 or \a index >= getTestCount().
+   */
+  Test *getTestAt( int index ) const;
+
+  /*! \brief Returns the position of the specified test.
+   * \param id Identifier of the test.
+   * \return Zero based index of the test, -1 if no test with that identifier
+   *         was indexed.
+   */
+  int indexOf( TestId id ) const;
+
+  /*! \brief Tests if the specified test is part of the indexed hierarchy.
+   * \param test Test to look for.
+   * \return \c true if \a test was indexed, \c false otherwise.
+   */
+  bool contains( const Test *test ) const;
+
+  /*! \brief Finds the indexed test with the specified identifier.
+   * \param id Identifier of the test.
+   * \return Test with identifier \a id, \c NULL if it was not indexed.
+   */
+  Test *findTest( TestId id ) const;
+
+  /*! \brief Returns the parent of the specified test.
+   * \param test Indexed test.
+   * \return Parent of \a test, \c NULL if \a test is the root.
+   * \exception std::invalid_argument if \a test was not indexed.
+   */
+  Test *getParentTest( const Test *test ) const;
+
+  /*! \brief Returns the full path of the specified test.
+   * \param test Indexed test.
+   * \return Path of \a test, as returned by TestPath::toString(). The reference
+   *         remains valid as long as the index exists.
+   * \exception std::invalid_argument if \a test was not indexed.
+   */
+  const std::string &getPath( const Test *test ) const;
+
+  /*! \brief Returns the TestPath of the specified test.
+   * \param test Indexed test.
+   * \return Path from the root to \a test.
+   * \exception std::invalid_argument if \a test was not indexed.
+   */
+  TestPath makeTestPath( const Test *test ) const;
+
+private:
+  /// Indexed test (Implementation).
+  struct Entry
+  {
+    Test *m_test;
+    int m_parentIndex;
+    std::string m_path;
+  };
+
+  void addTest( Test *test, int parentIndex );
+
+  int checkedIndexOf( const Test *test ) const;
+
+  /// Prevents the use of the copy constructor.
+  TestIndex( const TestIndex &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestIndex &copy );
+
+private:
+  typedef CppUnitVector<Entry> Entries;
+  Entries m_entries;
+
+  typedef CppUnitMap<TestId, int> IndexesById;
+  IndexesById m_indexesById;
+};
+
+
+CPPUNIT_NS_END
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( pop )
+#endif
+
+#endif // CPPUNIT_TESTINDEX_H
@@ -106,6 +106,32 @@ public:
    */
   virtual void addFailure( const TestFailure & /*failure*/ ) {}
 
+  /*! \brief Called just before endTest() with the number of assertions
+   *         checked by the test.
+   * \see Asserter::countAssertion().
+   */
+  virtual void addAssertions( Test * /*test*/, 
+                              int /*assertionCount*/ ) {}
+
+  /*! \brief Called just before endTest() with the allocations made by the
+   *         test.
+   *
+   * Only called if the allocations are counted.
+   * \see AllocationScope.
+   */
+  virtual void addAllocations( Test * /*test*/, 
+                               long /*allocationCount*/,
+                               long /*allocatedByteCount*/ ) {}
+
+  /*! \brief Called just before endTest() with the peak memory measured
+   *         while the test ran, in kilobytes.
+   *
+   * Only called if the peak memory is tracked.
+   * \see TestResult::setTracksPeakMemory().
+   */
+  virtual void addPeakMemory( Test * /*test*/, 
+                              long /*peakKilobytes*/ ) {}
+
   /// Called just after a TestCase was run (even if a failure occured).
   virtual void endTest( Test * /*test*/ ) {}
 
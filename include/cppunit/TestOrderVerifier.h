@@ -0,0 +1,180 @@
+#ifndef CPPUNIT_TESTORDERVERIFIER_H
+#define CPPUNIT_TESTORDERVERIFIER_H
+
+#include <cppunit/Portability.h>
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( push )
+#pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
+#endif
+
+#include <cppunit/portability/CppUnitSet.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <cppunit/portability/Stream.h>
+#include <iosfwd>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+
+class Test;
+
+
+/*! \brief Pair of tests whose results depend on their order.
+ */
+class CPPUNIT_API TestOrderDependency
+{
+public:
+  /// Path of the suite of the tests, see TestPath::toString().
+  std::string m_suitePath;
+
+  /*! Name of the test whose side effects change the result of
+   * m_dependentTest when run before it. Empty if no single test was found to
+   * change that result.
+   */
+  std::string m_precedingTest;
+
+  /// Name of the test whose result depends on the tests run before it.
+  std::string m_dependentTest;
+
+  /// \c true if m_dependentTest succeeds when run alone.
+  bool m_succeedsAlone;
+};
+
+
+/*! \brief Verifies that the tests of each suite do not depend on their order.
+ * \ingroup ExecutingTest
+ *
+ * For each suite, every test case of the suite is first run alone. The test
+ * cases are then run in their declared order and in several random orders,
+ * generated from a seed so that a verification can be reproduced. When the
+ * result of a test is not the same as when it runs alone, each test that ran
+ * before it is run again alone with it to find the pairs of tests whose
+ * results depend on their order.
+ *
+ * Sub-suites are verified as separate suites: only the test cases that are
+ * direct children of a suite are reordered. The once-per-suite fixture of a
+ * suite (see CPPUNIT_TEST_SUITE_SETUP()) is set up around each run.
+ *
+ * The tests are run with a TestResult private to the verifier, so the
+ * verification does not report any failure: it only finds dependencies.
+ * All the runs happen in the same process: a state that is not reset by the
+ * suite fixture also leaks from one run to the next.
+ *
+ * The suites without dependency can be written in a property file, which
+ * tags them as safe to run in parallel:
+ * \code
+ * CppUnit::TestOrderVerifier verifier;
+ * runner.verifyOrderIndependence( verifier );
+ * CppUnit::OFileStream properties( "order.properties" );
+ * verifier.writeProperties( properties );
+ * \endcode
+ *
+ * \see TestRunner::verifyOrderIndependence().
+ */
+class CPPUNIT_API TestOrderVerifier
+{
+public:
+  /*! Constructs a verifier.
+   * \param permutationCount Number of random orders each suite is run in,
+   *                         in addition to its declared order.
+   * \param seed Seed of the random orders.
+   */
+  TestOrderVerifier( int permutationCount = 5,
+                     unsigned int seed = 1 );
+
+  /// Destructor.
+  virtual ~TestOrderVerifier();
+
+  /*! \brief Verifies the suites of the specified test.
+   * \param test Test to verify. Its sub-suites are verified too.
+   * \param parentPath Path of the parent of \a test, used to name the suites.
+   */
+  void verify( Test *test,
+               const std::string &parentPath = "" );
+
+  /*! \brief Returns the number of suites verified.
+   */
+  int getSuiteCount() const;
+
+  /*! \brief Returns the path of a verified suite.
+   */
+  std::string getSuitePathAt( int index ) const;
+
+  /*! \brief Indicates if the tests of a verified suite do not depend on their order.
+   */
+  bool isSuiteOrderIndependentAt( int index ) const;
+
+  /*! \brief Returns the number of order dependencies found.
+   */
+  int getDependencyCount() const;
+
+  /*! \brief Returns an order dependency found.
+   */
+  const TestOrderDependency &getDependencyAt( int index ) const;
+
+  /*! \brief Writes the order dependencies, one per line.
+   */
+  void printDependencies( OStream &stream ) const;
+
+  /*! \brief Writes the property file of the verified suites.
+   *
+   * Each line is the path of a suite followed by "=parallel-safe" if its tests
+   * do not depend on their order, or "=order-dependent".
+   */
+  void writeProperties( OStream &stream ) const;
+
+  /*! \brief Reads the suites tagged as safe to run in parallel.
+   * \param stream Property file written by writeProperties().
+   * \param suitePaths Receives the path of each suite whose value is
+   *                   "parallel-safe".
+   */
+  static void readParallelSafeSuites( std::istream &stream,
+                                      CppUnitSet<std::string> &suitePaths );
+
+private:
+  typedef CppUnitVector<Test *> Tests;
+  typedef CppUnitVector<bool> Results;
+
+  void verifySuite( Test *suite,
+                    const Tests &tests,
+                    const std::string &suitePath );
+
+  bool runInOrder( Test *suite,
+                   const Tests &tests,
+                   Results &succeeded );
+
+  void findPrecedingTests( Test *suite,
+                           const Tests &order,
+                           int dependentIndex,
+                           bool succeedsAlone,
+                           const std::string &suitePath );
+
+  void addDependency( const std::string &suitePath,
+                      const std::string &precedingTest,
+                      const std::string &dependentTest,
+                      bool succeedsAlone );
+
+  unsigned int nextRandom( unsigned int bound );
+
+  /// Prevents the use of the copy constructor.
+  TestOrderVerifier( const TestOrderVerifier &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestOrderVerifier &copy );
+
+private:
+  int m_permutationCount;
+  unsigned int m_random;
+  CppUnitVector<std::string> m_suitePaths;
+  CppUnitVector<bool> m_suiteIndependence;
+  CppUnitVector<TestOrderDependency> m_dependencies;
+};
+
+
+CPPUNIT_NS_END
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( pop )
+#endif
+
+#endif  // CPPUNIT_TESTORDERVERIFIER_H
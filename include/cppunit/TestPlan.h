@@ -0,0 +1,170 @@
+#ifndef CPPUNIT_TESTPLAN_H
+#define CPPUNIT_TESTPLAN_H
+
+#include <cppunit/Portability.h>
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( push )
+#pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
+#endif
+
+#include <cppunit/Test.h>
+#include <cppunit/portability/CppUnitVector.h>
+
+CPPUNIT_NS_BEGIN
+
+
+class TestFilter;
+class TestResult;
+
+
+/*! \brief Entry of a TestPlan.
+ * \ingroup ExecutingTest
+ *
+ * An entry is either a suite, whose children are the entries that follow it
+ * up to m_endIndex, or a unit of execution run with Test::run().
+ */
+class CPPUNIT_API TestPlanEntry
+{
+public:
+  /// Test of the entry.
+  Test *m_test;
+
+  /// Identifier of m_test.
+  TestId m_id;
+
+  /// Index of the parent suite entry, -1 for the root entry.
+  int m_parentIndex;
+
+  /// Depth of the entry. The root entry has a depth of 0.
+  int m_depth;
+
+  /// Index of the first entry that is not part of this entry sub-tree.
+  int m_endIndex;
+
+  /// Number of test cases invoked when running the entry.
+  int m_testCaseCount;
+
+  /*! \c true if the children of the test are expanded in the plan, \c false
+   * if the entry is run with Test::run().
+   */
+  bool m_isSuite;
+};
+
+
+/*! \brief Flattened execution plan of a test hierarchy.
+ * \ingroup ExecutingTest
+ *
+ * The hierarchy is compiled once on construction into a contiguous array of
+ * entries, in the order they are run. Each test that can be flattened (see
+ * Test::canBeFlattened()) becomes a suite entry followed by the entries of
+ * its children. Any other test (test cases, decorators...) becomes a leaf
+ * entry, executed by calling Test::run().
+ *
+ * Executing the plan with run() produces the same events as calling run() on
+ * the root test, but without walking the hierarchy through virtual calls. The
+ * number of test cases of each entry is computed once, so countTestCases() is
+ * constant time.
+ *
+ * The plan does not own the tests. The hierarchy must not be modified while
+ * the plan is used.
+ *
+ * \see TestRunner, TestResult::runTestPlan().
+ */
+class CPPUNIT_API TestPlan
+{
+public:
+  /*! \brief Compiles the plan of the specified test.
+   * \param root Test to compile. Must not be \c NULL.
+   */
+  TestPlan( Test *root );
+
+  /*! \brief Compiles the plan of the tests selected by a filter.
+   *
+   * Suites excluded by \a filter are skipped as a whole: their children are
+   * not visited. A suite is kept in the plan only if one of the tests below it
+   * is selected, so running the plan never emits startSuite() for an empty
+   * selection. A root suite is always kept. A root test case that is not
+   * selected results in a plan without entries.
+   *
+   * A test that can not be flattened but has children, such as a decorator
+   * or a suite that overrides run(), is run as a whole if one of the tests
+   * below it is selected.
+   *
+   * \param root Test to compile. Must not be \c NULL.
+   * \param filter Filter that selects the tests to add to the plan.
+   * \param parentPath Path of the parent of \a root, as returned by
+   *                   TestPath::toString(). Empty if \a root is the top test.
+   *                   Test paths matched by the filter start with this path.
+   * \exception std::invalid_argument if \a root can not be flattened, has
+   *            children, and neither it nor a test below it is selected.
+   */
+  TestPlan( Test *root,
+            const TestFilter &filter,
+            const std::string &parentPath = "" );
+
+  /// Destructor.
+  virtual ~TestPlan();
+
+  /*! \brief Returns the compiled test.
+   * \return Root test of the plan. Never \c NULL.
+   */
+  Test *getRootTest() const;
+
+  /*! \brief Returns the number of test cases invoked when running the plan.
+   * \return Number of test cases.
+   */
+  int countTestCases() const;
+
+  /*! \brief Returns the number of entries in the plan.
+   * \return Number of entries. Only 0 if a filter rejected the root test.
+   */
+  int getEntryCount() const;
+
+  /*! \brief Returns the entry at the specified index.
+   * \param index Zero based index of the entry.
+   * \return Entry at \a index.
+   * \exception std::out_of_range if \a index < 0 or \a index >= getEntryCount().
+   */
+  const TestPlanEntry &getEntryAt( int index ) const;
+
+  /*! \brief Runs the plan.
+   *
+   * Equivalent to calling getRootTest()->run( \a result ).
+   *
+   * \param result Controller that is notified of the test events.
+   */
+  void run( TestResult *result ) const;
+
+private:
+  void addTest( Test *test, int parentIndex, int depth );
+
+  bool addFilteredTest( Test *test,
+                        int parentIndex,
+                        int depth,
+                        const std::string &testPath,
+                        bool isIncluded,
+                        const TestFilter &filter );
+
+  void addEntry( Test *test, int parentIndex, int depth );
+
+  /// Prevents the use of the copy constructor.
+  TestPlan( const TestPlan &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestPlan &copy );
+
+private:
+  typedef CppUnitVector<TestPlanEntry> Entries;
+  Entries m_entries;
+  Test *m_root;
+};
+
+
+CPPUNIT_NS_END
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( pop )
+#endif
+
+#endif // CPPUNIT_TESTPLAN_H
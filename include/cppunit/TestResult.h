@@ -22,6 +22,7 @@ class ProtectorChain;
 class Test;
 class TestFailure;
 class TestListener;
+class TestPlan;
 
 
 #if CPPUNIT_NEED_DLL_DECL
@@ -84,9 +85,69 @@ public:
    */
   virtual void addFailure( Test *test, Exception *e );
 
+  /// Informs TestListener of the number of assertions checked by a test.
+  virtual void addAssertions( Test *test, int assertionCount );
+
+  /// Informs TestListener of the allocations made by a test.
+  virtual void addAllocations( Test *test, 
+                               long allocationCount,
+                               long allocatedByteCount );
+
   /// Informs TestListener that a test was completed.
   virtual void endTest( Test *test );
 
+  /*! \brief Sets whether a test that checks no assertion fails.
+   *
+   * Such a test does not verify anything, which is usually a mistake. The
+   * policy is off by default.
+   */
+  virtual void setFailsTestsWithoutAssertions( bool failsTests );
+
+  /// Returns whether a test that checks no assertion fails.
+  virtual bool failsTestsWithoutAssertions() const;
+
+  /// Informs TestListener of the peak memory measured while a test ran.
+  virtual void addPeakMemory( Test *test, long peakKilobytes );
+
+  /*! \brief Sets whether the peak memory of each test is measured.
+   *
+   * The peak is reported to TestListener::addPeakMemory(). Measuring costs
+   * reading a few files of /proc per test. The peak is always measured when
+   * the tests have a budget. Off by default.
+   * \see PeakMemory.
+   */
+  virtual void setTracksPeakMemory( bool tracksPeakMemory );
+
+  /// Returns whether the peak memory of each test is measured.
+  virtual bool tracksPeakMemory() const;
+
+  /*! \brief Sets the peak memory allowed to each test.
+   *
+   * A test whose peak memory exceeds the budget fails with the measured
+   * peak. The budget of the innermost suite that has one, see
+   * Test::getPeakMemoryBudget(), takes precedence.
+   * \param kilobytes Peak memory in kilobytes, 0 for no budget.
+   */
+  virtual void setPeakMemoryBudget( long kilobytes );
+
+  /*! \brief Returns the peak memory allowed to the tests being run, in
+   *         kilobytes, 0 if there is no budget.
+   */
+  virtual long peakMemoryBudget() const;
+
+  /*! \brief Runs the tests with the settings of another result.
+   *
+   * Copies the policy on tests without assertions and the peak memory
+   * settings of \a other, including the budget of the suites it is running,
+   * and protects the tests with the protectors of \a other. Used by tests
+   * that run their children with their own TestResult, such as
+   * ConcurrentRepeatedTest.
+   *
+   * The protectors are shared, not copied: \a other must outlive this result
+   * and its protector chain must not change while this result is used.
+   */
+  virtual void copySettings( const TestResult &other );
+
   /// Informs TestListener that a test suite will be started.
   virtual void startSuite( Test *test );
 
@@ -99,6 +160,13 @@ public:
    */
   virtual void runTest( Test *test );
 
+  /*! \brief Run the tests of the specified plan.
+   * 
+   * Calls startTestRun(), plan.run(this), and finally endTestRun(). The root
+   * test of the plan is passed to the listeners.
+   */
+  virtual void runTestPlan( const TestPlan &plan );
+
   /*! \brief Protects a call to the specified functor.
    *
    * See Protector to understand how protector works. A default protector is
@@ -137,6 +205,11 @@ protected:
   TestListeners m_listeners;
   ProtectorChain *m_protectorChain;
   bool m_stop;
+  bool m_failsTestsWithoutAssertions;
+  bool m_tracksPeakMemory;
+  long m_peakMemoryBudget;
+  /// Budget of each suite being run, 0 if neither it nor its parents have one.
+  CppUnitDeque<long> m_suitePeakMemoryBudgets;
 
 private: 
   TestResult( const TestResult &other );
@@ -10,6 +10,7 @@
 
 #include <cppunit/TestSuccessListener.h>
 #include <cppunit/portability/CppUnitDeque.h>
+#include <cppunit/portability/CppUnitMap.h>
 
 
 CPPUNIT_NS_BEGIN
@@ -49,6 +50,11 @@ public:
 
   void startTest( Test *test );
   void addFailure( const TestFailure &failure );
+  void addAssertions( Test *test, int assertionCount );
+  void addAllocations( Test *test, 
+                       long allocationCount,
+                       long allocatedByteCount );
+  void addPeakMemory( Test *test, long peakKilobytes );
 
   virtual void reset();
 
@@ -60,12 +66,46 @@ public:
   virtual const TestFailures& failures() const;
   virtual const Tests &tests() const;
 
+  /// Returns the number of assertions checked by all the tests.
+  virtual int assertionCount() const;
+
+  /// Returns the number of assertions checked by a test.
+  virtual int assertionCount( Test *test ) const;
+
+  /// Returns the number of allocations made by all the tests.
+  virtual long allocationCount() const;
+
+  /// Returns the number of allocations made by a test.
+  virtual long allocationCount( Test *test ) const;
+
+  /// Returns the number of bytes allocated by all the tests.
+  virtual long allocatedByteCount() const;
+
+  /// Returns the number of bytes allocated by a test.
+  virtual long allocatedByteCount( Test *test ) const;
+
+  /// Returns the highest peak memory of the tests in kilobytes, -1 if none
+  /// was measured.
+  virtual long peakMemory() const;
+
+  /// Returns the peak memory of a test in kilobytes, -1 if it was not
+  /// measured.
+  virtual long peakMemory( Test *test ) const;
+
 protected:
   void freeFailures();
 
   Tests m_tests;
   TestFailures m_failures;
   int m_testErrors;
+  CppUnitMap<Test *, int> m_testAssertionCounts;
+  int m_assertionCount;
+  CppUnitMap<Test *, long> m_testAllocationCounts;
+  CppUnitMap<Test *, long> m_testAllocatedByteCounts;
+  long m_allocationCount;
+  long m_allocatedByteCount;
+  CppUnitMap<Test *, long> m_testPeakMemories;
+  long m_peakMemory;
 
 private:
   /// Prevents the use of the copy constructor.
@@ -8,6 +8,9 @@ CPPUNIT_NS_BEGIN
 
 
 class Test;
+class TestFilter;
+class TestOrderVerifier;
+class TestPlan;
 class TestResult;
 
 
@@ -94,6 +97,49 @@ public:
   virtual void run( TestResult &controller,
                     const std::string &testPath = "" );
 
+  /*! \brief Runs the tests selected by a filter using the specified controller.
+   *
+   * Only the tests below \a testPath selected by \a filter are run. Test paths
+   * are matched by the filter as returned by TestPath::toString() on a path
+   * starting from the top test, for example "/All Tests/MathTest/MathTest::testAdd".
+   *
+   * \param controller Event manager and controller used for testing
+   * \param filter Filter that selects the tests to run.
+   * \param testPath Test path string. See Test::resolveTestPath() for detail.
+   * \exception std::invalid_argument if no test matching \a testPath is found.
+   */
+  virtual void run( TestResult &controller,
+                    const TestFilter &filter,
+                    const std::string &testPath = "" );
+
+  /*! \brief Compiles the plan of the tests selected by a filter.
+   *
+   * This is the plan run by run( controller, filter, testPath ). It can be used
+   * to run the selected tests without the events of a test run, for example
+   * from several threads.
+   *
+   * \param filter Filter that selects the tests to run.
+   * \param testPath Test path string. See Test::resolveTestPath() for detail.
+   * \return Plan owned by the caller, which refers to the tests of the runner.
+   * \exception std::invalid_argument if no test matching \a testPath is found.
+   */
+  virtual TestPlan *makeTestPlan( const TestFilter &filter,
+                                  const std::string &testPath = "" );
+
+  /*! \brief Verifies that the results of the tests do not depend on their order.
+   *
+   * Each suite below \a testPath is run several times in different orders, see
+   * TestOrderVerifier. No test event is reported: the order dependencies and
+   * the suites that are safe to run in parallel are available from
+   * \a verifier.
+   *
+   * \param verifier Verifier that runs the suites and collects the results.
+   * \param testPath Test path string. See Test::resolveTestPath() for detail.
+   * \exception std::invalid_argument if no test matching \a testPath is found.
+   */
+  virtual void verifyOrderIndependence( TestOrderVerifier &verifier,
+                                        const std::string &testPath = "" );
+
 protected:
   /*! \brief (INTERNAL) Mutating test suite.
    */
@@ -106,8 +152,17 @@ protected:
 
     std::string getName() const;
 
+    const std::string &getNameRef() const;
+
     void run( TestResult *result );
 
+    bool canBeFlattened() const;
+
+    /*! \brief Returns the test actually run by run().
+     * \return The unique child test if there is only one, this suite otherwise.
+     */
+    Test *getRunTest();
+
   protected:
     Test *doGetChildTestAt( int index ) const;
 
@@ -8,6 +8,7 @@
 #pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
 #endif
 
+#include <cppunit/Mutex.h>
 #include <cppunit/TestComposite.h>
 #include <cppunit/portability/CppUnitVector.h>
 
@@ -62,12 +63,61 @@ public:
    */
   virtual void deleteContents();
 
+  /*! \brief Returns the number of test cases invoked by run().
+   *
+   * The count is computed once and cached. The cache is invalidated
+   * whenever a test is added to or removed from any TestSuite, so a suite
+   * nested in this one can still be modified. A test whose count changes
+   * otherwise must be counted before it is added to the suite.
+   *
+   * \see Test::countTestCases().
+   */
+  int countTestCases() const;
+
   int getChildTestCount() const;
 
+  /*! \brief Returns \c true if the suite is a TestSuite, not a subclass.
+   *
+   * A TestSuite created by CPPUNIT_TEST_NEW() in a TestArena is flattened
+   * too.
+   *
+   * Subclasses may override run(), doStartSuite(), doRunChildTests() or
+   * doEndSuite(), so they are run with run() unless they override this
+   * method. Without RTTI, subclasses that customize how the suite is run must
+   * override this method to return \c false.
+   *
+   * \see Test::canBeFlattened().
+   */
+  bool canBeFlattened() const;
+
   Test *doGetChildTestAt( int index ) const;
 
+  /*! \brief Sets the resources shared by the tests of the suite.
+   * \param fixture Fixture set up before the first test of the suite is run,
+   *                and torn down after the last one. Not owned by the suite:
+   *                it is usually shared by all the instances of a fixture
+   *                suite. May be \c NULL.
+   * \see CPPUNIT_TEST_SUITE_SETUP().
+   */
+  void setSuiteFixture( SuiteFixture *fixture );
+
+  SuiteFixture *getSuiteFixture() const;
+
+  /*! \brief Sets the peak memory allowed to each test of the suite.
+   * \param kilobytes Peak memory in kilobytes, 0 for no budget.
+   * \see CPPUNIT_TEST_SUITE_PROPERTY(), TestResult::peakMemoryBudget().
+   */
+  void setPeakMemoryBudget( long kilobytes );
+
+  long getPeakMemoryBudget() const;
+
 private:
   CppUnitVector<Test *> m_tests;
+  SuiteFixture *m_suiteFixture;
+  long m_peakMemoryBudget;
+  mutable Mutex m_countLock;
+  mutable int m_testCaseCount;
+  mutable long m_testCaseCountStamp;
 };
 
 
@@ -0,0 +1,128 @@
+#ifndef CPPUNIT_TESTTHREADCONTEXT_H
+#define CPPUNIT_TESTTHREADCONTEXT_H
+
+#include <cppunit/Protector.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+class ExpectationCollector;
+
+
+/*! \brief Context of a test passed on to the threads it starts.
+ * \ingroup Assertions
+ *
+ * An assertion failing on a thread started by a test throws an Exception
+ * that nothing catches, which terminates the whole run. Instead, the test
+ * captures its context with current() and the thread runs its task with
+ * run(): the failed assertions and expectations of the task, as well as the
+ * exceptions escaping it, are reported as failures of the test.
+ *
+ * \code
+ * class FillTask : public CPPUNIT_NS::Functor
+ * {
+ * public:
+ *   FillTask( Cache &cache ) : m_cache( cache ) {}
+ *
+ *   bool operator()() const
+ *   {
+ *     CPPUNIT_ASSERT( m_cache.insert( "key", 3 ) );
+ *     CPPUNIT_EXPECT_EQUAL( 3, m_cache.lookup( "key" ) );
+ *     return true;
+ *   }
+ *
+ * private:
+ *   Cache &m_cache;
+ * };
+ *
+ * struct FillThread
+ * {
+ *   CPPUNIT_NS::TestThreadContext m_context;
+ *   Cache *m_cache;
+ * };
+ *
+ * static void *runFillThread( void *data )
+ * {
+ *   FillThread *thread = (FillThread *)data;
+ *   thread->m_context.run( FillTask( *thread->m_cache ) );
+ *   return NULL;
+ * }
+ *
+ * void CacheTest::testConcurrentFill()
+ * {
+ *   FillThread thread = { CPPUNIT_NS::TestThreadContext::current(), &m_cache };
+ *   pthread_t handle;
+ *   pthread_create( &handle, NULL, &runFillThread, &thread );
+ *   pthread_join( handle, NULL );
+ * }
+ * \endcode
+ *
+ * The failures of a task are reported once it returns. If a task is still
+ * running when the test ends, the test fails and the later failures of the
+ * task are ignored: the threads started by a test are expected to be joined
+ * by the test or its tearDown().
+ *
+ * A context may be copied, for example into the tasks of a thread pool, and
+ * used after the end of the test.
+ *
+ * \sa ExpectationCollector.
+ */
+class CPPUNIT_API TestThreadContext
+{
+public:
+  /*! \brief Constructs a context that belongs to no test.
+   *
+   * The failures of the tasks run in this context are ignored.
+   */
+  TestThreadContext();
+
+  /// Copy constructor.
+  TestThreadContext( const TestThreadContext &copy );
+
+  /// Destructor.
+  ~TestThreadContext();
+
+  /// Copy operator.
+  TestThreadContext &operator =( const TestThreadContext &copy );
+
+  /*! \brief Returns the context of the test running on the calling thread.
+   */
+  static TestThreadContext current();
+
+  /*! \brief Indicates if the context belongs to a test that has not ended.
+   */
+  bool isValid() const;
+
+  /*! \brief Runs a task on the calling thread in the context of the test.
+   *
+   * Never throws: the failures of the task are reported to the test.
+   * \return \c true if the task returned \c true and did not fail.
+   */
+  bool run( const Functor &task ) const;
+
+  /*! \brief Returns the number of tasks being run in the context.
+   */
+  int runningTaskCount() const;
+
+private:
+  friend class ExpectationCollector;
+
+  struct State;
+
+  TestThreadContext( ExpectationCollector *collector );
+
+  int detach();
+
+  void reportFailures( ExpectationCollector &failures ) const;
+
+  void release();
+
+private:
+  State *m_state;
+};
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_TESTTHREADCONTEXT_H
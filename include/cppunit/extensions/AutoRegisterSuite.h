@@ -3,6 +3,7 @@
 
 #include <cppunit/extensions/TestSuiteFactory.h>
 #include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/extensions/TypeList.h>
 #include <string>
 
 CPPUNIT_NS_BEGIN
@@ -57,6 +58,66 @@ private:
 };
 
 
+/*! \brief (Implementation) Automatically registers the suites of a fixture template for each type of a TypeList.
+ *
+ * You should not use this class directly. Instead, use the following macros:
+ * - CPPUNIT_TYPED_TEST_SUITE_REGISTRATION()
+ * - CPPUNIT_TYPED_TEST_SUITE_NAMED_REGISTRATION()
+ *
+ * The list is expanded at compile time: the fixture template is instantiated
+ * for the first type and registered with an AutoRegisterSuite, and the
+ * remaining types are registered by a member instantiated for the rest of
+ * the list.
+ */
+template<template<class> class FixtureTemplate, class Types>
+class AutoRegisterTypedSuites;
+
+
+/*! \brief (Implementation) Registers the suites of the types of a TypeList.
+ */
+template<template<class> class FixtureTemplate,
+         class T1, class T2, class T3, class T4, class T5, class T6,
+         class T7, class T8, class T9, class T10, class T11, class T12,
+         class T13, class T14, class T15, class T16>
+class AutoRegisterTypedSuites<FixtureTemplate,
+                              TypeList<T1, T2, T3, T4, T5, T6, T7, T8,
+                                       T9, T10, T11, T12, T13, T14, T15, T16> >
+{
+public:
+  AutoRegisterTypedSuites()
+  {
+  }
+
+  AutoRegisterTypedSuites( const std::string &name )
+      : m_suite( name )
+      , m_otherSuites( name )
+  {
+  }
+
+private:
+  AutoRegisterSuite< FixtureTemplate<T1> > m_suite;
+  AutoRegisterTypedSuites<FixtureTemplate,
+                          TypeList<T2, T3, T4, T5, T6, T7, T8, T9, T10,
+                                   T11, T12, T13, T14, T15, T16> > m_otherSuites;
+};
+
+
+/*! \brief (Implementation) End of the expansion of AutoRegisterTypedSuites.
+ */
+template<template<class> class FixtureTemplate>
+class AutoRegisterTypedSuites<FixtureTemplate, TypeList<> >
+{
+public:
+  AutoRegisterTypedSuites()
+  {
+  }
+
+  AutoRegisterTypedSuites( const std::string & )
+  {
+  }
+};
+
+
 /*! \brief (Implementation) Automatically adds a registry into another registry.
  *
  * Don't use this class. Use the macros CPPUNIT_REGISTRY_ADD() and
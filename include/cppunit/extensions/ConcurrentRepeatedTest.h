@@ -0,0 +1,130 @@
+#ifndef CPPUNIT_EXTENSIONS_CONCURRENTREPEATEDTEST_H
+#define CPPUNIT_EXTENSIONS_CONCURRENTREPEATEDTEST_H
+
+#include <cppunit/Portability.h>
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( push )
+#pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
+#endif
+
+#include <cppunit/extensions/TestDecorator.h>
+#include <cppunit/portability/CppUnitVector.h>
+
+CPPUNIT_NS_BEGIN
+
+class Test;
+class TestFactory;
+class TestResult;
+
+
+/*! \brief Decorator that runs a test repeatedly on several threads at once.
+ * \ingroup WritingTestFixture
+ *
+ * Each thread runs the test \a timesRepeat times. The threads wait for each
+ * other before running their first repetition, so that they all hit the code
+ * under test at the same time, which makes data races much more likely to
+ * show up than with RepeatedTest.
+ *
+ * Each thread reports the events of its repetitions to its own TestResult,
+ * which forwards them to the decorated TestResult while holding a lock: the
+ * TestListener of the decorated result are never called concurrently.
+ * The thread results have the settings and the protectors of the decorated
+ * result (see TestResult::copySettings()), so the protectors may be called
+ * concurrently.
+ *
+ * When constructed with a test, all the threads run that same test, and
+ * therefore share its fixture: setUp() and tearDown() are called concurrently
+ * on the same object. When constructed with a TestFactory, each thread runs
+ * its own test created by the factory.
+ *
+ * Repetitions of threads that can not be started (or all the repetitions if
+ * the platform has no thread support) are run on the calling thread.
+ *
+ * After run(), the number of repetitions, how many of them failed and the
+ * elapsed time are available to report the throughput of the test.
+ */
+class CPPUNIT_API ConcurrentRepeatedTest : public TestDecorator
+{
+public:
+  /*! Constructs a decorator that runs the same test on all the threads.
+   * \param test Test to run. Owned by the decorator.
+   * \param threadCount Number of threads, > 0.
+   * \param timesRepeat Number of repetitions on each thread.
+   */
+  ConcurrentRepeatedTest( Test *test,
+                          int threadCount,
+                          int timesRepeat = 1 );
+
+  /*! Constructs a decorator that runs a different test on each thread.
+   *
+   * The test of the first thread is created immediately, and the tests of the
+   * other threads the first time the decorator is run. They are owned by the
+   * decorator, so the failures reported on them stay valid.
+   * \param factory Factory used to create the test of each thread. Must
+   *                outlive the first call to run().
+   * \param threadCount Number of threads, > 0.
+   * \param timesRepeat Number of repetitions on each thread.
+   */
+  ConcurrentRepeatedTest( TestFactory *factory,
+                          int threadCount,
+                          int timesRepeat = 1 );
+
+  /// Destructor. Destroys the tests.
+  ~ConcurrentRepeatedTest();
+
+  void run( TestResult *result );
+
+  int countTestCases() const;
+
+  /*! \brief Returns the number of threads.
+   */
+  int getThreadCount() const;
+
+  /*! \brief Returns the number of repetitions run by the last call to run().
+   */
+  int getRepetitionCount() const;
+
+  /*! \brief Returns the number of repetitions that reported a failure or an
+   *         error during the last call to run().
+   */
+  int getFailedRepetitionCount() const;
+
+  /*! \brief Returns the wall clock time taken by the last call to run(), in
+   *         seconds, from the start of the threads to the end of the last one.
+   */
+  double getElapsedTime() const;
+
+  /*! \brief Returns the number of repetitions per second of the last call to
+   *         run(), or 0 if it was too fast to be measured.
+   */
+  double getThroughput() const;
+
+private:
+  Test *getThreadTest( int threadIndex );
+
+  /// Prevents the use of the copy constructor.
+  ConcurrentRepeatedTest( const ConcurrentRepeatedTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const ConcurrentRepeatedTest &copy );
+
+private:
+  TestFactory *m_factory;
+  const int m_threadCount;
+  const int m_timesRepeat;
+  typedef CppUnitVector<Test *> Tests;
+  Tests m_threadTests;
+  int m_repetitionCount;
+  int m_failedRepetitionCount;
+  double m_elapsedTime;
+};
+
+
+CPPUNIT_NS_END
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( pop )
+#endif
+
+#endif  // CPPUNIT_EXTENSIONS_CONCURRENTREPEATEDTEST_H
@@ -6,10 +6,14 @@
 #ifndef CPPUNIT_EXTENSIONS_HELPERMACROS_H
 #define CPPUNIT_EXTENSIONS_HELPERMACROS_H
 
+#include <cppunit/SuiteFixture.h>
+#include <cppunit/TestArena.h>
 #include <cppunit/TestCaller.h>
 #include <cppunit/TestSuite.h>
 #include <cppunit/extensions/AutoRegisterSuite.h>
 #include <cppunit/extensions/ExceptionTestCaseDecorator.h>
+#include <cppunit/extensions/StaticTest.h>
+#include <cppunit/extensions/StaticTestSuiteFactory.h>
 #include <cppunit/extensions/TestFixtureFactory.h>
 #include <cppunit/extensions/TestNamer.h>
 #include <cppunit/extensions/TestSuiteBuilderContext.h>
@@ -108,6 +112,12 @@
       return testNamer;                                                     \
     }                                                                       \
                                                                             \
+    static CPPUNIT_NS::SuiteFixture &getSuiteFixture__()                    \
+    {                                                                       \
+      static CPPUNIT_NS::SuiteFixture suiteFixture;                         \
+      return suiteFixture;                                                  \
+    }                                                                       \
+                                                                            \
   public:                                                                   \
     typedef CPPUNIT_NS::TestSuiteBuilderContext<TestFixtureType>            \
                 TestSuiteBuilderContextType;                                \
@@ -170,7 +180,8 @@
     {                                                                          \
       const CPPUNIT_NS::TestNamer &namer = getTestNamer__();                   \
       std::auto_ptr<CPPUNIT_NS::TestSuite> suite(                              \
-             new CPPUNIT_NS::TestSuite( namer.getFixtureName() ));             \
+             CPPUNIT_TEST_NEW( CPPUNIT_NS::TestSuite,                          \
+                               ( namer.getFixtureName() ) ) );                 \
       CPPUNIT_NS::ConcretTestFixtureFactory<TestFixtureType> factory;          \
       CPPUNIT_NS::TestSuiteBuilderContextBase context( *suite.get(),           \
                                                        namer,                  \
@@ -295,10 +306,11 @@
  */
 #define CPPUNIT_TEST( testMethod )                        \
     CPPUNIT_TEST_SUITE_ADD_TEST(                           \
-        ( new CPPUNIT_NS::TestCaller<TestFixtureType>(    \
-                  context.getTestNameFor( #testMethod),   \
-                  &TestFixtureType::testMethod,           \
-                  context.makeFixture() ) ) )
+        CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCaller<TestFixtureType>, \
+                          ( context.getTestNamer(),       \
+                            #testMethod,                  \
+                            &TestFixtureType::testMethod, \
+                            context.makeFixture() ) ) )
 
 /*! \brief Add a test which fail if the specified exception is not caught.
  *
@@ -326,11 +338,13 @@
  */
 #define CPPUNIT_TEST_EXCEPTION( testMethod, ExceptionType )          \
   CPPUNIT_TEST_SUITE_ADD_TEST(                                        \
-      (new CPPUNIT_NS::ExceptionTestCaseDecorator< ExceptionType >(  \
-          new CPPUNIT_NS::TestCaller< TestFixtureType >(             \
-                               context.getTestNameFor( #testMethod ),  \
-                               &TestFixtureType::testMethod,         \
-                               context.makeFixture() ) ) ) )
+      CPPUNIT_TEST_NEW(                                              \
+          CPPUNIT_NS::ExceptionTestCaseDecorator< ExceptionType >,   \
+          ( CPPUNIT_TEST_NEW( CPPUNIT_NS::TestCaller< TestFixtureType >, \
+                              ( context.getTestNamer(),              \
+                                #testMethod,                         \
+                                &TestFixtureType::testMethod,        \
+                                context.makeFixture() ) ) ) ) )
 
 /*! \brief Adds a test case which is excepted to fail.
  *
@@ -408,11 +422,76 @@
  * Example:
  * \code
  * CPPUNIT_TEST_SUITE_PROPERTY("XmlFileName", "paraTest.xml"); \endcode
+ *
+ * The property "max_rss_mb" sets the peak memory allowed to each test of the
+ * suite, in megabytes. A test that exceeds it fails:
+ * \code
+ * CPPUNIT_TEST_SUITE_PROPERTY("max_rss_mb", "256"); \endcode
+ * \see TestResult::peakMemoryBudget().
  */
 #define CPPUNIT_TEST_SUITE_PROPERTY( APropertyKey, APropertyValue ) \
     context.addProperty( std::string(APropertyKey),                 \
                          std::string(APropertyValue) )
 
+/*! \brief Sets the static method called once before the tests of the suite.
+ *
+ * The method sets up resources that are expensive to create, such as a large
+ * data set or a server, and are shared by all the tests of the suite. It is
+ * called before the first test of the suite is run, and the method specified
+ * with CPPUNIT_TEST_SUITE_TEARDOWN() after the last one. The tests should
+ * only read the shared resources.
+ *
+ * An exception thrown by either method is reported as a failure of the
+ * suite, like a test failure. If the set up fails, the tests of the suite are
+ * not run.
+ *
+ * The set up is done exactly once per run, even if the suite is run by
+ * several threads at the same time, see SuiteFixture.
+ *
+ * \code
+ * class DataSetTest : public CppUnit::TestFixture {
+ *   CPPUNIT_TEST_SUITE( DataSetTest );
+ *   CPPUNIT_TEST_SUITE_SETUP( loadDataSet );
+ *   CPPUNIT_TEST_SUITE_TEARDOWN( releaseDataSet );
+ *   CPPUNIT_TEST( testFind );
+ *   CPPUNIT_TEST_SUITE_END();
+ * public:
+ *   static void loadDataSet()
+ *   {
+ *     s_dataSet = new DataSet( "big.data" );
+ *   }
+ *
+ *   static void releaseDataSet()
+ *   {
+ *     delete s_dataSet;
+ *   }
+ *
+ *   void testFind();
+ * private:
+ *   static DataSet *s_dataSet;
+ * };
+ * \endcode
+ *
+ * A suite declared with CPPUNIT_TEST_SUB_SUITE() shares the suite fixture of
+ * its parent, unless it declares its own.
+ *
+ * \param setUpMethod Name of the static method. Its signature must be:
+ *                    static void setUpMethod();
+ */
+#define CPPUNIT_TEST_SUITE_SETUP( setUpMethod )                               \
+    getSuiteFixture__().setSetUpFunction( &TestFixtureType::setUpMethod );    \
+    context.setSuiteFixture( &getSuiteFixture__() )
+
+/*! \brief Sets the static method called once after the tests of the suite.
+ * \param tearDownMethod Name of the static method. Its signature must be:
+ *                       static void tearDownMethod();
+ * \see CPPUNIT_TEST_SUITE_SETUP().
+ */
+#define CPPUNIT_TEST_SUITE_TEARDOWN( tearDownMethod )                          \
+    getSuiteFixture__().setTearDownFunction(                                  \
+        &TestFixtureType::tearDownMethod );                                   \
+    context.setSuiteFixture( &getSuiteFixture__() )
+
 /** @}
  */
 
@@ -424,6 +503,10 @@
  * causes a test suite factory to be inserted in a global registry
  * of such factories.  The registry is available by calling
  * the static function CppUnit::TestFactoryRegistry::getRegistry().
+ *
+ * The factory is only linked in a list of pending factories when the
+ * static variable is constructed. It is added to the registry the first
+ * time the registry is used (see CppUnit::StaticTestSuiteFactory).
  * 
  * \param ATestFixtureType Type of the test case class.
  * \warning This macro should be used only once per line of code (the line
@@ -431,12 +514,14 @@
  * \see CPPUNIT_TEST_SUITE_NAMED_REGISTRATION
  * \see CPPUNIT_REGISTRY_ADD_TO_DEFAULT
  * \see CPPUNIT_REGISTRY_ADD
- * \see CPPUNIT_TEST_SUITE, CppUnit::AutoRegisterSuite, 
+ * \see CPPUNIT_TEST_SUITE, CppUnit::StaticTestSuiteFactory, 
  *      CppUnit::TestFactoryRegistry.
  */
-#define CPPUNIT_TEST_SUITE_REGISTRATION( ATestFixtureType )      \
-  static CPPUNIT_NS::AutoRegisterSuite< ATestFixtureType >       \
-             CPPUNIT_MAKE_UNIQUE_NAME(autoRegisterRegistry__ )
+#define CPPUNIT_TEST_SUITE_REGISTRATION( ATestFixtureType )                \
+  static CPPUNIT_NS::StaticTestSuiteFactory                                \
+             CPPUNIT_MAKE_UNIQUE_NAME(autoRegisterRegistry__ )(            \
+                 NULL,                                                     \
+                 &CPPUNIT_NS::makeStaticTestSuite< ATestFixtureType > )
 
 
 /** Adds the specified fixture suite to the specified registry suite.
@@ -480,6 +565,90 @@
   static CPPUNIT_NS::AutoRegisterSuite< ATestFixtureType >                   \
              CPPUNIT_MAKE_UNIQUE_NAME(autoRegisterRegistry__ )(suiteName)
 
+/** Adds the specified fixture suite to the registry suite with a constant name.
+ * \ingroup CreatingTestSuite
+ *
+ * Same as CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(), but the registry is only
+ * looked up the first time the registries are used instead of during static
+ * initialization. The registry name must be a string literal, or a \c const
+ * \c char* which outlives the registration.
+ *
+ * \code
+ * CPPUNIT_TEST_SUITE_NAMED_STATIC_REGISTRATION( ComplexNumberTest, "Math" );
+ * \endcode
+ *
+ * \param ATestFixtureType Type of the test case class.
+ * \param suiteName Name of the global registry suite the test suite is 
+ *                  registered into (\c const \c char*).
+ * \warning This macro should be used only once per line of code (the line
+ *          number is used to name a hidden static variable).
+ * \see CPPUNIT_TEST_SUITE_NAMED_REGISTRATION
+ * \see CppUnit::StaticTestSuiteFactory.
+ */
+#define CPPUNIT_TEST_SUITE_NAMED_STATIC_REGISTRATION( ATestFixtureType, suiteName ) \
+  static CPPUNIT_NS::StaticTestSuiteFactory                                         \
+             CPPUNIT_MAKE_UNIQUE_NAME(autoRegisterRegistry__ )(                     \
+                 suiteName,                                                         \
+                 &CPPUNIT_NS::makeStaticTestSuite< ATestFixtureType > )
+
+/** Adds the suites of a fixture template instantiated for each type of a list.
+ * \ingroup CreatingTestSuite
+ *
+ * The fixture template is declared with CPPUNIT_TEST_SUITE() like any other
+ * fixture, and instantiated at compile time for each type of the
+ * CppUnit::TypeList. Each instantiation is a suite of the default registry,
+ * named after the instantiated fixture (for example "VectorTest<int>" when 
+ * RTTI is used to name the fixtures, see CppUnit::TypeInfoHelper).
+ *
+ * \code
+ * template<class ValueType>
+ * class VectorTest : public CppUnit::TestFixture
+ * {
+ *   CPPUNIT_TEST_SUITE( VectorTest );
+ *   CPPUNIT_TEST( testPushBack );
+ *   CPPUNIT_TEST_SUITE_END();
+ * public:
+ *   void testPushBack();
+ * };
+ *
+ * typedef CppUnit::TypeList<int, double, std::string> VectorTestTypes;
+ * CPPUNIT_TYPED_TEST_SUITE_REGISTRATION( VectorTest, VectorTestTypes );
+ * \endcode
+ *
+ * The type list must be a typedef, since a macro parameter can not contain
+ * the commas of a template argument list.
+ *
+ * \param FixtureTemplate Class template of the test case, with a single
+ *                        type parameter.
+ * \param ATypeList CppUnit::TypeList of the types to instantiate the
+ *                  fixture template for.
+ * \warning This macro should be used only once per line of code (the line
+ *          number is used to name a hidden static variable).
+ * \see CPPUNIT_TYPED_TEST_SUITE_NAMED_REGISTRATION, CPPUNIT_TEST_SUITE_REGISTRATION
+ * \see CppUnit::AutoRegisterTypedSuites.
+ */
+#define CPPUNIT_TYPED_TEST_SUITE_REGISTRATION( FixtureTemplate, ATypeList )     \
+  static CPPUNIT_NS::AutoRegisterTypedSuites< FixtureTemplate, ATypeList >      \
+             CPPUNIT_MAKE_UNIQUE_NAME(autoRegisterRegistry__ )
+
+/** Adds the suites of a fixture template instantiated for each type of a list
+ * to the specified registry suite.
+ * \ingroup CreatingTestSuite
+ *
+ * \param FixtureTemplate Class template of the test case, with a single
+ *                        type parameter.
+ * \param ATypeList CppUnit::TypeList of the types to instantiate the
+ *                  fixture template for.
+ * \param suiteName Name of the global registry suite the test suites are
+ *                  registered into.
+ * \warning This macro should be used only once per line of code (the line
+ *          number is used to name a hidden static variable).
+ * \see CPPUNIT_TYPED_TEST_SUITE_REGISTRATION, CPPUNIT_TEST_SUITE_NAMED_REGISTRATION.
+ */
+#define CPPUNIT_TYPED_TEST_SUITE_NAMED_REGISTRATION( FixtureTemplate, ATypeList, suiteName ) \
+  static CPPUNIT_NS::AutoRegisterTypedSuites< FixtureTemplate, ATypeList >                   \
+             CPPUNIT_MAKE_UNIQUE_NAME(autoRegisterRegistry__ )(suiteName)
+
 /*! Adds that the specified registry suite to another registry suite.
  * \ingroup CreatingTestSuite
  *
@@ -0,0 +1,118 @@
+#ifndef CPPUNIT_EXTENSIONS_STATICTEST_H
+#define CPPUNIT_EXTENSIONS_STATICTEST_H
+
+#include <cppunit/SourceLine.h>
+#include <cppunit/TestArena.h>
+#include <cppunit/TestLeaf.h>
+#include <cppunit/extensions/StaticTestSuiteFactory.h>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Test of a condition checked at compile time.
+ *
+ * You should not use this class directly. Instead, use the following macros:
+ * - CPPUNIT_STATIC_TEST()
+ * - CPPUNIT_STATIC_TEST_NAMED_REGISTRATION()
+ *
+ * The condition was checked by the compiler, so running the test only
+ * reports it to the TestResult as a test checking one assertion. The test
+ * appears in the test tree, in the counts, the filters and the outputs like
+ * any other test.
+ */
+class CPPUNIT_API StaticTest : public TestLeaf
+{
+public:
+  /*! Constructs a test.
+   * \param name Name of the test.
+   * \param expression Text of the condition checked at compile time.
+   * \param sourceLine Location of the check.
+   */
+  StaticTest( const std::string &name,
+              const std::string &expression,
+              const SourceLine &sourceLine );
+
+  /// Destructor.
+  ~StaticTest();
+
+  void run( TestResult *result );
+
+  std::string getName() const;
+
+  /// Returns the text of the condition checked at compile time.
+  std::string getExpression() const;
+
+  /// Returns the location of the check.
+  SourceLine getSourceLine() const;
+
+private:
+  /// Prevents the use of the copy constructor.
+  StaticTest( const StaticTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const StaticTest &copy );
+
+private:
+  std::string m_name;
+  std::string m_expression;
+  SourceLine m_sourceLine;
+};
+
+
+CPPUNIT_NS_END
+
+
+/*! \brief Checks a condition at compile time and registers it as a test.
+ * \ingroup CreatingTestSuite
+ *
+ * The condition must be an integral constant expression. If it is false, the
+ * compilation fails on an array of negative size named after the test:
+ * \code
+ * CPPUNIT_STATIC_TEST( typeListHasThreeTypes,
+ *                      (TypeListLength<NumericTypes>::value == 3) );
+ * CPPUNIT_STATIC_TEST( pointIsSmall, sizeof(Point) <= 16 );
+ * \endcode
+ *
+ * The check costs nothing at run time. A StaticTest named after the check is
+ * added to the default registry the first time the registry is used (see
+ * CppUnit::StaticTestSuiteFactory), so that the check shows up next to the
+ * other tests.
+ *
+ * Use the macro at namespace scope of a source file. A condition containing
+ * commas, such as the arguments of a template, must be enclosed in
+ * parentheses.
+ *
+ * \param name Name of the test, an identifier unique in the source file.
+ * \param expression Condition checked at compile time.
+ * \see CPPUNIT_STATIC_TEST_NAMED_REGISTRATION
+ */
+#define CPPUNIT_STATIC_TEST( name, expression )                              \
+  CPPUNIT_STATIC_TEST_NAMED_REGISTRATION( name, expression, NULL )
+
+
+/*! \brief Checks a condition at compile time and registers it as a test of
+ *         the specified registry.
+ * \ingroup CreatingTestSuite
+ *
+ * Same as CPPUNIT_STATIC_TEST(), but the test is added to the named
+ * registry.
+ * \param name Name of the test, an identifier unique in the source file.
+ * \param expression Condition checked at compile time.
+ * \param registryName Name of the registry (\c const \c char* which
+ *                     outlives the registration, such as a string literal).
+ * \see CPPUNIT_TEST_SUITE_NAMED_STATIC_REGISTRATION
+ */
+#define CPPUNIT_STATIC_TEST_NAMED_REGISTRATION( name, expression, registryName ) \
+  typedef char cpputStaticTestFailed_##name[ (expression) ? 1 : -1 ];            \
+  static CPPUNIT_NS::Test *cpputMakeStaticTest_##name()                          \
+  {                                                                              \
+    return CPPUNIT_TEST_NEW( CPPUNIT_NS::StaticTest,                             \
+                             ( #name, #expression, CPPUNIT_SOURCELINE() ) );     \
+  }                                                                              \
+  static CPPUNIT_NS::StaticTestSuiteFactory                                      \
+             cpputStaticTestFactory_##name( registryName,                        \
+                                            &cpputMakeStaticTest_##name )
+
+
+#endif  // CPPUNIT_EXTENSIONS_STATICTEST_H
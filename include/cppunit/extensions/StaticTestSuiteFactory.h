@@ -0,0 +1,83 @@
+#ifndef CPPUNIT_EXTENSIONS_STATICTESTSUITEFACTORY_H
+#define CPPUNIT_EXTENSIONS_STATICTESTSUITEFACTORY_H
+
+#include <cppunit/extensions/TestFactory.h>
+
+CPPUNIT_NS_BEGIN
+
+
+class TestFactoryRegistry;
+
+
+/*! \brief (Implementation) Test suite factory registered without touching the registry.
+ *
+ * You should not use this class directly. Instead, use the following macros:
+ * - CPPUNIT_TEST_SUITE_REGISTRATION()
+ * - CPPUNIT_TEST_SUITE_NAMED_STATIC_REGISTRATION()
+ *
+ * Unlike AutoRegisterSuite, constructing this object does not look up the
+ * TestFactoryRegistry: it only links the factory in a list of pending
+ * factories, which takes a few pointer assignments and no memory allocation.
+ * The pending factories are moved to their registry the first time
+ * TestFactoryRegistry::getRegistry() is called, so loading a test plug-in
+ * that declares many suites costs almost nothing until its tests are used.
+ *
+ * This object is intended to be used as a static variable. It unregisters
+ * itself when destroyed (for example when a test plug-in is unloaded).
+ *
+ * \see CPPUNIT_TEST_SUITE_REGISTRATION, CPPUNIT_TEST_SUITE_NAMED_STATIC_REGISTRATION
+ * \see TestFactoryRegistry.
+ */
+class CPPUNIT_API StaticTestSuiteFactory : public TestFactory
+{
+public:
+  typedef Test *(*MakeSuiteFunction)();
+
+  /*! Links the factory in the list of pending factories.
+   * \param registryName Name of the registry the suite is added to, or
+   *                     \c NULL for the default registry. The string must
+   *                     outlive this object (a string literal).
+   * \param makeSuite Function that creates the test suite.
+   */
+  StaticTestSuiteFactory( const char *registryName,
+                          MakeSuiteFunction makeSuite );
+
+  /// Removes the factory from the pending list or from its registry.
+  virtual ~StaticTestSuiteFactory();
+
+  Test *makeTest();
+
+  /*! \brief Moves all the pending factories to their registry.
+   *
+   * Called by TestFactoryRegistry::getRegistry().
+   */
+  static void registerPendingFactories();
+
+private:
+  /// Prevents the use of the copy constructor.
+  StaticTestSuiteFactory( const StaticTestSuiteFactory &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const StaticTestSuiteFactory &copy );
+
+private:
+  const char *m_registryName;
+  MakeSuiteFunction m_makeSuite;
+  StaticTestSuiteFactory *m_previous;
+  StaticTestSuiteFactory *m_next;
+  TestFactoryRegistry *m_registry;
+};
+
+
+/*! \brief (Implementation) Makes the suite of a fixture for StaticTestSuiteFactory.
+ */
+template<class TestCaseType>
+Test *makeStaticTestSuite()
+{
+  return TestCaseType::suite();
+}
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_EXTENSIONS_STATICTESTSUITEFACTORY_H
@@ -23,6 +23,8 @@ public:
 
   std::string getName() const;
 
+  const std::string &getNameRef() const;
+
   void setUp();
 
   void tearDown();
@@ -0,0 +1,241 @@
+#ifndef CPPUNIT_EXTENSIONS_TESTDATATABLE_H
+#define CPPUNIT_EXTENSIONS_TESTDATATABLE_H
+
+#include <cppunit/Portability.h>
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( push )
+#pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
+#endif
+
+#include <cppunit/portability/CppUnitVector.h>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+
+
+class MappedFile;
+
+
+/*! \brief Row of a TestDataTable.
+ * \ingroup WritingTestFixture
+ */
+class CPPUNIT_API TestDataRow
+{
+public:
+  /*! Key of the row, used to name its test. Empty to name the test with
+   * the index of the row.
+   */
+  std::string m_key;
+
+  /// Parameters passed to the test method.
+  std::string m_parameters;
+
+  /// Expected result passed to the test method.
+  std::string m_expected;
+};
+
+
+/*! \brief Rows of data of a parameterized test.
+ * \ingroup WritingTestFixture
+ *
+ * Each row of the table becomes a test case of a ParameterizedTestCase.
+ * Rows are only read when their test is run, so a table may be much larger
+ * than the memory used to run its tests.
+ *
+ * \see ParameterizedTestCase, MappedTestDataTable.
+ */
+class CPPUNIT_API TestDataTable
+{
+public:
+  virtual ~TestDataTable();
+
+  /*! \brief Returns the number of rows.
+   * \exception std::runtime_error if the data can not be read.
+   */
+  virtual int getRowCount() =0;
+
+  /*! \brief Reads the row at the specified index.
+   * \param index Zero based index of the row, < getRowCount().
+   * \param row Receives the row.
+   * \exception std::runtime_error if the row can not be read.
+   */
+  virtual void getRow( int index,
+                       TestDataRow &row ) =0;
+};
+
+
+/*! \brief Table of test data read from a memory-mapped file.
+ * \ingroup WritingTestFixture
+ *
+ * The file is mapped in memory (or read if the platform does not support
+ * mapping) the first time the table is used. The offsets of the rows are
+ * then found in a single pass, and each row is only parsed when it is read
+ * by getRow().
+ *
+ * Subclasses define the format of the file.
+ *
+ * \see CsvTestDataTable, XmlTestDataTable, BinaryTestDataTable.
+ */
+class CPPUNIT_API MappedTestDataTable : public TestDataTable
+{
+public:
+  /*! Constructs a table for the specified file. The file is not opened.
+   */
+  MappedTestDataTable( const std::string &fileName );
+
+  /// Destructor. Unmaps the file.
+  virtual ~MappedTestDataTable();
+
+  /*! \brief Returns the number of rows, mapping and indexing the file if needed.
+   * \exception std::runtime_error if the file can not be read.
+   */
+  int getRowCount();
+
+  void getRow( int index,
+               TestDataRow &row );
+
+  /*! \brief Returns the name of the file.
+   */
+  std::string getFileName() const;
+
+protected:
+  /// First byte of a row, and byte following its last byte.
+  typedef std::pair<const char *, const char *> RowRange;
+  typedef CppUnitVector<RowRange> RowRanges;
+
+  /*! \brief Finds the rows of the file.
+   * \param begin First byte of the file.
+   * \param end Byte following the last byte of the file.
+   * \param rows Receives the range of each row, in order.
+   * \exception std::runtime_error if the file is not valid.
+   */
+  virtual void findRows( const char *begin,
+                         const char *end,
+                         RowRanges &rows ) const =0;
+
+  /*! \brief Parses a row found by findRows().
+   * \exception std::runtime_error if the row is not valid.
+   */
+  virtual void parseRow( const char *begin,
+                         const char *end,
+                         TestDataRow &row ) const =0;
+
+private:
+  void indexRows();
+
+  /// Prevents the use of the copy constructor.
+  MappedTestDataTable( const MappedTestDataTable &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const MappedTestDataTable &copy );
+
+private:
+  std::string m_fileName;
+  MappedFile *m_file;
+  RowRanges m_rows;
+};
+
+
+/*! \brief Table of test data read from a CSV file.
+ * \ingroup WritingTestFixture
+ *
+ * Each non-empty line that does not start with '#' is a row of three comma
+ * separated fields: the key, the parameters and the expected result. A field
+ * enclosed in double quotes may contain commas, and "" for a double quote.
+ * Fields can not contain line breaks.
+ *
+ * \code
+ * # key, parameters, expected
+ * zero,"0 0",0
+ * ,"1 2",3
+ * \endcode
+ */
+class CPPUNIT_API CsvTestDataTable : public MappedTestDataTable
+{
+public:
+  CsvTestDataTable( const std::string &fileName );
+
+protected:
+  void findRows( const char *begin,
+                 const char *end,
+                 RowRanges &rows ) const;
+
+  void parseRow( const char *begin,
+                 const char *end,
+                 TestDataRow &row ) const;
+};
+
+
+/*! \brief Table of test data read from a XML file.
+ * \ingroup WritingTestFixture
+ *
+ * Each \c row element is a row. Its optional \c key attribute is the key, and
+ * the content of its \c parameters and \c expected child elements are the
+ * parameters and the expected result. The predefined entities and character
+ * references are decoded. Elements other than \c row are ignored.
+ *
+ * \code
+ * <?xml version="1.0" ?>
+ * <rows>
+ *   <row key="zero"><parameters>0 0</parameters><expected>0</expected></row>
+ *   <row><parameters>1 2</parameters><expected>3</expected></row>
+ * </rows>
+ * \endcode
+ */
+class CPPUNIT_API XmlTestDataTable : public MappedTestDataTable
+{
+public:
+  XmlTestDataTable( const std::string &fileName );
+
+protected:
+  void findRows( const char *begin,
+                 const char *end,
+                 RowRanges &rows ) const;
+
+  void parseRow( const char *begin,
+                 const char *end,
+                 TestDataRow &row ) const;
+};
+
+
+/*! \brief Table of test data read from a file of fixed size binary records.
+ * \ingroup WritingTestFixture
+ *
+ * Each record is a row: its first \a parametersSize bytes are the parameters,
+ * and the remaining bytes the expected result. Rows have no key.
+ */
+class CPPUNIT_API BinaryTestDataTable : public MappedTestDataTable
+{
+public:
+  /*! Constructs a table of records.
+   * \param fileName Name of the file.
+   * \param recordSize Size of a record in bytes. Must be > 0.
+   * \param parametersSize Size of the parameters in bytes, <= \a recordSize.
+   */
+  BinaryTestDataTable( const std::string &fileName,
+                       int recordSize,
+                       int parametersSize );
+
+protected:
+  void findRows( const char *begin,
+                 const char *end,
+                 RowRanges &rows ) const;
+
+  void parseRow( const char *begin,
+                 const char *end,
+                 TestDataRow &row ) const;
+
+private:
+  int m_recordSize;
+  int m_parametersSize;
+};
+
+
+CPPUNIT_NS_END
+
+#if CPPUNIT_NEED_DLL_DECL
+#pragma warning( pop )
+#endif
+
+#endif  // CPPUNIT_EXTENSIONS_TESTDATATABLE_H
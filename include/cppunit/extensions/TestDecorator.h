@@ -28,6 +28,8 @@ public:
 
   std::string getName() const;
 
+  const std::string &getNameRef() const;
+
   void run( TestResult *result );
 
   int getChildTestCount() const;
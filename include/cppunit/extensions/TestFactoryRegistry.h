@@ -74,6 +74,10 @@ class TestSuite;
  * Since a TestFactoryRegistry is a TestFactory, the named registries can be 
  * registered in the unnamed registry, creating the hierarchy links.
  *
+ * getRegistry(), registerFactory() and unregisterFactory() may be called
+ * concurrently, such as by the static constructors of test plug-ins opened
+ * with PlugInManager::loadConcurrently().
+ *
  * \see TestSuiteFactory, AutoRegisterSuite
  * \see CPPUNIT_TEST_SUITE_REGISTRATION, CPPUNIT_TEST_SUITE_NAMED_REGISTRATION
  */
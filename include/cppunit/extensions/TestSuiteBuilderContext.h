@@ -13,6 +13,7 @@
 
 CPPUNIT_NS_BEGIN
 
+class SuiteFixture;
 class TestSuite;
 class TestFixture;
 class TestFixtureFactory;
@@ -62,7 +63,18 @@ public:
    */
   std::string getTestNameFor( const std::string &testMethodName ) const;
 
+  /*! \brief Returns the namer of the fixture suite.
+   *
+   * Used by CPPUNIT_TEST() to name the tests (see
+   * TestCase::TestCase(const TestNamer &,const char *)).
+   * \return Namer of the fixture.
+   */
+  const TestNamer &getTestNamer() const;
+
   /*! \brief Adds property pair.
+   *
+   * The property "max_rss_mb" also sets the peak memory budget of the tests
+   * of the suite, in megabytes (see TestSuite::setPeakMemoryBudget()).
    * \param key   PropertyKey string to add.
    * \param value PropertyValue string to add.
    */
@@ -74,6 +86,12 @@ public:
    */
   const std::string getStringProperty( const std::string &key ) const;
 
+  /*! \brief Sets the resources shared by the tests of the fixture suite.
+   * \param fixture Suite fixture. Not owned by the suite.
+   * \see TestSuite::setSuiteFixture(), CPPUNIT_TEST_SUITE_SETUP().
+   */
+  void setSuiteFixture( SuiteFixture *fixture );
+
 protected:
   TestFixture *makeTestFixture() const;
 
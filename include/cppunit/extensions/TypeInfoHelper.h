@@ -21,6 +21,8 @@ CPPUNIT_NS_BEGIN
      * \return The string returned by type_info::name() without
      *         the "class" prefix. If the name is not prefixed
      *         by "class", it is returned as this.
+     *
+     * The name of each type is only extracted once, then cached.
      */
     static std::string getClassName( const std::type_info &info );
   };
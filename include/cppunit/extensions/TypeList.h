@@ -0,0 +1,43 @@
+#ifndef CPPUNIT_EXTENSIONS_TYPELIST_H
+#define CPPUNIT_EXTENSIONS_TYPELIST_H
+
+#include <cppunit/Portability.h>
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief (Implementation) Marks the unused entries of a TypeList.
+ */
+class TypeListEnd
+{
+};
+
+
+/*! \brief List of types a typed test suite is instantiated for.
+ * \ingroup CreatingTestSuite
+ *
+ * A list holds up to 16 types. It is never instantiated: it only carries its
+ * template arguments to CPPUNIT_TYPED_TEST_SUITE_REGISTRATION().
+ *
+ * \code
+ * typedef CppUnit::TypeList<int, double, std::string> ValueTypes;
+ * \endcode
+ *
+ * \see CPPUNIT_TYPED_TEST_SUITE_REGISTRATION, AutoRegisterTypedSuites.
+ */
+template<class T1 = TypeListEnd, class T2 = TypeListEnd,
+         class T3 = TypeListEnd, class T4 = TypeListEnd,
+         class T5 = TypeListEnd, class T6 = TypeListEnd,
+         class T7 = TypeListEnd, class T8 = TypeListEnd,
+         class T9 = TypeListEnd, class T10 = TypeListEnd,
+         class T11 = TypeListEnd, class T12 = TypeListEnd,
+         class T13 = TypeListEnd, class T14 = TypeListEnd,
+         class T15 = TypeListEnd, class T16 = TypeListEnd>
+class TypeList
+{
+};
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_EXTENSIONS_TYPELIST_H
@@ -5,18 +5,18 @@
 
 
 /*! \brief Adds a parameterized test method to the suite.
+ *
+ * The rows are read from the XML file named by the \c XmlFileName property
+ * of the suite (see CPPUNIT_TEST_SUITE_PROPERTY()), using XmlTestDataTable.
  * \param testMethod Name of the method of the test case to add to the
  *                   suite. The signature of the method must be of
  *                   type: void testMethod(std::istream& param_in, std::istream& exp_in);
- * \see  CPPUNIT_TEST_SUITE.
+ * \see  CPPUNIT_TEST_SUITE, CPPUNIT_TEST_DATA.
  */
-#define CPPUNIT_TEST_XML( testMethod)											                    \
-	CPPUNIT_TEST_ADD( new CppUnit::ParameterizedTestCase<ThisTestFixtureType>(  \
-					context.getTestNameFor( #testMethod ),							                \
-					#testMethod,												                                \
-					&TestFixtureType::testMethod,							                          \
-					context.makeFixture(),										                          \
-					context.getStringProperty( std::string("XmlFileName") ) ) )
+#define CPPUNIT_TEST_XML( testMethod )                                          \
+    CPPUNIT_TEST_DATA( testMethod,                                              \
+                       new CPPUNIT_NS::XmlTestDataTable(                        \
+                           context.getStringProperty( std::string("XmlFileName") ) ) )
 
 
 
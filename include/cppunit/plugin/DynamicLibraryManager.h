@@ -37,12 +37,26 @@ public:
   typedef void *Symbol;
   typedef void *LibraryHandle;
 
+  /// When the functions used by the library are resolved.
+  enum SymbolResolution
+  {
+    /// All the symbols are resolved when the library is loaded.
+    resolveOnLoad = 0,
+    /*! Functions are resolved on their first call, which makes loading
+     * faster. Only supported by the Unix loader, other loaders always
+     * resolve the symbols on load.
+     */
+    resolveOnFirstCall
+  };
+
   /*! \brief Loads the specified library.
    * \param libraryFileName Name of the library to load.
+   * \param symbolResolution When the functions used by the library are resolved.
    * \exception DynamicLibraryManagerException if a failure occurs while loading
    *            the library (fail to found or load the library).
    */
-  DynamicLibraryManager( const std::string &libraryFileName );
+  DynamicLibraryManager( const std::string &libraryFileName,
+                         SymbolResolution symbolResolution = resolveOnLoad );
 
   /// Releases the loaded library..
   ~DynamicLibraryManager();
@@ -111,6 +125,7 @@ private:
 private:
   LibraryHandle m_libraryHandle;
   std::string m_libraryName;
+  SymbolResolution m_symbolResolution;
 };
 
 
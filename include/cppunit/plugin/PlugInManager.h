@@ -10,18 +10,27 @@
 #pragma warning( disable: 4251 )  // X needs to have dll-interface to be used by clients of class Z
 #endif
 
+#include <cppunit/plugin/DynamicLibraryManager.h>
 #include <cppunit/plugin/PlugInParameters.h>
+#include <cppunit/portability/CppUnitDeque.h>
+#include <cppunit/portability/CppUnitVector.h>
 struct CppUnitTestPlugIn;
 
 CPPUNIT_NS_BEGIN
 
 
-class DynamicLibraryManager;
 class TestResult;
 class XmlOutputter;
 
 
 /*! \brief Manges TestPlugIn.
+ *
+ * Loading many large plug-ins can take a while before the first test runs.
+ * It can be made faster by resolving the functions used by the plug-ins on
+ * their first call (see setSymbolResolution()), and by opening the libraries
+ * of the plug-ins concurrently (see loadConcurrently()). The time taken to
+ * load each plug-in is available with getOpenTimeAt() and
+ * getInitializeTimeAt().
  */
 class CPPUNIT_API PlugInManager
 {
@@ -46,6 +55,64 @@ public:
   void load( const std::string &libraryFileName,
              const PlugInParameters &parameters = PlugInParameters() );
 
+  /*! \brief Loads several plug-ins, opening their libraries concurrently.
+   *
+   * The libraries are opened on up to \a threadCount threads at once, which
+   * overlaps the time spent reading them and running their static
+   * constructors. The registration of the suites done by the static
+   * constructors (see CPPUNIT_TEST_SUITE_REGISTRATION()) is thread safe.
+   * CppUnitTestPlugIn::initialize() is then called for each plug-in on the
+   * calling thread, in order, since plug-ins are not required to be thread
+   * safe.
+   *
+   * If a library fails to load, the plug-ins that precede it are initialized,
+   * the following ones are unloaded, and the exception is thrown, as if each
+   * plug-in had been loaded in order by load().
+   *
+   * \param libraryFileNames Name of the files that contain the TestPlugIn.
+   * \param parameters Parameters passed to each plug-in, in the order of
+   *                   \a libraryFileNames. Missing parameters are empty.
+   * \param threadCount Maximum number of libraries opened at once. The
+   *                    libraries are opened one at a time on the calling
+   *                    thread if the platform has no thread support.
+   * \exception DynamicLibraryManagerException is thrown if an error occurs
+   *            during loading.
+   */
+  void loadConcurrently( const CppUnitVector<std::string> &libraryFileNames,
+                         const CppUnitVector<PlugInParameters> &parameters,
+                         int threadCount );
+
+  /*! \brief Sets when the functions used by the plug-ins are resolved.
+   *
+   * Only affects the plug-ins loaded afterward. Resolving the functions on
+   * their first call (DynamicLibraryManager::resolveOnFirstCall) makes the
+   * loading faster, but a missing function is only reported when it is called
+   * and usually aborts the process instead of failing the load.
+   */
+  void setSymbolResolution( DynamicLibraryManager::SymbolResolution symbolResolution );
+
+  /*! \brief Returns the number of loaded plug-ins.
+   */
+  int getPlugInCount() const;
+
+  /*! \brief Returns the name of the file of a loaded plug-in.
+   */
+  std::string getPlugInFileNameAt( int index ) const;
+
+  /*! \brief Returns the wall clock time taken to open the library of a
+   *         loaded plug-in, in seconds.
+   *
+   * For libraries opened by loadConcurrently(), it includes the time spent
+   * waiting for the other libraries, since most platforms serialize the
+   * execution of static constructors.
+   */
+  double getOpenTimeAt( int index ) const;
+
+  /*! \brief Returns the wall clock time taken by the
+   *         CppUnitTestPlugIn::initialize() of a loaded plug-in, in seconds.
+   */
+  double getInitializeTimeAt( int index ) const;
+
   /*! \brief Unloads the specified plug-in.
    * \param libraryFileName Name of the file that contains the TestPlugIn passed
    *                        to a previous call to load().
@@ -81,8 +148,17 @@ protected:
     std::string m_fileName;
     DynamicLibraryManager *m_manager;
     CppUnitTestPlugIn *m_interface;
+    double m_openTime;
+    double m_initializeTime;
   };
 
+  /*! Initializes an opened plug-in and adds it to the loaded plug-ins.
+   * \param plugIn Information about the plug-in, whose library is opened.
+   * \param parameters List of string passed to the plug-in.
+   */
+  void initialize( PlugInInfo &plugIn,
+                   const PlugInParameters &parameters );
+
   /*! Unloads the specified plug-in.
    * \param plugIn Information about the plug-in.
    */
@@ -98,6 +174,7 @@ private:
 private:
   typedef CppUnitDeque<PlugInInfo> PlugIns;
   PlugIns m_plugIns;
+  DynamicLibraryManager::SymbolResolution m_symbolResolution;
 };
 
 
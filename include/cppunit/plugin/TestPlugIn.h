@@ -126,6 +126,56 @@ typedef CppUnitTestPlugIn *(*TestPlugInSignature)();
   typedef char __CppUnitPlugInExportFunctionDummyTypeDef  // dummy typedef so it can end with ';'
 
 
+/*! \brief Name of the function exported by a test plug-in to control code
+ *         coverage counters.
+ * \ingroup WritingTestPlugIn
+ *
+ * The signature of the exported function is:
+ * \code
+ * void CPPUNIT_PLUGIN_COVERAGE_NAME( int dump );
+ * \endcode
+ *
+ * If \c dump is 0, the coverage counters are reset, otherwise they are
+ * written to the coverage data files.
+ *
+ * Used by DllPlugInTester to find the tests impacted by a change.
+ */
+#define CPPUNIT_PLUGIN_COVERAGE_NAME cppunitTestPlugInCoverage
+
+/*! \brief Type of the coverage function exported by a plug-in.
+ * \ingroup WritingTestPlugIn
+ */
+typedef void (*TestPlugInCoverageSignature)( int dump );
+
+
+/*! \def CPPUNIT_PLUGIN_COVERAGE_IMPL()
+ * \brief Implements the coverage function exported by the test plug-in.
+ * \ingroup WritingTestPlugIn
+ *
+ * The function is only exported if CPPUNIT_PLUGIN_GCOV is defined. Define it
+ * when the plug-in is compiled and linked with gcc coverage instrumentation
+ * (--coverage -DCPPUNIT_PLUGIN_GCOV): the gcc coverage run-time functions
+ * are then linked in the plug-in and called by the exported function.
+ */
+#if defined(CPPUNIT_PLUGIN_GCOV)
+extern "C" void __gcov_reset(void);
+extern "C" void __gcov_dump(void);
+
+#define CPPUNIT_PLUGIN_COVERAGE_IMPL()                                   \
+  CPPUNIT_PLUGIN_EXPORT void CPPUNIT_PLUGIN_COVERAGE_NAME( int dump )    \
+  {                                                                      \
+    if ( dump )                                                          \
+      __gcov_dump();                                                     \
+    else                                                                 \
+      __gcov_reset();                                                    \
+  }                                                                      \
+  typedef char __CppUnitPlugInCoverageDummyTypeDef
+#else
+#define CPPUNIT_PLUGIN_COVERAGE_IMPL()                                   \
+  typedef char __CppUnitPlugInCoverageDummyTypeDef
+#endif
+
+
 // Note: This include should remain after definition of CppUnitTestPlugIn
 #include <cppunit/plugin/TestPlugInDefaultImpl.h>
 
@@ -179,6 +229,7 @@ typedef CppUnitTestPlugIn *(*TestPlugInSignature)();
  * \ingroup WritingTestPlugIn
  *
  * This macro exports the test plug-in function using the subclass, 
+ * the coverage function using CPPUNIT_PLUGIN_COVERAGE_IMPL(),
  * and implements the 'main' function for the plug-in using 
  * CPPUNIT_PLUGIN_IMPLEMENT_MAIN().
  *
@@ -187,10 +238,12 @@ typedef CppUnitTestPlugIn *(*TestPlugInSignature)();
  * not be visible to the DllPlugInTester.
  *
  * \see CppUnitTestPlugIn
- * \see CPPUNIT_PLUGIN_EXPORTED_FUNCTION_IMPL(), CPPUNIT_PLUGIN_IMPLEMENT_MAIN().
+ * \see CPPUNIT_PLUGIN_EXPORTED_FUNCTION_IMPL(), CPPUNIT_PLUGIN_COVERAGE_IMPL(),
+ *      CPPUNIT_PLUGIN_IMPLEMENT_MAIN().
  */
 #define CPPUNIT_PLUGIN_IMPLEMENT()                                          \
   CPPUNIT_PLUGIN_EXPORTED_FUNCTION_IMPL( CPPUNIT_NS::TestPlugInDefaultImpl );  \
+  CPPUNIT_PLUGIN_COVERAGE_IMPL();                                           \
   CPPUNIT_PLUGIN_IMPLEMENT_MAIN()
 
 
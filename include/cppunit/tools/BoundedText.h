@@ -0,0 +1,175 @@
+#ifndef CPPUNIT_TOOLS_BOUNDEDTEXT_H
+#define CPPUNIT_TOOLS_BOUNDEDTEXT_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/portability/Stream.h>
+#include <string>
+
+#if !defined(CPPUNIT_NO_STREAM)
+#include <streambuf>
+#include <stdio.h>
+#endif
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Text that only keeps its head and its tail once it is too long.
+ *
+ * Used to render the values reported by failed assertions. A failed
+ * CPPUNIT_ASSERT_EQUAL() on a 50 MB string only keeps about a thousand
+ * characters of each value, so that the failure does not copy the values
+ * into the Message, the TestResultCollector and the outputters.
+ *
+ * The text is never stored in full: the characters beyond the head are only
+ * counted, hashed and kept in a ring buffer for the tail. If the text is
+ * longer than the maximum length, str() returns:
+ * \code
+ * head[... 52427776 of 52428800 characters elided, hash 8d6a1f0c ...]tail
+ * \endcode
+ * The hash (32 bits FNV-1a) of the whole text tells apart two elided values
+ * that only differ in the middle. The elided text is never longer than the
+ * maximum length.
+ *
+ * \sa setMaximumLength(), BoundedTextStreamBuffer.
+ */
+class CPPUNIT_API BoundedText
+{
+public:
+  /*! Constructs an empty text bounded by the default maximum length.
+   */
+  BoundedText();
+
+  /*! Constructs an empty text.
+   * \param maximumLength Maximum length of the text, 0 if unbounded.
+   */
+  BoundedText( unsigned int maximumLength );
+
+  /// Destructor.
+  ~BoundedText();
+
+  /*! \brief Appends characters to the text.
+   */
+  void append( const char *text,
+               unsigned long length );
+
+  /*! \brief Appends a character to the text.
+   */
+  void append( char c );
+
+  /*! \brief Returns the length of the whole appended text.
+   */
+  unsigned long length() const;
+
+  /*! \brief Returns the text, elided if it is longer than the maximum length.
+   */
+  std::string str() const;
+
+  /*! \brief Returns a text elided to the default maximum length.
+   */
+  static std::string elide( const std::string &text );
+
+  /*! \brief Sets the default maximum length of the rendered values.
+   *
+   * The default is 1024 characters. The maximum length is raised to 128
+   * characters so that an elided text always has room for its head and tail.
+   * \param maximumLength Maximum length of the text, 0 if unbounded.
+   */
+  static void setMaximumLength( unsigned int maximumLength );
+
+  /*! \brief Returns the default maximum length of the rendered values.
+   */
+  static unsigned int maximumLength();
+
+private:
+  /// Prevents the use of the copy constructor.
+  BoundedText( const BoundedText &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const BoundedText &copy );
+
+  unsigned int headCapacity() const;
+  unsigned int tailCapacity() const;
+
+private:
+  unsigned int m_maximumLength;
+  std::string m_head;
+  std::string m_tail;
+  unsigned int m_tailStart;
+  unsigned long m_length;
+  unsigned long m_hash;
+};
+
+
+#if !defined(CPPUNIT_NO_STREAM)
+
+/*! \brief Stream buffer that writes to a BoundedText.
+ *
+ * \code
+ * BoundedText text;
+ * BoundedTextStreamBuffer buffer( text );
+ * OStream stream( &buffer );
+ * stream  <<  value;
+ * return text.str();
+ * \endcode
+ */
+class BoundedTextStreamBuffer : public std::streambuf
+{
+public:
+  BoundedTextStreamBuffer( BoundedText &text )
+      : m_text( text )
+  {
+  }
+
+protected:
+  int overflow( int c )
+  {
+    if ( c != EOF )
+      m_text.append( (char)c );
+    return c == EOF ? 0 : c;
+  }
+
+  std::streamsize xsputn( const char *text,
+                          std::streamsize length )
+  {
+    m_text.append( text, (unsigned long)length );
+    return length;
+  }
+
+private:
+  /// Prevents the use of the copy constructor.
+  BoundedTextStreamBuffer( const BoundedTextStreamBuffer &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const BoundedTextStreamBuffer &copy );
+
+private:
+  BoundedText &m_text;
+};
+
+#else   // !defined(CPPUNIT_NO_STREAM)
+
+class BoundedTextStreamBuffer : public StreamBuffer
+{
+public:
+  BoundedTextStreamBuffer( BoundedText &text )
+      : m_text( text )
+  {
+  }
+
+public: // overridden from StreamBuffer
+  void write( const char *text, unsigned int length )
+  {
+    m_text.append( text, length );
+  }
+
+private:
+  BoundedText &m_text;
+};
+
+#endif  // !defined(CPPUNIT_NO_STREAM)
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_TOOLS_BOUNDEDTEXT_H
@@ -0,0 +1,47 @@
+#ifndef CPPUNIT_TOOLS_PEAKMEMORY_H
+#define CPPUNIT_TOOLS_PEAKMEMORY_H
+
+#include <cppunit/Portability.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Peak resident memory of the process.
+ *
+ * TestCase::run() uses it to measure the peak memory of each test when the
+ * TestResult tracks it (see TestResult::setTracksPeakMemory()).
+ *
+ * On Linux the peak (VmHWM) is read from /proc/self/status and reset by
+ * writing to /proc/self/clear_refs. Elsewhere the peak is the maximum
+ * resident set size given by getrusage(), which can not be reset.
+ *
+ * The memory is the one of the whole process: the tests run by other
+ * threads at the same time are measured together.
+ */
+class CPPUNIT_API PeakMemory
+{
+public:
+  /*! \brief Resets the peak to the current resident memory.
+   * \return \c true if the peak was reset, \c false if the platform does not
+   *         support it.
+   */
+  static bool reset();
+
+  /*! \brief Returns the peak resident memory since the last reset() or the
+   *         start of the process, in kilobytes.
+   * \return Peak memory, or -1 if it can not be measured.
+   */
+  static long kilobytes();
+
+  /*! \brief Returns the size of the address space of the process, in
+   *         kilobytes.
+   * \return Size of the address space, or -1 if it can not be measured.
+   */
+  static long addressSpaceKilobytes();
+};
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_TOOLS_PEAKMEMORY_H
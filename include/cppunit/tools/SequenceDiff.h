@@ -0,0 +1,215 @@
+#ifndef CPPUNIT_TOOLS_SEQUENCEDIFF_H
+#define CPPUNIT_TOOLS_SEQUENCEDIFF_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <string>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Sequences compared by SequenceDiff.
+ *
+ * The elements are only accessed by index, so that the sequences do not
+ * have to be copied.
+ */
+class CPPUNIT_API DiffSequences
+{
+public:
+  virtual ~DiffSequences();
+
+  /*! \brief Indicates if an element of the expected sequence is equal to an
+   *         element of the actual sequence.
+   */
+  virtual bool areEqual( int expectedIndex,
+                         int actualIndex ) const =0;
+
+  /*! \brief Returns the text of an element of the expected sequence.
+   */
+  virtual std::string expectedElement( int index ) const =0;
+
+  /*! \brief Returns the text of an element of the actual sequence.
+   */
+  virtual std::string actualElement( int index ) const =0;
+};
+
+
+/*! \brief Shortest edit script between two sequences.
+ *
+ * Computed with the linear space variant of the O(ND) algorithm of Eugene
+ * W. Myers: the time is proportional to the length of the sequences times
+ * the number of differences, and the memory to the number of differences.
+ * The common head and tail of the sequences are skipped first, so that
+ * comparing multi-megabyte sequences that differ in a few places is fast.
+ *
+ * The computation gives up once the edit distance or the number of
+ * comparisons exceeds a limit. Only the removed and inserted elements are
+ * stored.
+ *
+ * render() formats the edits as the hunks of a unified diff:
+ * \code
+ * @@ -12,3 +12,3 @@
+ *  <total>
+ * -  <count>3</count>
+ * +  <count>4</count>
+ *  </total>
+ * \endcode
+ */
+class CPPUNIT_API SequenceDiff
+{
+public:
+  /// Kind of an edit.
+  enum EditKind
+  {
+    removal = 0,  ///< The element of the expected sequence is missing.
+    insertion     ///< The element of the actual sequence is extra.
+  };
+
+  /// Removal or insertion of an element.
+  struct Edit
+  {
+    EditKind m_kind;
+    int m_expectedIndex;
+    int m_actualIndex;
+  };
+
+  enum
+  {
+    defaultMaximumEditDistance = 2000,   ///< Default limit of the edit distance.
+    contextSize = 3,                     ///< Elements shown around the edits.
+    maximumLineCount = 100               ///< Lines rendered before truncation.
+  };
+
+  /*! Constructs a diff.
+   * \param maximumEditDistance Number of edits beyond which the computation
+   *                            gives up.
+   * \param maximumComparisons Number of comparisons of elements beyond which
+   *                           the computation gives up.
+   */
+  SequenceDiff( int maximumEditDistance = defaultMaximumEditDistance,
+                long maximumComparisons = 20000000L );
+
+  /// Destructor.
+  ~SequenceDiff();
+
+  /*! \brief Computes the edits that turn the expected sequence into the
+   *         actual sequence.
+   * \return \c true if the edits were computed, \c false if a limit was
+   *         exceeded.
+   */
+  bool compute( const DiffSequences &sequences,
+                int expectedCount,
+                int actualCount );
+
+  /// Returns the number of edits.
+  int editCount() const;
+
+  /// Returns an edit.
+  const Edit &editAt( int index ) const;
+
+  /// Returns the number of removed elements.
+  int removalCount() const;
+
+  /// Returns the number of inserted elements.
+  int insertionCount() const;
+
+  /*! \brief Returns the number of elements at the start of both sequences
+   *         that are equal.
+   *
+   * Available even if the computation gave up.
+   */
+  int commonHeadLength() const;
+
+  /*! \brief Renders the edits as the hunks of a unified diff.
+   *
+   * The lines are prefixed by ' ' for the context, '-' for the removed
+   * elements and '+' for the inserted elements, and their length is bounded
+   * by BoundedText.
+   * \param sequences Sequences the diff was computed on.
+   * \param joinElements If \c true, consecutive elements of the same kind
+   *                     are rendered on the same line, which suits the
+   *                     characters of a string. Otherwise each element is
+   *                     rendered on its own line.
+   */
+  std::string render( const DiffSequences &sequences,
+                      bool joinElements ) const;
+
+private:
+  struct Point
+  {
+    int m_x;
+    int m_y;
+  };
+
+  bool findPath( int left, int top, int right, int bottom,
+                 CppUnitVector<Point> &path );
+
+  bool findMiddleSnake( int left, int top, int right, int bottom,
+                        Point &start, Point &finish );
+
+  bool areEqual( int expectedIndex, int actualIndex );
+
+  void addEdit( EditKind kind, int expectedIndex, int actualIndex );
+
+  void addEdits( const CppUnitVector<Point> &path );
+
+  /// Prevents the use of the copy constructor.
+  SequenceDiff( const SequenceDiff &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const SequenceDiff &copy );
+
+private:
+  int m_maximumEditDistance;
+  long m_maximumComparisons;
+  const DiffSequences *m_sequences;
+  long m_comparisonCount;
+  bool m_hasGivenUp;
+  int m_expectedCount;
+  int m_commonHeadLength;
+  int m_removalCount;
+  CppUnitVector<Edit> m_edits;
+};
+
+
+/*! \brief Describes the differences between two sequences.
+ *
+ * The description starts with the count of removed and added elements,
+ * followed by the hunks rendered by SequenceDiff::render(). If the diff could
+ * not be computed, only the position of the first difference is given.
+ * \param sequences Sequences to compare.
+ * \param expectedCount Number of elements of the expected sequence.
+ * \param actualCount Number of elements of the actual sequence.
+ * \param elementName Name of an element, such as "line".
+ * \param joinElements See SequenceDiff::render().
+ */
+std::string CPPUNIT_API describeSequenceDifference( const DiffSequences &sequences,
+                                                    int expectedCount,
+                                                    int actualCount,
+                                                    const std::string &elementName,
+                                                    bool joinElements );
+
+
+/*! \brief Describes the differences between two strings.
+ *
+ * Strings of several lines are compared line by line, the other ones
+ * character by character. Used by CPPUNIT_ASSERT_EQUAL() on strings.
+ * \code
+ * Difference: 1 line removed, 1 line added
+ * @@ -2,3 +2,3 @@
+ *  <total>
+ * -  <count>3</count>
+ * +  <count>4</count>
+ *  </total>
+ * \endcode
+ * \return The description of the differences, or an empty string if the
+ *         strings are equal.
+ */
+std::string CPPUNIT_API describeStringDifference( const std::string &expected,
+                                                  const std::string &actual );
+
+
+CPPUNIT_NS_END
+
+#endif  // CPPUNIT_TOOLS_SEQUENCEDIFF_H
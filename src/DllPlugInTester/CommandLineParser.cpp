@@ -1,4 +1,5 @@
 #include "CommandLineParser.h"
+#include <stdlib.h>
 
 
 CommandLineParser::CommandLineParser( int argc, 
@@ -10,6 +11,18 @@ CommandLineParser::CommandLineParser( int argc,
     , m_useText( false )
     , m_useCout( false )
     , m_waitBeforeExit( false )
+    , m_fastExit( false )
+    , m_dataShardIndex( 0 )
+    , m_dataShardCount( 1 )
+    , m_stressThreadCount( 0 )
+    , m_stressRepeatCount( 1 )
+    , m_lazyBinding( false )
+    , m_loadThreadCount( 1 )
+    , m_printLoadTimes( false )
+    , m_workerCount( 0 )
+    , m_requireAssertions( false )
+    , m_countAllocations( false )
+    , m_maximumRssMegabytes( 0 )
     , m_currentArgument( 0 )
 {
   for ( int index =1; index < argc; ++index )
@@ -52,11 +65,126 @@ CommandLineParser::parse()
       m_useCout = true;
     else if ( isOption( "w", "wait" ) )
       m_waitBeforeExit = true;
+    else if ( isOption( "F", "fast-exit" ) )
+      m_fastExit = true;
+    else if ( isOption( "f", "filter" ) )
+      m_filters.push_back( getNextParameter() );
+    else if ( isOption( "X", "exclude" ) )
+      m_excludes.push_back( getNextParameter() );
+    else if ( isOption( "R", "record-impact" ) )
+      m_recordImpactFileName = getNextParameter();
+    else if ( isOption( "I", "impact-map" ) )
+      m_impactMapFileName = getNextParameter();
+    else if ( isOption( "C", "changed-files" ) )
+      m_changedFilesFileName = getNextParameter();
+    else if ( isOption( "D", "data-shard" ) )
+      readDataShard( getNextParameter() );
+    else if ( isOption( "S", "stress" ) )
+      readStress( getNextParameter() );
+    else if ( isOption( "O", "verify-order" ) )
+      m_orderPropertiesFileName = getNextParameter();
+    else if ( isOption( "L", "lazy-binding" ) )
+      m_lazyBinding = true;
+    else if ( isOption( "j", "load-threads" ) )
+      readLoadThreads( getNextParameter() );
+    else if ( isOption( "M", "manifest" ) )
+      m_manifestFileName = getNextParameter();
+    else if ( isOption( "T", "load-times" ) )
+      m_printLoadTimes = true;
+    else if ( isOption( "P", "serve" ) )
+      m_serveSocketName = getNextParameter();
+    else if ( isOption( "r", "request" ) )
+      m_requestSocketName = getNextParameter();
+    else if ( isOption( "W", "workers" ) )
+      readWorkers( getNextParameter() );
+    else if ( isOption( "A", "require-assertions" ) )
+      m_requireAssertions = true;
+    else if ( isOption( "a", "count-allocations" ) )
+      m_countAllocations = true;
+    else if ( isOption( "m", "max-rss-mb" ) )
+      readMaximumRss( getNextParameter() );
     else if ( !m_option.empty() )
       fail( "Unknown option" );
     else if ( hasNextArgument() )
       readNonOptionCommands();
   }
+
+  if ( m_impactMapFileName.empty() != m_changedFilesFileName.empty() )
+    throw CommandLineParserException( "--impact-map and --changed-files must be "
+                                      "used together" );
+
+  if ( !m_serveSocketName.empty()  &&  !m_requestSocketName.empty() )
+    throw CommandLineParserException( "--serve and --request can not be used "
+                                      "together" );
+
+  if ( m_workerCount > 0  &&  
+       ( m_stressThreadCount > 0  ||  !m_orderPropertiesFileName.empty()  ||
+         !m_recordImpactFileName.empty()  ||  !m_impactMapFileName.empty()  ||
+         !m_serveSocketName.empty()  ||  !m_requestSocketName.empty() ) )
+    throw CommandLineParserException( "--workers can not be used with --stress, "
+                                      "--verify-order, --record-impact, "
+                                      "--impact-map, --serve or --request" );
+}
+
+
+void 
+CommandLineParser::readDataShard( const std::string &shard )
+{
+  const char *index = shard.c_str();
+  char *slash;
+  m_dataShardIndex = strtol( index, &slash, 10 );
+  char *end = slash;
+  if ( *slash == '/' )
+    m_dataShardCount = strtol( slash + 1, &end, 10 );
+  if ( slash == index  ||  *slash != '/'  ||  end == slash + 1  ||  *end != '\0'  ||
+       m_dataShardCount <= 0  ||  m_dataShardIndex < 0  ||  
+       m_dataShardIndex >= m_dataShardCount )
+    fail( "Invalid data shard (expected index/count): " + shard );
+}
+
+
+void 
+CommandLineParser::readStress( const std::string &stress )
+{
+  const char *threads = stress.c_str();
+  char *end;
+  m_stressThreadCount = strtol( threads, &end, 10 );
+  char *repeat = end;
+  if ( *repeat == 'x' )
+    m_stressRepeatCount = strtol( repeat + 1, &end, 10 );
+  if ( repeat == threads  ||  end == repeat + 1  ||  *end != '\0'  ||
+       m_stressThreadCount <= 0  ||  m_stressRepeatCount <= 0 )
+    fail( "Invalid stress (expected threads or threadsxrepeat): " + stress );
+}
+
+
+void 
+CommandLineParser::readLoadThreads( const std::string &threads )
+{
+  char *end;
+  m_loadThreadCount = strtol( threads.c_str(), &end, 10 );
+  if ( end == threads.c_str()  ||  *end != '\0'  ||  m_loadThreadCount <= 0 )
+    fail( "Invalid number of load threads: " + threads );
+}
+
+
+void 
+CommandLineParser::readWorkers( const std::string &workers )
+{
+  char *end;
+  m_workerCount = strtol( workers.c_str(), &end, 10 );
+  if ( end == workers.c_str()  ||  *end != '\0'  ||  m_workerCount <= 0 )
+    fail( "Invalid number of worker processes: " + workers );
+}
+
+
+void 
+CommandLineParser::readMaximumRss( const std::string &megabytes )
+{
+  char *end;
+  m_maximumRssMegabytes = strtol( megabytes.c_str(), &end, 10 );
+  if ( end == megabytes.c_str()  ||  *end != '\0'  ||  m_maximumRssMegabytes <= 0 )
+    fail( "Invalid peak memory budget: " + megabytes );
 }
 
 
@@ -232,6 +360,13 @@ CommandLineParser::waitBeforeExit() const
 }
 
 
+bool 
+CommandLineParser::useFastExit() const
+{
+  return m_fastExit;
+}
+
+
 int 
 CommandLineParser::getPlugInCount() const
 {
@@ -251,3 +386,157 @@ CommandLineParser::getTestPath() const
   return m_testPath;
 }
 
+
+
+int 
+CommandLineParser::getFilterCount() const
+{
+  return m_filters.size();
+}
+
+
+std::string 
+CommandLineParser::getFilterAt( int index ) const
+{
+  return m_filters[ index ];
+}
+
+
+int 
+CommandLineParser::getExcludeCount() const
+{
+  return m_excludes.size();
+}
+
+
+std::string 
+CommandLineParser::getExcludeAt( int index ) const
+{
+  return m_excludes[ index ];
+}
+
+
+std::string 
+CommandLineParser::getRecordImpactFileName() const
+{
+  return m_recordImpactFileName;
+}
+
+
+std::string 
+CommandLineParser::getImpactMapFileName() const
+{
+  return m_impactMapFileName;
+}
+
+
+std::string 
+CommandLineParser::getChangedFilesFileName() const
+{
+  return m_changedFilesFileName;
+}
+
+
+int 
+CommandLineParser::getDataShardIndex() const
+{
+  return m_dataShardIndex;
+}
+
+
+int 
+CommandLineParser::getDataShardCount() const
+{
+  return m_dataShardCount;
+}
+
+
+int 
+CommandLineParser::getStressThreadCount() const
+{
+  return m_stressThreadCount;
+}
+
+
+int 
+CommandLineParser::getStressRepeatCount() const
+{
+  return m_stressRepeatCount;
+}
+
+
+std::string 
+CommandLineParser::getOrderPropertiesFileName() const
+{
+  return m_orderPropertiesFileName;
+}
+
+
+bool 
+CommandLineParser::useLazyBinding() const
+{
+  return m_lazyBinding;
+}
+
+
+int 
+CommandLineParser::getLoadThreadCount() const
+{
+  return m_loadThreadCount;
+}
+
+
+std::string 
+CommandLineParser::getManifestFileName() const
+{
+  return m_manifestFileName;
+}
+
+
+bool 
+CommandLineParser::printLoadTimes() const
+{
+  return m_printLoadTimes;
+}
+
+
+std::string 
+CommandLineParser::getServeSocketName() const
+{
+  return m_serveSocketName;
+}
+
+
+std::string 
+CommandLineParser::getRequestSocketName() const
+{
+  return m_requestSocketName;
+}
+
+
+int 
+CommandLineParser::getWorkerCount() const
+{
+  return m_workerCount;
+}
+
+
+bool 
+CommandLineParser::requireAssertions() const
+{
+  return m_requireAssertions;
+}
+
+
+bool 
+CommandLineParser::countAllocations() const
+{
+  return m_countAllocations;
+}
+
+
+long 
+CommandLineParser::getMaximumRssMegabytes() const
+{
+  return m_maximumRssMegabytes;
+}
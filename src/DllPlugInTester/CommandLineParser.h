@@ -38,6 +38,25 @@ struct CommandLinePlugInInfo
 -t --text
 -o --cout
 -w --wait
+-f --filter pattern
+-X --exclude pattern
+-R --record-impact mapfile
+-I --impact-map mapfile
+-C --changed-files listfile
+-F --fast-exit
+-D --data-shard index/count
+-S --stress threads[xrepeat]
+-O --verify-order properties-filename
+-L --lazy-binding
+-j --load-threads count
+-M --manifest filename
+-T --load-times
+-P --serve socket-filename
+-r --request socket-filename
+-W --workers count
+-A --require-assertions
+-a --count-allocations
+-m --max-rss-mb megabytes
 filename[="options"]
 :testpath
 
@@ -68,7 +87,30 @@ public:
   bool useTextOutputter() const;
   bool useCoutStream() const;
   bool waitBeforeExit() const;
+  bool useFastExit() const;
   std::string getTestPath() const;
+  int getFilterCount() const;
+  std::string getFilterAt( int index ) const;
+  int getExcludeCount() const;
+  std::string getExcludeAt( int index ) const;
+  std::string getRecordImpactFileName() const;
+  std::string getImpactMapFileName() const;
+  std::string getChangedFilesFileName() const;
+  int getDataShardIndex() const;
+  int getDataShardCount() const;
+  int getStressThreadCount() const;
+  int getStressRepeatCount() const;
+  std::string getOrderPropertiesFileName() const;
+  bool useLazyBinding() const;
+  int getLoadThreadCount() const;
+  std::string getManifestFileName() const;
+  bool printLoadTimes() const;
+  std::string getServeSocketName() const;
+  std::string getRequestSocketName() const;
+  int getWorkerCount() const;
+  bool requireAssertions() const;
+  bool countAllocations() const;
+  long getMaximumRssMegabytes() const;
   int getPlugInCount() const;
   CommandLinePlugInInfo getPlugInAt( int index ) const;
 
@@ -81,6 +123,15 @@ protected:
 
   void readNonOptionCommands();
 
+  void readDataShard( const std::string &shard );
+
+  void readStress( const std::string &stress );
+
+  void readLoadThreads( const std::string &threads );
+
+  void readWorkers( const std::string &workers );
+  void readMaximumRss( const std::string &megabytes );
+
   bool hasNextArgument() const;
 
   std::string getNextArgument();
@@ -111,8 +162,32 @@ protected:
   bool m_useText;
   bool m_useCout;
   bool m_waitBeforeExit;
+  bool m_fastExit;
   std::string m_testPath;
 
+  typedef CppUnitDeque<std::string> Patterns;
+  Patterns m_filters;
+  Patterns m_excludes;
+
+  std::string m_recordImpactFileName;
+  std::string m_impactMapFileName;
+  std::string m_changedFilesFileName;
+  int m_dataShardIndex;
+  int m_dataShardCount;
+  int m_stressThreadCount;
+  int m_stressRepeatCount;
+  std::string m_orderPropertiesFileName;
+  bool m_lazyBinding;
+  int m_loadThreadCount;
+  std::string m_manifestFileName;
+  bool m_printLoadTimes;
+  std::string m_serveSocketName;
+  std::string m_requestSocketName;
+  int m_workerCount;
+  bool m_requireAssertions;
+  bool m_countAllocations;
+  long m_maximumRssMegabytes;
+
   typedef CppUnitDeque<CommandLinePlugInInfo> PlugIns;
   PlugIns m_plugIns;
 
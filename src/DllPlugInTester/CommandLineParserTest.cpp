@@ -78,6 +78,7 @@ CommandLineParserTest::testFlagCompiler()
   CPPUNIT_ASSERT( !_parser->useCoutStream() );
   CPPUNIT_ASSERT( !_parser->useTextOutputter() );
   CPPUNIT_ASSERT( !_parser->useXmlOutputter() );
+  CPPUNIT_ASSERT( !_parser->useFastExit() );
   CPPUNIT_ASSERT_EQUAL( 0, _parser->getPlugInCount() );
 }
 
@@ -103,6 +104,17 @@ CommandLineParserTest::testLongFlagBriefProgress()
 }
 
 
+void 
+CommandLineParserTest::testLongFlagFastExit()
+{
+  static const char *lines[] = { "", "--fast-exit", "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT( _parser->useFastExit() );
+  CPPUNIT_ASSERT_EQUAL( 1, _parser->getPlugInCount() );
+}
+
+
 void 
 CommandLineParserTest::testFileName()
 {
@@ -218,3 +230,251 @@ CommandLineParserTest::testPlugInsWithParameters()
   CPPUNIT_ASSERT_EQUAL( std::string("Clocker.dll"), info2.m_fileName );
   CPPUNIT_ASSERT( info2.m_parameters.getCommandLine().empty() );
 }
+
+
+void 
+CommandLineParserTest::testRepeatedFilters()
+{
+  static const char *lines[] = { "", "--filter", "Network*::*Timeout*",
+                                 "-X", "*::testSlow*", "-f", "regex:Core",
+                                 "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT_EQUAL( 2, _parser->getFilterCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string("Network*::*Timeout*"), 
+                        _parser->getFilterAt( 0 ) );
+  CPPUNIT_ASSERT_EQUAL( std::string("regex:Core"), _parser->getFilterAt( 1 ) );
+  CPPUNIT_ASSERT_EQUAL( 1, _parser->getExcludeCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string("*::testSlow*"), _parser->getExcludeAt( 0 ) );
+  CPPUNIT_ASSERT_EQUAL( 1, _parser->getPlugInCount() );
+}
+
+
+void 
+CommandLineParserTest::testImpactOptions()
+{
+  static const char *lines[] = { "", "-R", "record.map", "--impact-map", "tests.map",
+                                 "-C", "changed.txt", "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT_EQUAL( std::string("record.map"), 
+                        _parser->getRecordImpactFileName() );
+  CPPUNIT_ASSERT_EQUAL( std::string("tests.map"), _parser->getImpactMapFileName() );
+  CPPUNIT_ASSERT_EQUAL( std::string("changed.txt"), 
+                        _parser->getChangedFilesFileName() );
+  CPPUNIT_ASSERT_EQUAL( 1, _parser->getPlugInCount() );
+}
+
+
+void 
+CommandLineParserTest::testImpactMapWithoutChangedFilesThrow()
+{
+  static const char *lines[] = { "", "--impact-map", "tests.map", 
+                                 "TestPlugIn.dll", NULL };
+  parse( lines );
+}
+
+
+void 
+CommandLineParserTest::testDataShard()
+{
+  static const char *lines[] = { "", "--data-shard", "2/3", "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT_EQUAL( 2, _parser->getDataShardIndex() );
+  CPPUNIT_ASSERT_EQUAL( 3, _parser->getDataShardCount() );
+}
+
+
+void 
+CommandLineParserTest::testInvalidDataShardThrow()
+{
+  static const char *lines[] = { "", "-D", "3/3", "TestPlugIn.dll", NULL };
+  parse( lines );
+}
+
+
+void 
+CommandLineParserTest::testStress()
+{
+  static const char *lines[] = { "", "--stress", "8x100", "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT_EQUAL( 8, _parser->getStressThreadCount() );
+  CPPUNIT_ASSERT_EQUAL( 100, _parser->getStressRepeatCount() );
+
+  static const char *threadsOnly[] = { "", "-S", "4", "TestPlugIn.dll", NULL };
+  parse( threadsOnly );
+
+  CPPUNIT_ASSERT_EQUAL( 4, _parser->getStressThreadCount() );
+  CPPUNIT_ASSERT_EQUAL( 1, _parser->getStressRepeatCount() );
+}
+
+
+void 
+CommandLineParserTest::testInvalidStressThrow()
+{
+  static const char *lines[] = { "", "-S", "4x", "TestPlugIn.dll", NULL };
+  parse( lines );
+}
+
+
+void 
+CommandLineParserTest::testVerifyOrder()
+{
+  static const char *lines[] = { "", "--verify-order", "order.properties", 
+                                 "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT_EQUAL( std::string("order.properties"), 
+                        _parser->getOrderPropertiesFileName() );
+}
+
+
+void 
+CommandLineParserTest::testPlugInLoading()
+{
+  static const char *defaults[] = { "", "TestPlugIn.dll", NULL };
+  parse( defaults );
+
+  CPPUNIT_ASSERT( !_parser->useLazyBinding() );
+  CPPUNIT_ASSERT_EQUAL( 1, _parser->getLoadThreadCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string(""), _parser->getManifestFileName() );
+  CPPUNIT_ASSERT( !_parser->printLoadTimes() );
+
+  static const char *lines[] = { "", "-L", "--load-threads", "8", 
+                                 "-M", "plugins.manifest", "-T", 
+                                 "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT( _parser->useLazyBinding() );
+  CPPUNIT_ASSERT_EQUAL( 8, _parser->getLoadThreadCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string("plugins.manifest"), 
+                        _parser->getManifestFileName() );
+  CPPUNIT_ASSERT( _parser->printLoadTimes() );
+}
+
+
+void 
+CommandLineParserTest::testInvalidLoadThreadsThrow()
+{
+  static const char *lines[] = { "", "-j", "0", "TestPlugIn.dll", NULL };
+  parse( lines );
+}
+
+
+void 
+CommandLineParserTest::testServe()
+{
+  static const char *lines[] = { "", "--serve", "/tmp/tests.socket", 
+                                 "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT_EQUAL( std::string("/tmp/tests.socket"), 
+                        _parser->getServeSocketName() );
+  CPPUNIT_ASSERT_EQUAL( std::string(""), _parser->getRequestSocketName() );
+
+  static const char *request[] = { "", "-r", "/tmp/tests.socket", 
+                                   ":MathTest", NULL };
+  parse( request );
+
+  CPPUNIT_ASSERT_EQUAL( std::string("/tmp/tests.socket"), 
+                        _parser->getRequestSocketName() );
+  CPPUNIT_ASSERT_EQUAL( std::string("MathTest"), _parser->getTestPath() );
+  CPPUNIT_ASSERT_EQUAL( 0, _parser->getPlugInCount() );
+}
+
+
+void 
+CommandLineParserTest::testServeAndRequestThrow()
+{
+  static const char *lines[] = { "", "-P", "a.socket", "-r", "a.socket", 
+                                 "TestPlugIn.dll", NULL };
+  parse( lines );
+}
+
+
+void 
+CommandLineParserTest::testWorkers()
+{
+  static const char *lines[] = { "", "--workers", "4", "TestPlugIn1.dll", 
+                                 "TestPlugIn2.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT_EQUAL( 4, _parser->getWorkerCount() );
+  CPPUNIT_ASSERT_EQUAL( 2, _parser->getPlugInCount() );
+
+  static const char *defaultLines[] = { "", "TestPlugIn.dll", NULL };
+  parse( defaultLines );
+
+  CPPUNIT_ASSERT_EQUAL( 0, _parser->getWorkerCount() );
+}
+
+
+void 
+CommandLineParserTest::testInvalidWorkersThrow()
+{
+  static const char *lines[] = { "", "-W", "none", "TestPlugIn.dll", NULL };
+  parse( lines );
+}
+
+
+void 
+CommandLineParserTest::testWorkersAndStressThrow()
+{
+  static const char *lines[] = { "", "-W", "2", "-S", "4", "TestPlugIn.dll", NULL };
+  parse( lines );
+}
+
+
+void 
+CommandLineParserTest::testRequireAssertions()
+{
+  static const char *lines[] = { "", "-A", "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT( _parser->requireAssertions() );
+
+  static const char *defaultLines[] = { "", "TestPlugIn.dll", NULL };
+  parse( defaultLines );
+
+  CPPUNIT_ASSERT( !_parser->requireAssertions() );
+}
+
+
+void 
+CommandLineParserTest::testCountAllocations()
+{
+  static const char *lines[] = { "", "--count-allocations", "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT( _parser->countAllocations() );
+
+  static const char *defaultLines[] = { "", "TestPlugIn.dll", NULL };
+  parse( defaultLines );
+
+  CPPUNIT_ASSERT( !_parser->countAllocations() );
+}
+
+
+void 
+CommandLineParserTest::testMaximumRss()
+{
+  static const char *lines[] = { "", "--max-rss-mb", "256", "TestPlugIn.dll", NULL };
+  parse( lines );
+
+  CPPUNIT_ASSERT_EQUAL( 256L, _parser->getMaximumRssMegabytes() );
+
+  static const char *defaultLines[] = { "", "TestPlugIn.dll", NULL };
+  parse( defaultLines );
+
+  CPPUNIT_ASSERT_EQUAL( 0L, _parser->getMaximumRssMegabytes() );
+}
+
+
+void 
+CommandLineParserTest::testInvalidMaximumRssThrow()
+{
+  static const char *lines[] = { "", "-m", "0", "TestPlugIn.dll", NULL };
+  parse( lines );
+}
@@ -14,6 +14,7 @@ class CommandLineParserTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( testEmptyCommandLine );
   CPPUNIT_TEST( testFlagCompiler );
   CPPUNIT_TEST( testLongFlagBriefProgress );
+  CPPUNIT_TEST( testLongFlagFastExit );
   CPPUNIT_TEST( testFileName );
   CPPUNIT_TEST( testTestPath );
   CPPUNIT_TEST( testParameterWithSpace );
@@ -21,6 +22,25 @@ class CommandLineParserTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST_EXCEPTION( testMissingEncodingParameterThrow, CommandLineParserException);
   CPPUNIT_TEST( testXmlFileNameIsOptional );
   CPPUNIT_TEST( testPlugInsWithParameters );
+  CPPUNIT_TEST( testRepeatedFilters );
+  CPPUNIT_TEST( testImpactOptions );
+  CPPUNIT_TEST_EXCEPTION( testImpactMapWithoutChangedFilesThrow, CommandLineParserException);
+  CPPUNIT_TEST( testDataShard );
+  CPPUNIT_TEST_EXCEPTION( testInvalidDataShardThrow, CommandLineParserException);
+  CPPUNIT_TEST( testStress );
+  CPPUNIT_TEST_EXCEPTION( testInvalidStressThrow, CommandLineParserException);
+  CPPUNIT_TEST( testVerifyOrder );
+  CPPUNIT_TEST( testPlugInLoading );
+  CPPUNIT_TEST_EXCEPTION( testInvalidLoadThreadsThrow, CommandLineParserException);
+  CPPUNIT_TEST( testServe );
+  CPPUNIT_TEST_EXCEPTION( testServeAndRequestThrow, CommandLineParserException);
+  CPPUNIT_TEST( testWorkers );
+  CPPUNIT_TEST_EXCEPTION( testInvalidWorkersThrow, CommandLineParserException);
+  CPPUNIT_TEST_EXCEPTION( testWorkersAndStressThrow, CommandLineParserException);
+  CPPUNIT_TEST( testRequireAssertions );
+  CPPUNIT_TEST( testCountAllocations );
+  CPPUNIT_TEST( testMaximumRss );
+  CPPUNIT_TEST_EXCEPTION( testInvalidMaximumRssThrow, CommandLineParserException);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -33,6 +53,7 @@ public:
   void testEmptyCommandLine();
   void testFlagCompiler();
   void testLongFlagBriefProgress();
+  void testLongFlagFastExit();
   void testFileName();
   void testTestPath();
   void testParameterWithSpace();
@@ -40,6 +61,25 @@ public:
   void testMissingEncodingParameterThrow();
   void testXmlFileNameIsOptional();
   void testPlugInsWithParameters();
+  void testRepeatedFilters();
+  void testImpactOptions();
+  void testImpactMapWithoutChangedFilesThrow();
+  void testDataShard();
+  void testInvalidDataShardThrow();
+  void testStress();
+  void testInvalidStressThrow();
+  void testVerifyOrder();
+  void testPlugInLoading();
+  void testInvalidLoadThreadsThrow();
+  void testServe();
+  void testServeAndRequestThrow();
+  void testWorkers();
+  void testInvalidWorkersThrow();
+  void testWorkersAndStressThrow();
+  void testRequireAssertions();
+  void testCountAllocations();
+  void testMaximumRss();
+  void testInvalidMaximumRssThrow();
 
 private:
   CommandLineParserTest( const CommandLineParserTest &other );
@@ -1,5 +1,14 @@
+#include <cppunit/AllocationCountXmlHook.h>
+#include <cppunit/AllocationScope.h>
+#include <cppunit/AssertionCountXmlHook.h>
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
+#include <cppunit/ParameterizedTestCase.h>
+#include <cppunit/PeakMemoryXmlHook.h>
+#include <cppunit/Test.h>
+#include <cppunit/TestArena.h>
+#include <cppunit/TestFilter.h>
+#include <cppunit/TestOrderVerifier.h>
 #include <cppunit/TestPath.h>
 #include <cppunit/TestResult.h>
 #include <cppunit/TestResultCollector.h>
@@ -7,13 +16,25 @@
 #include <cppunit/TextOutputter.h>
 #include <cppunit/TextTestProgressListener.h>
 #include <cppunit/XmlOutputter.h>
+#include <cppunit/extensions/ConcurrentRepeatedTest.h>
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/plugin/DynamicLibraryManagerException.h>
 #include <cppunit/plugin/PlugInParameters.h>
 #include <cppunit/plugin/PlugInManager.h>
 #include <cppunit/plugin/TestPlugIn.h>
+#include <cppunit/portability/CppUnitSet.h>
+#include <cppunit/portability/CppUnitVector.h>
 #include <cppunit/portability/Stream.h>
 #include "CommandLineParser.h"
+#include "PlugInManifest.h"
+#include "PlugInWorkerPool.h"
+#include "StressTestFactory.h"
+#include "TestImpactMap.h"
+#include "TestImpactRecorder.h"
+#include "TestServer.h"
+#include <fstream>
+#include <memory>
+#include <stdlib.h>
 
 
 /* Notes:
@@ -23,6 +44,311 @@
  */
 
 
+// Counts the allocations made by each test with --count-allocations, see
+// CppUnit::AllocationScope.
+CPPUNIT_INSTALL_ALLOCATION_COUNTING()
+
+
+/*! Waits for the user to press return if requested on the command line.
+ */
+static void
+waitBeforeExit( const CommandLineParser &parser )
+{
+#if !defined( CPPUNIT_NO_STREAM )
+  if ( parser.waitBeforeExit() )
+  {
+    CPPUNIT_NS::stdCOut() << "Please press <RETURN> to exit\n";
+    CPPUNIT_NS::stdCOut().flush();
+    std::cin.get();
+  }
+#else
+  (void)parser;
+#endif
+}
+
+
+/*! Adds the include and exclude patterns of the command line to the filter.
+ * \exception std::invalid_argument if a pattern is not valid.
+ */
+static void
+addFilterPatterns( const CommandLineParser &parser,
+                   CPPUNIT_NS::TestFilter &filter )
+{
+  for ( int filterIndex =0; filterIndex < parser.getFilterCount(); ++filterIndex )
+    filter.addInclude( parser.getFilterAt( filterIndex ) );
+  for ( int excludeIndex =0; excludeIndex < parser.getExcludeCount(); ++excludeIndex )
+    filter.addExclude( parser.getExcludeAt( excludeIndex ) );
+}
+
+
+/*! Indicates if the plug-ins that contain no selected test can be skipped.
+ *
+ * The tests selected by a test impact map are only known once all the
+ * plug-ins are loaded, and impact recording needs all the plug-ins.
+ */
+static bool
+canSkipPlugIns( const CommandLineParser &parser )
+{
+  return !parser.getManifestFileName().empty()  &&
+         ( !parser.getTestPath().empty()  ||  parser.getFilterCount() > 0 )  &&
+         parser.getImpactMapFileName().empty()  &&
+         parser.getRecordImpactFileName().empty();
+}
+
+
+/*! Adds the path of all the test cases of the default registry to a set.
+ */
+static void
+addRegisteredTestPaths( CppUnitSet<std::string> &testPaths )
+{
+  std::auto_ptr<CPPUNIT_NS::Test> root( 
+      CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+  PlugInManifest::TestPaths paths;
+  PlugInManifest::addTestPaths( root.get(), "", paths );
+  testPaths.insert( paths.begin(), paths.end() );
+}
+
+
+/*! Loads the test plug-ins.
+ *
+ * If a manifest is used, the plug-ins whose entry is out of date are loaded
+ * first, one at a time, to find the tests each of them adds, and the manifest
+ * is updated. The plug-ins that contain none of the selected tests are not
+ * loaded. The other plug-ins are loaded concurrently if requested.
+ *
+ * \param parser Command line parser.
+ * \param plugInManager Manager the plug-ins are loaded in.
+ * \exception DynamicLibraryManagerException if a plug-in can not be loaded.
+ */
+static void
+loadPlugIns( const CommandLineParser &parser,
+             CPPUNIT_NS::PlugInManager &plugInManager )
+{
+  if ( parser.useLazyBinding() )
+    plugInManager.setSymbolResolution( CPPUNIT_NS::DynamicLibraryManager::resolveOnFirstCall );
+
+  PlugInManifest manifest;
+  bool useManifest = !parser.getManifestFileName().empty();
+  if ( useManifest )
+    manifest.load( parser.getManifestFileName() );
+
+  CPPUNIT_NS::TestFilter filter;
+  bool canSkip = canSkipPlugIns( parser );
+  try
+  {
+    addFilterPatterns( parser, filter );
+  }
+  catch ( std::invalid_argument & )
+  {
+    canSkip = false;    // reported when the tests are run
+  }
+
+  CppUnitVector<std::string> fileNames;
+  CppUnitVector<CPPUNIT_NS::PlugInParameters> parameters;
+  CppUnitSet<std::string> knownTestPaths;
+  bool manifestChanged = false;
+  for ( int index =0; index < parser.getPlugInCount(); ++index )
+  {
+    CommandLinePlugInInfo plugIn = parser.getPlugInAt( index );
+    if ( useManifest  &&  !manifest.isUpToDate( plugIn.m_fileName ) )
+    {
+      // The tests of the plug-in are the ones that were not there before.
+      if ( !manifestChanged )
+        addRegisteredTestPaths( knownTestPaths );
+      plugInManager.load( plugIn.m_fileName, plugIn.m_parameters );
+
+      CppUnitSet<std::string> testPaths;
+      addRegisteredTestPaths( testPaths );
+      PlugInManifest::TestPaths addedTestPaths;
+      for ( CppUnitSet<std::string>::iterator it = testPaths.begin(); it != testPaths.end(); ++it )
+      {
+        if ( knownTestPaths.find( *it ) == knownTestPaths.end() )
+          addedTestPaths.push_back( *it );
+      }
+      manifest.setPlugInTests( plugIn.m_fileName, addedTestPaths );
+      knownTestPaths.swap( testPaths );
+      manifestChanged = true;
+    }
+    else if ( canSkip  &&  
+              !manifest.isNeeded( plugIn.m_fileName, parser.getTestPath(), filter ) )
+    {
+      if ( parser.printLoadTimes() )
+        CPPUNIT_NS::stdCOut()  <<  "Skipped plug-in without selected test: "
+                               <<  plugIn.m_fileName  <<  "\n";
+    }
+    else
+    {
+      fileNames.push_back( plugIn.m_fileName );
+      parameters.push_back( plugIn.m_parameters );
+    }
+  }
+
+  if ( manifestChanged  &&  !manifest.save( parser.getManifestFileName() ) )
+    CPPUNIT_NS::stdCOut()  <<  "Warning: can not write plug-in manifest: "
+                           <<  parser.getManifestFileName()  <<  "\n";
+
+  plugInManager.loadConcurrently( fileNames, parameters, parser.getLoadThreadCount() );
+}
+
+
+/*! Prints the time taken to load each plug-in.
+ */
+static void
+printLoadTimes( const CPPUNIT_NS::PlugInManager &plugInManager )
+{
+  double totalTime = 0;
+  for ( int index =0; index < plugInManager.getPlugInCount(); ++index )
+  {
+    double openTime = plugInManager.getOpenTimeAt( index );
+    double initializeTime = plugInManager.getInitializeTimeAt( index );
+    CPPUNIT_NS::stdCOut()  <<  "Loaded plug-in "  <<  plugInManager.getPlugInFileNameAt( index )
+                           <<  ": open "  <<  openTime  <<  " s, initialize "
+                           <<  initializeTime  <<  " s\n";
+    totalTime += openTime + initializeTime;
+  }
+  CPPUNIT_NS::stdCOut()  <<  "Loaded "  <<  plugInManager.getPlugInCount()
+                         <<  " plug-ins, total "  <<  totalTime  <<  " s\n";
+}
+
+
+/*! Adds the tests impacted by the changed files to the filter.
+ * \param parser Command line parser.
+ * \param rootTest Root of the tests to select.
+ * \param filter Filter to which the paths of the impacted tests are added.
+ * \return \c false if no test is impacted, \c true otherwise.
+ * \exception TestImpactMapException if a file can not be read.
+ */
+static bool
+addImpactedTests( const CommandLineParser &parser,
+                  CPPUNIT_NS::Test *rootTest,
+                  CPPUNIT_NS::TestFilter &filter )
+{
+  TestImpactMap impactMap;
+  impactMap.load( parser.getImpactMapFileName() );
+  TestImpactMap::ChangedFiles changedFiles =
+      TestImpactMap::readChangedFiles( parser.getChangedFilesFileName() );
+
+  // The tests impacted by a file that no test executed can not be known: a
+  // new file, a header without code, a build file... Runs everything.
+  std::string unknownFile = impactMap.findUnknownFile( changedFiles );
+  if ( !unknownFile.empty() )
+  {
+    CPPUNIT_NS::stdCOut()  <<  "Changed file not in test impact map, running all "
+                               "tests: "  <<  unknownFile  <<  "\n";
+    return true;
+  }
+
+  return impactMap.addImpactedTests( rootTest, changedFiles, filter ) > 0;
+}
+
+
+/*! Runs the tests and records the source files executed by each test.
+ * \param parser Command line parser.
+ * \param runner Runner of the tests.
+ * \param controller Test event manager.
+ * \param filter Filter of the tests to run.
+ * \return \c true if the tests were run and the map was saved, \c false
+ *         otherwise.
+ * \exception TestImpactMapException if the map can not be read or written.
+ */
+static bool
+runAndRecordImpact( const CommandLineParser &parser,
+                    CPPUNIT_NS::TestRunner &runner,
+                    CPPUNIT_NS::TestResult &controller,
+                    const CPPUNIT_NS::TestFilter &filter )
+{
+#if defined(CPPUNIT_TEST_IMPACT_RECORDING)
+  // Paths recorded in the map are relative to the root of the registry.
+  if ( !parser.getTestPath().empty() )
+  {
+    CPPUNIT_NS::stdCOut()  <<  "A test path can not be used with --record-impact, "
+                               "use --filter instead.\n";
+    return false;
+  }
+
+  // Updates the existing map so that a filtered run only replaces the
+  // entries of the tests it ran.
+  TestImpactMap impactMap;
+  std::ifstream existingMap( parser.getRecordImpactFileName().c_str() );
+  if ( existingMap )
+  {
+    existingMap.close();
+    impactMap.load( parser.getRecordImpactFileName() );
+  }
+
+  TestImpactRecorder recorder( impactMap );
+  for ( int index =0; index < parser.getPlugInCount(); ++index )
+  {
+    std::string fileName = parser.getPlugInAt( index ).m_fileName;
+    if ( !recorder.addPlugIn( fileName ) )
+    {
+      CPPUNIT_NS::stdCOut()  <<  "Warning: test plug-in not built with "
+                                 "--coverage -DCPPUNIT_PLUGIN_GCOV, its tests "
+                                 "will always be run: "  <<  fileName  <<  "\n";
+    }
+  }
+
+  controller.addListener( &recorder );
+  runner.run( controller, filter );
+  controller.removeListener( &recorder );
+
+  impactMap.save( parser.getRecordImpactFileName() );
+  return true;
+#else
+  (void)runner;
+  (void)controller;
+  (void)filter;
+  CPPUNIT_NS::stdCOut()  <<  "--record-impact is not supported on this "
+                             "platform: "  <<  parser.getRecordImpactFileName()
+                         <<  "\n";
+  return false;
+#endif
+}
+
+
+/*! Prints the throughput and the failed repetitions of a stress run.
+ */
+static void
+printStressStatistics( const CPPUNIT_NS::ConcurrentRepeatedTest &stressTest )
+{
+  CPPUNIT_NS::stdCOut()  <<  "Stress: "  <<  stressTest.getRepetitionCount()
+                         <<  " repetitions on "  <<  stressTest.getThreadCount()
+                         <<  " threads in "  <<  stressTest.getElapsedTime()
+                         <<  " s ("  <<  stressTest.getThroughput()
+                         <<  " repetitions/s), "
+                         <<  stressTest.getFailedRepetitionCount()
+                         <<  " failed\n";
+}
+
+
+/*! Verifies that the results of the tests do not depend on their order, and
+ * writes the suites that are safe to run in parallel.
+ * \return \c true if no order dependency was found.
+ */
+static bool
+verifyOrderIndependence( const CommandLineParser &parser,
+                         CPPUNIT_NS::TestRunner &runner )
+{
+  CPPUNIT_NS::TestOrderVerifier verifier;
+  runner.verifyOrderIndependence( verifier, parser.getTestPath() );
+  verifier.printDependencies( CPPUNIT_NS::stdCOut() );
+
+  int safeSuiteCount = 0;
+  for ( int index = 0; index < verifier.getSuiteCount(); ++index )
+  {
+    if ( verifier.isSuiteOrderIndependentAt( index ) )
+      ++safeSuiteCount;
+  }
+  CPPUNIT_NS::stdCOut()  <<  "Order verification: "  <<  safeSuiteCount  <<  " of "
+                         <<  verifier.getSuiteCount()  <<  " suites are parallel-safe, "
+                         <<  verifier.getDependencyCount()  <<  " order dependencies\n";
+
+  CPPUNIT_NS::OFileStream properties( parser.getOrderPropertiesFileName().c_str() );
+  verifier.writeProperties( properties );
+  return verifier.getDependencyCount() == 0;
+}
+
+
 /*! Runs the specified tests located in the root suite.
  * \param parser Command line parser.
  * \return \c true if the run succeed, \c false if a test failed or if a test
@@ -33,11 +359,15 @@ runTests( const CommandLineParser &parser )
 {
   bool wasSuccessful = false;
   CPPUNIT_NS::PlugInManager plugInManager;
+  CPPUNIT_NS::TestArena testArena;
 
   // The following scope is used to explicitely free all memory allocated before
   // unload the test plug-ins (uppon plugInManager destruction).
   {
     CPPUNIT_NS::TestResult controller;
+    controller.setFailsTestsWithoutAssertions( parser.requireAssertions() );
+    controller.setPeakMemoryBudget( parser.getMaximumRssMegabytes() * 1024 );
+    controller.setTracksPeakMemory( parser.useXmlOutputter() );
     CPPUNIT_NS::TestResultCollector result;
     controller.addListener( &result );        
 
@@ -52,6 +382,13 @@ runTests( const CommandLineParser &parser )
 
     CPPUNIT_NS::XmlOutputter xmlOutputter( &result, *xmlStream, parser.getEncoding() );
     xmlOutputter.setStyleSheet( parser.getXmlStyleSheet() );
+    CPPUNIT_NS::AssertionCountXmlHook assertionCountHook( &result );
+    xmlOutputter.addHook( &assertionCountHook );
+    CPPUNIT_NS::AllocationCountXmlHook allocationCountHook( &result );
+    if ( CPPUNIT_NS::AllocationScope::isCountingInstalled() )
+      xmlOutputter.addHook( &allocationCountHook );
+    CPPUNIT_NS::PeakMemoryXmlHook peakMemoryHook( &result );
+    xmlOutputter.addHook( &peakMemoryHook );
     CPPUNIT_NS::TextOutputter textOutputter( &result, *stream );
     CPPUNIT_NS::CompilerOutputter compilerOutputter( &result, *stream );
 
@@ -63,11 +400,12 @@ runTests( const CommandLineParser &parser )
     else if ( !parser.noTestProgress() )
       controller.addListener( &dotListener );
 
-    // Set up plug-ins
-    for ( int index =0; index < parser.getPlugInCount(); ++index )
+    // Set up plug-ins, only loaded by the worker processes if there are any
+    if ( parser.getWorkerCount() == 0 )
     {
-      CommandLinePlugInInfo plugIn = parser.getPlugInAt( index );
-      plugInManager.load( plugIn.m_fileName, plugIn.m_parameters );
+      loadPlugIns( parser, plugInManager );
+      if ( parser.printLoadTimes() )
+        printLoadTimes( plugInManager );
     }
 
     // Registers plug-in specific TestListener (global setUp/tearDown, custom TestListener...)
@@ -75,18 +413,77 @@ runTests( const CommandLineParser &parser )
 
     // Adds the default registry suite
     CPPUNIT_NS::TestRunner runner;
-    runner.addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+    CPPUNIT_NS::Test *rootTest;
+    CPPUNIT_NS::ParameterizedTest::setDefaultShard( parser.getDataShardIndex(),
+                                                    parser.getDataShardCount() );
+    {
+      // Allocates the test tree contiguously.
+      CPPUNIT_NS::TestArena::Scope arenaScope( testArena );
+      rootTest = CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest();
+    }
+    runner.addTest( rootTest );
+
+    // Outlives the outputters, which refer to the tests of the stress threads.
+    std::auto_ptr<CPPUNIT_NS::ConcurrentRepeatedTest> stressTest;
+
+    // Outlives the outputters, which refer to the tests reported by the workers.
+    PlugInWorkerPool workerPool( parser );
 
     // Runs the specified test
     try
     {
-      runner.run( controller, parser.getTestPath() );
-      wasSuccessful = result.wasSuccessful();
+      CPPUNIT_NS::TestFilter filter;
+      addFilterPatterns( parser, filter );
+
+      bool hasImpactedTests = true;
+      if ( !parser.getImpactMapFileName().empty() )
+        hasImpactedTests = addImpactedTests( parser, rootTest, filter );
+
+      if ( !hasImpactedTests )
+      {
+        CPPUNIT_NS::stdCOut()  <<  "No test impacted by the changed files\n";
+        wasSuccessful = true;
+      }
+      else if ( !parser.getRecordImpactFileName().empty() )
+      {
+        wasSuccessful = runAndRecordImpact( parser, runner, controller, filter )  &&
+                        result.wasSuccessful();
+      }
+      else if ( !parser.getOrderPropertiesFileName().empty() )
+      {
+        wasSuccessful = verifyOrderIndependence( parser, runner );
+      }
+      else if ( parser.getWorkerCount() > 0 )
+      {
+        wasSuccessful = workerPool.run( controller )  &&  result.wasSuccessful();
+      }
+      else if ( parser.getStressThreadCount() > 0 )
+      {
+        StressTestFactory factory( filter, parser.getTestPath() );
+        stressTest.reset( new CPPUNIT_NS::ConcurrentRepeatedTest( 
+                                  &factory,
+                                  parser.getStressThreadCount(),
+                                  parser.getStressRepeatCount() ) );
+        controller.runTest( stressTest.get() );
+        printStressStatistics( *stressTest );
+        wasSuccessful = result.wasSuccessful();
+      }
+      else
+      {
+        runner.run( controller, filter, parser.getTestPath() );
+        wasSuccessful = result.wasSuccessful();
+      }
+    }
+    catch ( std::invalid_argument &e )
+    {
+      CPPUNIT_NS::stdCOut()  <<  "Failed to resolve test path or filter: "  
+                             <<  e.what()
+                             <<  "\n";
     }
-    catch ( std::invalid_argument & )
+    catch ( TestImpactMapException &e )
     {
-      CPPUNIT_NS::stdCOut()  <<  "Failed to resolve test path: "  
-                             <<  parser.getTestPath() 
+      CPPUNIT_NS::stdCOut()  <<  "Test impact map error: "  
+                             <<  e.what()
                              <<  "\n";
     }
 
@@ -109,6 +506,16 @@ runTests( const CommandLineParser &parser )
 
     if ( !parser.getXmlFileName().empty() )
       delete xmlStream;
+
+    // Skips the destruction of the test tree and the unloading of the test
+    // plug-ins, which take a while for large test trees.
+    if ( parser.useFastExit() )
+    {
+      waitBeforeExit( parser );
+      CPPUNIT_NS::stdCOut().flush();
+      CPPUNIT_NS::stdCErr().flush();
+      ::exit( wasSuccessful ? 0 : 1 );
+    }
   }
 
   return wasSuccessful;
@@ -148,6 +555,74 @@ printUsage( const std::string &applicationName )
 "	Ouputters output to cout instead of the default cerr.\n"
 "-w --wait\n"
 "	Wait for the user to press a return before exit.\n"
+"-F --fast-exit\n"
+"	Exit as soon as the results are written, without destroying the\n"
+"	tests nor unloading the test plug-ins.\n"
+"-D --data-shard index/count\n"
+"	Only run the rows of the parameterized tests whose zero based index\n"
+"	modulo count is index, for example 0/4 to 3/4 over four processes.\n"
+"-S --stress threads[xrepeat]\n"
+"	Run the selected tests at the same time on the specified number of\n"
+"	threads, each with its own copy of the tests, repeat times on each\n"
+"	thread (default 1), then print the throughput and the number of\n"
+"	failed repetitions.\n"
+"-O --verify-order filename\n"
+"	Instead of running the tests, verify that the results of the tests\n"
+"	of each suite do not depend on their order, by running them alone and\n"
+"	in random orders. Print the pairs of order dependent tests, and write\n"
+"	the suites that are safe to run in parallel in the property file.\n"
+"-L --lazy-binding\n"
+"	Resolve the functions used by the test plug-ins on their first call\n"
+"	instead of when loading them. A missing function aborts the run.\n"
+"-j --load-threads count\n"
+"	Open up to count test plug-ins at the same time.\n"
+"-M --manifest filename\n"
+"	Cache of the tests contained in each test plug-in. With a test path\n"
+"	or a filter, the plug-ins that contain no selected test are not\n"
+"	loaded. The entries of new or modified plug-ins are updated.\n"
+"-T --load-times\n"
+"	Print the time taken to load each test plug-in.\n"
+"-P --serve socket-filename\n"
+"	Keep the test plug-ins loaded and run the tests requested on the\n"
+"	Unix domain socket. The plug-ins modified since the previous request\n"
+"	are reloaded before each run.\n"
+"-r --request socket-filename\n"
+"	Ask the server listening on the socket to run the tests of the test\n"
+"	path (all the tests if omitted), and print the results.\n"
+"-W --workers count\n"
+"	Run the tests of each test plug-in in its own child process, up to\n"
+"	count processes at the same time. A plug-in that crashes only fails\n"
+"	the test it was running. The results of all the plug-ins are merged.\n"
+"-A --require-assertions\n"
+"	Fail the tests that pass without checking any assertion.\n"
+"-a --count-allocations\n"
+"	Count the allocations made with new by each test, and write them in\n"
+"	the XML output. The allocations of the test plug-ins are only\n"
+"	counted on the platforms where they use the operators of the program.\n"
+"-m --max-rss-mb megabytes\n"
+"	Fail the tests whose peak resident memory exceeds megabytes, unless\n"
+"	their suite sets its own budget with the property max_rss_mb. The\n"
+"	address space of the worker processes of --workers is also limited\n"
+"	to their own plus four times the budget.\n"
+"-f --filter pattern\n"
+"	Only run the tests whose path, or the path of a parent suite,\n"
+"	matches the pattern. May be repeated. Patterns are globs matched\n"
+"	against test paths such as /All Tests/MathTest/MathTest::testAdd:\n"
+"	'*' does not match '/', '**' does. A pattern that does not start\n"
+"	with '/' matches the trailing components of the path, for example\n"
+"	Network*::*Timeout*. Prefix with regex: for a regular expression.\n"
+"-X --exclude pattern\n"
+"	Do not run the tests whose path, or the path of a parent suite,\n"
+"	matches the pattern. May be repeated.\n"
+"-R --record-impact mapfile\n"
+"	Records the source files executed by each test in mapfile. The\n"
+"	test plug-ins must be built with --coverage -DCPPUNIT_PLUGIN_GCOV.\n"
+"	Existing entries of mapfile are kept for the tests not run.\n"
+"-I --impact-map mapfile\n"
+"-C --changed-files listfile\n"
+"	Only run the tests which executed one of the files listed in\n"
+"	listfile (one per line) according to mapfile, and the tests not\n"
+"	in mapfile. All tests are run if a listed file is not in mapfile.\n"
 "filename[=\"options\"]\n"
 "	Many filenames can be specified. They are the name of the \n"
 "	test plug-ins to load. Optional plug-ins parameters can be \n"
@@ -231,11 +706,24 @@ main( int argc,
     printShortUsage( applicationName );
     return badCommadLineReturnCode;
   }
+  CPPUNIT_NS::AllocationScope::setCountingEnabled( parser.countAllocations() );
 
   bool wasSuccessful = false;
   try
   {
-    wasSuccessful = runTests( parser );
+    if ( !parser.getRequestSocketName().empty() )
+    {
+      wasSuccessful = TestServer::request( parser.getRequestSocketName(),
+                                           parser.getTestPath(),
+                                           CPPUNIT_NS::stdCOut() );
+    }
+    else if ( !parser.getServeSocketName().empty() )
+    {
+      TestServer server( parser );
+      wasSuccessful = server.serve( parser.getServeSocketName() );
+    }
+    else
+      wasSuccessful = runTests( parser );
   }
   catch ( CPPUNIT_NS::DynamicLibraryManagerException &e )
   {
@@ -243,14 +731,7 @@ main( int argc,
                            << e.what() << "\n";
   }
 
-#if !defined( CPPUNIT_NO_STREAM )
-  if ( parser.waitBeforeExit() )
-  {
-    CPPUNIT_NS::stdCOut() << "Please press <RETURN> to exit\n";
-    CPPUNIT_NS::stdCOut().flush();
-    std::cin.get();
-  }
-#endif
+  waitBeforeExit( parser );
 
   return wasSuccessful ? successReturnCode : failureReturnCode;
 }
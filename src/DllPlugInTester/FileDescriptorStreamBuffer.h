@@ -0,0 +1,80 @@
+#ifndef CPPUNIT_HELPER_FILEDESCRIPTORSTREAMBUFFER_H
+#define CPPUNIT_HELPER_FILEDESCRIPTORSTREAMBUFFER_H
+
+#include <cppunit/Portability.h>
+
+#if defined(CPPUNIT_HAVE_UNISTD_H) && !defined(CPPUNIT_NO_STREAM)
+#include <streambuf>
+#include <stdio.h>
+#include <unistd.h>
+
+
+/*! \brief Stream buffer that writes to a file descriptor.
+ *
+ * Used to write a std::ostream to a socket or a pipe. The file descriptor is
+ * not closed by the buffer.
+ */
+class FileDescriptorStreamBuffer : public std::streambuf
+{
+public:
+  FileDescriptorStreamBuffer( int fileDescriptor )
+      : m_fileDescriptor( fileDescriptor )
+  {
+    setp( m_buffer, m_buffer + sizeof(m_buffer) );
+  }
+
+  ~FileDescriptorStreamBuffer()
+  {
+    sync();
+  }
+
+protected:
+  int overflow( int c )
+  {
+    if ( writeBuffer() != 0 )
+      return EOF;
+    if ( c != EOF )
+    {
+      *pptr() = (char)c;
+      pbump( 1 );
+    }
+    return c == EOF ? 0 : c;
+  }
+
+  int sync()
+  {
+    return writeBuffer();
+  }
+
+private:
+  int writeBuffer()
+  {
+    const char *data = pbase();
+    int length = pptr() - pbase();
+    while ( length > 0 )
+    {
+      int written = ::write( m_fileDescriptor, data, length );
+      if ( written <= 0 )
+        return -1;
+      data += written;
+      length -= written;
+    }
+    setp( m_buffer, m_buffer + sizeof(m_buffer) );
+    return 0;
+  }
+
+  /// Prevents the use of the copy constructor.
+  FileDescriptorStreamBuffer( const FileDescriptorStreamBuffer &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const FileDescriptorStreamBuffer &copy );
+
+private:
+  int m_fileDescriptor;
+  char m_buffer[4096];
+};
+
+
+#endif  // defined(CPPUNIT_HAVE_UNISTD_H) && !defined(CPPUNIT_NO_STREAM)
+
+#endif  // CPPUNIT_HELPER_FILEDESCRIPTORSTREAMBUFFER_H
@@ -0,0 +1,251 @@
+#include "GcovReader.h"
+#include <stdio.h>
+#include <string.h>
+
+
+/*! \brief (INTERNAL) Sequential reader of the words of a gcov file.
+ *
+ * gcov files are a sequence of 32 bits words written in the byte order of the
+ * host. Files written by another host are rejected because their magic
+ * number does not match.
+ */
+class GcovStream
+{
+public:
+  enum
+  {
+    noteMagic = 0x67636e6f,          // "gcno"
+    dataMagic = 0x67636461,          // "gcda"
+    functionTag = 0x01000000,
+    arcCountersTag = 0x01a10000
+  };
+
+  GcovStream( const std::string &data )
+      : m_data( data )
+      , m_position( 0 )
+      , m_major( 0 )
+  {
+  }
+
+  /*! Reads the header of the file.
+   * \return \c true if the magic number is \a expectedMagic and the format
+   *         version is supported.
+   */
+  bool readHeader( unsigned int expectedMagic,
+                   unsigned int &stamp )
+  {
+    unsigned int magic, version;
+    if ( !readWord( magic )  ||  magic != expectedMagic )
+      return false;
+    if ( !readWord( version )  ||  !readWord( stamp ) )
+      return false;
+
+    // The version is 4 characters, for example "B22*" for gcc 12.2, "A93*"
+    // for gcc 9.3 or "408*" for gcc 4.8.
+    int first = (version >> 24) & 0xff;
+    int second = (version >> 16) & 0xff;
+    if ( first < 'A'  ||  second < '0'  ||  second > '9' )
+      return false;
+    m_major = (first - 'A') * 10 + second - '0';
+    if ( m_major < 9 )
+      return false;
+
+    unsigned int checksum;
+    if ( m_major >= 12  &&  !readWord( checksum ) )
+      return false;
+    return true;
+  }
+
+  /*! Reads the header specific to note files.
+   * \param directory Receives the compilation directory.
+   */
+  bool readNoteHeader( std::string &directory )
+  {
+    unsigned int hasUnexecutedBlocks;
+    return readString( directory )  &&  readWord( hasUnexecutedBlocks );
+  }
+
+  bool atEnd() const
+  {
+    return m_position >= m_data.length();
+  }
+
+  /*! Reads the tag and the length in bytes of the next record.
+   * \param length Receives the length of the record in bytes. Negative for
+   *               counters which are all zero (gcc 12 and later).
+   */
+  bool readRecordHeader( unsigned int &tag,
+                         int &length )
+  {
+    if ( !readWord( tag ) )
+      return false;
+    if ( tag == 0 )     // end of file marker, ignores anything after it
+    {
+      length = 0;
+      m_position = m_data.length();
+      return true;
+    }
+
+    unsigned int rawLength;
+    if ( !readWord( rawLength ) )
+      return false;
+    length = int(rawLength);
+    if ( m_major < 12 )
+      length *= 4;
+    return true;
+  }
+
+  bool readWord( unsigned int &word )
+  {
+    if ( m_position + 4 > m_data.length() )
+      return false;
+    memcpy( &word, m_data.data() + m_position, 4 );
+    m_position += 4;
+    return true;
+  }
+
+  bool readString( std::string &value )
+  {
+    unsigned int length;
+    if ( !readWord( length ) )
+      return false;
+    if ( m_major < 12 )
+      length *= 4;    // Length in words, padded with '\0'.
+    if ( m_position + length > m_data.length() )
+      return false;
+    value = std::string( m_data.data() + m_position, length );
+    std::string::size_type end = value.find( '\0' );
+    if ( end != std::string::npos )
+      value.erase( end );
+    m_position += length;
+    return true;
+  }
+
+  bool seek( unsigned int position )
+  {
+    if ( position > m_data.length() )
+      return false;
+    m_position = position;
+    return true;
+  }
+
+  unsigned int getPosition() const
+  {
+    return m_position;
+  }
+
+private:
+  const std::string &m_data;
+  unsigned int m_position;
+  int m_major;
+};
+
+
+bool
+GcovReader::readFunctionSources( const std::string &data,
+                                 unsigned int &stamp,
+                                 FunctionSources &sources )
+{
+  GcovStream stream( data );
+  std::string directory;
+  if ( !stream.readHeader( GcovStream::noteMagic, stamp )  ||
+       !stream.readNoteHeader( directory ) )
+    return false;
+
+  while ( !stream.atEnd() )
+  {
+    unsigned int tag;
+    int length;
+    if ( !stream.readRecordHeader( tag, length )  ||  length < 0 )
+      return false;
+    unsigned int recordEnd = stream.getPosition() + length;
+
+    if ( tag == GcovStream::functionTag )
+    {
+      unsigned int ident, linenoChecksum, cfgChecksum, artificial;
+      std::string name, source;
+      if ( !stream.readWord( ident )  ||
+           !stream.readWord( linenoChecksum )  ||
+           !stream.readWord( cfgChecksum )  ||
+           !stream.readString( name )  ||
+           !stream.readWord( artificial )  ||
+           !stream.readString( source ) )
+        return false;
+
+      if ( !source.empty()  &&  source[0] != '/'  &&  !directory.empty() )
+        source = directory + "/" + source;
+      sources[ ident ] = source;
+    }
+
+    if ( !stream.seek( recordEnd ) )
+      return false;
+  }
+
+  return true;
+}
+
+
+bool
+GcovReader::readExecutedFunctions( const std::string &data,
+                                   unsigned int &stamp,
+                                   FunctionIds &executed )
+{
+  GcovStream stream( data );
+  if ( !stream.readHeader( GcovStream::dataMagic, stamp ) )
+    return false;
+
+  bool hasFunction = false;
+  unsigned int ident = 0;
+  while ( !stream.atEnd() )
+  {
+    unsigned int tag;
+    int length;
+    if ( !stream.readRecordHeader( tag, length ) )
+      return false;
+    if ( length < 0 )   // counters are all zero and are not written
+      continue;
+    unsigned int recordEnd = stream.getPosition() + length;
+
+    if ( tag == GcovStream::functionTag )
+    {
+      hasFunction = length > 0  &&  stream.readWord( ident );
+    }
+    else if ( tag == GcovStream::arcCountersTag  &&  hasFunction )
+    {
+      unsigned int word;
+      while ( stream.getPosition() < recordEnd  &&  stream.readWord( word ) )
+      {
+        if ( word != 0 )
+        {
+          executed.insert( ident );
+          break;
+        }
+      }
+    }
+
+    if ( !stream.seek( recordEnd ) )
+      return false;
+  }
+
+  return true;
+}
+
+
+bool
+GcovReader::readFile( const std::string &fileName,
+                      std::string &data )
+{
+  FILE *file = fopen( fileName.c_str(), "rb" );
+  if ( file == NULL )
+    return false;
+
+  data.erase();
+  char buffer[4096];
+  size_t count;
+  while ( (count = fread( buffer, 1, sizeof(buffer), file )) > 0 )
+    data.append( buffer, count );
+
+  bool hasError = ferror( file ) != 0;
+  fclose( file );
+  return !hasError;
+}
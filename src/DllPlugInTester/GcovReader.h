@@ -0,0 +1,59 @@
+#ifndef CPPUNIT_HELPER_GCOVREADER_H
+#define CPPUNIT_HELPER_GCOVREADER_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/portability/CppUnitMap.h>
+#include <cppunit/portability/CppUnitSet.h>
+#include <string>
+
+
+/*! \brief Reads the gcov note (.gcno) and data (.gcda) files written by gcc.
+ *
+ * Only the information needed to know which source files a test executed is
+ * read: the source file of each function from the note file, and the
+ * functions which have at least one non-zero arc counter from the data file.
+ *
+ * The formats of gcc 9 and later are supported. Any other format (older gcc,
+ * clang, other endianness...) is rejected.
+ */
+class GcovReader
+{
+public:
+  typedef CppUnitMap<unsigned int, std::string, std::less<unsigned int> > FunctionSources;
+  typedef CppUnitSet<unsigned int, std::less<unsigned int> > FunctionIds;
+
+  /*! \brief Reads the source file of each function of a note file.
+   * \param data Content of the .gcno file.
+   * \param stamp Receives the stamp of the note file. A data file written by
+   *              the same compilation has the same stamp.
+   * \param sources Receives the source file of each function, by function
+   *                identifier. Relative file names are made absolute using
+   *                the compilation directory recorded in the note file.
+   * \return \c true if \a data was read, \c false if the format is not
+   *         supported.
+   */
+  static bool readFunctionSources( const std::string &data,
+                                   unsigned int &stamp,
+                                   FunctionSources &sources );
+
+  /*! \brief Reads the functions executed according to a data file.
+   * \param data Content of the .gcda file.
+   * \param stamp Receives the stamp of the data file.
+   * \param executed Receives the identifier of the functions that have a
+   *                 non-zero arc counter.
+   * \return \c true if \a data was read, \c false if the format is not
+   *         supported.
+   */
+  static bool readExecutedFunctions( const std::string &data,
+                                     unsigned int &stamp,
+                                     FunctionIds &executed );
+
+  /*! \brief Reads the content of a binary file.
+   * \return \c true if the file was read, \c false otherwise.
+   */
+  static bool readFile( const std::string &fileName,
+                        std::string &data );
+};
+
+
+#endif  // CPPUNIT_HELPER_GCOVREADER_H
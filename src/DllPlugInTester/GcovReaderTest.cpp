@@ -0,0 +1,217 @@
+#include "GcovReader.h"
+#include "GcovReaderTest.h"
+#include <string.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GcovReaderTest );
+
+
+// Files written by gcc 12.2.
+static const unsigned int gcc12Version = ('B' << 24) | ('2' << 16) | ('2' << 8) | '*';
+static const unsigned int stamp = 0x12345678;
+
+
+GcovReaderTest::GcovReaderTest()
+{
+}
+
+
+GcovReaderTest::~GcovReaderTest()
+{
+}
+
+
+void 
+GcovReaderTest::testReadFunctionSources()
+{
+  unsigned int actualStamp = 0;
+  GcovReader::FunctionSources sources;
+  CPPUNIT_ASSERT( GcovReader::readFunctionSources( makeNoteFile( gcc12Version ),
+                                                   actualStamp,
+                                                   sources ) );
+
+  CPPUNIT_ASSERT_EQUAL( stamp, actualStamp );
+  CPPUNIT_ASSERT_EQUAL( 3, int(sources.size()) );
+  CPPUNIT_ASSERT_EQUAL( std::string("/src/Math.cpp"), sources[1] );
+  CPPUNIT_ASSERT_EQUAL( std::string("/build/include/Math.h"), sources[2] );
+  CPPUNIT_ASSERT_EQUAL( std::string("/src/Math.cpp"), sources[3] );
+}
+
+
+void 
+GcovReaderTest::testReadExecutedFunctions()
+{
+  unsigned int actualStamp = 0;
+  GcovReader::FunctionIds executed;
+  CPPUNIT_ASSERT( GcovReader::readExecutedFunctions( makeDataFile(),
+                                                     actualStamp,
+                                                     executed ) );
+
+  CPPUNIT_ASSERT_EQUAL( stamp, actualStamp );
+  CPPUNIT_ASSERT_EQUAL( 1, int(executed.size()) );
+  CPPUNIT_ASSERT( executed.find( 2 ) != executed.end() );
+}
+
+
+void 
+GcovReaderTest::testStampsMatch()
+{
+  unsigned int noteStamp = 0;
+  unsigned int dataStamp = 1;
+  GcovReader::FunctionSources sources;
+  GcovReader::FunctionIds executed;
+  GcovReader::readFunctionSources( makeNoteFile( gcc12Version ), noteStamp, sources );
+  GcovReader::readExecutedFunctions( makeDataFile(), dataStamp, executed );
+
+  CPPUNIT_ASSERT_EQUAL( noteStamp, dataStamp );
+}
+
+
+void 
+GcovReaderTest::testOldVersionIsRejected()
+{
+  // gcc 4.8
+  const unsigned int version = ('4' << 24) | ('0' << 16) | ('8' << 8) | '*';
+  unsigned int actualStamp;
+  GcovReader::FunctionSources sources;
+  CPPUNIT_ASSERT( !GcovReader::readFunctionSources( makeNoteFile( version ),
+                                                    actualStamp,
+                                                    sources ) );
+}
+
+
+void 
+GcovReaderTest::testWrongMagicIsRejected()
+{
+  unsigned int actualStamp;
+  GcovReader::FunctionIds executed;
+  CPPUNIT_ASSERT( !GcovReader::readExecutedFunctions( makeNoteFile( gcc12Version ),
+                                                      actualStamp,
+                                                      executed ) );
+}
+
+
+void 
+GcovReaderTest::testTruncatedDataIsRejected()
+{
+  std::string data = makeNoteFile( gcc12Version );
+  data.erase( data.length() - 6 );
+
+  unsigned int actualStamp;
+  GcovReader::FunctionSources sources;
+  CPPUNIT_ASSERT( !GcovReader::readFunctionSources( data, actualStamp, sources ) );
+}
+
+
+std::string 
+GcovReaderTest::makeNoteFile( unsigned int version )
+{
+  std::string data;
+  writeWord( data, 0x67636e6f );    // "gcno"
+  writeWord( data, version );
+  writeWord( data, stamp );
+  writeWord( data, 0 );             // checksum
+  writeString( data, "/build" );    // compilation directory
+  writeWord( data, 0 );             // has unexecuted blocks
+
+  writeFunction( data, 1, "_ZN4Math3addEii", "/src/Math.cpp" );
+
+  // Unrelated record (blocks)
+  writeWord( data, 0x01410000 );
+  writeWord( data, 4 );
+  writeWord( data, 5 );
+
+  writeFunction( data, 2, "_ZN4Math3subEii", "include/Math.h" );
+  writeFunction( data, 3, "main", "/src/Math.cpp" );
+  return data;
+}
+
+
+std::string 
+GcovReaderTest::makeDataFile()
+{
+  std::string data;
+  writeWord( data, 0x67636461 );    // "gcda"
+  writeWord( data, gcc12Version );
+  writeWord( data, stamp );
+  writeWord( data, 0 );             // checksum
+
+  // Function 1: arc counters written but all zero.
+  writeWord( data, 0x01000000 );
+  writeWord( data, 12 );
+  writeWord( data, 1 );
+  writeWord( data, 0xaaaa );
+  writeWord( data, 0xbbbb );
+  writeWord( data, 0x01a10000 );
+  writeWord( data, 16 );
+  for ( int index =0; index < 4; ++index )
+    writeWord( data, 0 );
+
+  // Function 2: the second counter is not zero.
+  writeWord( data, 0x01000000 );
+  writeWord( data, 12 );
+  writeWord( data, 2 );
+  writeWord( data, 0xaaaa );
+  writeWord( data, 0xbbbb );
+  writeWord( data, 0x01a10000 );
+  writeWord( data, 16 );
+  writeWord( data, 0 );
+  writeWord( data, 0 );
+  writeWord( data, 3 );
+  writeWord( data, 0 );
+
+  // Function 3: arc counters all zero, not written (negative length).
+  writeWord( data, 0x01000000 );
+  writeWord( data, 12 );
+  writeWord( data, 3 );
+  writeWord( data, 0xaaaa );
+  writeWord( data, 0xbbbb );
+  writeWord( data, 0x01a10000 );
+  writeWord( data, (unsigned int)-16 );
+
+  writeWord( data, 0 );             // end of file
+  return data;
+}
+
+
+void 
+GcovReaderTest::writeWord( std::string &data, 
+                           unsigned int word )
+{
+  char bytes[4];
+  memcpy( bytes, &word, 4 );
+  data.append( bytes, 4 );
+}
+
+
+void 
+GcovReaderTest::writeString( std::string &data, 
+                             const std::string &value )
+{
+  // gcc 12 and later: length in bytes including the '\0', not padded.
+  writeWord( data, value.length() + 1 );
+  data.append( value.c_str(), value.length() + 1 );
+}
+
+
+void 
+GcovReaderTest::writeFunction( std::string &data,
+                               unsigned int ident,
+                               const std::string &name,
+                               const std::string &source )
+{
+  std::string record;
+  writeWord( record, ident );
+  writeWord( record, 0xaaaa );      // line number checksum
+  writeWord( record, 0xbbbb );      // configuration checksum
+  writeString( record, name );
+  writeWord( record, 0 );           // artificial
+  writeString( record, source );
+  writeWord( record, 10 );          // start line
+  writeWord( record, 1 );           // start column
+  writeWord( record, 12 );          // end line
+  writeWord( record, 1 );           // end column
+
+  writeWord( data, 0x01000000 );
+  writeWord( data, record.length() );
+  data += record;
+}
@@ -0,0 +1,45 @@
+#ifndef GCOVREADERTEST_H
+#define GCOVREADERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class GcovReaderTest : public CPPUNIT_NS::TestCase
+{
+  CPPUNIT_TEST_SUITE( GcovReaderTest );
+  CPPUNIT_TEST( testReadFunctionSources );
+  CPPUNIT_TEST( testReadExecutedFunctions );
+  CPPUNIT_TEST( testStampsMatch );
+  CPPUNIT_TEST( testOldVersionIsRejected );
+  CPPUNIT_TEST( testWrongMagicIsRejected );
+  CPPUNIT_TEST( testTruncatedDataIsRejected );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  GcovReaderTest();
+  virtual ~GcovReaderTest();
+
+  void testReadFunctionSources();
+  void testReadExecutedFunctions();
+  void testStampsMatch();
+  void testOldVersionIsRejected();
+  void testWrongMagicIsRejected();
+  void testTruncatedDataIsRejected();
+
+private:
+  GcovReaderTest( const GcovReaderTest &other );
+  void operator =( const GcovReaderTest &other );
+
+  static std::string makeNoteFile( unsigned int version );
+  static std::string makeDataFile();
+  static void writeWord( std::string &data, unsigned int word );
+  static void writeString( std::string &data, const std::string &value );
+  static void writeFunction( std::string &data,
+                             unsigned int ident,
+                             const std::string &name,
+                             const std::string &source );
+};
+
+
+
+#endif  // GCOVREADERTEST_H
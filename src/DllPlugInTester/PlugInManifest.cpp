@@ -0,0 +1,182 @@
+#include <cppunit/Test.h>
+#include <cppunit/TestFilter.h>
+#include "PlugInManifest.h"
+#include <fstream>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+
+PlugInManifest::PlugInManifest()
+{
+}
+
+
+PlugInManifest::~PlugInManifest()
+{
+}
+
+
+void
+PlugInManifest::load( const std::string &fileName )
+{
+  m_plugIns.clear();
+  std::ifstream stream( fileName.c_str() );
+
+  PlugInEntry *entry = NULL;
+  std::string line;
+  while ( std::getline( stream, line ) )
+  {
+    if ( line.compare( 0, 7, "plugin " ) == 0 )
+    {
+      // The stamp is made of the size and the modification time.
+      std::string::size_type sizeEnd = line.find( ' ', 7 );
+      std::string::size_type timeEnd = sizeEnd == std::string::npos
+          ? sizeEnd : line.find( ' ', sizeEnd + 1 );
+      if ( timeEnd == std::string::npos )
+        break;
+      entry = &m_plugIns[ line.substr( timeEnd + 1 ) ];
+      entry->m_stamp = line.substr( 7, timeEnd - 7 );
+    }
+    else if ( line.compare( 0, 5, "test " ) == 0  &&  entry != NULL )
+      entry->m_testPaths.push_back( line.substr( 5 ) );
+    else if ( !line.empty()  &&  line[0] != '#' )
+      break;
+  }
+
+  if ( !stream.eof() )
+    m_plugIns.clear();
+}
+
+
+bool
+PlugInManifest::save( const std::string &fileName ) const
+{
+  std::ofstream stream( fileName.c_str() );
+  stream  <<  "# test plug-in manifest, see DllPlugInTester --manifest\n";
+  for ( PlugIns::const_iterator itPlugIn = m_plugIns.begin();
+        itPlugIn != m_plugIns.end();
+        ++itPlugIn )
+  {
+    const PlugInEntry &entry = (*itPlugIn).second;
+    stream  <<  "plugin "  <<  entry.m_stamp  <<  " "  <<  (*itPlugIn).first  <<  "\n";
+    for ( TestPaths::const_iterator it = entry.m_testPaths.begin();
+          it != entry.m_testPaths.end();
+          ++it )
+      stream  <<  "test "  <<  *it  <<  "\n";
+  }
+
+  stream.flush();
+  return stream.good();
+}
+
+
+void
+PlugInManifest::setPlugInTests( const std::string &plugInFileName,
+                                const TestPaths &testPaths )
+{
+  PlugInEntry &entry = m_plugIns[ plugInFileName ];
+  entry.m_stamp = getFileStamp( plugInFileName );
+  entry.m_testPaths = testPaths;
+}
+
+
+bool
+PlugInManifest::isUpToDate( const std::string &plugInFileName ) const
+{
+  PlugIns::const_iterator it = m_plugIns.find( plugInFileName );
+  return it != m_plugIns.end()  &&
+         (*it).second.m_stamp == getFileStamp( plugInFileName );
+}
+
+
+bool
+PlugInManifest::isNeeded( const std::string &plugInFileName,
+                          const std::string &testPath,
+                          const CPPUNIT_NS::TestFilter &filter ) const
+{
+  if ( !isUpToDate( plugInFileName ) )
+    return true;
+
+  const TestPaths &testPaths = (*m_plugIns.find( plugInFileName )).second.m_testPaths;
+  if ( testPaths.empty() )
+    return true;
+
+  for ( TestPaths::const_iterator it = testPaths.begin(); it != testPaths.end(); ++it )
+  {
+    if ( isSelectedByPath( *it, testPath )  &&  isSelectedByFilter( *it, filter ) )
+      return true;
+  }
+  return false;
+}
+
+
+void
+PlugInManifest::addTestPaths( CPPUNIT_NS::Test *test,
+                              const std::string &parentPath,
+                              TestPaths &testPaths )
+{
+  std::string path = parentPath + "/" + test->getNameRef();
+  if ( !test->canBeFlattened() )
+  {
+    testPaths.push_back( path );
+    return;
+  }
+
+  for ( int index =0; index < test->getChildTestCount(); ++index )
+    addTestPaths( test->getChildTestAt( index ), path, testPaths );
+}
+
+
+std::string
+PlugInManifest::getFileStamp( const std::string &fileName )
+{
+  struct stat status;
+  if ( ::stat( fileName.c_str(), &status ) != 0 )
+    return "";
+
+  std::ostringstream stamp;
+  stamp  <<  (unsigned long)status.st_size  <<  " "  <<  (unsigned long)status.st_mtime;
+  return stamp.str();
+}
+
+
+bool
+PlugInManifest::isSelectedByPath( const std::string &testPath,
+                                  const std::string &selectedPath )
+{
+  if ( selectedPath.empty() )
+    return true;
+
+  // An absolute path selects the test it designates and its children.
+  if ( selectedPath[0] == '/' )
+  {
+    return testPath.compare( 0, selectedPath.length(), selectedPath ) == 0  &&
+           ( testPath.length() == selectedPath.length()  ||
+             testPath[ selectedPath.length() ] == '/' );
+  }
+
+  // The first test of a relative path is searched anywhere in the tree.
+  std::string firstName = selectedPath.substr( 0, selectedPath.find( '/' ) );
+  return ( testPath + "/" ).find( "/" + firstName + "/" ) != std::string::npos;
+}
+
+
+bool
+PlugInManifest::isSelectedByFilter( const std::string &testPath,
+                                    const CPPUNIT_NS::TestFilter &filter )
+{
+  // A test is selected if it or one of its parent suites is included, and
+  // none of them is excluded.
+  bool isIncluded = false;
+  std::string::size_type separator = 0;
+  while ( separator != std::string::npos )
+  {
+    separator = testPath.find( '/', separator + 1 );
+    std::string path = testPath.substr( 0, separator );
+    if ( filter.isExcluded( path ) )
+      return false;
+    isIncluded = isIncluded  ||  filter.isIncluded( path );
+  }
+  return isIncluded;
+}
@@ -0,0 +1,121 @@
+#ifndef CPPUNIT_HELPER_PLUGINMANIFEST_H
+#define CPPUNIT_HELPER_PLUGINMANIFEST_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/portability/CppUnitDeque.h>
+#include <cppunit/portability/CppUnitMap.h>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+class Test;
+class TestFilter;
+CPPUNIT_NS_END
+
+
+/*! \brief Cache of the tests contained in each test plug-in.
+ *
+ * The manifest lets DllPlugInTester skip the loading of the plug-ins that
+ * contain none of the tests selected by the test path and the filter. The
+ * entry of a plug-in is only used while the size and the modification time of
+ * its file are the ones recorded with the entry: a plug-in whose entry is
+ * missing or out of date must be loaded to update it.
+ *
+ * The manifest is stored in a text file. Each plug-in entry is followed by the
+ * path of its tests, as returned by TestPath::toString():
+ * \code
+ * plugin 52344 1190374523 lib/MathTestPlugIn.so
+ * test /All Tests/MathTest/MathTest::testAdd
+ * test /All Tests/MathTest/MathTest::testSub
+ * plugin 20532 1190374519 lib/ClockerPlugIn.so
+ * ...
+ * \endcode
+ */
+class PlugInManifest
+{
+public:
+  typedef CppUnitDeque<std::string> TestPaths;
+
+  /*! Constructs an empty manifest.
+   */
+  PlugInManifest();
+
+  /// Destructor.
+  virtual ~PlugInManifest();
+
+  /*! \brief Loads the manifest from a file, replacing the current content.
+   *
+   * A missing or invalid file leaves the manifest empty: it is only a cache.
+   */
+  void load( const std::string &fileName );
+
+  /*! \brief Saves the manifest to a file.
+   * \return \c false if the file can not be written, \c true otherwise.
+   */
+  bool save( const std::string &fileName ) const;
+
+  /*! \brief Sets the tests of a plug-in, stamped with the current size and
+   *         modification time of its file.
+   */
+  void setPlugInTests( const std::string &plugInFileName,
+                       const TestPaths &testPaths );
+
+  /*! \brief Indicates if the entry of a plug-in matches its file.
+   */
+  bool isUpToDate( const std::string &plugInFileName ) const;
+
+  /*! \brief Indicates if a plug-in must be loaded to run the selected tests.
+   *
+   * A plug-in must be loaded if its entry is not up to date, if it contains
+   * no test (it may only add a TestListener), or if one of its tests is
+   * selected by the test path and the filter.
+   *
+   * \param plugInFileName Name of the file of the plug-in.
+   * \param testPath Test path given on the command line, see TestPath for
+   *                 the syntax. Empty to select all the tests.
+   * \param filter Filter of the tests to run.
+   */
+  bool isNeeded( const std::string &plugInFileName,
+                 const std::string &testPath,
+                 const CPPUNIT_NS::TestFilter &filter ) const;
+
+  /*! \brief Adds the path of the test cases below a test to a list.
+   * \param test Test whose test cases are added.
+   * \param parentPath Path of the parent of \a test.
+   * \param testPaths List the paths are added to.
+   */
+  static void addTestPaths( CPPUNIT_NS::Test *test,
+                            const std::string &parentPath,
+                            TestPaths &testPaths );
+
+  /*! \brief Returns a string that changes when a file is modified.
+   * \return Size and modification time of the file, or an empty string if
+   *         the file does not exist.
+   */
+  static std::string getFileStamp( const std::string &fileName );
+
+private:
+  struct PlugInEntry
+  {
+    std::string m_stamp;
+    TestPaths m_testPaths;
+  };
+
+  static bool isSelectedByPath( const std::string &testPath,
+                                const std::string &selectedPath );
+
+  static bool isSelectedByFilter( const std::string &testPath,
+                                  const CPPUNIT_NS::TestFilter &filter );
+
+  /// Prevents the use of the copy constructor.
+  PlugInManifest( const PlugInManifest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const PlugInManifest &copy );
+
+private:
+  typedef CppUnitMap<std::string, PlugInEntry, std::less<std::string> > PlugIns;
+  PlugIns m_plugIns;
+};
+
+
+#endif  // CPPUNIT_HELPER_PLUGINMANIFEST_H
@@ -0,0 +1,183 @@
+#include <cppunit/TestFilter.h>
+#include "PlugInManifest.h"
+#include "PlugInManifestTest.h"
+#include <fstream>
+#include <stdio.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PlugInManifestTest );
+
+
+PlugInManifestTest::PlugInManifestTest()
+{
+}
+
+
+PlugInManifestTest::~PlugInManifestTest()
+{
+}
+
+
+void 
+PlugInManifestTest::setUp()
+{
+  m_manifest = new PlugInManifest();
+  m_fileName = "PlugInManifestTest.tmp";
+  m_plugInFileName = "PlugInManifestTest Plug-In.tmp";
+  writeFile( m_plugInFileName, "plug-in" );
+}
+
+
+void 
+PlugInManifestTest::tearDown()
+{
+  ::remove( m_fileName.c_str() );
+  ::remove( m_plugInFileName.c_str() );
+  delete m_manifest;
+}
+
+
+void 
+PlugInManifestTest::testAddTestPaths()
+{
+  CPPUNIT_NS::TestSuite root( "All Tests" );
+  CPPUNIT_NS::TestSuite *mathSuite = new CPPUNIT_NS::TestSuite( "MathTest" );
+  mathSuite->addTest( new CPPUNIT_NS::TestCase( "MathTest::testAdd" ) );
+  mathSuite->addTest( new CPPUNIT_NS::TestCase( "MathTest::testSub" ) );
+  root.addTest( mathSuite );
+
+  PlugInManifest::TestPaths testPaths;
+  PlugInManifest::addTestPaths( &root, "", testPaths );
+
+  CPPUNIT_ASSERT_EQUAL( 2, int(testPaths.size()) );
+  CPPUNIT_ASSERT_EQUAL( std::string("/All Tests/MathTest/MathTest::testAdd"), 
+                        testPaths[0] );
+  CPPUNIT_ASSERT_EQUAL( std::string("/All Tests/MathTest/MathTest::testSub"), 
+                        testPaths[1] );
+}
+
+
+void 
+PlugInManifestTest::testUnknownPlugInIsNeeded()
+{
+  CPPUNIT_NS::TestFilter filter;
+  filter.addInclude( "StringTest" );
+
+  CPPUNIT_ASSERT( !m_manifest->isUpToDate( m_plugInFileName ) );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, "StringTest", filter ) );
+}
+
+
+void 
+PlugInManifestTest::testModifiedPlugInIsNotUpToDate()
+{
+  setMathPlugInTests();
+  CPPUNIT_ASSERT( m_manifest->isUpToDate( m_plugInFileName ) );
+
+  writeFile( m_plugInFileName, "rebuilt plug-in" );
+  CPPUNIT_ASSERT( !m_manifest->isUpToDate( m_plugInFileName ) );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, "StringTest", 
+                                        CPPUNIT_NS::TestFilter() ) );
+}
+
+
+void 
+PlugInManifestTest::testPlugInWithoutTestIsNeeded()
+{
+  m_manifest->setPlugInTests( m_plugInFileName, PlugInManifest::TestPaths() );
+
+  CPPUNIT_ASSERT( m_manifest->isUpToDate( m_plugInFileName ) );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, "StringTest", 
+                                        CPPUNIT_NS::TestFilter() ) );
+}
+
+
+void 
+PlugInManifestTest::testIsNeededByTestPath()
+{
+  setMathPlugInTests();
+  CPPUNIT_NS::TestFilter noFilter;
+
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, "", noFilter ) );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, "MathTest", noFilter ) );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, 
+                                        "MathTest::testAdd", noFilter ) );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, 
+                                        "Arithmetic/MathTest", noFilter ) );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, 
+                                        "/All Tests/Arithmetic", noFilter ) );
+  CPPUNIT_ASSERT( !m_manifest->isNeeded( m_plugInFileName, "Math", noFilter ) );
+  CPPUNIT_ASSERT( !m_manifest->isNeeded( m_plugInFileName, 
+                                         "StringTest/MathTest", noFilter ) );
+  CPPUNIT_ASSERT( !m_manifest->isNeeded( m_plugInFileName, 
+                                         "/All Tests/MathTest", noFilter ) );
+}
+
+
+void 
+PlugInManifestTest::testIsNeededByFilter()
+{
+  setMathPlugInTests();
+
+  CPPUNIT_NS::TestFilter includeMath;
+  includeMath.addInclude( "MathTest" );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, "", includeMath ) );
+
+  CPPUNIT_NS::TestFilter includeString;
+  includeString.addInclude( "StringTest" );
+  CPPUNIT_ASSERT( !m_manifest->isNeeded( m_plugInFileName, "", includeString ) );
+
+  CPPUNIT_NS::TestFilter excludeArithmetic;
+  excludeArithmetic.addExclude( "Arithmetic" );
+  CPPUNIT_ASSERT( !m_manifest->isNeeded( m_plugInFileName, "", excludeArithmetic ) );
+
+  CPPUNIT_NS::TestFilter excludeAdd;
+  excludeAdd.addExclude( "*::testAdd" );
+  CPPUNIT_ASSERT( m_manifest->isNeeded( m_plugInFileName, "", excludeAdd ) );
+}
+
+
+void 
+PlugInManifestTest::testSaveAndLoad()
+{
+  setMathPlugInTests();
+  CPPUNIT_ASSERT( m_manifest->save( m_fileName ) );
+
+  PlugInManifest loaded;
+  loaded.load( m_fileName );
+  CPPUNIT_ASSERT( loaded.isUpToDate( m_plugInFileName ) );
+
+  CPPUNIT_NS::TestFilter noFilter;
+  CPPUNIT_ASSERT( loaded.isNeeded( m_plugInFileName, "MathTest::testSub", noFilter ) );
+  CPPUNIT_ASSERT( !loaded.isNeeded( m_plugInFileName, "StringTest", noFilter ) );
+}
+
+
+void 
+PlugInManifestTest::testLoadInvalidFileIsEmpty()
+{
+  setMathPlugInTests();
+  writeFile( m_fileName, "# comment\n"
+                         "plugin 7\n" );
+
+  m_manifest->load( m_fileName );
+  CPPUNIT_ASSERT( !m_manifest->isUpToDate( m_plugInFileName ) );
+}
+
+
+void 
+PlugInManifestTest::writeFile( const std::string &fileName,
+                               const std::string &content )
+{
+  std::ofstream stream( fileName.c_str() );
+  stream  <<  content;
+}
+
+
+void 
+PlugInManifestTest::setMathPlugInTests()
+{
+  PlugInManifest::TestPaths testPaths;
+  testPaths.push_back( "/All Tests/Arithmetic/MathTest/MathTest::testAdd" );
+  testPaths.push_back( "/All Tests/Arithmetic/MathTest/MathTest::testSub" );
+  m_manifest->setPlugInTests( m_plugInFileName, testPaths );
+}
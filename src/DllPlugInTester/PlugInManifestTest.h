@@ -0,0 +1,54 @@
+#ifndef PLUGINMANIFESTTEST_H
+#define PLUGINMANIFESTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "PlugInManifest.h"
+
+
+class PlugInManifestTest : public CPPUNIT_NS::TestCase
+{
+  CPPUNIT_TEST_SUITE( PlugInManifestTest );
+  CPPUNIT_TEST( testAddTestPaths );
+  CPPUNIT_TEST( testUnknownPlugInIsNeeded );
+  CPPUNIT_TEST( testModifiedPlugInIsNotUpToDate );
+  CPPUNIT_TEST( testPlugInWithoutTestIsNeeded );
+  CPPUNIT_TEST( testIsNeededByTestPath );
+  CPPUNIT_TEST( testIsNeededByFilter );
+  CPPUNIT_TEST( testSaveAndLoad );
+  CPPUNIT_TEST( testLoadInvalidFileIsEmpty );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  PlugInManifestTest();
+  virtual ~PlugInManifestTest();
+
+  void setUp();
+  void tearDown();
+
+  void testAddTestPaths();
+  void testUnknownPlugInIsNeeded();
+  void testModifiedPlugInIsNotUpToDate();
+  void testPlugInWithoutTestIsNeeded();
+  void testIsNeededByTestPath();
+  void testIsNeededByFilter();
+  void testSaveAndLoad();
+  void testLoadInvalidFileIsEmpty();
+
+private:
+  PlugInManifestTest( const PlugInManifestTest &other );
+  void operator =( const PlugInManifestTest &other );
+
+  void writeFile( const std::string &fileName,
+                  const std::string &content );
+
+  void setMathPlugInTests();
+
+private:
+  PlugInManifest *m_manifest;
+  std::string m_fileName;
+  std::string m_plugInFileName;
+};
+
+
+
+#endif  // PLUGINMANIFESTTEST_H
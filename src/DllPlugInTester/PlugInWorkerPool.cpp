@@ -0,0 +1,348 @@
+#include <cppunit/Message.h>
+#include <cppunit/ParameterizedTestCase.h>
+#include <cppunit/TestFilter.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestRunner.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/plugin/DynamicLibraryManagerException.h>
+#include <cppunit/plugin/PlugInManager.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <cppunit/portability/Stream.h>
+#include <cppunit/tools/PeakMemory.h>
+#include "CommandLineParser.h"
+#include "FileDescriptorStreamBuffer.h"
+#include "PlugInWorkerPool.h"
+#include "TestEventReader.h"
+#include "TestEventWriter.h"
+
+#if defined(CPPUNIT_WORKER_PROCESSES)
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/*! \brief Worker process running the tests of a plug-in (Implementation).
+ */
+struct PlugInWorker
+{
+  pid_t m_pid;
+  int m_fileDescriptor;
+  TestEventReader *m_reader;
+};
+
+
+/*! Indicates if a worker process exited with a zero status.
+ */
+static bool
+hasExitedNormally( int status )
+{
+  return WIFEXITED( status )  &&  WEXITSTATUS( status ) == 0;
+}
+
+
+/*! Describes how a worker process ended abnormally.
+ */
+static std::string
+describeExitStatus( int status,
+                    bool isDone )
+{
+  CPPUNIT_NS::OStringStream description;
+  if ( WIFSIGNALED( status ) )
+    description  <<  "Killed by signal "  <<  WTERMSIG( status );
+  else if ( WIFEXITED( status ) )
+  {
+    description  <<  "Exited with status "  <<  WEXITSTATUS( status );
+    if ( !isDone )
+      description  <<  " before the end of the run";
+  }
+  else
+    description  <<  "Ended with status "  <<  status;
+  return description.str();
+}
+
+
+/*! Kills the workers still running, failing the test they were running.
+ */
+static void
+killWorkers( CppUnitDeque<PlugInWorker> &workers,
+             const std::string &reason )
+{
+  for ( unsigned int index =0; index < workers.size(); ++index )
+  {
+    PlugInWorker &worker = workers[ index ];
+    ::kill( worker.m_pid, SIGKILL );
+    ::close( worker.m_fileDescriptor );
+    int status = 0;
+    while ( ::waitpid( worker.m_pid, &status, 0 ) < 0  &&  errno == EINTR )
+      ;
+    worker.m_reader->reportExitFailure( reason );
+  }
+  workers.clear();
+}
+
+
+/*! \brief Limits the address space of the worker to its current size plus
+ *         four times the peak memory budget of the tests.
+ *
+ * The budget is only checked once a test returns: the limit makes a test
+ * that allocates without bound fail with std::bad_alloc instead of
+ * exhausting the memory of the machine. The margin covers the address space
+ * that is reserved but not resident, such as the stacks of the threads and
+ * the arenas of malloc().
+ */
+static void
+limitAddressSpace( long budgetKilobytes )
+{
+  long currentKilobytes = CPPUNIT_NS::PeakMemory::addressSpaceKilobytes();
+  struct rlimit limit;
+  if ( budgetKilobytes <= 0  ||  currentKilobytes < 0  ||
+       ::getrlimit( RLIMIT_AS, &limit ) != 0 )
+    return;
+
+  rlim_t bytes = rlim_t( currentKilobytes + 4 * budgetKilobytes ) * 1024;
+  if ( limit.rlim_max != RLIM_INFINITY  &&  bytes > limit.rlim_max )
+    bytes = limit.rlim_max;
+  limit.rlim_cur = bytes;
+  ::setrlimit( RLIMIT_AS, &limit );
+}
+
+#endif  // defined(CPPUNIT_WORKER_PROCESSES)
+
+
+PlugInWorkerPool::PlugInWorkerPool( const CommandLineParser &parser )
+    : m_parser( parser )
+{
+}
+
+
+PlugInWorkerPool::~PlugInWorkerPool()
+{
+  for ( unsigned int index =0; index < m_readers.size(); ++index )
+    delete m_readers[ index ];
+}
+
+
+#if defined(CPPUNIT_WORKER_PROCESSES)
+
+bool
+PlugInWorkerPool::run( CPPUNIT_NS::TestResult &controller )
+{
+  CppUnitDeque<PlugInWorker> workers;
+  int nextPlugIn = 0;
+  bool hasFailedWorkers = false;
+  while ( nextPlugIn < m_parser.getPlugInCount()  ||  !workers.empty() )
+  {
+    while ( nextPlugIn < m_parser.getPlugInCount()  &&
+            int(workers.size()) < m_parser.getWorkerCount() )
+    {
+      int plugInIndex = nextPlugIn++;
+      TestEventReader *reader = new TestEventReader( controller,
+                                   m_parser.getPlugInAt( plugInIndex ).m_fileName );
+      m_readers.push_back( reader );
+
+      int pipeEnds[2];
+      if ( ::pipe( pipeEnds ) != 0 )
+      {
+        reader->finish( std::string( "Can not create pipe: " ) + ::strerror( errno ) );
+        hasFailedWorkers = true;
+        continue;
+      }
+
+      // The output buffered before the fork would be written again by the child.
+      CPPUNIT_NS::stdCOut().flush();
+      CPPUNIT_NS::stdCErr().flush();
+      ::fflush( NULL );
+
+      pid_t pid = ::fork();
+      if ( pid == 0 )
+      {
+        ::close( pipeEnds[0] );
+        for ( unsigned int index =0; index < workers.size(); ++index )
+          ::close( workers[ index ].m_fileDescriptor );
+        runWorker( plugInIndex, pipeEnds[1] );
+      }
+
+      ::close( pipeEnds[1] );
+      if ( pid < 0 )
+      {
+        ::close( pipeEnds[0] );
+        reader->finish( std::string( "Can not fork: " ) + ::strerror( errno ) );
+        hasFailedWorkers = true;
+        continue;
+      }
+
+      PlugInWorker worker;
+      worker.m_pid = pid;
+      worker.m_fileDescriptor = pipeEnds[0];
+      worker.m_reader = reader;
+      workers.push_back( worker );
+    }
+
+    if ( workers.empty() )
+      continue;
+
+    CppUnitVector<struct pollfd> pollFds( workers.size() );
+    for ( unsigned int index =0; index < workers.size(); ++index )
+    {
+      pollFds[ index ].fd = workers[ index ].m_fileDescriptor;
+      pollFds[ index ].events = POLLIN;
+      pollFds[ index ].revents = 0;
+    }
+
+    if ( ::poll( &pollFds[0], pollFds.size(), -1 ) < 0 )
+    {
+      if ( errno == EINTR )
+        continue;
+      std::string reason = std::string( "Can not poll worker process: " ) + 
+                           ::strerror( errno );
+      killWorkers( workers, reason );
+      for ( ; nextPlugIn < m_parser.getPlugInCount(); ++nextPlugIn )
+      {
+        TestEventReader *reader = new TestEventReader( controller,
+                                     m_parser.getPlugInAt( nextPlugIn ).m_fileName );
+        m_readers.push_back( reader );
+        reader->finish( reason );
+      }
+      hasFailedWorkers = true;
+      break;
+    }
+
+    // Backward, so that the index of the remaining workers is kept on erase.
+    for ( int index = int(workers.size()) -1; index >= 0; --index )
+    {
+      if ( pollFds[ index ].revents == 0 )
+        continue;
+
+      PlugInWorker &worker = workers[ index ];
+      char buffer[4096];
+      int readCount = ::read( worker.m_fileDescriptor, buffer, sizeof(buffer) );
+      if ( readCount > 0 )
+      {
+        worker.m_reader->addData( buffer, readCount );
+        continue;
+      }
+      if ( readCount < 0  &&  errno == EINTR )
+        continue;
+
+      ::close( worker.m_fileDescriptor );
+      int status = 0;
+      while ( ::waitpid( worker.m_pid, &status, 0 ) < 0  &&  errno == EINTR )
+        ;
+      // A crash after the end of the run, such as in the destructors of
+      // the static objects, fails the run too.
+      bool isDone = worker.m_reader->isDone();
+      if ( !isDone  ||  !hasExitedNormally( status ) )
+      {
+        worker.m_reader->reportExitFailure( describeExitStatus( status, isDone ) );
+        hasFailedWorkers = true;
+      }
+      workers.erase( workers.begin() + index );
+    }
+  }
+
+  // A test path or a filter only has to be resolved by one of the plug-ins.
+  bool isResolved = m_readers.empty();
+  std::string unresolvedReason;
+  for ( unsigned int index =0; index < m_readers.size(); ++index )
+  {
+    if ( m_readers[ index ]->isResolved() )
+      isResolved = true;
+    else
+      unresolvedReason = m_readers[ index ]->getUnresolvedReason();
+  }
+
+  if ( !isResolved )
+  {
+    CPPUNIT_NS::stdCOut()  <<  "Failed to resolve test path or filter: "
+                           <<  unresolvedReason  <<  "\n";
+  }
+  return isResolved  &&  !hasFailedWorkers;
+}
+
+
+
+void
+PlugInWorkerPool::runWorker( int plugInIndex,
+                             int fileDescriptor )
+{
+  {
+    FileDescriptorStreamBuffer buffer( fileDescriptor );
+    std::ostream stream( &buffer );
+    TestEventWriter writer( stream );
+    CommandLinePlugInInfo plugIn = m_parser.getPlugInAt( plugInIndex );
+    try
+    {
+      CPPUNIT_NS::PlugInManager plugInManager;
+      if ( m_parser.useLazyBinding() )
+        plugInManager.setSymbolResolution( CPPUNIT_NS::DynamicLibraryManager::resolveOnFirstCall );
+      plugInManager.load( plugIn.m_fileName, plugIn.m_parameters );
+      limitAddressSpace( m_parser.getMaximumRssMegabytes() * 1024 );
+
+      CPPUNIT_NS::TestResult controller;
+      controller.setFailsTestsWithoutAssertions( m_parser.requireAssertions() );
+      controller.setPeakMemoryBudget( m_parser.getMaximumRssMegabytes() * 1024 );
+      controller.setTracksPeakMemory( m_parser.useXmlOutputter() );
+      controller.addListener( &writer );
+      plugInManager.addListener( &controller );
+
+      CPPUNIT_NS::ParameterizedTest::setDefaultShard( m_parser.getDataShardIndex(),
+                                                      m_parser.getDataShardCount() );
+      CPPUNIT_NS::TestRunner runner;
+      runner.addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+      try
+      {
+        CPPUNIT_NS::TestFilter filter;
+        for ( int filterIndex =0; filterIndex < m_parser.getFilterCount(); ++filterIndex )
+          filter.addInclude( m_parser.getFilterAt( filterIndex ) );
+        for ( int excludeIndex =0; excludeIndex < m_parser.getExcludeCount(); ++excludeIndex )
+          filter.addExclude( m_parser.getExcludeAt( excludeIndex ) );
+        runner.run( controller, filter, m_parser.getTestPath() );
+      }
+      catch ( std::invalid_argument &e )
+      {
+        writer.writeUnresolved( e.what() );
+      }
+
+      plugInManager.removeListener( &controller );
+    }
+    catch ( CPPUNIT_NS::DynamicLibraryManagerException &e )
+    {
+      writer.writeError( plugIn.m_fileName,
+                         CPPUNIT_NS::Message( "Failed to load test plug-in",
+                                              e.what() ) );
+    }
+
+    // Written once the plug-in is unloaded, so that a crash of its
+    // destructors is reported.
+    writer.writeDone();
+  }
+
+  CPPUNIT_NS::stdCOut().flush();
+  CPPUNIT_NS::stdCErr().flush();
+  ::fflush( NULL );
+  ::_exit( 0 );
+}
+
+
+#else   // defined(CPPUNIT_WORKER_PROCESSES)
+
+bool
+PlugInWorkerPool::run( CPPUNIT_NS::TestResult & )
+{
+  CPPUNIT_NS::stdCOut()  <<  "--workers is not supported on this platform\n";
+  return false;
+}
+
+
+void
+PlugInWorkerPool::runWorker( int, int )
+{
+}
+
+#endif  // defined(CPPUNIT_WORKER_PROCESSES)
@@ -0,0 +1,78 @@
+#ifndef CPPUNIT_HELPER_PLUGINWORKERPOOL_H
+#define CPPUNIT_HELPER_PLUGINWORKERPOOL_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/portability/CppUnitDeque.h>
+#include <string>
+
+#if defined(CPPUNIT_HAVE_UNISTD_H) && defined(CPPUNIT_HAVE_SYS_WAIT_H) && \
+    defined(CPPUNIT_HAVE_POLL_H) && !defined(CPPUNIT_NO_STREAM)
+#define CPPUNIT_WORKER_PROCESSES 1
+#endif
+
+CPPUNIT_NS_BEGIN
+class TestResult;
+CPPUNIT_NS_END
+
+class CommandLineParser;
+class TestEventReader;
+
+
+/*! \brief Runs the tests of each plug-in in its own worker process.
+ *
+ * A child process is forked for each plug-in of the command line, up to the
+ * specified number at the same time. The child loads its plug-in, runs the
+ * tests selected by the test path and the filters with the listeners of the
+ * plug-in, and reports the results over a pipe with a TestEventWriter. The
+ * parent process never loads the plug-ins: it replays the results of the
+ * children in its own TestResult as they arrive, test by test, so that a
+ * single TestResultCollector and a single set of outputters cover all the
+ * plug-ins.
+ *
+ * A plug-in that crashes, aborts or exits before the end of its run only
+ * fails the test in progress, reported as an error with the exit status of
+ * its process. A worker that crashes or exits with a non-zero status after
+ * its run fails a test named after its plug-in. A test path is resolved if
+ * it is found in one of the plug-ins.
+ *
+ * The tests reported to the TestResult are owned by the pool: it must outlive
+ * the TestResultCollector and the outputters.
+ *
+ * Only available if CPPUNIT_WORKER_PROCESSES is defined.
+ */
+class PlugInWorkerPool
+{
+public:
+  /*! Constructs a pool for the plug-ins of the command line.
+   */
+  PlugInWorkerPool( const CommandLineParser &parser );
+
+  /// Destructor. Destroys the tests reported by the workers.
+  virtual ~PlugInWorkerPool();
+
+  /*! \brief Runs the tests of the plug-ins in worker processes.
+   * \param controller Test event manager the results are reported to.
+   * \return \c false if a process could not be started or did not exit
+   *         normally, or if the test path or the filter was resolved by none
+   *         of the plug-ins.
+   */
+  bool run( CPPUNIT_NS::TestResult &controller );
+
+private:
+  /// Runs the tests of a plug-in in the worker process, then exits.
+  void runWorker( int plugInIndex,
+                  int fileDescriptor );
+
+  /// Prevents the use of the copy constructor.
+  PlugInWorkerPool( const PlugInWorkerPool &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const PlugInWorkerPool &copy );
+
+private:
+  const CommandLineParser &m_parser;
+  CppUnitDeque<TestEventReader *> m_readers;
+};
+
+
+#endif  // CPPUNIT_HELPER_PLUGINWORKERPOOL_H
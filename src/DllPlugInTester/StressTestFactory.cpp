@@ -0,0 +1,55 @@
+#include <cppunit/TestLeaf.h>
+#include <cppunit/TestPlan.h>
+#include <cppunit/TestRunner.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include "StressTestFactory.h"
+#include <memory>
+
+
+/*! \brief (INTERNAL) Runs the tests selected in a test tree of its own.
+ */
+class SelectedTests : public CPPUNIT_NS::TestLeaf
+{
+public:
+  SelectedTests( const CPPUNIT_NS::TestFilter &filter,
+                 const std::string &testPath )
+  {
+    m_runner.addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+    m_plan.reset( m_runner.makeTestPlan( filter, testPath ) );
+  }
+
+  void run( CPPUNIT_NS::TestResult *result )
+  {
+    m_plan->run( result );
+  }
+
+  int countTestCases() const
+  {
+    return m_plan->countTestCases();
+  }
+
+  std::string getName() const
+  {
+    return m_plan->getRootTest()->getName();
+  }
+
+private:
+  // The plan refers to the tests of the runner and is destroyed first.
+  CPPUNIT_NS::TestRunner m_runner;
+  std::auto_ptr<CPPUNIT_NS::TestPlan> m_plan;
+};
+
+
+StressTestFactory::StressTestFactory( const CPPUNIT_NS::TestFilter &filter,
+                                      const std::string &testPath )
+    : m_filter( filter )
+    , m_testPath( testPath )
+{
+}
+
+
+CPPUNIT_NS::Test *
+StressTestFactory::makeTest()
+{
+  return new SelectedTests( m_filter, m_testPath );
+}
@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_HELPER_STRESSTESTFACTORY_H
+#define CPPUNIT_HELPER_STRESSTESTFACTORY_H
+
+#include <cppunit/extensions/TestFactory.h>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+class TestFilter;
+CPPUNIT_NS_END
+
+
+/*! \brief Makes a new copy of the selected tests for each thread of a stress run.
+ *
+ * Each test made by the factory owns its own test tree created by the
+ * default registry, so the threads of a ConcurrentRepeatedTest do not share
+ * fixtures. The test runs the tests of its tree below the test path that
+ * are selected by the filter.
+ */
+class StressTestFactory : public CPPUNIT_NS::TestFactory
+{
+public:
+  /*! Constructs a factory.
+   * \param filter Filter that selects the tests to run. Must outlive the factory.
+   * \param testPath Test path string. See Test::resolveTestPath() for detail.
+   */
+  StressTestFactory( const CPPUNIT_NS::TestFilter &filter,
+                     const std::string &testPath );
+
+  /*! Makes a new test tree and selects its tests.
+   * \exception std::invalid_argument if no test matching the test path is found.
+   */
+  CPPUNIT_NS::Test *makeTest();
+
+private:
+  const CPPUNIT_NS::TestFilter &m_filter;
+  const std::string m_testPath;
+};
+
+
+#endif  // CPPUNIT_HELPER_STRESSTESTFACTORY_H
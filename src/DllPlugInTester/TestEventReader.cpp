@@ -0,0 +1,243 @@
+#include <cppunit/Exception.h>
+#include <cppunit/Message.h>
+#include <cppunit/SourceLine.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestResult.h>
+#include "TestEventReader.h"
+#include <stdlib.h>
+
+
+TestEventReader::TestEventReader( CPPUNIT_NS::TestResult &result,
+                                  const std::string &sourceName )
+    : m_result( result )
+    , m_sourceName( sourceName )
+    , m_isInTest( false )
+    , m_assertionCount( 0 )
+    , m_hasAllocations( false )
+    , m_allocationCount( 0 )
+    , m_allocatedByteCount( 0 )
+    , m_peakMemory( -1 )
+    , m_isDone( false )
+    , m_isResolved( true )
+{
+}
+
+
+TestEventReader::~TestEventReader()
+{
+  deletePendingFailures();
+  for ( unsigned int index =0; index < m_tests.size(); ++index )
+    delete m_tests[ index ];
+}
+
+
+void
+TestEventReader::addData( const char *data,
+                          int length )
+{
+  const char *end = data + length;
+  while ( data != end )
+  {
+    const char *lineEnd = data;
+    while ( lineEnd != end  &&  *lineEnd != '\n' )
+      ++lineEnd;
+
+    m_partialLine.append( data, lineEnd );
+    if ( lineEnd == end )
+      break;
+
+    readLine( m_partialLine );
+    m_partialLine = "";
+    data = lineEnd + 1;
+  }
+}
+
+
+void
+TestEventReader::finish( const std::string &exitDescription )
+{
+  if ( !m_isDone )
+    reportExitFailure( exitDescription );
+}
+
+
+void
+TestEventReader::reportExitFailure( const std::string &exitDescription )
+{
+  if ( !m_isInTest )
+  {
+    m_isInTest = true;
+    m_testName = m_sourceName;
+  }
+
+  PendingFailure failure;
+  failure.m_isError = true;
+  failure.m_exception = new CPPUNIT_NS::Exception(
+      CPPUNIT_NS::Message( "worker process failed",
+                           "Plug-in: " + m_sourceName,
+                           exitDescription ) );
+  m_failures.push_back( failure );
+  reportTest();
+}
+
+
+bool
+TestEventReader::isDone() const
+{
+  return m_isDone;
+}
+
+
+bool
+TestEventReader::isResolved() const
+{
+  return m_isResolved;
+}
+
+
+std::string
+TestEventReader::getUnresolvedReason() const
+{
+  return m_unresolvedReason;
+}
+
+
+std::string
+TestEventReader::unescape( const std::string &text )
+{
+  std::string unescaped;
+  unescaped.reserve( text.length() );
+  for ( std::string::const_iterator it = text.begin(); it != text.end(); ++it )
+  {
+    if ( *it != '\\'  ||  it + 1 == text.end() )
+    {
+      unescaped += *it;
+      continue;
+    }
+
+    ++it;
+    if ( *it == 'n' )
+      unescaped += '\n';
+    else if ( *it == 'r' )
+      unescaped += '\r';
+    else
+      unescaped += *it;
+  }
+  return unescaped;
+}
+
+
+void
+TestEventReader::readLine( const std::string &line )
+{
+  std::string::size_type separator = line.find( ' ' );
+  std::string event = line.substr( 0, separator );
+  std::string argument;
+  if ( separator != std::string::npos )
+    argument = unescape( line.substr( separator + 1 ) );
+
+  if ( event == "start" )
+  {
+    m_isInTest = true;
+    m_testName = argument;
+  }
+  else if ( event == "failure"  ||  event == "error" )
+    readFailure( event == "error",
+                 separator == std::string::npos ? "" : line.substr( separator + 1 ) );
+  else if ( event == "message"  &&  !m_failures.empty() )
+  {
+    CPPUNIT_NS::Exception *exception = m_failures.back().m_exception;
+    exception->setMessage( CPPUNIT_NS::Message( argument ) );
+  }
+  else if ( event == "detail"  &&  !m_failures.empty() )
+  {
+    CPPUNIT_NS::Exception *exception = m_failures.back().m_exception;
+    CPPUNIT_NS::Message message = exception->message();
+    message.addDetail( argument );
+    exception->setMessage( message );
+  }
+  else if ( event == "assertions" )
+    m_assertionCount = ::atoi( argument.c_str() );
+  else if ( event == "allocations" )
+  {
+    std::string::size_type countSeparator = argument.find( ' ' );
+    m_hasAllocations = true;
+    m_allocationCount = ::atol( argument.substr( 0, countSeparator ).c_str() );
+    if ( countSeparator != std::string::npos )
+      m_allocatedByteCount = ::atol( argument.substr( countSeparator + 1 ).c_str() );
+  }
+  else if ( event == "peakmemory" )
+    m_peakMemory = ::atol( argument.c_str() );
+  else if ( event == "end"  &&  m_isInTest )
+    reportTest();
+  else if ( event == "unresolved" )
+  {
+    m_isResolved = false;
+    m_unresolvedReason = argument;
+  }
+  else if ( event == "done" )
+    m_isDone = true;
+}
+
+
+void
+TestEventReader::readFailure( bool isError,
+                              const std::string &location )
+{
+  CPPUNIT_NS::SourceLine sourceLine;
+  std::string::size_type separator = location.find( ' ' );
+  if ( separator != std::string::npos )
+  {
+    int lineNumber = ::atoi( location.substr( 0, separator ).c_str() );
+    sourceLine = CPPUNIT_NS::SourceLine( unescape( location.substr( separator + 1 ) ),
+                                         lineNumber );
+  }
+
+  PendingFailure failure;
+  failure.m_isError = isError;
+  failure.m_exception = new CPPUNIT_NS::Exception( CPPUNIT_NS::Message(), sourceLine );
+  m_failures.push_back( failure );
+}
+
+
+void
+TestEventReader::reportTest()
+{
+  CPPUNIT_NS::Test *test = new CPPUNIT_NS::TestCase( m_testName );
+  m_tests.push_back( test );
+
+  m_result.startTest( test );
+  for ( unsigned int index =0; index < m_failures.size(); ++index )
+  {
+    // The TestResult takes the ownership of the exception.
+    const PendingFailure &failure = m_failures[ index ];
+    if ( failure.m_isError )
+      m_result.addError( test, failure.m_exception );
+    else
+      m_result.addFailure( test, failure.m_exception );
+  }
+  m_failures.clear();
+  m_result.addAssertions( test, m_assertionCount );
+  if ( m_hasAllocations )
+    m_result.addAllocations( test, m_allocationCount, m_allocatedByteCount );
+  if ( m_peakMemory >= 0 )
+    m_result.addPeakMemory( test, m_peakMemory );
+  m_result.endTest( test );
+
+  m_isInTest = false;
+  m_testName = "";
+  m_assertionCount = 0;
+  m_hasAllocations = false;
+  m_allocationCount = 0;
+  m_allocatedByteCount = 0;
+  m_peakMemory = -1;
+}
+
+
+void
+TestEventReader::deletePendingFailures()
+{
+  for ( unsigned int index =0; index < m_failures.size(); ++index )
+    delete m_failures[ index ].m_exception;
+  m_failures.clear();
+}
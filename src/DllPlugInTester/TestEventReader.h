@@ -0,0 +1,126 @@
+#ifndef CPPUNIT_HELPER_TESTEVENTREADER_H
+#define CPPUNIT_HELPER_TESTEVENTREADER_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/portability/CppUnitDeque.h>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+class Exception;
+class Test;
+class TestResult;
+CPPUNIT_NS_END
+
+
+/*! \brief Replays the test events written by TestEventWriter.
+ *
+ * Each test read from the stream is represented by a TestCase of the same
+ * name, owned by the reader: the reader must outlive the TestResultCollector
+ * and the outputters the events are sent to.
+ *
+ * The events of a test are only sent to the TestResult once the end of the
+ * test is read, so that the tests of readers fed concurrently from several
+ * streams are not interleaved.
+ */
+class TestEventReader
+{
+public:
+  /*! Constructs a reader.
+   * \param result Test event manager the events are sent to.
+   * \param sourceName Name of the source of the stream, such as the name of
+   *                   a plug-in, used to report its crash.
+   */
+  TestEventReader( CPPUNIT_NS::TestResult &result,
+                   const std::string &sourceName );
+
+  /// Destructor. Destroys the tests.
+  virtual ~TestEventReader();
+
+  /*! \brief Reads the next chunk of the stream.
+   *
+   * The complete lines are processed, the rest is kept for the next chunk.
+   */
+  void addData( const char *data,
+                int length );
+
+  /*! \brief Ends the stream.
+   *
+   * If the end of the run was not read, the source is assumed to have
+   * crashed: an error is reported on the test in progress, or on a test named
+   * after the source if no test was in progress.
+   *
+   * \param exitDescription Description of how the source ended, added to the
+   *                        error message.
+   */
+  void finish( const std::string &exitDescription );
+
+  /*! \brief Reports that the source ended abnormally, even if the end of the
+   *         run was read.
+   *
+   * An error is reported on the test in progress, or on a test named after
+   * the source if no test was in progress.
+   *
+   * \param exitDescription Description of how the source ended, added to the
+   *                        error message.
+   */
+  void reportExitFailure( const std::string &exitDescription );
+
+  /*! \brief Indicates if the end of the run was read.
+   */
+  bool isDone() const;
+
+  /*! \brief Indicates if the test path and the filter were resolved.
+   */
+  bool isResolved() const;
+
+  /*! \brief Returns why the test path or the filter could not be resolved.
+   */
+  std::string getUnresolvedReason() const;
+
+  /*! \brief Returns a text escaped by TestEventWriter::escape().
+   */
+  static std::string unescape( const std::string &text );
+
+private:
+  struct PendingFailure
+  {
+    bool m_isError;
+    CPPUNIT_NS::Exception *m_exception;
+  };
+
+  void readLine( const std::string &line );
+
+  void readFailure( bool isError,
+                    const std::string &location );
+
+  void reportTest();
+
+  void deletePendingFailures();
+
+  /// Prevents the use of the copy constructor.
+  TestEventReader( const TestEventReader &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestEventReader &copy );
+
+private:
+  CPPUNIT_NS::TestResult &m_result;
+  std::string m_sourceName;
+  /// End of the stream that does not make a complete line yet.
+  std::string m_partialLine;
+  bool m_isInTest;
+  std::string m_testName;
+  CppUnitDeque<PendingFailure> m_failures;
+  int m_assertionCount;
+  bool m_hasAllocations;
+  long m_allocationCount;
+  long m_allocatedByteCount;
+  long m_peakMemory;
+  bool m_isDone;
+  bool m_isResolved;
+  std::string m_unresolvedReason;
+  CppUnitDeque<CPPUNIT_NS::Test *> m_tests;
+};
+
+
+#endif  // CPPUNIT_HELPER_TESTEVENTREADER_H
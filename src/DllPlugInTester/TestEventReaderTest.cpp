@@ -0,0 +1,285 @@
+#include <cppunit/Exception.h>
+#include <cppunit/Message.h>
+#include <cppunit/SourceLine.h>
+#include <cppunit/TestFailure.h>
+#include "TestEventReader.h"
+#include "TestEventReaderTest.h"
+#include "TestEventWriter.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestEventReaderTest );
+
+
+TestEventReaderTest::TestEventReaderTest()
+{
+}
+
+
+TestEventReaderTest::~TestEventReaderTest()
+{
+}
+
+
+void 
+TestEventReaderTest::setUp()
+{
+  m_result = new CPPUNIT_NS::TestResult();
+  m_collector = new CPPUNIT_NS::TestResultCollector();
+  m_result->addListener( m_collector );
+}
+
+
+void 
+TestEventReaderTest::tearDown()
+{
+  delete m_collector;
+  delete m_result;
+}
+
+
+std::string 
+TestEventReaderTest::writeFailedTest()
+{
+  CPPUNIT_NS::OStringStream stream;
+  TestEventWriter writer( stream );
+  CPPUNIT_NS::TestCase test( "MathTest::testAdd" );
+  writer.startTest( &test );
+  CPPUNIT_NS::Message message( "equality assertion failed", 
+                               "- Expected: 3", 
+                               "- Actual  : 4\nwith a second line" );
+  writer.addFailure( CPPUNIT_NS::TestFailure( 
+      &test, 
+      new CPPUNIT_NS::Exception( message, 
+                                 CPPUNIT_NS::SourceLine( "Math Test.cpp", 12 ) ),
+      false ) );
+  writer.endTest( &test );
+  writer.writeDone();
+  return stream.str();
+}
+
+
+void 
+TestEventReaderTest::testEscape()
+{
+  std::string text = "a\\b\nc\r\\n";
+  std::string escaped = TestEventWriter::escape( text );
+  CPPUNIT_ASSERT_EQUAL( std::string( "a\\\\b\\nc\\r\\\\n" ), escaped );
+  CPPUNIT_ASSERT_EQUAL( text, TestEventReader::unescape( escaped ) );
+}
+
+
+void 
+TestEventReaderTest::testReplayTests()
+{
+  CPPUNIT_NS::OStringStream stream;
+  TestEventWriter writer( stream );
+  CPPUNIT_NS::TestCase test1( "MathTest::testAdd" );
+  CPPUNIT_NS::TestCase test2( "MathTest::testSub" );
+  writer.startTest( &test1 );
+  writer.endTest( &test1 );
+  writer.startTest( &test2 );
+  writer.endTest( &test2 );
+  writer.writeDone();
+
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  std::string events = stream.str();
+  reader.addData( events.c_str(), events.length() );
+  reader.finish( "unused" );
+
+  CPPUNIT_ASSERT( reader.isDone() );
+  CPPUNIT_ASSERT( reader.isResolved() );
+  CPPUNIT_ASSERT_EQUAL( 2, m_collector->runTests() );
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "MathTest::testSub" ), 
+                        m_collector->tests()[1]->getName() );
+}
+
+
+void 
+TestEventReaderTest::testReplayFailure()
+{
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  std::string events = writeFailedTest();
+  reader.addData( events.c_str(), events.length() );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->runTests() );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+  CPPUNIT_ASSERT_EQUAL( 0, m_collector->testErrors() );
+
+  CPPUNIT_NS::TestFailure *failure = m_collector->failures()[0];
+  CPPUNIT_ASSERT_EQUAL( std::string( "MathTest::testAdd" ), 
+                        failure->failedTestName() );
+  CPPUNIT_NS::Message message = failure->thrownException()->message();
+  CPPUNIT_ASSERT_EQUAL( std::string( "equality assertion failed" ), 
+                        message.shortDescription() );
+  CPPUNIT_ASSERT_EQUAL( 2, message.detailCount() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "- Actual  : 4\nwith a second line" ), 
+                        message.detailAt( 1 ) );
+  CPPUNIT_ASSERT( CPPUNIT_NS::SourceLine( "Math Test.cpp", 12 ) == 
+                  failure->sourceLine() );
+}
+
+
+void 
+TestEventReaderTest::testTestReportedOnlyAtEnd()
+{
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  std::string events = writeFailedTest();
+  std::string::size_type endIndex = events.find( "end\n" );
+
+  for ( std::string::size_type index =0; index < endIndex + 3; ++index )
+    reader.addData( events.c_str() + index, 1 );
+  CPPUNIT_ASSERT_EQUAL( 0, m_collector->runTests() );
+
+  reader.addData( events.c_str() + endIndex + 3, 1 );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->runTests() );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+}
+
+
+void 
+TestEventReaderTest::testCrashFailsTestInProgress()
+{
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  std::string events = "start MathTest::testDivide\nfailure\nmessage first\n";
+  reader.addData( events.c_str(), events.length() );
+  reader.finish( "Killed by signal 11" );
+
+  CPPUNIT_ASSERT( !reader.isDone() );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->runTests() );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testFailures() );
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testErrors() );
+  CPPUNIT_NS::TestFailure *crash = m_collector->failures()[1];
+  CPPUNIT_ASSERT_EQUAL( std::string( "MathTest::testDivide" ), 
+                        crash->failedTestName() );
+  CPPUNIT_ASSERT( crash->isError() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "Killed by signal 11" ), 
+                        crash->thrownException()->message().detailAt( 1 ) );
+}
+
+
+void 
+TestEventReaderTest::testCrashBeforeFirstTest()
+{
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  reader.finish( "Exited with status 3 before the end of the run" );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testErrors() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "MathPlugIn.so" ), 
+                        m_collector->failures()[0]->failedTestName() );
+}
+
+
+void 
+TestEventReaderTest::testFinishAfterDone()
+{
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  reader.addData( "done\n", 5 );
+  reader.finish( "Exited with status 0 before the end of the run" );
+
+  CPPUNIT_ASSERT_EQUAL( 0, m_collector->runTests() );
+  CPPUNIT_ASSERT( m_collector->wasSuccessful() );
+}
+
+
+void 
+TestEventReaderTest::testExitFailureAfterDone()
+{
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  reader.addData( "done\n", 5 );
+  reader.reportExitFailure( "Killed by signal 6" );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_collector->testErrors() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "MathPlugIn.so" ), 
+                        m_collector->failures()[0]->failedTestName() );
+}
+
+
+void 
+TestEventReaderTest::testUnresolved()
+{
+  CPPUNIT_NS::OStringStream stream;
+  TestEventWriter writer( stream );
+  writer.writeUnresolved( "No test named <MathTest>" );
+  writer.writeDone();
+
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  std::string events = stream.str();
+  reader.addData( events.c_str(), events.length() );
+
+  CPPUNIT_ASSERT( reader.isDone() );
+  CPPUNIT_ASSERT( !reader.isResolved() );
+  CPPUNIT_ASSERT_EQUAL( std::string( "No test named <MathTest>" ), 
+                        reader.getUnresolvedReason() );
+}
+
+
+void 
+TestEventReaderTest::testReplayAssertionCount()
+{
+  CPPUNIT_NS::OStringStream stream;
+  TestEventWriter writer( stream );
+  CPPUNIT_NS::TestCase test1( "MathTest::testAdd" );
+  CPPUNIT_NS::TestCase test2( "MathTest::testSub" );
+  writer.startTest( &test1 );
+  writer.addAssertions( &test1, 7 );
+  writer.endTest( &test1 );
+  writer.startTest( &test2 );
+  writer.endTest( &test2 );
+  writer.writeDone();
+
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  std::string events = stream.str();
+  reader.addData( events.c_str(), events.length() );
+
+  CPPUNIT_ASSERT_EQUAL( 7, m_collector->assertionCount() );
+  CPPUNIT_ASSERT_EQUAL( 7, m_collector->assertionCount( m_collector->tests()[0] ) );
+  CPPUNIT_ASSERT_EQUAL( 0, m_collector->assertionCount( m_collector->tests()[1] ) );
+}
+
+
+void 
+TestEventReaderTest::testReplayAllocationCount()
+{
+  CPPUNIT_NS::OStringStream stream;
+  TestEventWriter writer( stream );
+  CPPUNIT_NS::TestCase test1( "MathTest::testAdd" );
+  CPPUNIT_NS::TestCase test2( "MathTest::testSub" );
+  writer.startTest( &test1 );
+  writer.addAllocations( &test1, 12, 480 );
+  writer.endTest( &test1 );
+  writer.startTest( &test2 );
+  writer.endTest( &test2 );
+  writer.writeDone();
+
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  std::string events = stream.str();
+  reader.addData( events.c_str(), events.length() );
+
+  CPPUNIT_ASSERT_EQUAL( 12L, m_collector->allocationCount() );
+  CPPUNIT_ASSERT_EQUAL( 480L, m_collector->allocatedByteCount( m_collector->tests()[0] ) );
+  CPPUNIT_ASSERT_EQUAL( 0L, m_collector->allocationCount( m_collector->tests()[1] ) );
+}
+
+
+void 
+TestEventReaderTest::testReplayPeakMemory()
+{
+  CPPUNIT_NS::OStringStream stream;
+  TestEventWriter writer( stream );
+  CPPUNIT_NS::TestCase test1( "MathTest::testAdd" );
+  CPPUNIT_NS::TestCase test2( "MathTest::testSub" );
+  writer.startTest( &test1 );
+  writer.addPeakMemory( &test1, 5312 );
+  writer.endTest( &test1 );
+  writer.startTest( &test2 );
+  writer.endTest( &test2 );
+  writer.writeDone();
+
+  TestEventReader reader( *m_result, "MathPlugIn.so" );
+  std::string events = stream.str();
+  reader.addData( events.c_str(), events.length() );
+
+  CPPUNIT_ASSERT_EQUAL( 5312L, m_collector->peakMemory() );
+  CPPUNIT_ASSERT_EQUAL( 5312L, m_collector->peakMemory( m_collector->tests()[0] ) );
+  CPPUNIT_ASSERT_EQUAL( -1L, m_collector->peakMemory( m_collector->tests()[1] ) );
+}
@@ -0,0 +1,60 @@
+#ifndef TESTEVENTREADERTEST_H
+#define TESTEVENTREADERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <string>
+
+
+class TestEventReaderTest : public CPPUNIT_NS::TestCase
+{
+  CPPUNIT_TEST_SUITE( TestEventReaderTest );
+  CPPUNIT_TEST( testEscape );
+  CPPUNIT_TEST( testReplayTests );
+  CPPUNIT_TEST( testReplayFailure );
+  CPPUNIT_TEST( testTestReportedOnlyAtEnd );
+  CPPUNIT_TEST( testCrashFailsTestInProgress );
+  CPPUNIT_TEST( testCrashBeforeFirstTest );
+  CPPUNIT_TEST( testFinishAfterDone );
+  CPPUNIT_TEST( testExitFailureAfterDone );
+  CPPUNIT_TEST( testUnresolved );
+  CPPUNIT_TEST( testReplayAssertionCount );
+  CPPUNIT_TEST( testReplayAllocationCount );
+  CPPUNIT_TEST( testReplayPeakMemory );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TestEventReaderTest();
+  virtual ~TestEventReaderTest();
+
+  void setUp();
+  void tearDown();
+
+  void testEscape();
+  void testReplayTests();
+  void testReplayFailure();
+  void testTestReportedOnlyAtEnd();
+  void testCrashFailsTestInProgress();
+  void testCrashBeforeFirstTest();
+  void testFinishAfterDone();
+  void testExitFailureAfterDone();
+  void testUnresolved();
+  void testReplayAssertionCount();
+  void testReplayAllocationCount();
+  void testReplayPeakMemory();
+
+private:
+  TestEventReaderTest( const TestEventReaderTest &other );
+  void operator =( const TestEventReaderTest &other );
+
+  std::string writeFailedTest();
+
+private:
+  CPPUNIT_NS::TestResult *m_result;
+  CPPUNIT_NS::TestResultCollector *m_collector;
+};
+
+
+
+#endif  // TESTEVENTREADERTEST_H
@@ -0,0 +1,131 @@
+#include <cppunit/Exception.h>
+#include <cppunit/Message.h>
+#include <cppunit/SourceLine.h>
+#include <cppunit/Test.h>
+#include <cppunit/TestFailure.h>
+#include "TestEventWriter.h"
+
+
+TestEventWriter::TestEventWriter( CPPUNIT_NS::OStream &stream )
+    : m_stream( stream )
+{
+}
+
+
+TestEventWriter::~TestEventWriter()
+{
+}
+
+
+void
+TestEventWriter::startTest( CPPUNIT_NS::Test *test )
+{
+  // Flushed so that a crash of the test is reported on it.
+  m_stream  <<  "start "  <<  escape( test->getName() )  <<  "\n";
+  m_stream.flush();
+}
+
+
+void
+TestEventWriter::addFailure( const CPPUNIT_NS::TestFailure &failure )
+{
+  writeFailure( failure.isError(), *failure.thrownException() );
+}
+
+
+void
+TestEventWriter::addAssertions( CPPUNIT_NS::Test *,
+                                int assertionCount )
+{
+  m_stream  <<  "assertions "  <<  assertionCount  <<  "\n";
+}
+
+
+void
+TestEventWriter::addAllocations( CPPUNIT_NS::Test *,
+                                 long allocationCount,
+                                 long allocatedByteCount )
+{
+  m_stream  <<  "allocations "  <<  allocationCount  <<  " "  
+            <<  allocatedByteCount  <<  "\n";
+}
+
+
+void
+TestEventWriter::addPeakMemory( CPPUNIT_NS::Test *,
+                                long peakKilobytes )
+{
+  m_stream  <<  "peakmemory "  <<  peakKilobytes  <<  "\n";
+}
+
+
+void
+TestEventWriter::endTest( CPPUNIT_NS::Test * )
+{
+  m_stream  <<  "end\n";
+  m_stream.flush();
+}
+
+
+void
+TestEventWriter::writeError( const std::string &name,
+                             const CPPUNIT_NS::Message &message )
+{
+  m_stream  <<  "start "  <<  escape( name )  <<  "\n";
+  writeFailure( true, CPPUNIT_NS::Exception( message ) );
+  m_stream  <<  "end\n";
+  m_stream.flush();
+}
+
+
+void
+TestEventWriter::writeUnresolved( const std::string &reason )
+{
+  m_stream  <<  "unresolved "  <<  escape( reason )  <<  "\n";
+}
+
+
+void
+TestEventWriter::writeDone()
+{
+  m_stream  <<  "done\n";
+  m_stream.flush();
+}
+
+
+std::string
+TestEventWriter::escape( const std::string &text )
+{
+  std::string escaped;
+  escaped.reserve( text.length() );
+  for ( std::string::const_iterator it = text.begin(); it != text.end(); ++it )
+  {
+    if ( *it == '\\' )
+      escaped += "\\\\";
+    else if ( *it == '\n' )
+      escaped += "\\n";
+    else if ( *it == '\r' )
+      escaped += "\\r";
+    else
+      escaped += *it;
+  }
+  return escaped;
+}
+
+
+void
+TestEventWriter::writeFailure( bool isError,
+                               const CPPUNIT_NS::Exception &exception )
+{
+  m_stream  <<  (isError ? "error" : "failure");
+  CPPUNIT_NS::SourceLine sourceLine = exception.sourceLine();
+  if ( sourceLine.isValid() )
+    m_stream  <<  " "  <<  sourceLine.lineNumber()
+              <<  " "  <<  escape( sourceLine.fileName() );
+  m_stream  <<  "\n";
+
+  CPPUNIT_NS::Message message = exception.message();
+  m_stream  <<  "message "  <<  escape( message.shortDescription() )  <<  "\n";
+  for ( int index =0; index < message.detailCount(); ++index )
+    m_stream  <<  "detail "  <<  escape( message.detailAt( index ) )  <<  "\n";
+}
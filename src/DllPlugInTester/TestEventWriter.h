@@ -0,0 +1,99 @@
+#ifndef CPPUNIT_HELPER_TESTEVENTWRITER_H
+#define CPPUNIT_HELPER_TESTEVENTWRITER_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/TestListener.h>
+#include <cppunit/portability/Stream.h>
+#include <string>
+
+CPPUNIT_NS_BEGIN
+class Exception;
+class Message;
+CPPUNIT_NS_END
+
+
+/*! \brief Writes the test events to a stream, to be replayed by TestEventReader.
+ *
+ * Used by the worker processes of DllPlugInTester to report their results to
+ * the parent process. Each event is written on its own line and the stream is
+ * flushed at the start and at the end of each test:
+ * \code
+ * start MathTest::testAdd
+ * failure 12 MathTest.cpp
+ * message equality assertion failed
+ * detail - Expected: 3
+ * detail - Actual  : 4
+ * assertions 7
+ * allocations 12 480
+ * peakmemory 5312
+ * end
+ * done
+ * \endcode
+ * A failure line is "failure" or "error", followed by the line number and the
+ * file name if the source line is known. "assertions" gives the number of
+ * assertions checked by the test, "allocations" the number of allocations
+ * and of bytes allocated if they are counted, "peakmemory" the peak memory
+ * in kilobytes if it is tracked. The text of the lines is escaped by
+ * escape(). "unresolved reason" is written if the test path or the filter can
+ * not be resolved. "done" is written once all the tests have been run.
+ */
+class TestEventWriter : public CPPUNIT_NS::TestListener
+{
+public:
+  /*! Constructs a writer that writes to the specified stream.
+   */
+  TestEventWriter( CPPUNIT_NS::OStream &stream );
+
+  /// Destructor.
+  virtual ~TestEventWriter();
+
+  void startTest( CPPUNIT_NS::Test *test );
+
+  void addFailure( const CPPUNIT_NS::TestFailure &failure );
+
+  void addAssertions( CPPUNIT_NS::Test *test, int assertionCount );
+
+  void addAllocations( CPPUNIT_NS::Test *test, 
+                       long allocationCount,
+                       long allocatedByteCount );
+
+  void addPeakMemory( CPPUNIT_NS::Test *test, long peakKilobytes );
+
+  void endTest( CPPUNIT_NS::Test *test );
+
+  /*! \brief Writes an error that is not raised by a test, as a failed test.
+   * \param name Name of the failed test, such as the name of the plug-in
+   *             that could not be loaded.
+   * \param message Message of the error.
+   */
+  void writeError( const std::string &name,
+                   const CPPUNIT_NS::Message &message );
+
+  /*! \brief Writes that the test path or the filter could not be resolved.
+   */
+  void writeUnresolved( const std::string &reason );
+
+  /*! \brief Writes that all the tests have been run.
+   */
+  void writeDone();
+
+  /*! \brief Escapes the backslashes and the ends of line of a text.
+   */
+  static std::string escape( const std::string &text );
+
+private:
+  void writeFailure( bool isError,
+                     const CPPUNIT_NS::Exception &exception );
+
+  /// Prevents the use of the copy constructor.
+  TestEventWriter( const TestEventWriter &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestEventWriter &copy );
+
+private:
+  CPPUNIT_NS::OStream &m_stream;
+};
+
+
+#endif  // CPPUNIT_HELPER_TESTEVENTWRITER_H
@@ -0,0 +1,241 @@
+#include <cppunit/Test.h>
+#include <cppunit/TestFilter.h>
+#include "TestImpactMap.h"
+#include <fstream>
+
+
+TestImpactMap::TestImpactMap()
+{
+}
+
+
+TestImpactMap::~TestImpactMap()
+{
+}
+
+
+void
+TestImpactMap::load( const std::string &fileName )
+{
+  std::ifstream stream( fileName.c_str() );
+  if ( !stream )
+    throw TestImpactMapException( "can not read test impact map: " + fileName );
+
+  m_tests.clear();
+  Sources *sources = NULL;
+  std::string line;
+  while ( std::getline( stream, line ) )
+  {
+    if ( line.compare( 0, 5, "test " ) == 0 )
+      sources = &m_tests[ line.substr( 5 ) ];
+    else if ( line.compare( 0, 4, "src " ) == 0  &&  sources != NULL )
+      sources->insert( line.substr( 4 ) );
+    else if ( !line.empty()  &&  line[0] != '#' )
+      throw TestImpactMapException( "invalid line in test impact map " +
+                                    fileName + ": " + line );
+  }
+}
+
+
+void
+TestImpactMap::save( const std::string &fileName ) const
+{
+  std::ofstream stream( fileName.c_str() );
+  stream  <<  "# test impact map, see DllPlugInTester --record-impact\n";
+  for ( TestSources::const_iterator itTest = m_tests.begin();
+        itTest != m_tests.end();
+        ++itTest )
+  {
+    stream  <<  "test "  <<  (*itTest).first  <<  "\n";
+    const Sources &sources = (*itTest).second;
+    for ( Sources::const_iterator it = sources.begin(); it != sources.end(); ++it )
+      stream  <<  "src "  <<  *it  <<  "\n";
+  }
+
+  stream.flush();
+  if ( !stream )
+    throw TestImpactMapException( "can not write test impact map: " + fileName );
+}
+
+
+void
+TestImpactMap::setTestSources( const std::string &testPath,
+                               const Sources &sources )
+{
+  m_tests[ testPath ] = sources;
+}
+
+
+void
+TestImpactMap::removeTest( const std::string &testPath )
+{
+  m_tests.erase( testPath );
+}
+
+
+bool
+TestImpactMap::hasTest( const std::string &testPath ) const
+{
+  return m_tests.find( testPath ) != m_tests.end();
+}
+
+
+const TestImpactMap::Sources &
+TestImpactMap::getTestSources( const std::string &testPath ) const
+{
+  TestSources::const_iterator it = m_tests.find( testPath );
+  if ( it == m_tests.end() )
+    throw std::invalid_argument( "test not in impact map: " + testPath );
+  return (*it).second;
+}
+
+
+int
+TestImpactMap::getTestCount() const
+{
+  return m_tests.size();
+}
+
+
+std::string
+TestImpactMap::findUnknownFile( const ChangedFiles &changedFiles ) const
+{
+  Sources allSources = getAllSources();
+  for ( ChangedFiles::const_iterator itFile = changedFiles.begin();
+        itFile != changedFiles.end();
+        ++itFile )
+  {
+    bool isKnown = false;
+    for ( Sources::const_iterator itSource = allSources.begin();
+          itSource != allSources.end()  &&  !isKnown;
+          ++itSource )
+      isKnown = isSameFile( *itSource, *itFile );
+
+    if ( !isKnown )
+      return *itFile;
+  }
+
+  return "";
+}
+
+
+int
+TestImpactMap::addImpactedTests( CPPUNIT_NS::Test *root,
+                                 const ChangedFiles &changedFiles,
+                                 CPPUNIT_NS::TestFilter &filter ) const
+{
+  return addImpactedTests( root,
+                           "/" + root->getNameRef(),
+                           findChangedSources( changedFiles ),
+                           filter );
+}
+
+
+int
+TestImpactMap::addImpactedTests( CPPUNIT_NS::Test *test,
+                                 const std::string &testPath,
+                                 const Sources &changedSources,
+                                 CPPUNIT_NS::TestFilter &filter ) const
+{
+  if ( test->canBeFlattened() )
+  {
+    int count = 0;
+    for ( int index =0; index < test->getChildTestCount(); ++index )
+    {
+      CPPUNIT_NS::Test *child = test->getChildTestAt( index );
+      count += addImpactedTests( child,
+                                 testPath + "/" + child->getNameRef(),
+                                 changedSources,
+                                 filter );
+    }
+    return count;
+  }
+
+  TestSources::const_iterator itTest = m_tests.find( testPath );
+  bool isImpacted = itTest == m_tests.end();
+  if ( !isImpacted )
+  {
+    const Sources &sources = (*itTest).second;
+    for ( Sources::const_iterator it = changedSources.begin();
+          it != changedSources.end()  &&  !isImpacted;
+          ++it )
+      isImpacted = sources.find( *it ) != sources.end();
+  }
+
+  if ( !isImpacted )
+    return 0;
+  filter.addIncludePath( testPath );
+  return 1;
+}
+
+
+TestImpactMap::ChangedFiles
+TestImpactMap::readChangedFiles( const std::string &fileName )
+{
+  std::ifstream stream( fileName.c_str() );
+  if ( !stream )
+    throw TestImpactMapException( "can not read changed files: " + fileName );
+
+  ChangedFiles files;
+  std::string line;
+  while ( std::getline( stream, line ) )
+  {
+    std::string::size_type end = line.find_last_not_of( " \t\r" );
+    if ( end == std::string::npos )
+      continue;
+    std::string::size_type start = line.compare( 0, 2, "./" ) == 0 ? 2 : 0;
+    files.push_back( line.substr( start, end + 1 - start ) );
+  }
+  return files;
+}
+
+
+bool
+TestImpactMap::isSameFile( const std::string &source,
+                           const std::string &changedFile )
+{
+  if ( changedFile.empty()  ||  changedFile.length() > source.length() )
+    return false;
+
+  if ( changedFile[0] == '/' )
+    return source == changedFile;
+
+  std::string::size_type start = source.length() - changedFile.length();
+  if ( source.compare( start, changedFile.length(), changedFile ) != 0 )
+    return false;
+  return start == 0  ||  source[start - 1] == '/';
+}
+
+
+TestImpactMap::Sources
+TestImpactMap::getAllSources() const
+{
+  Sources allSources;
+  for ( TestSources::const_iterator itTest = m_tests.begin();
+        itTest != m_tests.end();
+        ++itTest )
+    allSources.insert( (*itTest).second.begin(), (*itTest).second.end() );
+  return allSources;
+}
+
+
+TestImpactMap::Sources
+TestImpactMap::findChangedSources( const ChangedFiles &changedFiles ) const
+{
+  Sources allSources = getAllSources();
+  Sources changedSources;
+  for ( Sources::const_iterator itSource = allSources.begin();
+        itSource != allSources.end();
+        ++itSource )
+  {
+    for ( ChangedFiles::const_iterator itFile = changedFiles.begin();
+          itFile != changedFiles.end();
+          ++itFile )
+    {
+      if ( isSameFile( *itSource, *itFile ) )
+        changedSources.insert( *itSource );
+    }
+  }
+
+  return changedSources;
+}
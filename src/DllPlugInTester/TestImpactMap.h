@@ -0,0 +1,149 @@
+#ifndef CPPUNIT_HELPER_TESTIMPACTMAP_H
+#define CPPUNIT_HELPER_TESTIMPACTMAP_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/portability/CppUnitDeque.h>
+#include <cppunit/portability/CppUnitMap.h>
+#include <cppunit/portability/CppUnitSet.h>
+#include <string>
+#include <stdexcept>
+
+CPPUNIT_NS_BEGIN
+class Test;
+class TestFilter;
+CPPUNIT_NS_END
+
+
+/*! Exception thrown when a test impact map can not be read or written.
+ */
+class TestImpactMapException : public std::runtime_error
+{
+public:
+  TestImpactMapException( std::string message )
+    : std::runtime_error( message )
+  {
+  }
+};
+
+
+/*! \brief Map of the source files executed by each test.
+ *
+ * The map is built by TestImpactRecorder while running tests compiled with
+ * gcc coverage instrumentation (--coverage), and is used to select the tests
+ * impacted by a set of changed files.
+ *
+ * Tests are identified by their path, as returned by TestPath::toString().
+ * The map is stored in a text file with one entry per line:
+ * \code
+ * test /All Tests/MathTest/MathTest::testAdd
+ * src /home/me/project/src/Math.cpp
+ * src /home/me/project/include/Math.h
+ * test /All Tests/MathTest/MathTest::testSub
+ * ...
+ * \endcode
+ */
+class TestImpactMap
+{
+public:
+  typedef CppUnitSet<std::string, std::less<std::string> > Sources;
+  typedef CppUnitDeque<std::string> ChangedFiles;
+
+  /*! Constructs an empty map.
+   */
+  TestImpactMap();
+
+  /// Destructor.
+  virtual ~TestImpactMap();
+
+  /*! \brief Loads the map from a file, replacing the current content.
+   * \exception TestImpactMapException if the file can not be read.
+   */
+  void load( const std::string &fileName );
+
+  /*! \brief Saves the map to a file.
+   * \exception TestImpactMapException if the file can not be written.
+   */
+  void save( const std::string &fileName ) const;
+
+  /*! \brief Sets the source files executed by a test.
+   */
+  void setTestSources( const std::string &testPath,
+                       const Sources &sources );
+
+  /*! \brief Removes a test from the map.
+   *
+   * A test which is not in the map is always selected by addImpactedTests().
+   */
+  void removeTest( const std::string &testPath );
+
+  /*! \brief Indicates if the map contains the specified test.
+   */
+  bool hasTest( const std::string &testPath ) const;
+
+  /*! \brief Returns the source files executed by a test.
+   * \exception std::invalid_argument if the test is not in the map.
+   */
+  const Sources &getTestSources( const std::string &testPath ) const;
+
+  /*! \brief Returns the number of tests in the map.
+   */
+  int getTestCount() const;
+
+  /*! \brief Returns the first changed file that is not a source of any test.
+   *
+   * A changed file may be given relative to any parent directory of the source
+   * file paths stored in the map. The tests impacted by an unknown file can not
+   * be determined: it may be a new file, or a header without code.
+   *
+   * \return First unknown file of \a changedFiles, or an empty string if all
+   *         the changed files are known.
+   */
+  std::string findUnknownFile( const ChangedFiles &changedFiles ) const;
+
+  /*! \brief Adds the paths of the tests impacted by changed files to a filter.
+   *
+   * Walks the tests below \a root. A test is selected if it is not in the map
+   * (new test or test without coverage information), or if one of the source
+   * files it executed is in \a changedFiles.
+   *
+   * \param root Top test. Paths start with the name of this test.
+   * \param changedFiles Changed files. See findUnknownFile() for the syntax.
+   * \param filter Filter to which the path of the selected tests are added
+   *               with TestFilter::addIncludePath().
+   * \return Number of selected tests.
+   */
+  int addImpactedTests( CPPUNIT_NS::Test *root,
+                        const ChangedFiles &changedFiles,
+                        CPPUNIT_NS::TestFilter &filter ) const;
+
+  /*! \brief Reads a list of file names, one per line.
+   * \exception TestImpactMapException if the file can not be read.
+   */
+  static ChangedFiles readChangedFiles( const std::string &fileName );
+
+private:
+  static bool isSameFile( const std::string &source,
+                          const std::string &changedFile );
+
+  Sources getAllSources() const;
+
+  Sources findChangedSources( const ChangedFiles &changedFiles ) const;
+
+  int addImpactedTests( CPPUNIT_NS::Test *test,
+                        const std::string &testPath,
+                        const Sources &changedSources,
+                        CPPUNIT_NS::TestFilter &filter ) const;
+
+  /// Prevents the use of the copy constructor.
+  TestImpactMap( const TestImpactMap &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestImpactMap &copy );
+
+private:
+  typedef CppUnitMap<std::string, Sources, std::less<std::string> > TestSources;
+  TestSources m_tests;
+};
+
+
+#endif  // CPPUNIT_HELPER_TESTIMPACTMAP_H
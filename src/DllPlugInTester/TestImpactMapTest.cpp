@@ -0,0 +1,209 @@
+#include <cppunit/TestFilter.h>
+#include "TestImpactMap.h"
+#include "TestImpactMapTest.h"
+#include <fstream>
+#include <stdio.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestImpactMapTest );
+
+
+TestImpactMapTest::TestImpactMapTest()
+{
+}
+
+
+TestImpactMapTest::~TestImpactMapTest()
+{
+}
+
+
+void 
+TestImpactMapTest::setUp()
+{
+  m_map = new TestImpactMap();
+  m_fileName = "TestImpactMapTest.tmp";
+
+  m_root = new CPPUNIT_NS::TestSuite( "All Tests" );
+  CPPUNIT_NS::TestSuite *mathSuite = new CPPUNIT_NS::TestSuite( "MathTest" );
+  mathSuite->addTest( new CPPUNIT_NS::TestCase( "MathTest::testAdd" ) );
+  mathSuite->addTest( new CPPUNIT_NS::TestCase( "MathTest::testSub" ) );
+  m_root->addTest( mathSuite );
+  CPPUNIT_NS::TestSuite *stringSuite = new CPPUNIT_NS::TestSuite( "StringTest" );
+  stringSuite->addTest( new CPPUNIT_NS::TestCase( "StringTest::testFind" ) );
+  m_root->addTest( stringSuite );
+}
+
+
+void 
+TestImpactMapTest::tearDown()
+{
+  ::remove( m_fileName.c_str() );
+  delete m_root;
+  delete m_map;
+}
+
+
+void 
+TestImpactMapTest::testSetTestSources()
+{
+  setSources( "/All Tests/MathTest/MathTest::testAdd", "/src/Math.cpp", "/src/Math.h" );
+
+  CPPUNIT_ASSERT_EQUAL( 1, m_map->getTestCount() );
+  CPPUNIT_ASSERT( m_map->hasTest( "/All Tests/MathTest/MathTest::testAdd" ) );
+  CPPUNIT_ASSERT( !m_map->hasTest( "/All Tests/MathTest/MathTest::testSub" ) );
+  const TestImpactMap::Sources &sources = 
+      m_map->getTestSources( "/All Tests/MathTest/MathTest::testAdd" );
+  CPPUNIT_ASSERT_EQUAL( 2, int(sources.size()) );
+  CPPUNIT_ASSERT( sources.find( "/src/Math.h" ) != sources.end() );
+}
+
+
+void 
+TestImpactMapTest::testRemoveTest()
+{
+  setSources( "/All Tests/MathTest/MathTest::testAdd", "/src/Math.cpp" );
+  m_map->removeTest( "/All Tests/MathTest/MathTest::testAdd" );
+
+  CPPUNIT_ASSERT_EQUAL( 0, m_map->getTestCount() );
+  CPPUNIT_ASSERT_THROW( m_map->getTestSources( "/All Tests/MathTest/MathTest::testAdd" ),
+                        std::invalid_argument );
+}
+
+
+void 
+TestImpactMapTest::testSaveAndLoad()
+{
+  setSources( "/All Tests/MathTest/MathTest::testAdd", "/src/Math.cpp", "/src/Math.h" );
+  setSources( "/All Tests/StringTest/StringTest::testFind", "/src/My String.cpp" );
+  m_map->save( m_fileName );
+
+  TestImpactMap loaded;
+  loaded.load( m_fileName );
+  CPPUNIT_ASSERT_EQUAL( 2, loaded.getTestCount() );
+  CPPUNIT_ASSERT_EQUAL( 2, int(loaded.getTestSources( 
+      "/All Tests/MathTest/MathTest::testAdd" ).size()) );
+  const TestImpactMap::Sources &sources = 
+      loaded.getTestSources( "/All Tests/StringTest/StringTest::testFind" );
+  CPPUNIT_ASSERT_EQUAL( 1, int(sources.size()) );
+  CPPUNIT_ASSERT_EQUAL( std::string("/src/My String.cpp"), *sources.begin() );
+}
+
+
+void 
+TestImpactMapTest::testLoadInvalidLineThrow()
+{
+  writeFile( "# comment\n"
+             "test /All Tests/MathTest/MathTest::testAdd\n"
+             "source /src/Math.cpp\n" );
+  m_map->load( m_fileName );
+}
+
+
+void 
+TestImpactMapTest::testFindUnknownFile()
+{
+  setSources( "/All Tests/MathTest/MathTest::testAdd", "/src/Math.cpp", "/src/Math.h" );
+
+  TestImpactMap::ChangedFiles changedFiles;
+  changedFiles.push_back( "src/Math.h" );
+  changedFiles.push_back( "/src/Math.cpp" );
+  CPPUNIT_ASSERT_EQUAL( std::string(""), m_map->findUnknownFile( changedFiles ) );
+
+  changedFiles.push_back( "src/String.cpp" );
+  CPPUNIT_ASSERT_EQUAL( std::string("src/String.cpp"), 
+                        m_map->findUnknownFile( changedFiles ) );
+}
+
+
+void 
+TestImpactMapTest::testChangedFileMatchesWholeComponents()
+{
+  setSources( "/All Tests/MathTest/MathTest::testAdd", "/src/FastMath.cpp" );
+
+  TestImpactMap::ChangedFiles changedFiles;
+  changedFiles.push_back( "Math.cpp" );
+  CPPUNIT_ASSERT_EQUAL( std::string("Math.cpp"), 
+                        m_map->findUnknownFile( changedFiles ) );
+
+  changedFiles[0] = "/FastMath.cpp";
+  CPPUNIT_ASSERT_EQUAL( std::string("/FastMath.cpp"), 
+                        m_map->findUnknownFile( changedFiles ) );
+
+  changedFiles[0] = "FastMath.cpp";
+  CPPUNIT_ASSERT_EQUAL( std::string(""), m_map->findUnknownFile( changedFiles ) );
+}
+
+
+void 
+TestImpactMapTest::testAddImpactedTests()
+{
+  setSources( "/All Tests/MathTest/MathTest::testAdd", "/src/Math.cpp", "/src/Math.h" );
+  setSources( "/All Tests/MathTest/MathTest::testSub", "/src/Math.cpp" );
+  setSources( "/All Tests/StringTest/StringTest::testFind", "/src/String.cpp", 
+              "/src/Math.h" );
+
+  TestImpactMap::ChangedFiles changedFiles;
+  changedFiles.push_back( "src/String.cpp" );
+  CPPUNIT_NS::TestFilter filter;
+  CPPUNIT_ASSERT_EQUAL( 1, m_map->addImpactedTests( m_root, changedFiles, filter ) );
+  CPPUNIT_ASSERT( filter.isIncluded( "/All Tests/StringTest/StringTest::testFind" ) );
+  CPPUNIT_ASSERT( !filter.isIncluded( "/All Tests/MathTest/MathTest::testAdd" ) );
+
+  changedFiles[0] = "Math.h";
+  CPPUNIT_NS::TestFilter headerFilter;
+  CPPUNIT_ASSERT_EQUAL( 2, m_map->addImpactedTests( m_root, changedFiles, headerFilter ) );
+  CPPUNIT_ASSERT( headerFilter.isIncluded( "/All Tests/MathTest/MathTest::testAdd" ) );
+  CPPUNIT_ASSERT( !headerFilter.isIncluded( "/All Tests/MathTest/MathTest::testSub" ) );
+  CPPUNIT_ASSERT( headerFilter.isIncluded( "/All Tests/StringTest/StringTest::testFind" ) );
+}
+
+
+void 
+TestImpactMapTest::testTestsNotInMapAreImpacted()
+{
+  setSources( "/All Tests/MathTest/MathTest::testAdd", "/src/Math.cpp" );
+
+  TestImpactMap::ChangedFiles changedFiles;
+  CPPUNIT_NS::TestFilter filter;
+  CPPUNIT_ASSERT_EQUAL( 2, m_map->addImpactedTests( m_root, changedFiles, filter ) );
+  CPPUNIT_ASSERT( !filter.isIncluded( "/All Tests/MathTest/MathTest::testAdd" ) );
+  CPPUNIT_ASSERT( filter.isIncluded( "/All Tests/MathTest/MathTest::testSub" ) );
+  CPPUNIT_ASSERT( filter.isIncluded( "/All Tests/StringTest/StringTest::testFind" ) );
+}
+
+
+void 
+TestImpactMapTest::testReadChangedFiles()
+{
+  writeFile( "./src/Math.cpp\n"
+             "\n"
+             "include/Math.h  \r\n"
+             "/src/String.cpp" );
+
+  TestImpactMap::ChangedFiles files = TestImpactMap::readChangedFiles( m_fileName );
+  CPPUNIT_ASSERT_EQUAL( 3, int(files.size()) );
+  CPPUNIT_ASSERT_EQUAL( std::string("src/Math.cpp"), files[0] );
+  CPPUNIT_ASSERT_EQUAL( std::string("include/Math.h"), files[1] );
+  CPPUNIT_ASSERT_EQUAL( std::string("/src/String.cpp"), files[2] );
+}
+
+
+void 
+TestImpactMapTest::setSources( const std::string &testPath,
+                               const std::string &source1,
+                               const std::string &source2 )
+{
+  TestImpactMap::Sources sources;
+  sources.insert( source1 );
+  if ( !source2.empty() )
+    sources.insert( source2 );
+  m_map->setTestSources( testPath, sources );
+}
+
+
+void 
+TestImpactMapTest::writeFile( const std::string &content )
+{
+  std::ofstream stream( m_fileName.c_str() );
+  stream  <<  content;
+}
@@ -0,0 +1,57 @@
+#ifndef TESTIMPACTMAPTEST_H
+#define TESTIMPACTMAPTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "TestImpactMap.h"
+
+
+class TestImpactMapTest : public CPPUNIT_NS::TestCase
+{
+  CPPUNIT_TEST_SUITE( TestImpactMapTest );
+  CPPUNIT_TEST( testSetTestSources );
+  CPPUNIT_TEST( testRemoveTest );
+  CPPUNIT_TEST( testSaveAndLoad );
+  CPPUNIT_TEST_EXCEPTION( testLoadInvalidLineThrow, TestImpactMapException );
+  CPPUNIT_TEST( testFindUnknownFile );
+  CPPUNIT_TEST( testChangedFileMatchesWholeComponents );
+  CPPUNIT_TEST( testAddImpactedTests );
+  CPPUNIT_TEST( testTestsNotInMapAreImpacted );
+  CPPUNIT_TEST( testReadChangedFiles );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TestImpactMapTest();
+  virtual ~TestImpactMapTest();
+
+  void setUp();
+  void tearDown();
+
+  void testSetTestSources();
+  void testRemoveTest();
+  void testSaveAndLoad();
+  void testLoadInvalidLineThrow();
+  void testFindUnknownFile();
+  void testChangedFileMatchesWholeComponents();
+  void testAddImpactedTests();
+  void testTestsNotInMapAreImpacted();
+  void testReadChangedFiles();
+
+private:
+  TestImpactMapTest( const TestImpactMapTest &other );
+  void operator =( const TestImpactMapTest &other );
+
+  void setSources( const std::string &testPath,
+                   const std::string &source1,
+                   const std::string &source2 = "" );
+
+  void writeFile( const std::string &content );
+
+private:
+  TestImpactMap *m_map;
+  CPPUNIT_NS::TestSuite *m_root;
+  std::string m_fileName;
+};
+
+
+
+#endif  // TESTIMPACTMAPTEST_H
@@ -0,0 +1,265 @@
+#include "TestImpactRecorder.h"
+
+#if defined(CPPUNIT_TEST_IMPACT_RECORDING)
+
+#include <cppunit/Test.h>
+#include <cppunit/plugin/DynamicLibraryManager.h>
+#include <cppunit/plugin/DynamicLibraryManagerException.h>
+#include <cppunit/plugin/TestPlugIn.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+typedef CppUnitDeque<std::string> FileNames;
+
+
+/*! Recursively lists the files of a directory which end with \a suffix.
+ */
+static void
+findFiles( const std::string &directory,
+           const std::string &suffix,
+           FileNames &files )
+{
+  DIR *dir = ::opendir( directory.c_str() );
+  if ( dir == NULL )
+    return;
+
+  struct dirent *entry;
+  while ( (entry = ::readdir( dir )) != NULL )
+  {
+    std::string name( entry->d_name );
+    if ( name == "."  ||  name == ".." )
+      continue;
+
+    std::string path( directory + "/" + name );
+    struct stat status;
+    if ( ::lstat( path.c_str(), &status ) != 0 )
+      continue;
+
+    if ( S_ISDIR( status.st_mode ) )
+      findFiles( path, suffix, files );
+    else if ( name.length() >= suffix.length()  &&
+              name.compare( name.length() - suffix.length(),
+                            suffix.length(), suffix ) == 0 )
+      files.push_back( path );
+  }
+
+  ::closedir( dir );
+}
+
+
+/*! Removes a directory and its content.
+ */
+static void
+removeDirectory( const std::string &directory )
+{
+  DIR *dir = ::opendir( directory.c_str() );
+  if ( dir != NULL )
+  {
+    struct dirent *entry;
+    while ( (entry = ::readdir( dir )) != NULL )
+    {
+      std::string name( entry->d_name );
+      if ( name == "."  ||  name == ".." )
+        continue;
+
+      std::string path( directory + "/" + name );
+      struct stat status;
+      if ( ::lstat( path.c_str(), &status ) == 0  &&  S_ISDIR( status.st_mode ) )
+        removeDirectory( path );
+      else
+        ::unlink( path.c_str() );
+    }
+    ::closedir( dir );
+  }
+
+  ::rmdir( directory.c_str() );
+}
+
+
+TestImpactRecorder::TestImpactRecorder( TestImpactMap &map )
+    : m_map( map )
+    , m_hadPrefix( false )
+{
+  const char *temporaryDirectory = ::getenv( "TMPDIR" );
+  std::string pattern( temporaryDirectory != NULL ? temporaryDirectory : "/tmp" );
+  pattern += "/cppunit-gcov-XXXXXX";
+
+  CppUnitVector<char> buffer( pattern.begin(), pattern.end() );
+  buffer.push_back( '\0' );
+  if ( ::mkdtemp( &buffer[0] ) == NULL )
+    throw TestImpactMapException( "can not create coverage directory: " + pattern );
+  m_directory = &buffer[0];
+
+  // Coverage data are dumped in m_directory + absolute path of the .gcda.
+  const char *oldPrefix = ::getenv( "GCOV_PREFIX" );
+  m_hadPrefix = oldPrefix != NULL;
+  if ( m_hadPrefix )
+    m_oldPrefix = oldPrefix;
+  ::setenv( "GCOV_PREFIX", m_directory.c_str(), 1 );
+}
+
+
+TestImpactRecorder::~TestImpactRecorder()
+{
+  if ( m_hadPrefix )
+    ::setenv( "GCOV_PREFIX", m_oldPrefix.c_str(), 1 );
+  else
+    ::unsetenv( "GCOV_PREFIX" );
+
+  removeDirectory( m_directory );
+
+  for ( Libraries::iterator it = m_libraries.begin(); it != m_libraries.end(); ++it )
+    delete *it;
+}
+
+
+bool
+TestImpactRecorder::addPlugIn( const std::string &fileName )
+{
+  CPPUNIT_NS::DynamicLibraryManager *library =
+      new CPPUNIT_NS::DynamicLibraryManager( fileName );
+  try
+  {
+    CoverageFunction coverage = (CoverageFunction)library->findSymbol(
+            CPPUNIT_STRINGIZE( CPPUNIT_PLUGIN_COVERAGE_NAME ) );
+    m_coverageFunctions.push_back( coverage );
+    m_libraries.push_back( library );
+    return true;
+  }
+  catch ( CPPUNIT_NS::DynamicLibraryManagerException & )
+  {
+    delete library;
+    return false;
+  }
+}
+
+
+void
+TestImpactRecorder::startSuite( CPPUNIT_NS::Test *suite )
+{
+  m_suitePath.push_back( suite->getNameRef() );
+}
+
+
+void
+TestImpactRecorder::endSuite( CPPUNIT_NS::Test * )
+{
+  m_suitePath.pop_back();
+}
+
+
+void
+TestImpactRecorder::startTest( CPPUNIT_NS::Test * )
+{
+  callCoverageFunctions( 0 );
+}
+
+
+void
+TestImpactRecorder::endTest( CPPUNIT_NS::Test *test )
+{
+  callCoverageFunctions( 1 );
+
+  std::string testPath;
+  for ( SuitePath::const_iterator it = m_suitePath.begin(); it != m_suitePath.end(); ++it )
+    testPath += "/" + *it;
+  testPath += "/" + test->getNameRef();
+
+  TestImpactMap::Sources sources;
+  if ( readCoverage( sources ) )
+    m_map.setTestSources( testPath, sources );
+  else
+    m_map.removeTest( testPath );
+}
+
+
+void
+TestImpactRecorder::callCoverageFunctions( int dump )
+{
+  for ( CoverageFunctions::const_iterator it = m_coverageFunctions.begin();
+        it != m_coverageFunctions.end();
+        ++it )
+    (**it)( dump );
+}
+
+
+bool
+TestImpactRecorder::readCoverage( TestImpactMap::Sources &sources )
+{
+  FileNames dataFiles;
+  findFiles( m_directory, ".gcda", dataFiles );
+
+  bool isValid = !dataFiles.empty();
+  for ( FileNames::const_iterator it = dataFiles.begin(); it != dataFiles.end(); ++it )
+  {
+    if ( !readDataFile( *it, sources ) )
+      isValid = false;
+    ::unlink( (*it).c_str() );
+  }
+
+  return isValid;
+}
+
+
+bool
+TestImpactRecorder::readDataFile( const std::string &dataFileName,
+                                  TestImpactMap::Sources &sources )
+{
+  std::string data;
+  unsigned int stamp;
+  GcovReader::FunctionIds executed;
+  if ( !GcovReader::readFile( dataFileName, data )  ||
+       !GcovReader::readExecutedFunctions( data, stamp, executed ) )
+    return false;
+
+  // The note file is next to the object file, in the build tree.
+  std::string noteFileName( dataFileName.substr( m_directory.length() ) );
+  noteFileName.replace( noteFileName.length() - 5, 5, ".gcno" );
+  const GcovReader::FunctionSources *functionSources =
+      getFunctionSources( noteFileName, stamp );
+  if ( functionSources == NULL )
+    return false;
+
+  for ( GcovReader::FunctionIds::const_iterator it = executed.begin();
+        it != executed.end();
+        ++it )
+  {
+    GcovReader::FunctionSources::const_iterator itSource = functionSources->find( *it );
+    if ( itSource == functionSources->end() )
+      return false;
+    sources.insert( (*itSource).second );
+  }
+
+  return true;
+}
+
+
+const GcovReader::FunctionSources *
+TestImpactRecorder::getFunctionSources( const std::string &noteFileName,
+                                        unsigned int stamp )
+{
+  NoteFiles::iterator it = m_noteFiles.find( noteFileName );
+  if ( it == m_noteFiles.end() )
+  {
+    NoteFile &noteFile = m_noteFiles[ noteFileName ];
+    std::string data;
+    noteFile.m_isValid = GcovReader::readFile( noteFileName, data )  &&
+                         GcovReader::readFunctionSources( data,
+                                                          noteFile.m_stamp,
+                                                          noteFile.m_sources );
+    it = m_noteFiles.find( noteFileName );
+  }
+
+  const NoteFile &noteFile = (*it).second;
+  if ( !noteFile.m_isValid  ||  noteFile.m_stamp != stamp )
+    return NULL;
+  return &noteFile.m_sources;
+}
+
+
+#endif  // defined(CPPUNIT_TEST_IMPACT_RECORDING)
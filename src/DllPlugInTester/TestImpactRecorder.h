@@ -0,0 +1,104 @@
+#ifndef CPPUNIT_HELPER_TESTIMPACTRECORDER_H
+#define CPPUNIT_HELPER_TESTIMPACTRECORDER_H
+
+#include <cppunit/TestListener.h>
+#include <cppunit/portability/CppUnitDeque.h>
+#include <cppunit/portability/CppUnitMap.h>
+#include "GcovReader.h"
+#include "TestImpactMap.h"
+
+#if defined(CPPUNIT_HAVE_DIRENT_H) && defined(CPPUNIT_HAVE_MKDTEMP) && defined(CPPUNIT_HAVE_SETENV)
+#define CPPUNIT_TEST_IMPACT_RECORDING 1
+#endif
+
+#if defined(CPPUNIT_TEST_IMPACT_RECORDING)
+
+CPPUNIT_NS_BEGIN
+class DynamicLibraryManager;
+CPPUNIT_NS_END
+
+
+/*! \brief Records the source files executed by each test in a TestImpactMap.
+ *
+ * The test plug-ins must be compiled and linked with gcc coverage
+ * instrumentation and CPPUNIT_PLUGIN_GCOV defined (--coverage
+ * -DCPPUNIT_PLUGIN_GCOV), see CPPUNIT_PLUGIN_COVERAGE_IMPL(). The coverage
+ * counters are reset when a test starts using __gcov_reset(), and dumped
+ * when it ends using __gcov_dump().
+ * The counters are dumped in a private directory (using GCOV_PREFIX), so
+ * the coverage data files of the build tree are not modified.
+ *
+ * The source files of the functions that have a non-zero counter are
+ * then found using the .gcno files of the build tree. A test for which the
+ * coverage data could not be read is removed from the map, so it is always
+ * selected by TestImpactMap::addImpactedTests().
+ *
+ * Only available if CPPUNIT_TEST_IMPACT_RECORDING is defined.
+ */
+class TestImpactRecorder : public CPPUNIT_NS::TestListener
+{
+public:
+  /*! Constructs a recorder which updates the specified map.
+   * \exception TestImpactMapException if the directory to dump coverage data
+   *            can not be created.
+   */
+  TestImpactRecorder( TestImpactMap &map );
+
+  /// Destructor.
+  virtual ~TestImpactRecorder();
+
+  /*! \brief Looks up the coverage functions of a test plug-in.
+   * \param fileName Name of the test plug-in (already loaded).
+   * \return \c true if the plug-in is instrumented, \c false otherwise.
+   */
+  bool addPlugIn( const std::string &fileName );
+
+  void startTest( CPPUNIT_NS::Test *test );
+  void endTest( CPPUNIT_NS::Test *test );
+  void startSuite( CPPUNIT_NS::Test *suite );
+  void endSuite( CPPUNIT_NS::Test *suite );
+
+private:
+  typedef void (*CoverageFunction)( int dump );
+
+  void callCoverageFunctions( int dump );
+  bool readCoverage( TestImpactMap::Sources &sources );
+  bool readDataFile( const std::string &dataFileName,
+                     TestImpactMap::Sources &sources );
+  const GcovReader::FunctionSources *getFunctionSources( const std::string &noteFileName,
+                                                         unsigned int stamp );
+
+  /// Prevents the use of the copy constructor.
+  TestImpactRecorder( const TestImpactRecorder &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestImpactRecorder &copy );
+
+private:
+  TestImpactMap &m_map;
+  std::string m_directory;
+  std::string m_oldPrefix;
+  bool m_hadPrefix;
+
+  typedef CppUnitDeque<CPPUNIT_NS::DynamicLibraryManager *> Libraries;
+  Libraries m_libraries;
+  typedef CppUnitDeque<CoverageFunction> CoverageFunctions;
+  CoverageFunctions m_coverageFunctions;
+
+  typedef CppUnitDeque<std::string> SuitePath;
+  SuitePath m_suitePath;
+
+  struct NoteFile
+  {
+    bool m_isValid;
+    unsigned int m_stamp;
+    GcovReader::FunctionSources m_sources;
+  };
+  typedef CppUnitMap<std::string, NoteFile, std::less<std::string> > NoteFiles;
+  NoteFiles m_noteFiles;
+};
+
+
+#endif  // defined(CPPUNIT_TEST_IMPACT_RECORDING)
+
+#endif  // CPPUNIT_HELPER_TESTIMPACTRECORDER_H
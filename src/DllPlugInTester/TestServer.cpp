@@ -0,0 +1,379 @@
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/ParameterizedTestCase.h>
+#include <cppunit/TestFilter.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/plugin/DynamicLibraryManagerException.h>
+#include "CommandLineParser.h"
+#include "FileDescriptorStreamBuffer.h"
+#include "PlugInManifest.h"
+#include "TestServer.h"
+
+#if defined(CPPUNIT_TEST_SERVER)
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#if defined(CPPUNIT_HAVE_UNIX_DLL_LOADER)
+#include <dlfcn.h>
+#endif
+
+
+/*! Fills the address of a Unix domain socket.
+ * \return \c false if the name is too long.
+ */
+static bool
+makeAddress( const std::string &socketName,
+             struct sockaddr_un &address )
+{
+  ::memset( &address, 0, sizeof(address) );
+  address.sun_family = AF_UNIX;
+  if ( socketName.length() >= sizeof(address.sun_path) )
+    return false;
+  ::strcpy( address.sun_path, socketName.c_str() );
+  return true;
+}
+
+
+/*! \brief Reads lines from a socket (Implementation).
+ */
+class SocketLineReader
+{
+public:
+  SocketLineReader( int socket )
+      : m_socket( socket )
+      , m_begin( 0 )
+      , m_end( 0 )
+  {
+  }
+
+  /*! Reads a line, without the end of line.
+   * \return \c false if the connection was closed before the end of line.
+   */
+  bool readLine( std::string &line )
+  {
+    line = "";
+    while ( true )
+    {
+      if ( m_begin == m_end )
+      {
+        int readCount = ::read( m_socket, m_buffer, sizeof(m_buffer) );
+        if ( readCount <= 0 )
+          return false;
+        m_begin = 0;
+        m_end = readCount;
+      }
+
+      char c = m_buffer[ m_begin++ ];
+      if ( c == '\n' )
+        break;
+      line += c;
+    }
+
+    if ( !line.empty()  &&  line[ line.length() - 1 ] == '\r' )
+      line.erase( line.length() - 1 );
+    return true;
+  }
+
+private:
+  int m_socket;
+  char m_buffer[4096];
+  int m_begin;
+  int m_end;
+};
+
+
+/*! Warns if a plug-in is still in memory after being unloaded.
+ */
+static void
+checkUnloaded( const std::string &fileName,
+               CPPUNIT_NS::OStream &stream )
+{
+#if defined(CPPUNIT_HAVE_UNIX_DLL_LOADER) && defined(RTLD_NOLOAD)
+  void *handle = ::dlopen( fileName.c_str(), RTLD_LAZY | RTLD_NOLOAD );
+  if ( handle == NULL )
+    return;
+  ::dlclose( handle );
+  stream  <<  "Warning: plug-in could not be unloaded, its changes are ignored "
+              "until the server is restarted (build it with -fno-gnu-unique): "
+          <<  fileName  <<  "\n";
+#else
+  (void)fileName;
+  (void)stream;
+#endif
+}
+
+#endif  // defined(CPPUNIT_TEST_SERVER)
+
+
+TestServer::TestServer( const CommandLineParser &parser )
+    : m_parser( parser )
+    , m_plugInStamps( parser.getPlugInCount() )
+    , m_runner( NULL )
+{
+}
+
+
+TestServer::~TestServer()
+{
+  deleteTests();
+}
+
+
+bool
+TestServer::parseRequest( const std::string &line,
+                          std::string &command,
+                          std::string &testPath )
+{
+  testPath = "";
+  if ( line == "quit"  ||  line == "run" )
+  {
+    command = line;
+    return true;
+  }
+
+  if ( line.compare( 0, 4, "run " ) != 0 )
+    return false;
+  command = "run";
+  testPath = line.substr( 4 );
+  return true;
+}
+
+
+#if defined(CPPUNIT_TEST_SERVER)
+
+bool
+TestServer::serve( const std::string &socketName )
+{
+  struct sockaddr_un address;
+  int listening = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+  if ( listening < 0  ||  !makeAddress( socketName, address ) )
+  {
+    CPPUNIT_NS::stdCOut()  <<  "Can not create socket: "  <<  socketName  <<  "\n";
+    if ( listening >= 0 )
+      ::close( listening );
+    return false;
+  }
+
+  ::unlink( socketName.c_str() );
+  if ( ::bind( listening, (struct sockaddr *)&address, sizeof(address) ) != 0  ||
+       ::listen( listening, 8 ) != 0 )
+  {
+    CPPUNIT_NS::stdCOut()  <<  "Can not listen on socket: "  <<  socketName
+                           <<  ": "  <<  ::strerror( errno )  <<  "\n";
+    ::close( listening );
+    return false;
+  }
+
+  // A client that disconnects during a run must not kill the server.
+  ::signal( SIGPIPE, SIG_IGN );
+
+  CPPUNIT_NS::ParameterizedTest::setDefaultShard( m_parser.getDataShardIndex(),
+                                                  m_parser.getDataShardCount() );
+  reloadChangedPlugIns( CPPUNIT_NS::stdCOut() );
+  CPPUNIT_NS::stdCOut()  <<  "Serving tests on "  <<  socketName  <<  "\n";
+  CPPUNIT_NS::stdCOut().flush();
+
+  bool isServing = true;
+  while ( isServing )
+  {
+    int connection = ::accept( listening, NULL, NULL );
+    if ( connection < 0 )
+    {
+      if ( errno == EINTR )
+        continue;
+      break;
+    }
+
+    std::string line;
+    SocketLineReader( connection ).readLine( line );
+    {
+      FileDescriptorStreamBuffer buffer( connection );
+      std::ostream stream( &buffer );
+      isServing = handleRequest( line, stream );
+      stream.flush();
+    }
+    ::close( connection );
+  }
+
+  ::close( listening );
+  ::unlink( socketName.c_str() );
+  return true;
+}
+
+
+bool
+TestServer::request( const std::string &socketName,
+                     const std::string &testPath,
+                     CPPUNIT_NS::OStream &stream )
+{
+  struct sockaddr_un address;
+  int connection = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+  if ( connection < 0  ||  !makeAddress( socketName, address )  ||
+       ::connect( connection, (struct sockaddr *)&address, sizeof(address) ) != 0 )
+  {
+    stream  <<  "Can not connect to test server: "  <<  socketName  <<  "\n";
+    if ( connection >= 0 )
+      ::close( connection );
+    return false;
+  }
+
+  std::string request = testPath.empty() ? "run\n" : "run " + testPath + "\n";
+  bool wasSuccessful = false;
+  if ( ::write( connection, request.c_str(), request.length() ) == int(request.length()) )
+  {
+    // Copies the output line by line, until the exit status.
+    SocketLineReader reader( connection );
+    std::string line;
+    while ( reader.readLine( line )  &&  line.compare( 0, 5, "exit " ) != 0 )
+    {
+      stream  <<  line  <<  "\n";
+      stream.flush();
+    }
+    wasSuccessful = line == "exit 0";
+  }
+
+  ::close( connection );
+  return wasSuccessful;
+}
+
+
+bool
+TestServer::handleRequest( const std::string &line,
+                           CPPUNIT_NS::OStream &stream )
+{
+  std::string command;
+  std::string testPath;
+  if ( !parseRequest( line, command, testPath ) )
+  {
+    stream  <<  "Invalid request (expected 'run [testPath]' or 'quit'): "
+            <<  line  <<  "\nexit 1\n";
+    return true;
+  }
+
+  if ( command == "quit" )
+  {
+    stream  <<  "exit 0\n";
+    return false;
+  }
+
+  bool wasSuccessful = false;
+  try
+  {
+    reloadChangedPlugIns( stream );
+    wasSuccessful = runTests( testPath, stream );
+  }
+  catch ( CPPUNIT_NS::DynamicLibraryManagerException &e )
+  {
+    stream  <<  "Failed to load test plug-in:\n"  <<  e.what()  <<  "\n";
+  }
+
+  stream  <<  "exit "  <<  (wasSuccessful ? 0 : 1)  <<  "\n";
+  return true;
+}
+
+
+void
+TestServer::reloadChangedPlugIns( CPPUNIT_NS::OStream &stream )
+{
+  for ( int index =0; index < m_parser.getPlugInCount(); ++index )
+  {
+    CommandLinePlugInInfo plugIn = m_parser.getPlugInAt( index );
+    std::string stamp = PlugInManifest::getFileStamp( plugIn.m_fileName );
+    if ( !m_plugInStamps[ index ].empty()  &&  stamp == m_plugInStamps[ index ] )
+      continue;
+
+    // The tests refer to the code of the plug-ins.
+    deleteTests();
+    if ( !m_plugInStamps[ index ].empty() )
+    {
+      m_plugInManager.unload( plugIn.m_fileName );
+      m_plugInStamps[ index ] = "";
+      checkUnloaded( plugIn.m_fileName, stream );
+    }
+
+    m_plugInManager.load( plugIn.m_fileName, plugIn.m_parameters );
+    m_plugInStamps[ index ] = stamp;
+    stream  <<  "Loaded plug-in "  <<  plugIn.m_fileName  <<  "\n";
+  }
+}
+
+
+#else   // defined(CPPUNIT_TEST_SERVER)
+
+bool
+TestServer::serve( const std::string &socketName )
+{
+  CPPUNIT_NS::stdCOut()  <<  "--serve is not supported on this platform: "
+                         <<  socketName  <<  "\n";
+  return false;
+}
+
+
+bool
+TestServer::request( const std::string &socketName,
+                     const std::string &,
+                     CPPUNIT_NS::OStream &stream )
+{
+  stream  <<  "--request is not supported on this platform: "
+          <<  socketName  <<  "\n";
+  return false;
+}
+
+#endif  // defined(CPPUNIT_TEST_SERVER)
+
+
+bool
+TestServer::runTests( const std::string &testPath,
+                      CPPUNIT_NS::OStream &stream )
+{
+  if ( m_runner == NULL )
+  {
+    m_runner = new CPPUNIT_NS::TestRunner();
+    m_runner->addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+  }
+
+  CPPUNIT_NS::TestResult controller;
+  controller.setFailsTestsWithoutAssertions( m_parser.requireAssertions() );
+  controller.setPeakMemoryBudget( m_parser.getMaximumRssMegabytes() * 1024 );
+  CPPUNIT_NS::TestResultCollector result;
+  controller.addListener( &result );
+  CPPUNIT_NS::BriefTestProgressListener progress( stream );
+  controller.addListener( &progress );
+  m_plugInManager.addListener( &controller );
+
+  bool isResolved = true;
+  try
+  {
+    CPPUNIT_NS::TestFilter filter;
+    for ( int filterIndex =0; filterIndex < m_parser.getFilterCount(); ++filterIndex )
+      filter.addInclude( m_parser.getFilterAt( filterIndex ) );
+    for ( int excludeIndex =0; excludeIndex < m_parser.getExcludeCount(); ++excludeIndex )
+      filter.addExclude( m_parser.getExcludeAt( excludeIndex ) );
+    m_runner->run( controller, filter, testPath );
+  }
+  catch ( std::invalid_argument &e )
+  {
+    stream  <<  "Failed to resolve test path or filter: "  <<  e.what()  <<  "\n";
+    isResolved = false;
+  }
+
+  m_plugInManager.removeListener( &controller );
+  CPPUNIT_NS::CompilerOutputter outputter( &result, stream );
+  outputter.write();
+  return isResolved  &&  result.wasSuccessful();
+}
+
+
+void
+TestServer::deleteTests()
+{
+  delete m_runner;
+  m_runner = NULL;
+}
@@ -0,0 +1,107 @@
+#ifndef CPPUNIT_HELPER_TESTSERVER_H
+#define CPPUNIT_HELPER_TESTSERVER_H
+
+#include <cppunit/Portability.h>
+#include <cppunit/plugin/PlugInManager.h>
+#include <cppunit/portability/CppUnitDeque.h>
+#include <cppunit/portability/Stream.h>
+#include <string>
+
+#if defined(CPPUNIT_HAVE_SYS_UN_H) && !defined(CPPUNIT_NO_STREAM)
+#define CPPUNIT_TEST_SERVER 1
+#endif
+
+CPPUNIT_NS_BEGIN
+class TestRunner;
+CPPUNIT_NS_END
+
+class CommandLineParser;
+
+
+/*! \brief Keeps the test plug-ins loaded and runs tests on request.
+ *
+ * The server listens on a Unix domain socket. Each connection sends a single
+ * request line and receives the output of the run:
+ * - "run" runs all the tests, "run testPath" runs the specified test (see
+ *   TestPath for the syntax). The filters of the server command line apply.
+ *   The name and result of each test are streamed as the tests run, then the
+ *   failures are written as by CompilerOutputter. The last line is "exit 0"
+ *   if all the tests succeeded, "exit 1" otherwise.
+ * - "quit" stops the server.
+ *
+ * Before each run, the plug-ins whose file changed are unloaded and loaded
+ * again. The other plug-ins, and the tests they contain, are reused. A
+ * plug-in that the platform does not actually unload keeps running its old
+ * code: with gcc, this happens when the plug-in defines STB_GNU_UNIQUE
+ * symbols (inline function statics or template static members), unless it is
+ * compiled with -fno-gnu-unique. A warning is sent when it is detected.
+ *
+ * Only available if CPPUNIT_TEST_SERVER is defined.
+ */
+class TestServer
+{
+public:
+  /*! Constructs a server for the plug-ins of the command line.
+   */
+  TestServer( const CommandLineParser &parser );
+
+  /// Destructor. Destroys the tests and unloads the plug-ins.
+  virtual ~TestServer();
+
+  /*! \brief Loads the plug-ins and serves requests until a "quit" request.
+   * \param socketName Path of the Unix domain socket to create.
+   * \return \c false if the socket can not be created, \c true otherwise.
+   * \exception DynamicLibraryManagerException if a plug-in can not be loaded
+   *            on startup.
+   */
+  bool serve( const std::string &socketName );
+
+  /*! \brief Sends a run request to a server.
+   * \param socketName Path of the Unix domain socket of the server.
+   * \param testPath Test to run. Empty to run all the tests.
+   * \param stream Stream the output of the run is copied to.
+   * \return \c true if all the tests succeeded, \c false if a test failed or
+   *         if the server can not be reached.
+   */
+  static bool request( const std::string &socketName,
+                       const std::string &testPath,
+                       CPPUNIT_NS::OStream &stream );
+
+  /*! \brief Parses a request line.
+   * \param line Request line, without the end of line.
+   * \param command Receives "run" or "quit".
+   * \param testPath Receives the test path of a "run" request.
+   * \return \c false if the line is not a valid request.
+   */
+  static bool parseRequest( const std::string &line,
+                            std::string &command,
+                            std::string &testPath );
+
+private:
+  bool handleRequest( const std::string &line,
+                      CPPUNIT_NS::OStream &stream );
+
+  void reloadChangedPlugIns( CPPUNIT_NS::OStream &stream );
+
+  bool runTests( const std::string &testPath,
+                 CPPUNIT_NS::OStream &stream );
+
+  void deleteTests();
+
+  /// Prevents the use of the copy constructor.
+  TestServer( const TestServer &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const TestServer &copy );
+
+private:
+  const CommandLineParser &m_parser;
+  CPPUNIT_NS::PlugInManager m_plugInManager;
+  /// Stamp of the file of each loaded plug-in, empty if it is not loaded.
+  CppUnitDeque<std::string> m_plugInStamps;
+  /// Tests of the loaded plug-ins, NULL until the next run.
+  CPPUNIT_NS::TestRunner *m_runner;
+};
+
+
+#endif  // CPPUNIT_HELPER_TESTSERVER_H
@@ -0,0 +1,58 @@
+#include "TestServer.h"
+#include "TestServerTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestServerTest );
+
+
+TestServerTest::TestServerTest()
+{
+}
+
+
+TestServerTest::~TestServerTest()
+{
+}
+
+
+void 
+TestServerTest::testParseRunAll()
+{
+  std::string command;
+  std::string testPath = "previous";
+  CPPUNIT_ASSERT( TestServer::parseRequest( "run", command, testPath ) );
+  CPPUNIT_ASSERT_EQUAL( std::string("run"), command );
+  CPPUNIT_ASSERT_EQUAL( std::string(""), testPath );
+}
+
+
+void 
+TestServerTest::testParseRunTestPath()
+{
+  std::string command;
+  std::string testPath;
+  CPPUNIT_ASSERT( TestServer::parseRequest( "run /All Tests/Math Test", 
+                                            command, testPath ) );
+  CPPUNIT_ASSERT_EQUAL( std::string("run"), command );
+  CPPUNIT_ASSERT_EQUAL( std::string("/All Tests/Math Test"), testPath );
+}
+
+
+void 
+TestServerTest::testParseQuit()
+{
+  std::string command;
+  std::string testPath;
+  CPPUNIT_ASSERT( TestServer::parseRequest( "quit", command, testPath ) );
+  CPPUNIT_ASSERT_EQUAL( std::string("quit"), command );
+}
+
+
+void 
+TestServerTest::testParseInvalidRequest()
+{
+  std::string command;
+  std::string testPath;
+  CPPUNIT_ASSERT( !TestServer::parseRequest( "", command, testPath ) );
+  CPPUNIT_ASSERT( !TestServer::parseRequest( "runMathTest", command, testPath ) );
+  CPPUNIT_ASSERT( !TestServer::parseRequest( "stop", command, testPath ) );
+}
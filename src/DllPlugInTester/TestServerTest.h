@@ -0,0 +1,32 @@
+#ifndef TESTSERVERTEST_H
+#define TESTSERVERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class TestServerTest : public CPPUNIT_NS::TestCase
+{
+  CPPUNIT_TEST_SUITE( TestServerTest );
+  CPPUNIT_TEST( testParseRunAll );
+  CPPUNIT_TEST( testParseRunTestPath );
+  CPPUNIT_TEST( testParseQuit );
+  CPPUNIT_TEST( testParseInvalidRequest );
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TestServerTest();
+  virtual ~TestServerTest();
+
+  void testParseRunAll();
+  void testParseRunTestPath();
+  void testParseQuit();
+  void testParseInvalidRequest();
+
+private:
+  TestServerTest( const TestServerTest &other );
+  void operator =( const TestServerTest &other );
+};
+
+
+
+#endif  // TESTSERVERTEST_H
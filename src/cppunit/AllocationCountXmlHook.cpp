@@ -0,0 +1,67 @@
+#include <cppunit/AllocationCountXmlHook.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/portability/Stream.h>
+#include <cppunit/tools/XmlElement.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+AllocationCountXmlHook::AllocationCountXmlHook( TestResultCollector *result )
+    : m_result( result )
+{
+}
+
+
+AllocationCountXmlHook::~AllocationCountXmlHook()
+{
+}
+
+
+void 
+AllocationCountXmlHook::failTestAdded( XmlDocument *document,
+                                       XmlElement *testElement,
+                                       Test *test,
+                                       TestFailure * )
+{
+  successfulTestAdded( document, testElement, test );
+}
+
+
+void 
+AllocationCountXmlHook::successfulTestAdded( XmlDocument *,
+                                             XmlElement *testElement,
+                                             Test *test )
+{
+  addCounts( testElement, 
+             m_result->allocationCount( test ),
+             m_result->allocatedByteCount( test ) );
+}
+
+
+void 
+AllocationCountXmlHook::statisticsAdded( XmlDocument *,
+                                         XmlElement *statisticsElement )
+{
+  addCounts( statisticsElement, 
+             m_result->allocationCount(),
+             m_result->allocatedByteCount() );
+}
+
+
+void 
+AllocationCountXmlHook::addCounts( XmlElement *element,
+                                   long allocationCount,
+                                   long allocatedByteCount )
+{
+  OStringStream allocations;
+  allocations  <<  allocationCount;
+  element->addElement( new XmlElement( "Allocations", allocations.str() ) );
+
+  OStringStream bytes;
+  bytes  <<  allocatedByteCount;
+  element->addElement( new XmlElement( "AllocatedBytes", bytes.str() ) );
+}
+
+
+CPPUNIT_NS_END
@@ -0,0 +1,237 @@
+#include <cppunit/AllocationScope.h>
+#include <cppunit/Asserter.h>
+#include <cppunit/Message.h>
+#include <cppunit/portability/Stream.h>
+#include "Thread.h"
+#include <stdlib.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/// Set by the first allocation made through allocate().
+static volatile long isInstalled = 0;
+
+/// Set by setCountingEnabled( false ).
+static volatile long isDisabled = 0;
+
+/// Set once a scope was created, so that allocate() does not use the
+/// thread-local pointer while it is being constructed.
+static volatile long hasScopes = 0;
+
+
+/// Innermost scope of each thread.
+static ThreadLocalPointer *
+innermostScopes()
+{
+  // Never destroyed: allocations may still happen after the static objects
+  // are destroyed.
+  static ThreadLocalPointer *scopes = new ThreadLocalPointer();
+  return scopes;
+}
+
+
+AllocationScope::AllocationScope()
+    : m_enclosingScope( current() )
+    , m_allocationCount( 0 )
+    , m_allocatedByteCount( 0 )
+    , m_pauseDepth( 0 )
+    , m_hasEnded( false )
+{
+  innermostScopes()->set( this );
+  if ( atomicLoad( hasScopes ) == 0 )
+    atomicStore( hasScopes, 1 );
+}
+
+
+AllocationScope::~AllocationScope()
+{
+  end();
+}
+
+
+void 
+AllocationScope::end()
+{
+  if ( m_hasEnded )
+    return;
+
+  m_hasEnded = true;
+  innermostScopes()->set( m_enclosingScope );
+  if ( m_enclosingScope != NULL )
+  {
+    m_enclosingScope->m_allocationCount += m_allocationCount;
+    m_enclosingScope->m_allocatedByteCount += m_allocatedByteCount;
+  }
+}
+
+
+long 
+AllocationScope::allocationCount() const
+{
+  return m_allocationCount;
+}
+
+
+long 
+AllocationScope::allocatedByteCount() const
+{
+  return m_allocatedByteCount;
+}
+
+
+bool 
+AllocationScope::isCountingInstalled()
+{
+  return atomicLoad( isInstalled ) != 0  &&  atomicLoad( isDisabled ) == 0;
+}
+
+
+void 
+AllocationScope::setCountingEnabled( bool isEnabled )
+{
+  atomicStore( isDisabled, isEnabled ? 0 : 1 );
+}
+
+
+void *
+AllocationScope::allocate( std::size_t byteCount,
+                           bool throwsOnFailure )
+{
+  if ( atomicLoad( isDisabled ) == 0 )
+  {
+    if ( atomicLoad( isInstalled ) == 0 )
+      atomicStore( isInstalled, 1 );
+    AllocationScope *scope = current();
+    if ( scope != NULL )
+      scope->countAllocation( byteCount );
+  }
+
+  if ( byteCount == 0 )
+    byteCount = 1;
+  void *memory = ::malloc( byteCount );
+  while ( memory == NULL )
+  {
+    std::new_handler handler = std::set_new_handler( 0 );
+    std::set_new_handler( handler );
+    if ( handler == 0 )
+    {
+      if ( throwsOnFailure )
+        throw std::bad_alloc();
+      return NULL;
+    }
+
+    try
+    {
+      handler();
+    }
+    catch ( std::bad_alloc & )
+    {
+      if ( throwsOnFailure )
+        throw;
+      return NULL;
+    }
+    memory = ::malloc( byteCount );
+  }
+
+  return memory;
+}
+
+
+void 
+AllocationScope::deallocate( void *memory )
+{
+  ::free( memory );
+}
+
+
+AllocationScope *
+AllocationScope::current()
+{
+  if ( atomicLoad( hasScopes ) == 0 )
+    return NULL;
+  return (AllocationScope *)innermostScopes()->get();
+}
+
+
+void 
+AllocationScope::countAllocation( std::size_t byteCount )
+{
+  if ( m_pauseDepth > 0 )
+    return;
+
+  ++m_allocationCount;
+  m_allocatedByteCount += long(byteCount);
+}
+
+
+AllocationCountingPause::AllocationCountingPause()
+    : m_scope( AllocationScope::current() )
+{
+  if ( m_scope != NULL )
+    ++m_scope->m_pauseDepth;
+}
+
+
+AllocationCountingPause::~AllocationCountingPause()
+{
+  if ( m_scope != NULL )
+    --m_scope->m_pauseDepth;
+}
+
+
+AllocationAssertion::AllocationAssertion( long maximumAllocationCount,
+                                          const SourceLine &sourceLine )
+    : m_maximumAllocationCount( maximumAllocationCount )
+    , m_isCounting( true )
+{
+  AllocationCountingPause pause;
+  m_sourceLine = sourceLine;
+}
+
+
+AllocationAssertion::~AllocationAssertion()
+{
+}
+
+
+bool 
+AllocationAssertion::isCounting() const
+{
+  return m_isCounting;
+}
+
+
+void 
+AllocationAssertion::check()
+{
+  m_isCounting = false;
+  m_scope.end();
+  Asserter::countAssertion();
+
+  AllocationCountingPause pause;
+  if ( !AllocationScope::isCountingInstalled() )
+  {
+    Asserter::fail( Message( "allocation counting not installed",
+                             "Use CPPUNIT_INSTALL_ALLOCATION_COUNTING() in "
+                             "the test program" ),
+                    m_sourceLine );
+  }
+  else if ( m_scope.allocationCount() > m_maximumAllocationCount )
+  {
+    OStringStream expected;
+    expected  <<  "Expected: at most "  <<  m_maximumAllocationCount  
+              <<  " allocation(s)";
+    OStringStream actual;
+    actual  <<  "Actual  : "  <<  m_scope.allocationCount()  
+            <<  " allocation(s) of "  <<  m_scope.allocatedByteCount()  
+            <<  " bytes";
+    Asserter::fail( Message( "too many allocations", 
+                             expected.str(), 
+                             actual.str() ),
+                    m_sourceLine );
+  }
+}
+
+
+CPPUNIT_NS_END
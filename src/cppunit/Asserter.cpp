@@ -1,6 +1,9 @@
+#include <cppunit/AllocationScope.h>
 #include <cppunit/Asserter.h>
 #include <cppunit/Exception.h>
+#include <cppunit/ExpectationCollector.h>
 #include <cppunit/Message.h>
+#include <cppunit/tools/BoundedText.h>
 
 
 CPPUNIT_NS_BEGIN
@@ -10,6 +13,7 @@ void
 Asserter::fail( std::string message, 
                 const SourceLine &sourceLine )
 {
+  AllocationCountingPause pause;
   fail( Message( "assertion failed", message ), sourceLine );
 }
 
@@ -18,6 +22,11 @@ void
 Asserter::fail( const Message &message, 
                 const SourceLine &sourceLine )
 {
+  AllocationCountingPause pause;
+  // The failures of the CPPUNIT_EXPECT_* macros are recorded, not thrown.
+  if ( ExpectationCollector::recordFailure( message, sourceLine ) )
+    return;
+
   throw Exception( message, sourceLine );
 }
 
@@ -27,11 +36,19 @@ Asserter::failIf( bool shouldFail,
                   const Message &message, 
                   const SourceLine &sourceLine )
 {
+  countAssertion();
   if ( shouldFail )
     fail( message, sourceLine );
 }
 
 
+void 
+Asserter::countAssertion()
+{
+  ExpectationCollector::countAssertion();
+}
+
+
 void 
 Asserter::failIf( bool shouldFail, 
                   std::string message, 
@@ -44,14 +61,14 @@ Asserter::failIf( bool shouldFail,
 std::string 
 Asserter::makeExpected( const std::string &expectedValue )
 {
-  return "Expected: " + expectedValue;
+  return "Expected: " + BoundedText::elide( expectedValue );
 }
 
 
 std::string 
 Asserter::makeActual( const std::string &actualValue )
 {
-  return "Actual  : " + actualValue;
+  return "Actual  : " + BoundedText::elide( actualValue );
 }
 
 
@@ -77,6 +94,7 @@ Asserter::failNotEqual( std::string expected,
                         const AdditionalMessage &additionalMessage,
                         std::string shortDescription )
 {
+  AllocationCountingPause pause;
   fail( makeNotEqualMessage( expected,
                              actual,
                              additionalMessage,
@@ -93,6 +111,7 @@ Asserter::failNotEqualIf( bool shouldFail,
                           const AdditionalMessage &additionalMessage,
                           std::string shortDescription )
 {
+  countAssertion();
   if ( shouldFail )
     failNotEqual( expected, actual, sourceLine, additionalMessage, shortDescription );
 }
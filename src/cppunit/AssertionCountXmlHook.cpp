@@ -0,0 +1,49 @@
+#include <cppunit/AssertionCountXmlHook.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/tools/XmlElement.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+AssertionCountXmlHook::AssertionCountXmlHook( TestResultCollector *result )
+    : m_result( result )
+{
+}
+
+
+AssertionCountXmlHook::~AssertionCountXmlHook()
+{
+}
+
+
+void 
+AssertionCountXmlHook::failTestAdded( XmlDocument *document,
+                                      XmlElement *testElement,
+                                      Test *test,
+                                      TestFailure * )
+{
+  successfulTestAdded( document, testElement, test );
+}
+
+
+void 
+AssertionCountXmlHook::successfulTestAdded( XmlDocument *,
+                                            XmlElement *testElement,
+                                            Test *test )
+{
+  testElement->addElement( new XmlElement( "Assertions", 
+                                           m_result->assertionCount( test ) ) );
+}
+
+
+void 
+AssertionCountXmlHook::statisticsAdded( XmlDocument *,
+                                        XmlElement *statisticsElement )
+{
+  statisticsElement->addElement( new XmlElement( "Assertions", 
+                                                 m_result->assertionCount() ) );
+}
+
+
+CPPUNIT_NS_END
@@ -0,0 +1,182 @@
+#include <cppunit/tools/BoundedText.h>
+#include <stdio.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/// Default maximum length of the rendered values.
+static unsigned int maximumTextLength = 1024;
+
+/// Smallest maximum length, leaving room for the elision marker.
+static const unsigned int minimumMaximumLength = 128;
+
+static const unsigned long hashOffsetBasis = 2166136261UL;
+static const unsigned long hashPrime = 16777619UL;
+
+
+BoundedText::BoundedText()
+    : m_maximumLength( maximumTextLength )
+    , m_tailStart( 0 )
+    , m_length( 0 )
+    , m_hash( hashOffsetBasis )
+{
+}
+
+
+BoundedText::BoundedText( unsigned int maximumLength )
+    : m_maximumLength( maximumLength )
+    , m_tailStart( 0 )
+    , m_length( 0 )
+    , m_hash( hashOffsetBasis )
+{
+  if ( m_maximumLength != 0  &&  m_maximumLength < minimumMaximumLength )
+    m_maximumLength = minimumMaximumLength;
+}
+
+
+BoundedText::~BoundedText()
+{
+}
+
+
+void
+BoundedText::append( const char *text,
+                     unsigned long length )
+{
+  unsigned long hash = m_hash;
+  for ( unsigned long index = 0; index < length; ++index )
+    hash = ((hash ^ (unsigned char)text[index]) * hashPrime) & 0xffffffffUL;
+  m_hash = hash;
+  m_length += length;
+
+  if ( m_maximumLength == 0 )
+  {
+    m_head.append( text, length );
+    return;
+  }
+
+  unsigned long headLength = headCapacity() - m_head.length();
+  if ( headLength > length )
+    headLength = length;
+  m_head.append( text, headLength );
+  text += headLength;
+  length -= headLength;
+
+  // Only the last characters of a long text are kept.
+  if ( length >= tailCapacity() )
+  {
+    m_tail.assign( text + length - tailCapacity(), tailCapacity() );
+    m_tailStart = 0;
+    return;
+  }
+
+  for ( unsigned long index = 0; index < length; ++index )
+  {
+    if ( m_tail.length() < tailCapacity() )
+      m_tail += text[index];
+    else
+    {
+      m_tail[ m_tailStart ] = text[index];
+      m_tailStart = (m_tailStart + 1) % tailCapacity();
+    }
+  }
+}
+
+
+void
+BoundedText::append( char c )
+{
+  append( &c, 1 );
+}
+
+
+unsigned long
+BoundedText::length() const
+{
+  return m_length;
+}
+
+
+/*! Returns the marker replacing the middle of an elided text.
+ */
+static std::string
+makeElisionMarker( unsigned long elidedLength,
+                   unsigned long length,
+                   unsigned long hash )
+{
+  char buffer[128];
+#ifdef __STDC_SECURE_LIB__ // Use secure version with visual studio 2005 to avoid warning.
+  sprintf_s( buffer, sizeof(buffer),
+             "[... %lu of %lu characters elided, hash %08lx ...]",
+             elidedLength, length, hash );
+#else
+  sprintf( buffer, "[... %lu of %lu characters elided, hash %08lx ...]",
+           elidedLength, length, hash );
+#endif
+  return buffer;
+}
+
+
+std::string
+BoundedText::str() const
+{
+  std::string tail = m_tail.substr( m_tailStart ) + m_tail.substr( 0, m_tailStart );
+  if ( m_maximumLength == 0  ||  m_length <= m_maximumLength )
+    return m_head + tail;
+
+  // The marker is first sized for the longest count of elided characters.
+  unsigned int markerLength = makeElisionMarker( m_length, m_length, m_hash ).length();
+  unsigned int keptLength = m_maximumLength > markerLength ? m_maximumLength - markerLength
+                                                           : 0;
+  unsigned int headLength = keptLength / 2;
+  unsigned int tailLength = keptLength - headLength;
+  return m_head.substr( 0, headLength ) +
+         makeElisionMarker( m_length - keptLength, m_length, m_hash ) +
+         tail.substr( tail.length() - tailLength );
+}
+
+
+std::string
+BoundedText::elide( const std::string &text )
+{
+  if ( maximumTextLength == 0  ||  text.length() <= maximumTextLength )
+    return text;
+
+  BoundedText bounded;
+  bounded.append( text.c_str(), text.length() );
+  return bounded.str();
+}
+
+
+void
+BoundedText::setMaximumLength( unsigned int maximumLength )
+{
+  if ( maximumLength != 0  &&  maximumLength < minimumMaximumLength )
+    maximumLength = minimumMaximumLength;
+  maximumTextLength = maximumLength;
+}
+
+
+unsigned int
+BoundedText::maximumLength()
+{
+  return maximumTextLength;
+}
+
+
+unsigned int
+BoundedText::headCapacity() const
+{
+  return m_maximumLength / 2;
+}
+
+
+unsigned int
+BoundedText::tailCapacity() const
+{
+  return m_maximumLength - m_maximumLength / 2;
+}
+
+
+CPPUNIT_NS_END
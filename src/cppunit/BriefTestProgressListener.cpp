@@ -8,7 +8,15 @@ CPPUNIT_NS_BEGIN
 
 
 BriefTestProgressListener::BriefTestProgressListener()
-    : m_lastTestFailed( false )
+    : m_stream( stdCOut() )
+    , m_lastTestFailed( false )
+{
+}
+
+
+BriefTestProgressListener::BriefTestProgressListener( OStream &stream )
+    : m_stream( stream )
+    , m_lastTestFailed( false )
 {
 }
 
@@ -21,8 +29,8 @@ BriefTestProgressListener::~BriefTestProgressListener()
 void 
 BriefTestProgressListener::startTest( Test *test )
 {
-  stdCOut() << test->getName();
-  stdCOut().flush();
+  m_stream << test->getNameRef();
+  m_stream.flush();
 
   m_lastTestFailed = false;
 }
@@ -31,7 +39,7 @@ BriefTestProgressListener::startTest( Test *test )
 void 
 BriefTestProgressListener::addFailure( const TestFailure &failure )
 {
-  stdCOut() << " : " << (failure.isError() ? "error" : "assertion");
+  m_stream << " : " << (failure.isError() ? "error" : "assertion");
   m_lastTestFailed  = true;
 }
 
@@ -40,8 +48,8 @@ void
 BriefTestProgressListener::endTest( Test * )
 {
   if ( !m_lastTestFailed )
-    stdCOut()  <<  " : OK";
-  stdCOut() << "\n";
+    m_stream  <<  " : OK";
+  m_stream << "\n";
 }
 
 
@@ -0,0 +1,324 @@
+#include <cppunit/Exception.h>
+#include <cppunit/Mutex.h>
+#include <cppunit/TestFailure.h>
+#include <cppunit/TestListener.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/ConcurrentRepeatedTest.h>
+#include <cppunit/extensions/TestFactory.h>
+#include "Thread.h"
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief State shared by the threads of a ConcurrentRepeatedTest run (Implementation).
+ */
+class ConcurrentRun
+{
+public:
+  ConcurrentRun( TestResult *result,
+                 int threadCount )
+      : m_result( result )
+      , m_waitedThreadCount( threadCount )
+      , m_readyThreadCount( 0 )
+      , m_repetitionCount( 0 )
+      , m_failedRepetitionCount( 0 )
+  {
+  }
+
+  /// Protects the other members and the calls to m_result.
+  Mutex m_mutex;
+  TestResult *m_result;
+  /// Number of threads the start barrier waits for.
+  int m_waitedThreadCount;
+  /// Number of threads that reached the start barrier.
+  int m_readyThreadCount;
+  int m_repetitionCount;
+  int m_failedRepetitionCount;
+};
+
+
+/*! \brief Runs the repetitions of a thread of a ConcurrentRepeatedTest (Implementation).
+ *
+ * The repetitions are run with a TestResult private to the thread, which has
+ * the settings of the shared TestResult, and whose events are all forwarded
+ * to the shared TestResult under the lock of the run.
+ */
+class RepetitionThread : public TestListener
+                       , public Thread
+{
+public:
+  RepetitionThread( ConcurrentRun &run,
+                    Test *test,
+                    int timesRepeat )
+      : m_run( run )
+      , m_test( test )
+      , m_timesRepeat( timesRepeat )
+      , m_failureCount( 0 )
+  {
+    m_threadResult.copySettings( *run.m_result );
+    m_threadResult.addListener( this );
+  }
+
+  /// Waits for the other threads, then runs the repetitions.
+  void run()
+  {
+    waitForOtherThreads();
+    runRepetitions();
+  }
+
+  /// Spins until all the threads of the run are ready to start.
+  void waitForOtherThreads();
+
+  void runRepetitions()
+  {
+    for ( int n = 0; n < m_timesRepeat; ++n )
+    {
+      {
+        MutexLock lock( m_run.m_mutex );
+        if ( m_run.m_result->shouldStop() )
+          break;
+      }
+
+      int failureCount = m_failureCount;
+      m_test->run( &m_threadResult );
+
+      MutexLock lock( m_run.m_mutex );
+      ++m_run.m_repetitionCount;
+      if ( m_failureCount != failureCount )
+        ++m_run.m_failedRepetitionCount;
+    }
+  }
+
+  void startTest( Test *test )
+  {
+    MutexLock lock( m_run.m_mutex );
+    m_run.m_result->startTest( test );
+  }
+
+  void addFailure( const TestFailure &failure )
+  {
+    ++m_failureCount;
+    MutexLock lock( m_run.m_mutex );
+    if ( failure.isError() )
+      m_run.m_result->addError( failure.failedTest(),
+                                failure.thrownException()->clone() );
+    else
+      m_run.m_result->addFailure( failure.failedTest(),
+                                  failure.thrownException()->clone() );
+  }
+
+  void addAssertions( Test *test,
+                      int assertionCount )
+  {
+    MutexLock lock( m_run.m_mutex );
+    m_run.m_result->addAssertions( test, assertionCount );
+  }
+
+  void addAllocations( Test *test,
+                       long allocationCount,
+                       long allocatedByteCount )
+  {
+    MutexLock lock( m_run.m_mutex );
+    m_run.m_result->addAllocations( test, allocationCount, allocatedByteCount );
+  }
+
+  void addPeakMemory( Test *test,
+                      long peakKilobytes )
+  {
+    MutexLock lock( m_run.m_mutex );
+    m_run.m_result->addPeakMemory( test, peakKilobytes );
+  }
+
+  void endTest( Test *test )
+  {
+    MutexLock lock( m_run.m_mutex );
+    m_run.m_result->endTest( test );
+  }
+
+  void startSuite( Test *suite )
+  {
+    MutexLock lock( m_run.m_mutex );
+    m_run.m_result->startSuite( suite );
+  }
+
+  void endSuite( Test *suite )
+  {
+    MutexLock lock( m_run.m_mutex );
+    m_run.m_result->endSuite( suite );
+  }
+
+private:
+  /// Prevents the use of the copy constructor.
+  RepetitionThread( const RepetitionThread &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const RepetitionThread &copy );
+
+private:
+  ConcurrentRun &m_run;
+  Test *m_test;
+  const int m_timesRepeat;
+  TestResult m_threadResult;
+  int m_failureCount;
+};
+
+
+void
+RepetitionThread::waitForOtherThreads()
+{
+  {
+    MutexLock lock( m_run.m_mutex );
+    ++m_run.m_readyThreadCount;
+  }
+
+  while ( true )
+  {
+    {
+      MutexLock lock( m_run.m_mutex );
+      if ( m_run.m_readyThreadCount >= m_run.m_waitedThreadCount )
+        return;
+    }
+    Thread::yield();
+  }
+}
+
+
+ConcurrentRepeatedTest::ConcurrentRepeatedTest( Test *test,
+                                                int threadCount,
+                                                int timesRepeat )
+    : TestDecorator( test )
+    , m_factory( NULL )
+    , m_threadCount( threadCount )
+    , m_timesRepeat( timesRepeat )
+    , m_repetitionCount( 0 )
+    , m_failedRepetitionCount( 0 )
+    , m_elapsedTime( 0 )
+{
+}
+
+
+ConcurrentRepeatedTest::ConcurrentRepeatedTest( TestFactory *factory,
+                                                int threadCount,
+                                                int timesRepeat )
+    : TestDecorator( factory->makeTest() )
+    , m_factory( factory )
+    , m_threadCount( threadCount )
+    , m_timesRepeat( timesRepeat )
+    , m_repetitionCount( 0 )
+    , m_failedRepetitionCount( 0 )
+    , m_elapsedTime( 0 )
+{
+}
+
+
+ConcurrentRepeatedTest::~ConcurrentRepeatedTest()
+{
+  for ( Tests::iterator it = m_threadTests.begin(); it != m_threadTests.end(); ++it )
+    delete *it;
+}
+
+
+void
+ConcurrentRepeatedTest::run( TestResult *result )
+{
+  ConcurrentRun concurrentRun( result, m_threadCount );
+
+  // Creates the tests of the threads before starting any of them.
+  for ( int testIndex = 0; testIndex < m_threadCount; ++testIndex )
+    getThreadTest( testIndex );
+
+  CppUnitVector<RepetitionThread *> threads;
+  CppUnitVector<bool> started( m_threadCount, false );
+  for ( int index = 0; index < m_threadCount; ++index )
+    threads.push_back( new RepetitionThread( concurrentRun, getThreadTest( index ), m_timesRepeat ) );
+
+  // The calling thread is the first thread of the run.
+  for ( int threadIndex = 1; threadIndex < m_threadCount; ++threadIndex )
+  {
+    started[threadIndex] = threads[threadIndex]->start();
+    if ( !started[threadIndex] )
+    {
+      MutexLock lock( concurrentRun.m_mutex );
+      --concurrentRun.m_waitedThreadCount;
+    }
+  }
+
+  threads[0]->waitForOtherThreads();
+  double startTime = Thread::currentTime();
+  threads[0]->runRepetitions();
+
+  for ( int joinedIndex = 1; joinedIndex < m_threadCount; ++joinedIndex )
+  {
+    if ( started[joinedIndex] )
+      threads[joinedIndex]->join();
+    else
+      threads[joinedIndex]->runRepetitions();
+  }
+  m_elapsedTime = Thread::currentTime() - startTime;
+
+  for ( int deletedIndex = 0; deletedIndex < m_threadCount; ++deletedIndex )
+    delete threads[deletedIndex];
+
+  m_repetitionCount = concurrentRun.m_repetitionCount;
+  m_failedRepetitionCount = concurrentRun.m_failedRepetitionCount;
+}
+
+
+int
+ConcurrentRepeatedTest::countTestCases() const
+{
+  return TestDecorator::countTestCases() * m_threadCount * m_timesRepeat;
+}
+
+
+int
+ConcurrentRepeatedTest::getThreadCount() const
+{
+  return m_threadCount;
+}
+
+
+int
+ConcurrentRepeatedTest::getRepetitionCount() const
+{
+  return m_repetitionCount;
+}
+
+
+int
+ConcurrentRepeatedTest::getFailedRepetitionCount() const
+{
+  return m_failedRepetitionCount;
+}
+
+
+double
+ConcurrentRepeatedTest::getElapsedTime() const
+{
+  return m_elapsedTime;
+}
+
+
+double
+ConcurrentRepeatedTest::getThroughput() const
+{
+  if ( m_elapsedTime <= 0 )
+    return 0;
+  return m_repetitionCount / m_elapsedTime;
+}
+
+
+Test *
+ConcurrentRepeatedTest::getThreadTest( int threadIndex )
+{
+  if ( threadIndex == 0  ||  m_factory == NULL )
+    return m_test;
+
+  while ( int(m_threadTests.size()) < threadIndex )
+    m_threadTests.push_back( m_factory->makeTest() );
+  return m_threadTests[ threadIndex - 1 ];
+}
+
+
+CPPUNIT_NS_END
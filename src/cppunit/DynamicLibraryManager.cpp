@@ -6,9 +6,11 @@
 CPPUNIT_NS_BEGIN
 
 
-DynamicLibraryManager::DynamicLibraryManager( const std::string &libraryFileName )
+DynamicLibraryManager::DynamicLibraryManager( const std::string &libraryFileName,
+                                              SymbolResolution symbolResolution )
     : m_libraryHandle( NULL )
     , m_libraryName( libraryFileName )
+    , m_symbolResolution( symbolResolution )
 {
   loadLibrary( libraryFileName );
 }
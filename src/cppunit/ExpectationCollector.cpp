@@ -0,0 +1,262 @@
+#include <cppunit/AllocationScope.h>
+#include <cppunit/Exception.h>
+#include <cppunit/ExpectationCollector.h>
+#include <cppunit/Message.h>
+#include <cppunit/SourceLine.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/portability/Stream.h>
+#include "Thread.h"
+
+
+CPPUNIT_NS_BEGIN
+
+
+/// Collector of each thread.
+static ThreadLocalPointer currentCollector;
+
+
+ExpectationCollector::ExpectationCollector( int maximumFailureCount )
+    : m_maximumFailureCount( maximumFailureCount )
+    , m_droppedFailureCount( 0 )
+    , m_scopeDepth( 0 )
+    , m_assertionCount( 0 )
+    , m_adoptedAssertionCount( 0 )
+    , m_threadContext( this )
+{
+}
+
+
+ExpectationCollector::~ExpectationCollector()
+{
+  m_threadContext.detach();
+  for ( unsigned int index =0; index < m_failures.size(); ++index )
+    delete m_failures[ index ].m_exception;
+}
+
+
+void
+ExpectationCollector::addFailure( const Message &message,
+                                  const SourceLine &sourceLine )
+{
+  add( message, sourceLine, false );
+}
+
+
+void
+ExpectationCollector::addError( const Message &message,
+                                const SourceLine &sourceLine )
+{
+  add( message, sourceLine, true );
+}
+
+
+void
+ExpectationCollector::add( const Message &message,
+                           const SourceLine &sourceLine,
+                           bool isError )
+{
+  AllocationCountingPause pause;
+  MutexLock lock( m_lock );
+  if ( int(m_failures.size()) < m_maximumFailureCount )
+  {
+    Failure failure;
+    failure.m_exception = new Exception( message, sourceLine );
+    failure.m_isError = isError;
+    m_failures.push_back( failure );
+  }
+  else
+    ++m_droppedFailureCount;
+}
+
+
+void
+ExpectationCollector::adoptFailures( ExpectationCollector &other )
+{
+  CppUnitDeque<Failure> failures;
+  int droppedFailureCount;
+  int assertionCount;
+  {
+    MutexLock lock( other.m_lock );
+    failures.swap( other.m_failures );
+    droppedFailureCount = other.m_droppedFailureCount;
+    other.m_droppedFailureCount = 0;
+    assertionCount = other.m_assertionCount + other.m_adoptedAssertionCount;
+    other.m_assertionCount = 0;
+    other.m_adoptedAssertionCount = 0;
+  }
+
+  MutexLock lock( m_lock );
+  m_adoptedAssertionCount += assertionCount;
+  for ( unsigned int index =0; index < failures.size(); ++index )
+  {
+    if ( int(m_failures.size()) < m_maximumFailureCount )
+      m_failures.push_back( failures[ index ] );
+    else
+    {
+      delete failures[ index ].m_exception;
+      ++m_droppedFailureCount;
+    }
+  }
+  m_droppedFailureCount += droppedFailureCount;
+}
+
+
+int
+ExpectationCollector::failureCount() const
+{
+  ExpectationCollector *mutableThis = CPPUNIT_CONST_CAST( ExpectationCollector *, this );
+  MutexLock lock( mutableThis->m_lock );
+  return m_failures.size() + m_droppedFailureCount;
+}
+
+
+int
+ExpectationCollector::assertionCount() const
+{
+  ExpectationCollector *mutableThis = CPPUNIT_CONST_CAST( ExpectationCollector *, this );
+  MutexLock lock( mutableThis->m_lock );
+  return m_assertionCount + m_adoptedAssertionCount;
+}
+
+
+void
+ExpectationCollector::reportFailures( TestResult *result,
+                                      Test *test )
+{
+  CppUnitDeque<Failure> failures;
+  int droppedFailureCount;
+  {
+    MutexLock lock( m_lock );
+    failures.swap( m_failures );
+    droppedFailureCount = m_droppedFailureCount;
+    m_droppedFailureCount = 0;
+  }
+
+  for ( unsigned int index =0; index < failures.size(); ++index )
+  {
+    if ( failures[ index ].m_isError )
+      result->addError( test, failures[ index ].m_exception );
+    else
+      result->addFailure( test, failures[ index ].m_exception );
+  }
+
+  if ( droppedFailureCount > 0 )
+  {
+    OStringStream dropped;
+    dropped  <<  droppedFailureCount  <<  " more failed expectations were not kept";
+    result->addFailure( test, new Exception( Message( "too many failed expectations",
+                                                      dropped.str() ) ) );
+  }
+}
+
+
+void
+ExpectationCollector::endThreads()
+{
+  int runningTaskCount = m_threadContext.detach();
+  if ( runningTaskCount > 0 )
+  {
+    OStringStream running;
+    running  <<  runningTaskCount  <<  " task(s) run with TestThreadContext::run() "
+                                       "had not returned when the test ended";
+    addFailure( Message( "threads outlived the test", running.str() ),
+                SourceLine() );
+  }
+}
+
+
+void
+ExpectationCollector::endTest( TestResult *result,
+                               Test *test )
+{
+  endThreads();
+  reportFailures( result, test );
+}
+
+
+const TestThreadContext &
+ExpectationCollector::threadContext() const
+{
+  return m_threadContext;
+}
+
+
+ExpectationCollector *
+ExpectationCollector::setCurrent( ExpectationCollector *collector )
+{
+  ExpectationCollector *previous = current();
+  currentCollector.set( collector );
+  return previous;
+}
+
+
+ExpectationCollector *
+ExpectationCollector::current()
+{
+  return (ExpectationCollector *)currentCollector.get();
+}
+
+
+bool
+ExpectationCollector::recordFailure( const Message &message,
+                                     const SourceLine &sourceLine )
+{
+  ExpectationCollector *collector = current();
+  if ( collector == NULL  ||  collector->m_scopeDepth == 0 )
+    return false;
+
+  collector->addFailure( message, sourceLine );
+  return true;
+}
+
+
+void
+ExpectationCollector::countAssertion()
+{
+  AllocationCountingPause pause;
+  ExpectationCollector *collector = current();
+  if ( collector != NULL )
+    ++collector->m_assertionCount;
+}
+
+
+CurrentExpectationCollector::CurrentExpectationCollector( ExpectationCollector *collector )
+    : m_previousCollector( ExpectationCollector::setCurrent( collector ) )
+    , m_isRestored( false )
+{
+}
+
+
+CurrentExpectationCollector::~CurrentExpectationCollector()
+{
+  restore();
+}
+
+
+void
+CurrentExpectationCollector::restore()
+{
+  if ( m_isRestored )
+    return;
+
+  m_isRestored = true;
+  ExpectationCollector::setCurrent( m_previousCollector );
+}
+
+
+ExpectationScope::ExpectationScope()
+    : m_collector( ExpectationCollector::current() )
+{
+  if ( m_collector != NULL )
+    ++m_collector->m_scopeDepth;
+}
+
+
+ExpectationScope::~ExpectationScope()
+{
+  if ( m_collector != NULL )
+    --m_collector->m_scopeDepth;
+}
+
+
+CPPUNIT_NS_END
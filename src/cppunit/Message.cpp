@@ -1,3 +1,4 @@
+#include <cppunit/AllocationScope.h>
 #include <cppunit/Message.h>
 #include <stdexcept>
 
@@ -47,6 +48,32 @@ Message::Message( const std::string &shortDescription,
   addDetail( detail1, detail2, detail3 );
 }
 
+
+Message::Message( const char *shortDescription )
+{
+  AllocationCountingPause pause;
+  m_shortDescription = shortDescription;
+}
+
+
+Message::Message( const char *shortDescription,
+                  const char *detail1 )
+{
+  AllocationCountingPause pause;
+  m_shortDescription = shortDescription;
+  addDetail( detail1 );
+}
+
+
+Message::Message( const char *shortDescription,
+                  const char *detail1,
+                  const std::string &detail2 )
+{
+  AllocationCountingPause pause;
+  m_shortDescription = shortDescription;
+  addDetail( detail1, detail2 );
+}
+
 Message &
 Message::operator =( const Message &other )
 {
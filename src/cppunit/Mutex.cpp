@@ -0,0 +1,106 @@
+#include <cppunit/Mutex.h>
+
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+#include <pthread.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN 
+#define NOGDI
+#define NOUSER
+#define NOKERNEL
+#define NOSOUND
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+
+CPPUNIT_NS_BEGIN
+
+
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+
+Mutex::Mutex()
+    : m_handle( new pthread_mutex_t )
+{
+  ::pthread_mutex_init( (pthread_mutex_t *)m_handle, NULL );
+}
+
+
+Mutex::~Mutex()
+{
+  ::pthread_mutex_destroy( (pthread_mutex_t *)m_handle );
+  delete (pthread_mutex_t *)m_handle;
+}
+
+
+void 
+Mutex::lock()
+{
+  ::pthread_mutex_lock( (pthread_mutex_t *)m_handle );
+}
+
+
+void 
+Mutex::unlock()
+{
+  ::pthread_mutex_unlock( (pthread_mutex_t *)m_handle );
+}
+
+
+#elif defined(_WIN32)
+
+Mutex::Mutex()
+    : m_handle( new CRITICAL_SECTION )
+{
+  ::InitializeCriticalSection( (CRITICAL_SECTION *)m_handle );
+}
+
+
+Mutex::~Mutex()
+{
+  ::DeleteCriticalSection( (CRITICAL_SECTION *)m_handle );
+  delete (CRITICAL_SECTION *)m_handle;
+}
+
+
+void 
+Mutex::lock()
+{
+  ::EnterCriticalSection( (CRITICAL_SECTION *)m_handle );
+}
+
+
+void 
+Mutex::unlock()
+{
+  ::LeaveCriticalSection( (CRITICAL_SECTION *)m_handle );
+}
+
+
+#else   // no thread support
+
+Mutex::Mutex()
+    : m_handle( NULL )
+{
+}
+
+
+Mutex::~Mutex()
+{
+}
+
+
+void 
+Mutex::lock()
+{
+}
+
+
+void 
+Mutex::unlock()
+{
+}
+
+#endif
+
+
+CPPUNIT_NS_END
@@ -0,0 +1,271 @@
+#include <cppunit/Exception.h>
+#include <cppunit/Message.h>
+#include <cppunit/ParameterizedTestCase.h>
+#include <cppunit/TestCase.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/tools/StringTools.h>
+#include <memory>
+#include <stdexcept>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Test case of a row of a ParameterizedTest (Implementation).
+ */
+class ParameterizedRowTest : public TestCase
+{
+public:
+  ParameterizedRowTest( const ParameterizedTest &parent,
+                        int rowIndex )
+      : TestCase( makeName( parent, rowIndex ) )
+      , m_parent( parent )
+      , m_rowIndex( rowIndex )
+      , m_fixture( NULL )
+  {
+  }
+
+  ~ParameterizedRowTest()
+  {
+    delete m_fixture;
+  }
+
+  void setUp()
+  {
+    m_fixture = m_parent.makeFixture();
+    m_fixture->setUp();
+  }
+
+  void runTest()
+  {
+    std::string error = m_parent.getTableError();
+    if ( !error.empty() )
+      throw Exception( Message( "can not read test data", error ) );
+
+    TestDataRow row;
+    m_parent.getTable().getRow( m_rowIndex, row );
+    m_parent.runRow( m_fixture, row );
+  }
+
+  void tearDown()
+  {
+    std::auto_ptr<TestFixture> fixture( m_fixture );
+    m_fixture = NULL;
+    if ( fixture.get() != NULL )
+      fixture->tearDown();
+  }
+
+private:
+  /*! Returns the name of the parent followed by the key or index of the
+   * row.
+   */
+  static std::string makeName( const ParameterizedTest &parent,
+                               int rowIndex )
+  {
+    return parent.getNameRef() + "[" + getRowKey( parent, rowIndex ) + "]";
+  }
+
+  static std::string getRowKey( const ParameterizedTest &parent,
+                                int rowIndex )
+  {
+    if ( parent.getTableError().empty() )
+    {
+      try
+      {
+        TestDataRow row;
+        parent.getTable().getRow( rowIndex, row );
+        if ( !row.m_key.empty() )
+          return row.m_key;
+      }
+      catch ( std::exception & )
+      {
+        // reported when the test is run
+      }
+    }
+    return StringTools::toString( rowIndex );
+  }
+
+  /// Prevents the use of the copy constructor.
+  ParameterizedRowTest( const ParameterizedRowTest &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const ParameterizedRowTest &copy );
+
+private:
+  const ParameterizedTest &m_parent;
+  int m_rowIndex;
+  TestFixture *m_fixture;
+};
+
+
+/*! \brief Shard of the parameterized tests constructed next (Implementation).
+ */
+static int defaultShardIndex = 0;
+static int defaultShardCount = 1;
+
+
+static void
+checkShard( int shardIndex,
+            int shardCount )
+{
+  if ( shardCount <= 0  ||  shardIndex < 0  ||  shardIndex >= shardCount )
+    throw std::invalid_argument( "invalid test data shard " +
+                                 StringTools::toString( shardIndex ) + "/" +
+                                 StringTools::toString( shardCount ) );
+}
+
+
+ParameterizedTest::ParameterizedTest( const std::string &name,
+                                      TestDataTable *table )
+    : m_name( name )
+    , m_table( table )
+    , m_shardIndex( defaultShardIndex )
+    , m_shardCount( defaultShardCount )
+    , m_childCount( -1 )
+{
+}
+
+
+ParameterizedTest::~ParameterizedTest()
+{
+  for ( RowTests::iterator it = m_rowTests.begin(); it != m_rowTests.end(); ++it )
+    delete *it;
+  delete m_table;
+}
+
+
+void
+ParameterizedTest::run( TestResult *result )
+{
+  result->startSuite( this );
+
+  int childCount = getChildTestCount();
+  for ( int index = 0; index < childCount; ++index )
+  {
+    if ( result->shouldStop() )
+      break;
+    getChildTestAt( index )->run( result );
+  }
+
+  result->endSuite( this );
+}
+
+
+int
+ParameterizedTest::countTestCases() const
+{
+  return getChildTestCount();
+}
+
+
+int
+ParameterizedTest::getChildTestCount() const
+{
+  loadTable();
+  return m_childCount;
+}
+
+
+std::string
+ParameterizedTest::getName() const
+{
+  return m_name;
+}
+
+
+const std::string &
+ParameterizedTest::getNameRef() const
+{
+  return m_name;
+}
+
+
+bool
+ParameterizedTest::canBeFlattened() const
+{
+  return true;
+}
+
+
+void
+ParameterizedTest::setShard( int shardIndex,
+                             int shardCount )
+{
+  checkShard( shardIndex, shardCount );
+  if ( m_childCount >= 0 )
+    throw std::logic_error( "ParameterizedTest::setShard(): rows already loaded" );
+  m_shardIndex = shardIndex;
+  m_shardCount = shardCount;
+}
+
+
+void
+ParameterizedTest::setDefaultShard( int shardIndex,
+                                    int shardCount )
+{
+  checkShard( shardIndex, shardCount );
+  defaultShardIndex = shardIndex;
+  defaultShardCount = shardCount;
+}
+
+
+TestDataTable &
+ParameterizedTest::getTable() const
+{
+  return *m_table;
+}
+
+
+int
+ParameterizedTest::getRowIndex( int childIndex ) const
+{
+  return m_shardIndex + childIndex * m_shardCount;
+}
+
+
+std::string
+ParameterizedTest::getTableError() const
+{
+  loadTable();
+  return m_tableError;
+}
+
+
+Test *
+ParameterizedTest::doGetChildTestAt( int index ) const
+{
+  ParameterizedTest *mutableThis = CPPUNIT_CONST_CAST( ParameterizedTest *, this );
+  Test *&test = mutableThis->m_rowTests[ index ];
+  if ( test == NULL )
+    test = new ParameterizedRowTest( *this, getRowIndex( index ) );
+  return test;
+}
+
+
+void
+ParameterizedTest::loadTable() const
+{
+  if ( m_childCount >= 0 )
+    return;
+
+  ParameterizedTest *mutableThis = CPPUNIT_CONST_CAST( ParameterizedTest *, this );
+  int childCount;
+  try
+  {
+    int rowCount = m_table->getRowCount();
+    childCount = rowCount > m_shardIndex
+        ? (rowCount - m_shardIndex - 1) / m_shardCount + 1
+        : 0;
+  }
+  catch ( std::exception &e )
+  {
+    mutableThis->m_tableError = e.what();
+    childCount = 1;
+  }
+
+  mutableThis->m_rowTests.resize( childCount, (Test *)NULL );
+  mutableThis->m_childCount = childCount;
+}
+
+
+CPPUNIT_NS_END
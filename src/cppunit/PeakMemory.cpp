@@ -0,0 +1,101 @@
+#include <cppunit/tools/PeakMemory.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CPPUNIT_HAVE_SYS_RESOURCE_H)
+#include <sys/resource.h>
+#endif
+
+
+CPPUNIT_NS_BEGIN
+
+
+#if defined(__linux__)
+
+/*! \brief Reads a field of /proc/self/status given in kilobytes, such as
+ *         "VmHWM" (Implementation).
+ * \return Value of the field, or -1 if it can not be read.
+ */
+static long
+readStatusKilobytes( const char *field )
+{
+  FILE *file = ::fopen( "/proc/self/status", "r" );
+  if ( file == NULL )
+    return -1;
+
+  long kilobytes = -1;
+  size_t fieldLength = ::strlen( field );
+  char line[256];
+  while ( ::fgets( line, sizeof(line), file ) != NULL )
+  {
+    if ( ::strncmp( line, field, fieldLength ) == 0  &&  
+         line[ fieldLength ] == ':' )
+    {
+      // "VmHWM:     1688 kB"
+      kilobytes = ::atol( line + fieldLength + 1 );
+      break;
+    }
+  }
+
+  ::fclose( file );
+  return kilobytes;
+}
+
+#endif  // defined(__linux__)
+
+
+bool 
+PeakMemory::reset()
+{
+#if defined(__linux__)
+  FILE *file = ::fopen( "/proc/self/clear_refs", "w" );
+  if ( file == NULL )
+    return false;
+
+  // "5" resets the peak resident set size to the current one (Linux 4.0).
+  bool isWritten = ::fputs( "5", file ) >= 0;
+  return ::fclose( file ) == 0  &&  isWritten;
+#else
+  return false;
+#endif
+}
+
+
+long 
+PeakMemory::kilobytes()
+{
+#if defined(__linux__)
+  long kilobytes = readStatusKilobytes( "VmHWM" );
+  if ( kilobytes >= 0 )
+    return kilobytes;
+#endif
+
+#if defined(CPPUNIT_HAVE_SYS_RESOURCE_H)
+  struct rusage usage;
+  if ( ::getrusage( RUSAGE_SELF, &usage ) == 0 )
+  {
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024;    // In bytes on Mac OS X.
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+
+  return -1;
+}
+
+
+long 
+PeakMemory::addressSpaceKilobytes()
+{
+#if defined(__linux__)
+  return readStatusKilobytes( "VmSize" );
+#else
+  return -1;
+#endif
+}
+
+
+CPPUNIT_NS_END
@@ -0,0 +1,61 @@
+#include <cppunit/PeakMemoryXmlHook.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/portability/Stream.h>
+#include <cppunit/tools/XmlElement.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+PeakMemoryXmlHook::PeakMemoryXmlHook( TestResultCollector *result )
+    : m_result( result )
+{
+}
+
+
+PeakMemoryXmlHook::~PeakMemoryXmlHook()
+{
+}
+
+
+void 
+PeakMemoryXmlHook::failTestAdded( XmlDocument *document,
+                                  XmlElement *testElement,
+                                  Test *test,
+                                  TestFailure * )
+{
+  successfulTestAdded( document, testElement, test );
+}
+
+
+void 
+PeakMemoryXmlHook::successfulTestAdded( XmlDocument *,
+                                        XmlElement *testElement,
+                                        Test *test )
+{
+  addPeak( testElement, m_result->peakMemory( test ) );
+}
+
+
+void 
+PeakMemoryXmlHook::statisticsAdded( XmlDocument *,
+                                    XmlElement *statisticsElement )
+{
+  addPeak( statisticsElement, m_result->peakMemory() );
+}
+
+
+void 
+PeakMemoryXmlHook::addPeak( XmlElement *element,
+                            long peakKilobytes )
+{
+  if ( peakKilobytes < 0 )
+    return;
+
+  OStringStream peak;
+  peak  <<  peakKilobytes;
+  element->addElement( new XmlElement( "PeakMemoryKilobytes", peak.str() ) );
+}
+
+
+CPPUNIT_NS_END
@@ -5,13 +5,135 @@
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/plugin/PlugInManager.h>
 #include <cppunit/plugin/TestPlugIn.h>
+#include <cppunit/Mutex.h>
 #include <cppunit/plugin/DynamicLibraryManager.h>
+#include <cppunit/plugin/DynamicLibraryManagerException.h>
+#include "Thread.h"
 
 
 CPPUNIT_NS_BEGIN
 
 
+/*! Opens the library of a plug-in and returns its interface.
+ * \exception DynamicLibraryManagerException is thrown if an error occurs
+ *            during loading. The library is then released.
+ */
+static CppUnitTestPlugIn *
+openPlugIn( const std::string &libraryFileName,
+            DynamicLibraryManager::SymbolResolution symbolResolution,
+            DynamicLibraryManager *&manager )
+{
+  manager = new DynamicLibraryManager( libraryFileName, symbolResolution );
+  try
+  {
+    TestPlugInSignature plug = (TestPlugInSignature)manager->findSymbol( 
+          CPPUNIT_STRINGIZE( CPPUNIT_PLUGIN_EXPORTED_NAME ) );
+    return (*plug)();
+  }
+  catch ( ... )
+  {
+    delete manager;
+    manager = NULL;
+    throw;
+  }
+}
+
+
+/*! \brief Libraries opened by PlugInManager::loadConcurrently() (Implementation).
+ *
+ * Each library is opened by a single thread, which only writes the elements
+ * of the library index it took from the queue.
+ */
+class PlugInOpeningQueue
+{
+public:
+  PlugInOpeningQueue( const CppUnitVector<std::string> &libraryFileNames,
+                      DynamicLibraryManager::SymbolResolution symbolResolution )
+      : m_libraryFileNames( libraryFileNames )
+      , m_symbolResolution( symbolResolution )
+      , m_managers( libraryFileNames.size(), (DynamicLibraryManager *)NULL )
+      , m_interfaces( libraryFileNames.size(), (CppUnitTestPlugIn *)NULL )
+      , m_openTimes( libraryFileNames.size(), 0.0 )
+      , m_failures( libraryFileNames.size(), (DynamicLibraryManagerException *)NULL )
+      , m_nextIndex( 0 )
+  {
+  }
+
+  ~PlugInOpeningQueue()
+  {
+    for ( unsigned int index = 0; index < m_failures.size(); ++index )
+      delete m_failures[ index ];
+  }
+
+  /// Returns the index of the next library to open, or -1 if all are taken.
+  int takeNextIndex()
+  {
+    MutexLock lock( m_mutex );
+    if ( m_nextIndex >= int(m_libraryFileNames.size()) )
+      return -1;
+    return m_nextIndex++;
+  }
+
+  void open( int index )
+  {
+    double startTime = Thread::currentTime();
+    try
+    {
+      m_interfaces[ index ] = openPlugIn( m_libraryFileNames[ index ],
+                                          m_symbolResolution,
+                                          m_managers[ index ] );
+    }
+    catch ( DynamicLibraryManagerException &e )
+    {
+      m_failures[ index ] = new DynamicLibraryManagerException( e );
+    }
+    catch ( ... )
+    {
+      m_failures[ index ] = new DynamicLibraryManagerException( 
+                                    m_libraryFileNames[ index ],
+                                    "unexpected exception",
+                                    DynamicLibraryManagerException::loadingFailed );
+    }
+    m_openTimes[ index ] = Thread::currentTime() - startTime;
+  }
+
+  Mutex m_mutex;
+  const CppUnitVector<std::string> &m_libraryFileNames;
+  const DynamicLibraryManager::SymbolResolution m_symbolResolution;
+  CppUnitVector<DynamicLibraryManager *> m_managers;
+  CppUnitVector<CppUnitTestPlugIn *> m_interfaces;
+  CppUnitVector<double> m_openTimes;
+  CppUnitVector<DynamicLibraryManagerException *> m_failures;
+
+private:
+  int m_nextIndex;
+};
+
+
+/*! \brief Thread that opens libraries until the queue is empty (Implementation).
+ */
+class PlugInOpeningThread : public Thread
+{
+public:
+  PlugInOpeningThread( PlugInOpeningQueue &queue )
+      : m_queue( queue )
+  {
+  }
+
+  void run()
+  {
+    int index;
+    while ( (index = m_queue.takeNextIndex()) >= 0 )
+      m_queue.open( index );
+  }
+
+private:
+  PlugInOpeningQueue &m_queue;
+};
+
+
 PlugInManager::PlugInManager()
+    : m_symbolResolution( DynamicLibraryManager::resolveOnLoad )
 {
 }
 
@@ -29,15 +151,114 @@ PlugInManager::load( const std::string &libraryFileName,
 {
   PlugInInfo info;
   info.m_fileName = libraryFileName;
-  info.m_manager = new DynamicLibraryManager( libraryFileName );
+  double startTime = Thread::currentTime();
+  info.m_interface = openPlugIn( libraryFileName, m_symbolResolution, info.m_manager );
+  info.m_openTime = Thread::currentTime() - startTime;
+
+  initialize( info, parameters );
+}
 
-  TestPlugInSignature plug = (TestPlugInSignature)info.m_manager->findSymbol( 
-        CPPUNIT_STRINGIZE( CPPUNIT_PLUGIN_EXPORTED_NAME ) );
-  info.m_interface = (*plug)();
 
-  m_plugIns.push_back( info );
-  
-  info.m_interface->initialize( &TestFactoryRegistry::getRegistry(), parameters );
+void
+PlugInManager::loadConcurrently( const CppUnitVector<std::string> &libraryFileNames,
+                                 const CppUnitVector<PlugInParameters> &parameters,
+                                 int threadCount )
+{
+  PlugInOpeningQueue queue( libraryFileNames, m_symbolResolution );
+
+  // The calling thread opens libraries too.
+  CppUnitVector<PlugInOpeningThread *> threads;
+  for ( int threadIndex = 1; 
+        threadIndex < threadCount  &&  threadIndex < int(libraryFileNames.size());
+        ++threadIndex )
+  {
+    PlugInOpeningThread *thread = new PlugInOpeningThread( queue );
+    if ( thread->start() )
+      threads.push_back( thread );
+    else
+      delete thread;
+  }
+
+  PlugInOpeningThread( queue ).run();
+
+  for ( unsigned int joinedIndex = 0; joinedIndex < threads.size(); ++joinedIndex )
+  {
+    threads[ joinedIndex ]->join();
+    delete threads[ joinedIndex ];
+  }
+
+  unsigned int index = 0;
+  try
+  {
+    for ( ; index < libraryFileNames.size(); ++index )
+    {
+      if ( queue.m_failures[ index ] != NULL )
+        throw DynamicLibraryManagerException( *queue.m_failures[ index ] );
+
+      PlugInInfo info;
+      info.m_fileName = libraryFileNames[ index ];
+      info.m_manager = queue.m_managers[ index ];
+      info.m_interface = queue.m_interfaces[ index ];
+      info.m_openTime = queue.m_openTimes[ index ];
+      queue.m_managers[ index ] = NULL;
+      initialize( info, index < parameters.size() ? parameters[ index ]
+                                                  : PlugInParameters() );
+    }
+  }
+  catch ( ... )
+  {
+    for ( ; index < libraryFileNames.size(); ++index )
+      delete queue.m_managers[ index ];
+    throw;
+  }
+}
+
+
+void
+PlugInManager::setSymbolResolution( DynamicLibraryManager::SymbolResolution symbolResolution )
+{
+  m_symbolResolution = symbolResolution;
+}
+
+
+int
+PlugInManager::getPlugInCount() const
+{
+  return m_plugIns.size();
+}
+
+
+std::string
+PlugInManager::getPlugInFileNameAt( int index ) const
+{
+  return m_plugIns[ index ].m_fileName;
+}
+
+
+double
+PlugInManager::getOpenTimeAt( int index ) const
+{
+  return m_plugIns[ index ].m_openTime;
+}
+
+
+double
+PlugInManager::getInitializeTimeAt( int index ) const
+{
+  return m_plugIns[ index ].m_initializeTime;
+}
+
+
+void
+PlugInManager::initialize( PlugInInfo &plugIn,
+                           const PlugInParameters &parameters )
+{
+  plugIn.m_initializeTime = 0;
+  m_plugIns.push_back( plugIn );
+
+  double startTime = Thread::currentTime();
+  plugIn.m_interface->initialize( &TestFactoryRegistry::getRegistry(), parameters );
+  m_plugIns.back().m_initializeTime = Thread::currentTime() - startTime;
 }
 
 
@@ -0,0 +1,533 @@
+#include <cppunit/RangeAssert.h>
+#include <cppunit/portability/FloatingPoint.h>
+#include <cppunit/portability/Stream.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+CPPUNIT_NS_BEGIN
+
+
+/// Number of elements compared at once by memcmp().
+static const size_t bitwiseBlockSize = 4096;
+
+/// Maximum length of the string representation of an element in a window.
+static const size_t maximumElementLength = 40;
+
+
+RangeDifference::RangeDifference()
+    : m_expectedSize( 0 )
+    , m_actualSize( 0 )
+    , m_mismatchCount( 0 )
+    , m_firstMismatch( 0 )
+{
+}
+
+
+void
+RangeDifference::addMismatch( size_t index )
+{
+  if ( m_mismatchCount++ == 0 )
+    m_firstMismatch = index;
+}
+
+
+bool
+RangeDifference::isEqual() const
+{
+  return m_mismatchCount == 0  &&  m_expectedSize == m_actualSize;
+}
+
+
+size_t
+RangeDifference::firstDifference() const
+{
+  if ( m_mismatchCount > 0 )
+    return m_firstMismatch;
+  return m_expectedSize < m_actualSize ? m_expectedSize : m_actualSize;
+}
+
+
+size_t
+RangeDifference::windowBegin() const
+{
+  size_t first = firstDifference();
+  return first < size_t(contextSize) ? 0 : first - contextSize;
+}
+
+
+size_t
+RangeDifference::windowEnd() const
+{
+  return firstDifference() + contextSize + 1;
+}
+
+
+void
+findBitwiseMismatches( const void *expected,
+                       const void *actual,
+                       size_t count,
+                       size_t elementSize,
+                       RangeDifference &difference )
+{
+  const char *expectedBytes = (const char *)expected;
+  const char *actualBytes = (const char *)actual;
+  for ( size_t block = 0; block < count; block += bitwiseBlockSize )
+  {
+    size_t blockCount = count - block < bitwiseBlockSize ? count - block
+                                                         : bitwiseBlockSize;
+    const char *expectedBlock = expectedBytes + block * elementSize;
+    const char *actualBlock = actualBytes + block * elementSize;
+    if ( ::memcmp( expectedBlock, actualBlock, blockCount * elementSize ) == 0 )
+      continue;
+
+    for ( size_t index = 0; index < blockCount; ++index )
+    {
+      if ( ::memcmp( expectedBlock + index * elementSize,
+                     actualBlock + index * elementSize,
+                     elementSize ) != 0 )
+        difference.addMismatch( block + index );
+    }
+  }
+}
+
+
+void
+failRangesNotEqual( const RangeDifference &difference,
+                    const std::string &expectedWindow,
+                    const std::string &actualWindow,
+                    const std::string &elementDiff,
+                    const SourceLine &sourceLine,
+                    const std::string &message,
+                    const std::string &shortDescription )
+{
+  OStringStream sizes;
+  sizes  <<  "Expected size: "  <<  difference.m_expectedSize;
+  Message diagnostic( shortDescription, sizes.str() );
+
+  OStringStream actualSize;
+  actualSize  <<  "Actual size  : "  <<  difference.m_actualSize;
+  diagnostic.addDetail( actualSize.str() );
+
+  if ( difference.m_mismatchCount > 0 )
+  {
+    OStringStream mismatches;
+    mismatches  <<  "Mismatches   : "  <<  difference.m_mismatchCount
+                <<  ", first at index "  <<  difference.m_firstMismatch;
+    diagnostic.addDetail( mismatches.str() );
+  }
+
+  size_t size = difference.m_expectedSize > difference.m_actualSize
+                    ? difference.m_expectedSize : difference.m_actualSize;
+  size_t windowEnd = difference.windowEnd() < size ? difference.windowEnd() : size;
+  OStringStream window;
+  window  <<  "["  <<  difference.windowBegin()  <<  ".."  <<  windowEnd - 1  <<  "]: ";
+  diagnostic.addDetail( "Expected " + window.str() + expectedWindow );
+  diagnostic.addDetail( "Actual   " + window.str() + actualWindow );
+  if ( !elementDiff.empty() )
+    diagnostic.addDetail( elementDiff );
+
+  if ( !message.empty() )
+    diagnostic.addDetail( message );
+  Asserter::fail( diagnostic, sourceLine );
+}
+
+
+void
+appendRangeWindowElement( std::string &window,
+                          const std::string &element,
+                          bool isFirstDifference )
+{
+  if ( !window.empty() )
+    window += ", ";
+  if ( isFirstDifference )
+    window += "[";
+
+  if ( element.length() <= maximumElementLength )
+    window += element;
+  else
+    window += element.substr( 0, maximumElementLength ) + "...";
+
+  if ( isFirstDifference )
+    window += "]";
+}
+
+
+void
+assertBuffersEqual( const void *expected,
+                    const void *actual,
+                    size_t size,
+                    SourceLine sourceLine,
+                    const std::string &message )
+{
+  Asserter::countAssertion();
+  RangeDifference difference;
+  difference.m_expectedSize = size;
+  difference.m_actualSize = size;
+  findBitwiseMismatches( expected, actual, size, 1, difference );
+  if ( difference.isEqual() )
+    return;
+
+  const unsigned char *buffers[2] = { (const unsigned char *)expected,
+                                      (const unsigned char *)actual };
+  std::string windows[2];
+  for ( int buffer = 0; buffer < 2; ++buffer )
+  {
+    for ( size_t index = difference.windowBegin();
+          index < difference.windowEnd()  &&  index < size;
+          ++index )
+    {
+      static const char digits[] = "0123456789abcdef";
+      unsigned char byte = buffers[buffer][index];
+      std::string hexadecimal = "0x";
+      hexadecimal += digits[ byte >> 4 ];
+      hexadecimal += digits[ byte & 0xf ];
+      appendRangeWindowElement( windows[buffer],
+                                hexadecimal,
+                                index == difference.firstDifference() );
+    }
+  }
+
+  failRangesNotEqual( difference, windows[0], windows[1], "", sourceLine, message,
+                      "buffers not equal" );
+}
+
+
+Tolerance::Tolerance( Mode mode, 
+                      double maximumError )
+    : m_mode( mode )
+    , m_maximumError( maximumError )
+    , m_nanPolicy( nanIsNeverNear )
+    , m_infinityPolicy( infinityIsNearSameInfinity )
+{
+}
+
+
+Tolerance 
+Tolerance::absolute( double maximumError )
+{
+  return Tolerance( absoluteError, maximumError );
+}
+
+
+Tolerance 
+Tolerance::relative( double maximumError )
+{
+  return Tolerance( relativeError, maximumError );
+}
+
+
+Tolerance 
+Tolerance::ulps( double maximumUlps )
+{
+  return Tolerance( ulpError, maximumUlps );
+}
+
+
+Tolerance &
+Tolerance::setNanPolicy( NanPolicy policy )
+{
+  m_nanPolicy = policy;
+  return *this;
+}
+
+
+Tolerance &
+Tolerance::setInfinityPolicy( InfinityPolicy policy )
+{
+  m_infinityPolicy = policy;
+  return *this;
+}
+
+
+Tolerance::Mode 
+Tolerance::mode() const
+{
+  return m_mode;
+}
+
+
+double 
+Tolerance::maximumError() const
+{
+  return m_maximumError;
+}
+
+
+Tolerance::NanPolicy 
+Tolerance::nanPolicy() const
+{
+  return m_nanPolicy;
+}
+
+
+Tolerance::InfinityPolicy 
+Tolerance::infinityPolicy() const
+{
+  return m_infinityPolicy;
+}
+
+
+std::string 
+Tolerance::toString() const
+{
+  std::string maximumError = assertion_traits<double>::toString( m_maximumError );
+  std::string description;
+  if ( m_mode == absoluteError )
+    description = "absolute " + maximumError;
+  else if ( m_mode == relativeError )
+    description = "relative " + maximumError;
+  else
+    description = maximumError + " ulps";
+
+  if ( m_nanPolicy == nanIsNearNan )
+    description += ", NaN near NaN";
+  if ( m_infinityPolicy == infinityIsNeverNear )
+    description += ", infinities never near";
+  return description;
+}
+
+
+/*! \brief Errors found by assertArraysNear() (Implementation).
+ */
+struct ArrayErrors
+{
+  /// Upper bound of the buckets of the histogram, in multiples of the maximum error.
+  enum { bucketCount = 5 };
+
+  ArrayErrors()
+      : m_outCount( 0 )
+      , m_firstOut( 0 )
+      , m_maximumError( 0 )
+      , m_maximumErrorIndex( 0 )
+      , m_nonFiniteCount( 0 )
+  {
+    for ( int bucket = 0; bucket < bucketCount; ++bucket )
+      m_histogram[ bucket ] = 0;
+  }
+
+  size_t m_outCount;
+  size_t m_firstOut;
+  double m_maximumError;
+  size_t m_maximumErrorIndex;
+  size_t m_histogram[ bucketCount ];
+  size_t m_nonFiniteCount;
+};
+
+
+/// Absolute error (Implementation).
+struct AbsoluteErrorMeasure
+{
+  double operator()( double expected, double actual ) const
+  {
+    return fabs( expected - actual );
+  }
+};
+
+
+/// Relative error (Implementation).
+struct RelativeErrorMeasure
+{
+  double operator()( double expected, double actual ) const
+  {
+    double magnitude = fabs( expected ) > fabs( actual ) ? fabs( expected ) 
+                                                         : fabs( actual );
+    return magnitude == 0 ? 0 : fabs( expected - actual ) / magnitude;
+  }
+};
+
+
+/// Error in units in the last place of the larger value (Implementation).
+struct UlpErrorMeasure
+{
+  UlpErrorMeasure( int mantissaDigits,
+                   int minimumExponent )
+      : m_mantissaDigits( mantissaDigits )
+      , m_minimumExponent( minimumExponent )
+  {
+  }
+
+  double operator()( double expected, double actual ) const
+  {
+    if ( expected == actual )
+      return 0;
+
+    double magnitude = fabs( expected ) > fabs( actual ) ? fabs( expected ) 
+                                                         : fabs( actual );
+    int exponent;
+    ::frexp( magnitude, &exponent );
+    if ( exponent < m_minimumExponent )   // subnormal values
+      exponent = m_minimumExponent;
+    return fabs( expected - actual ) / ::ldexp( 1.0, exponent - m_mantissaDigits );
+  }
+
+  int m_mantissaDigits;
+  int m_minimumExponent;
+};
+
+
+/*! Indicates if two values, one of which is not finite, are near.
+ */
+static bool
+areNonFiniteNear( double expected,
+                  double actual,
+                  const Tolerance &tolerance )
+{
+  if ( floatingPointIsUnordered( expected )  ||  floatingPointIsUnordered( actual ) )
+    return tolerance.nanPolicy() == Tolerance::nanIsNearNan  &&
+           floatingPointIsUnordered( expected )  &&  
+           floatingPointIsUnordered( actual );
+
+  return tolerance.infinityPolicy() == Tolerance::infinityIsNearSameInfinity  &&
+         expected == actual;
+}
+
+
+/*! Measures the error of each value and records the errors out of tolerance.
+ *
+ * The loop only branches out for the values out of tolerance, and for the
+ * rare new maximum error, so that it runs at the speed of the error measure.
+ */
+template <class Real, class ErrorMeasure>
+static void
+findArrayErrors( const Real *expected,
+                 const Real *actual,
+                 size_t count,
+                 const Tolerance &tolerance,
+                 ErrorMeasure measure,
+                 ArrayErrors &errors )
+{
+  static const double bucketLimits[ ArrayErrors::bucketCount - 1 ] = { 2, 10, 100, 1000 };
+  double maximumError = tolerance.maximumError();
+
+  for ( size_t index = 0; index < count; ++index )
+  {
+    double error = measure( expected[index], actual[index] );
+    if ( error > errors.m_maximumError  &&  floatingPointIsFinite( error ) )
+    {
+      errors.m_maximumError = error;
+      errors.m_maximumErrorIndex = index;
+    }
+
+    if ( error <= maximumError )
+      continue;
+
+    // Out of tolerance, or not finite (NaN is never lower than the maximum).
+    if ( !floatingPointIsFinite( expected[index] )  ||  
+         !floatingPointIsFinite( actual[index] ) )
+    {
+      if ( areNonFiniteNear( expected[index], actual[index], tolerance ) )
+        continue;
+      ++errors.m_nonFiniteCount;
+    }
+    else
+    {
+      int bucket = 0;
+      while ( bucket < ArrayErrors::bucketCount - 1  &&  
+              error > bucketLimits[ bucket ] * maximumError )
+        ++bucket;
+      ++errors.m_histogram[ bucket ];
+    }
+
+    if ( errors.m_outCount++ == 0 )
+      errors.m_firstOut = index;
+  }
+}
+
+
+/*! Describes the values of an element of the arrays.
+ */
+template <class Real>
+static std::string
+describeValues( const Real *expected,
+                const Real *actual,
+                size_t index )
+{
+  return "(expected " + assertion_traits<double>::toString( expected[index] ) +
+         ", actual " + assertion_traits<double>::toString( actual[index] ) + ")";
+}
+
+
+template <class Real>
+static void
+checkArraysNear( const Real *expected,
+                 const Real *actual,
+                 size_t count,
+                 const Tolerance &tolerance,
+                 int mantissaDigits,
+                 int minimumExponent,
+                 const SourceLine &sourceLine,
+                 const std::string &message )
+{
+  Asserter::countAssertion();
+  ArrayErrors errors;
+  if ( tolerance.mode() == Tolerance::absoluteError )
+    findArrayErrors( expected, actual, count, tolerance, AbsoluteErrorMeasure(), errors );
+  else if ( tolerance.mode() == Tolerance::relativeError )
+    findArrayErrors( expected, actual, count, tolerance, RelativeErrorMeasure(), errors );
+  else
+    findArrayErrors( expected, actual, count, tolerance, 
+                     UlpErrorMeasure( mantissaDigits, minimumExponent ), errors );
+
+  if ( errors.m_outCount == 0 )
+    return;
+
+  Message diagnostic( "arrays not near", "Tolerance       : " + tolerance.toString() );
+
+  OStringStream outOfTolerance;
+  outOfTolerance  <<  "Out of tolerance: "  <<  errors.m_outCount  <<  " of "  <<  count
+                  <<  ", first at index "  <<  errors.m_firstOut  <<  " "
+                  <<  describeValues( expected, actual, errors.m_firstOut );
+  diagnostic.addDetail( outOfTolerance.str() );
+
+  OStringStream maximumError;
+  maximumError  <<  "Maximum error   : "
+                <<  assertion_traits<double>::toString( errors.m_maximumError )
+                <<  " at index "  <<  errors.m_maximumErrorIndex  <<  " "
+                <<  describeValues( expected, actual, errors.m_maximumErrorIndex );
+  diagnostic.addDetail( maximumError.str() );
+
+  static const char *bucketNames[ ArrayErrors::bucketCount ] = 
+  { 
+    "1-2x", "2-10x", "10-100x", "100-1000x", ">1000x"
+  };
+  OStringStream histogram;
+  histogram  <<  "Error histogram : ";
+  for ( int bucket = 0; bucket < ArrayErrors::bucketCount; ++bucket )
+    histogram  <<  bucketNames[ bucket ]  <<  ": "  <<  errors.m_histogram[ bucket ]  <<  ", ";
+  histogram  <<  "not finite: "  <<  errors.m_nonFiniteCount;
+  diagnostic.addDetail( histogram.str() );
+
+  if ( !message.empty() )
+    diagnostic.addDetail( message );
+  Asserter::fail( diagnostic, sourceLine );
+}
+
+
+void 
+assertArraysNear( const double *expected,
+                  const double *actual,
+                  size_t count,
+                  const Tolerance &tolerance,
+                  SourceLine sourceLine,
+                  const std::string &message )
+{
+  checkArraysNear( expected, actual, count, tolerance, 
+                   DBL_MANT_DIG, DBL_MIN_EXP, sourceLine, message );
+}
+
+
+void 
+assertArraysNear( const float *expected,
+                  const float *actual,
+                  size_t count,
+                  const Tolerance &tolerance,
+                  SourceLine sourceLine,
+                  const std::string &message )
+{
+  checkArraysNear( expected, actual, count, tolerance, 
+                   FLT_MANT_DIG, FLT_MIN_EXP, sourceLine, message );
+}
+
+
+CPPUNIT_NS_END
@@ -0,0 +1,579 @@
+#include <cppunit/tools/BoundedText.h>
+#include <cppunit/tools/SequenceDiff.h>
+#include <cppunit/portability/Stream.h>
+#include <stdexcept>
+#include <string.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+DiffSequences::~DiffSequences()
+{
+}
+
+
+SequenceDiff::SequenceDiff( int maximumEditDistance,
+                            long maximumComparisons )
+    : m_maximumEditDistance( maximumEditDistance )
+    , m_maximumComparisons( maximumComparisons )
+    , m_sequences( 0 )
+    , m_comparisonCount( 0 )
+    , m_hasGivenUp( false )
+    , m_expectedCount( 0 )
+    , m_commonHeadLength( 0 )
+    , m_removalCount( 0 )
+{
+}
+
+
+SequenceDiff::~SequenceDiff()
+{
+}
+
+
+bool
+SequenceDiff::compute( const DiffSequences &sequences,
+                       int expectedCount,
+                       int actualCount )
+{
+  m_sequences = &sequences;
+  m_comparisonCount = 0;
+  m_hasGivenUp = false;
+  m_expectedCount = expectedCount;
+  m_removalCount = 0;
+  m_edits.clear();
+
+  int left = 0;
+  int top = 0;
+  while ( left < expectedCount  &&  top < actualCount  &&
+          sequences.areEqual( left, top ) )
+    ++left, ++top;
+  m_commonHeadLength = left;
+
+  int right = expectedCount;
+  int bottom = actualCount;
+  while ( right > left  &&  bottom > top  &&
+          sequences.areEqual( right -1, bottom -1 ) )
+    --right, --bottom;
+
+  CppUnitVector<Point> path;
+  findPath( left, top, right, bottom, path );
+  if ( m_hasGivenUp )
+    return false;
+
+  addEdits( path );
+  return true;
+}
+
+
+int
+SequenceDiff::editCount() const
+{
+  return m_edits.size();
+}
+
+
+const SequenceDiff::Edit &
+SequenceDiff::editAt( int index ) const
+{
+  if ( index < 0  ||  index >= editCount() )
+    throw std::invalid_argument( "SequenceDiff::editAt() : invalid index" );
+  return m_edits[ index ];
+}
+
+
+int
+SequenceDiff::removalCount() const
+{
+  return m_removalCount;
+}
+
+
+int
+SequenceDiff::insertionCount() const
+{
+  return editCount() - m_removalCount;
+}
+
+
+int
+SequenceDiff::commonHeadLength() const
+{
+  return m_commonHeadLength;
+}
+
+
+/*! Finds the points of the shortest edit path of a box: the start and the
+ * end of the middle snake of each of its sub-boxes.
+ * \return \c false if the box is empty.
+ */
+bool
+SequenceDiff::findPath( int left, int top, int right, int bottom,
+                        CppUnitVector<Point> &path )
+{
+  Point start, finish;
+  if ( !findMiddleSnake( left, top, right, bottom, start, finish ) )
+    return false;
+
+  if ( !findPath( left, top, start.m_x, start.m_y, path ) )
+    path.push_back( start );
+  if ( !findPath( finish.m_x, finish.m_y, right, bottom, path ) )
+    path.push_back( finish );
+  return true;
+}
+
+
+/*! Finds the middle snake of the shortest edit path of a box by searching
+ * forward from its top left corner and backward from its bottom right
+ * corner until the paths overlap.
+ * \return \c false if the box is empty or if the search gave up.
+ */
+bool
+SequenceDiff::findMiddleSnake( int left, int top, int right, int bottom,
+                               Point &start, Point &finish )
+{
+  int width = right - left;
+  int height = bottom - top;
+  if ( m_hasGivenUp  ||  width + height == 0 )
+    return false;
+
+  int maximumD = (width + height + 1) / 2;
+  if ( maximumD > (m_maximumEditDistance + 1) / 2 + 1 )
+    maximumD = (m_maximumEditDistance + 1) / 2 + 1;
+
+  // Forward x and backward y of the furthest path on each diagonal, indexed
+  // from -maximumD-1 to maximumD+1.
+  int offset = maximumD + 1;
+  CppUnitVector<int> forward( 2 * maximumD + 3, 0 );
+  CppUnitVector<int> backward( 2 * maximumD + 3, 0 );
+  forward[ offset + 1 ] = left;
+  backward[ offset + 1 ] = bottom;
+  int delta = width - height;
+  bool isDeltaOdd = (delta & 1) != 0;
+
+  for ( int d = 0; d <= maximumD; ++d )
+  {
+    for ( int k = d; k >= -d; k -= 2 )
+    {
+      int x, previousX;
+      if ( k == -d  ||  (k != d  &&  forward[offset + k - 1] < forward[offset + k + 1]) )
+        previousX = x = forward[ offset + k + 1 ];
+      else
+      {
+        previousX = forward[ offset + k - 1 ];
+        x = previousX + 1;
+      }
+      int y = top + (x - left) - k;
+      int previousY = (d == 0  ||  x != previousX) ? y : y - 1;
+      while ( x < right  &&  y < bottom  &&  areEqual( x, y ) )
+        ++x, ++y;
+      forward[ offset + k ] = x;
+
+      int c = k - delta;
+      if ( isDeltaOdd  &&  c >= -(d - 1)  &&  c <= d - 1  &&
+           y >= backward[ offset + c ] )
+      {
+        start.m_x = previousX;
+        start.m_y = previousY;
+        finish.m_x = x;
+        finish.m_y = y;
+        return !m_hasGivenUp;
+      }
+    }
+
+    for ( int c = d; c >= -d; c -= 2 )
+    {
+      int y, previousY;
+      if ( c == -d  ||  (c != d  &&  backward[offset + c - 1] > backward[offset + c + 1]) )
+        previousY = y = backward[ offset + c + 1 ];
+      else
+      {
+        previousY = backward[ offset + c - 1 ];
+        y = previousY - 1;
+      }
+      int k = c + delta;
+      int x = left + (y - top) + k;
+      int previousX = (d == 0  ||  y != previousY) ? x : x + 1;
+      while ( x > left  &&  y > top  &&  areEqual( x - 1, y - 1 ) )
+        --x, --y;
+      backward[ offset + c ] = y;
+
+      if ( !isDeltaOdd  &&  k >= -d  &&  k <= d  &&  x <= forward[ offset + k ] )
+      {
+        start.m_x = x;
+        start.m_y = y;
+        finish.m_x = previousX;
+        finish.m_y = previousY;
+        return !m_hasGivenUp;
+      }
+    }
+
+    if ( m_hasGivenUp )
+      return false;
+  }
+
+  // The edit distance exceeds the maximum.
+  m_hasGivenUp = true;
+  return false;
+}
+
+
+bool
+SequenceDiff::areEqual( int expectedIndex, int actualIndex )
+{
+  if ( ++m_comparisonCount > m_maximumComparisons )
+  {
+    m_hasGivenUp = true;
+    return false;
+  }
+  return m_sequences->areEqual( expectedIndex, actualIndex );
+}
+
+
+void
+SequenceDiff::addEdit( EditKind kind, int expectedIndex, int actualIndex )
+{
+  Edit edit;
+  edit.m_kind = kind;
+  edit.m_expectedIndex = expectedIndex;
+  edit.m_actualIndex = actualIndex;
+  m_edits.push_back( edit );
+  if ( kind == removal )
+    ++m_removalCount;
+}
+
+
+/*! Converts the points of the path to edits. Consecutive points are linked
+ * by at most one removal or insertion, preceded or followed by a diagonal of
+ * equal elements.
+ */
+void
+SequenceDiff::addEdits( const CppUnitVector<Point> &path )
+{
+  for ( unsigned int index = 1; index < path.size(); ++index )
+  {
+    int x = path[ index - 1 ].m_x;
+    int y = path[ index - 1 ].m_y;
+    int endX = path[ index ].m_x;
+    int endY = path[ index ].m_y;
+    while ( x < endX  &&  y < endY  &&  m_sequences->areEqual( x, y ) )
+      ++x, ++y;
+
+    if ( endX - x > endY - y )
+      addEdit( removal, x, y );
+    else if ( endX - x < endY - y )
+      addEdit( insertion, x, y );
+  }
+}
+
+
+/*! \brief Accumulates the lines of a rendered diff (Implementation).
+ */
+class DiffLines
+{
+public:
+  DiffLines( bool joinElements )
+      : m_joinElements( joinElements )
+      , m_lineCount( 0 )
+      , m_prefix( 0 )
+      , m_line( 0 )
+  {
+  }
+
+  ~DiffLines()
+  {
+    delete m_line;
+  }
+
+  void addElement( char prefix, const std::string &element )
+  {
+    if ( !m_joinElements  ||  prefix != m_prefix )
+      endLine();
+    if ( m_line == 0 )
+    {
+      m_line = new BoundedText();
+      m_line->append( prefix );
+      m_prefix = prefix;
+    }
+    m_line->append( element.c_str(), element.length() );
+  }
+
+  void addHeader( const std::string &header )
+  {
+    endLine();
+    addLine( header );
+  }
+
+  void endLine()
+  {
+    if ( m_line != 0 )
+      addLine( m_line->str() );
+    delete m_line;
+    m_line = 0;
+    m_prefix = 0;
+  }
+
+  bool isFull() const
+  {
+    return m_lineCount >= SequenceDiff::maximumLineCount;
+  }
+
+  std::string str()
+  {
+    endLine();
+    return m_text;
+  }
+
+private:
+  void addLine( const std::string &line )
+  {
+    if ( isFull() )
+      return;
+    if ( !m_text.empty() )
+      m_text += '\n';
+    m_text += line;
+    if ( ++m_lineCount == SequenceDiff::maximumLineCount )
+      m_text += "\n...";
+  }
+
+  bool m_joinElements;
+  int m_lineCount;
+  char m_prefix;
+  BoundedText *m_line;
+  std::string m_text;
+};
+
+
+std::string
+SequenceDiff::render( const DiffSequences &sequences,
+                      bool joinElements ) const
+{
+  DiffLines lines( joinElements );
+  unsigned int editIndex = 0;
+  while ( editIndex < m_edits.size()  &&  !lines.isFull() )
+  {
+    // A hunk ends when the next edit is more than two contexts away.
+    unsigned int lastEditIndex = editIndex;
+    while ( lastEditIndex + 1 < m_edits.size() )
+    {
+      const Edit &last = m_edits[ lastEditIndex ];
+      int lastEnd = last.m_expectedIndex + (last.m_kind == removal ? 1 : 0);
+      if ( m_edits[ lastEditIndex + 1 ].m_expectedIndex - lastEnd > 2 * contextSize )
+        break;
+      ++lastEditIndex;
+    }
+
+    const Edit &first = m_edits[ editIndex ];
+    const Edit &last = m_edits[ lastEditIndex ];
+    int leadingCount = first.m_expectedIndex < contextSize ? first.m_expectedIndex
+                                                           : contextSize;
+    int expectedStart = first.m_expectedIndex - leadingCount;
+    int actualStart = first.m_actualIndex - leadingCount;
+    int expectedEnd = last.m_expectedIndex + (last.m_kind == removal ? 1 : 0);
+    int actualEnd = last.m_actualIndex + (last.m_kind == insertion ? 1 : 0);
+    int trailingCount = m_expectedCount - expectedEnd;
+    if ( trailingCount > contextSize )
+      trailingCount = contextSize;
+    expectedEnd += trailingCount;
+    actualEnd += trailingCount;
+
+    OStringStream header;
+    header  <<  "@@ -"  <<  expectedStart + 1  <<  ","  <<  expectedEnd - expectedStart
+            <<  " +"  <<  actualStart + 1  <<  ","  <<  actualEnd - actualStart  <<  " @@";
+    lines.addHeader( header.str() );
+
+    int expectedIndex = expectedStart;
+    int actualIndex = actualStart;
+    for ( ; editIndex <= lastEditIndex; ++editIndex )
+    {
+      const Edit &edit = m_edits[ editIndex ];
+      for ( ; expectedIndex < edit.m_expectedIndex; ++expectedIndex, ++actualIndex )
+        lines.addElement( ' ', sequences.expectedElement( expectedIndex ) );
+      if ( edit.m_kind == removal )
+        lines.addElement( '-', sequences.expectedElement( expectedIndex++ ) );
+      else
+        lines.addElement( '+', sequences.actualElement( actualIndex++ ) );
+    }
+    for ( ; expectedIndex < expectedEnd; ++expectedIndex )
+      lines.addElement( ' ', sequences.expectedElement( expectedIndex ) );
+  }
+
+  return lines.str();
+}
+
+
+/*! \brief Lines of two strings (Implementation).
+ *
+ * The lines are referenced by their offset in the strings, not copied.
+ */
+class StringLines : public DiffSequences
+{
+public:
+  StringLines( const std::string &expected,
+               const std::string &actual )
+      : m_expected( expected )
+      , m_actual( actual )
+  {
+    split( expected, m_expectedStarts );
+    split( actual, m_actualStarts );
+  }
+
+  int expectedCount() const
+  {
+    return m_expectedStarts.size() - 1;
+  }
+
+  int actualCount() const
+  {
+    return m_actualStarts.size() - 1;
+  }
+
+  bool areEqual( int expectedIndex, int actualIndex ) const
+  {
+    size_t length = lineLength( m_expectedStarts, expectedIndex );
+    return length == lineLength( m_actualStarts, actualIndex )  &&
+           ::memcmp( m_expected.data() + m_expectedStarts[ expectedIndex ],
+                     m_actual.data() + m_actualStarts[ actualIndex ],
+                     length ) == 0;
+  }
+
+  std::string expectedElement( int index ) const
+  {
+    return line( m_expected, m_expectedStarts, index );
+  }
+
+  std::string actualElement( int index ) const
+  {
+    return line( m_actual, m_actualStarts, index );
+  }
+
+private:
+  typedef CppUnitVector<size_t> Starts;
+
+  /// Stores the start of each line, followed by the end of the text.
+  static void split( const std::string &text, Starts &starts )
+  {
+    size_t start = 0;
+    while ( true )
+    {
+      starts.push_back( start );
+      size_t end = text.find( '\n', start );
+      if ( end == std::string::npos )
+        break;
+      start = end + 1;
+    }
+    starts.push_back( text.length() + 1 );
+  }
+
+  static size_t lineLength( const Starts &starts, int index )
+  {
+    return starts[ index + 1 ] - starts[ index ] - 1;
+  }
+
+  static std::string line( const std::string &text, const Starts &starts, int index )
+  {
+    BoundedText line;
+    line.append( text.data() + starts[ index ], lineLength( starts, index ) );
+    return line.str();
+  }
+
+  const std::string &m_expected;
+  const std::string &m_actual;
+  Starts m_expectedStarts;
+  Starts m_actualStarts;
+};
+
+
+/*! \brief Characters of two strings (Implementation).
+ */
+class StringCharacters : public DiffSequences
+{
+public:
+  StringCharacters( const std::string &expected,
+                    const std::string &actual )
+      : m_expected( expected )
+      , m_actual( actual )
+  {
+  }
+
+  bool areEqual( int expectedIndex, int actualIndex ) const
+  {
+    return m_expected[ expectedIndex ] == m_actual[ actualIndex ];
+  }
+
+  std::string expectedElement( int index ) const
+  {
+    return std::string( 1, m_expected[ index ] );
+  }
+
+  std::string actualElement( int index ) const
+  {
+    return std::string( 1, m_actual[ index ] );
+  }
+
+private:
+  const std::string &m_expected;
+  const std::string &m_actual;
+};
+
+
+/*! Returns the count of elements followed by their name, plural if needed.
+ */
+static std::string
+countElements( int count, const std::string &name )
+{
+  OStringStream text;
+  text  <<  count  <<  " "  <<  name  <<  (count == 1 ? "" : "s");
+  return text.str();
+}
+
+
+std::string
+describeSequenceDifference( const DiffSequences &sequences,
+                            int expectedCount,
+                            int actualCount,
+                            const std::string &elementName,
+                            bool joinElements )
+{
+  SequenceDiff diff;
+  OStringStream description;
+  description  <<  "Difference: ";
+  if ( !diff.compute( sequences, expectedCount, actualCount ) )
+  {
+    description  <<  "more than "  <<  SequenceDiff::defaultMaximumEditDistance
+                 <<  " edits, first at "  <<  elementName  <<  " "
+                 <<  diff.commonHeadLength() + 1;
+    return description.str();
+  }
+
+  description  <<  countElements( diff.removalCount(), elementName )  <<  " removed, "
+               <<  countElements( diff.insertionCount(), elementName )  <<  " added\n"
+               <<  diff.render( sequences, joinElements );
+  return description.str();
+}
+
+
+std::string
+describeStringDifference( const std::string &expected,
+                          const std::string &actual )
+{
+  if ( expected == actual )
+    return "";
+
+  if ( expected.find( '\n' ) == std::string::npos  &&
+       actual.find( '\n' ) == std::string::npos )
+  {
+    return describeSequenceDifference( StringCharacters( expected, actual ),
+                                       expected.length(), actual.length(),
+                                       "character", true );
+  }
+
+  StringLines lines( expected, actual );
+  return describeSequenceDifference( lines, 
+                                     lines.expectedCount(), lines.actualCount(),
+                                     "line", false );
+}
+
+
+CPPUNIT_NS_END
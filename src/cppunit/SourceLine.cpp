@@ -1,3 +1,4 @@
+#include <cppunit/AllocationScope.h>
 #include <cppunit/SourceLine.h>
 
 
@@ -25,6 +26,15 @@ SourceLine::SourceLine( const std::string &fileName,
 }
 
 
+SourceLine::SourceLine( const char *fileName,
+                        int lineNumber )
+   : m_lineNumber( lineNumber )
+{
+   AllocationCountingPause pause;
+   m_fileName = fileName;
+}
+
+
 SourceLine &
 SourceLine::operator =( const SourceLine &other )
 {
@@ -0,0 +1,54 @@
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/StaticTest.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+StaticTest::StaticTest( const std::string &name,
+                        const std::string &expression,
+                        const SourceLine &sourceLine )
+    : m_name( name )
+    , m_expression( expression )
+    , m_sourceLine( sourceLine )
+{
+}
+
+
+StaticTest::~StaticTest()
+{
+}
+
+
+void 
+StaticTest::run( TestResult *result )
+{
+  result->startTest( this );
+  // The condition was checked by the compiler.
+  result->addAssertions( this, 1 );
+  result->endTest( this );
+}
+
+
+std::string 
+StaticTest::getName() const
+{
+  return m_name;
+}
+
+
+std::string 
+StaticTest::getExpression() const
+{
+  return m_expression;
+}
+
+
+SourceLine 
+StaticTest::getSourceLine() const
+{
+  return m_sourceLine;
+}
+
+
+CPPUNIT_NS_END
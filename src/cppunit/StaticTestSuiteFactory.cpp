@@ -0,0 +1,103 @@
+#include <cppunit/Mutex.h>
+#include <cppunit/extensions/StaticTestSuiteFactory.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+
+
+CPPUNIT_NS_BEGIN
+
+/* Head of the doubly linked list of pending factories. A plain pointer is
+ * initialized before any static constructor runs, so factories can be
+ * linked from any translation unit, whatever the initialization order.
+ */
+static StaticTestSuiteFactory *pendingFactories = NULL;
+
+
+/* Protects the list of pending factories: test plug-ins may be opened
+ * concurrently (see PlugInManager::loadConcurrently()), and their static
+ * constructors link factories in the list. Created on first use and never
+ * destroyed, so that it outlives every static factory.
+ */
+static Mutex &
+pendingFactoriesMutex()
+{
+  static Mutex *mutex = new Mutex();
+  return *mutex;
+}
+
+
+StaticTestSuiteFactory::StaticTestSuiteFactory( const char *registryName,
+                                                MakeSuiteFunction makeSuite )
+    : m_registryName( registryName )
+    , m_makeSuite( makeSuite )
+    , m_previous( NULL )
+    , m_next( NULL )
+    , m_registry( NULL )
+{
+  MutexLock lock( pendingFactoriesMutex() );
+  m_next = pendingFactories;
+  if ( m_next != NULL )
+    m_next->m_previous = this;
+  pendingFactories = this;
+}
+
+
+StaticTestSuiteFactory::~StaticTestSuiteFactory()
+{
+  MutexLock lock( pendingFactoriesMutex() );
+  if ( m_registry != NULL )
+  {
+    if ( TestFactoryRegistry::isValid() )
+      m_registry->unregisterFactory( this );
+    return;
+  }
+
+  // Not linked while registerPendingFactories() registers it.
+  if ( m_previous == NULL  &&  pendingFactories != this )
+    return;
+
+  if ( m_previous != NULL )
+    m_previous->m_next = m_next;
+  else
+    pendingFactories = m_next;
+  if ( m_next != NULL )
+    m_next->m_previous = m_previous;
+}
+
+
+Test *
+StaticTestSuiteFactory::makeTest()
+{
+  return m_makeSuite();
+}
+
+
+void 
+StaticTestSuiteFactory::registerPendingFactories()
+{
+  while ( true )
+  {
+    // Unlinks one factory at a time: getRegistry() calls this method again.
+    StaticTestSuiteFactory *factory;
+    {
+      MutexLock lock( pendingFactoriesMutex() );
+      factory = pendingFactories;
+      if ( factory == NULL )
+        return;
+      pendingFactories = factory->m_next;
+      if ( pendingFactories != NULL )
+        pendingFactories->m_previous = NULL;
+      factory->m_next = NULL;
+    }
+
+    TestFactoryRegistry *registry = factory->m_registryName == NULL 
+        ? &TestFactoryRegistry::getRegistry()
+        : &TestFactoryRegistry::getRegistry( factory->m_registryName );
+
+    MutexLock lock( pendingFactoriesMutex() );
+    factory->m_registry = registry;
+    registry->registerFactory( factory );
+  }
+}
+
+
+CPPUNIT_NS_END
@@ -0,0 +1,89 @@
+#include <cppunit/Protector.h>
+#include <cppunit/SuiteFixture.h>
+#include <cppunit/TestResult.h>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Functor to call a suite fixture function (Implementation).
+ *
+ * Implementation detail.
+ */
+class SuiteFixtureFunctor : public Functor
+{
+public:
+  SuiteFixtureFunctor( SuiteFixture::Function function )
+     : m_function( function )
+  {
+  }
+
+  bool operator()() const
+  {
+    (*m_function)();
+    return true;
+  }
+
+private:
+  SuiteFixture::Function m_function;
+};
+
+
+SuiteFixture::SuiteFixture()
+    : m_setUp( NULL )
+    , m_tearDown( NULL )
+    , m_runCount( 0 )
+{
+}
+
+
+SuiteFixture::~SuiteFixture()
+{
+}
+
+
+void 
+SuiteFixture::setSetUpFunction( Function setUp )
+{
+  m_setUp = setUp;
+}
+
+
+void 
+SuiteFixture::setTearDownFunction( Function tearDown )
+{
+  m_tearDown = tearDown;
+}
+
+
+bool 
+SuiteFixture::setUp( TestResult *result, 
+                     Test *suite )
+{
+  // The lock is held while setting up, so concurrent runs wait for it. Once
+  // the last run tore the resources down, the next run sets them up again.
+  MutexLock lock( m_mutex );
+  if ( m_runCount == 0  &&  m_setUp != NULL )
+  {
+    if ( !result->protect( SuiteFixtureFunctor( m_setUp ), suite, 
+                           "setUpSuite() failed" ) )
+      return false;
+  }
+
+  ++m_runCount;
+  return true;
+}
+
+
+void 
+SuiteFixture::tearDown( TestResult *result, 
+                        Test *suite )
+{
+  MutexLock lock( m_mutex );
+  if ( --m_runCount == 0  &&  m_tearDown != NULL )
+    result->protect( SuiteFixtureFunctor( m_tearDown ), suite, 
+                     "tearDownSuite() failed" );
+}
+
+
+CPPUNIT_NS_END
@@ -1,12 +1,110 @@
+#include <cppunit/Mutex.h>
 #include <cppunit/Portability.h>
 #include <cppunit/Test.h>
 #include <cppunit/TestPath.h>
+#include <cppunit/portability/CppUnitMap.h>
 #include <stdexcept>
+#include "Thread.h"
 
 
 CPPUNIT_NS_BEGIN
 
 
+/*! \brief Returns the next test identifier (Implementation).
+ * \internal Test trees may be built by several threads at once, such as the
+ *           plug-ins opened concurrently by DllPlugInTester.
+ */
+static TestId
+nextTestId()
+{
+  static volatile long lastId = 0;
+  return TestId( atomicIncrement( lastId ) );
+}
+
+
+/*! \brief Pool of the names interned by Test::getNameRef() (Implementation).
+ * \internal Each name is counted once per test that interned it, and removed
+ *           once the last of these tests is destroyed. std::map never moves
+ *           its elements, so a name stays at the same address until then.
+ */
+struct InternedTestNames
+{
+  Mutex m_lock;
+  CppUnitMap<std::string, int> m_useCounts;
+};
+
+
+/*! \brief Returns the pool of interned names (Implementation).
+ * \internal Never destroyed: tests owned by static objects may be destroyed
+ *           after the static objects of this file.
+ */
+static InternedTestNames &
+internedTestNames()
+{
+  static InternedTestNames *names = new InternedTestNames();
+  return *names;
+}
+
+
+Test::Test()
+    : m_id( nextTestId() )
+    , m_internedName( NULL )
+{
+}
+
+
+Test::Test( const Test & )
+    : m_id( nextTestId() )
+    , m_internedName( NULL )
+{
+}
+
+
+Test::~Test()
+{
+  if ( m_internedName == NULL )
+    return;
+
+  InternedTestNames &names = internedTestNames();
+  MutexLock lock( names.m_lock );
+  CppUnitMap<std::string, int>::iterator it = names.m_useCounts.find( *m_internedName );
+  if ( --it->second == 0 )
+    names.m_useCounts.erase( it );
+}
+
+
+TestId 
+Test::getId() const
+{
+  return m_id;
+}
+
+
+const std::string &
+Test::getNameRef() const
+{
+  InternedTestNames &names = internedTestNames();
+  {
+    MutexLock lock( names.m_lock );
+    if ( m_internedName != NULL )
+      return *m_internedName;
+  }
+
+  // getName() is called unlocked, as it may use the names of other tests.
+  std::string name = getName();
+  MutexLock lock( names.m_lock );
+  if ( m_internedName == NULL )
+  {
+    CppUnitMap<std::string, int>::iterator it = 
+        names.m_useCounts.insert( std::make_pair( name, 0 ) ).first;
+    ++it->second;
+    Test *mutableThis = CPPUNIT_CONST_CAST( Test *, this );
+    mutableThis->m_internedName = &it->first;
+  }
+  return *m_internedName;
+}
+
+
 Test *
 Test::getChildTestAt( int index ) const
 {
@@ -23,7 +121,7 @@ Test::findTest( const std::string &testName ) const
   mutableThis->findTestPath( testName, path );
   if ( !path.isValid() )
     throw std::invalid_argument( "No test named <" + testName + "> found in test <"
-                                 + getName() + ">." );
+                                 + getNameRef() + ">." );
   return path.getChildTest();
 }
 
@@ -33,7 +131,7 @@ Test::findTestPath( const std::string &testName,
                     TestPath &testPath ) const
 {
   Test *mutableThis = CPPUNIT_CONST_CAST( Test *, this );
-  if ( getName() == testName )
+  if ( getNameRef() == testName )
   {
     testPath.add( mutableThis );
     return true;
@@ -86,6 +184,27 @@ Test::resolveTestPath( const std::string &testPath ) const
 }
 
 
+bool 
+Test::canBeFlattened() const
+{
+  return false;
+}
+
+
+SuiteFixture *
+Test::getSuiteFixture() const
+{
+  return NULL;
+}
+
+
+long 
+Test::getPeakMemoryBudget() const
+{
+  return 0;
+}
+
+
 void 
 Test::checkIsValidIndex( int index ) const
 {
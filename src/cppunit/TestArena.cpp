@@ -0,0 +1,242 @@
+#include <cppunit/Mutex.h>
+#include <cppunit/TestArena.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <new>
+#include "Thread.h"
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Header placed before each test allocated by TestArena::allocate().
+ * \internal The union gives the header, and therefore the test that follows,
+ *           the strictest alignment of the fundamental types.
+ */
+union TestAllocationHeader
+{
+  /// Pool the test was allocated in, \c NULL if allocated on the heap.
+  TestArenaPool *m_pool;
+  long double m_alignLongDouble;
+  double m_alignDouble;
+  long m_alignLong;
+  void *m_alignPointer;
+};
+
+
+/*! \brief Memory chunks of a TestArena (Implementation).
+ * \internal The pool outlives its arena as long as some of its tests are
+ *           alive. All the members are guarded by m_lock.
+ */
+class TestArenaPool
+{
+public:
+  TestArenaPool( size_t chunkSize )
+      : m_chunkSize( chunkSize )
+      , m_chunkCurrent( NULL )
+      , m_chunkUsed( chunkSize )
+      , m_allocatedSize( 0 )
+      , m_liveCount( 0 )
+      , m_isOrphan( false )
+  {
+  }
+
+  ~TestArenaPool()
+  {
+    for ( Chunks::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it )
+      ::operator delete( *it );
+  }
+
+  void *allocate( size_t size )
+  {
+    MutexLock lock( m_lock );
+    size = roundUp( size );
+    void *memory;
+    if ( size > m_chunkSize )   // allocated apart, leaves the current chunk
+      memory = addChunk( size );
+    else
+    {
+      if ( m_chunkUsed + size > m_chunkSize )
+      {
+        m_chunkCurrent = (char *)addChunk( m_chunkSize );
+        m_chunkUsed = 0;
+      }
+
+      memory = m_chunkCurrent + m_chunkUsed;
+      m_chunkUsed += size;
+    }
+
+    ++m_liveCount;
+    return memory;
+  }
+
+  /// Returns \c true if the pool must be deleted.
+  bool release()
+  {
+    MutexLock lock( m_lock );
+    return --m_liveCount == 0  &&  m_isOrphan;
+  }
+
+  /// Returns \c true if the pool must be deleted.
+  bool orphan()
+  {
+    MutexLock lock( m_lock );
+    m_isOrphan = true;
+    return m_liveCount == 0;
+  }
+
+  int liveCount()
+  {
+    MutexLock lock( m_lock );
+    return m_liveCount;
+  }
+
+  size_t allocatedSize()
+  {
+    MutexLock lock( m_lock );
+    return m_allocatedSize;
+  }
+
+  static size_t roundUp( size_t size )
+  {
+    const size_t alignment = sizeof(TestAllocationHeader);
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+private:
+  void *addChunk( size_t size )
+  {
+    void *chunk = ::operator new( size );
+    m_chunks.push_back( chunk );
+    m_allocatedSize += size;
+    return chunk;
+  }
+
+  typedef CppUnitVector<void *> Chunks;
+
+  Mutex m_lock;
+  size_t m_chunkSize;
+  char *m_chunkCurrent;
+  size_t m_chunkUsed;
+  size_t m_allocatedSize;
+  int m_liveCount;
+  bool m_isOrphan;
+  Chunks m_chunks;
+};
+
+
+/*! \brief Returns the pools of the active scope of each thread (Implementation).
+ * \internal Never destroyed: tests may be deleted after the static objects
+ *           are destroyed.
+ */
+static ThreadLocalPointer *
+currentPools()
+{
+  static ThreadLocalPointer *pools = new ThreadLocalPointer();
+  return pools;
+}
+
+
+/*! \brief Returns the pool of the active scope of the calling thread
+ *         (Implementation).
+ */
+static TestArenaPool *
+currentPool()
+{
+  return (TestArenaPool *)currentPools()->get();
+}
+
+
+TestArena::TestArena( size_t chunkSize )
+    : m_pool( new TestArenaPool( TestArenaPool::roundUp( chunkSize ) ) )
+{
+}
+
+
+TestArena::~TestArena()
+{
+  if ( m_pool->orphan() )
+    delete m_pool;
+}
+
+
+int 
+TestArena::getTestCount() const
+{
+  return m_pool->liveCount();
+}
+
+
+size_t 
+TestArena::getAllocatedSize() const
+{
+  return m_pool->allocatedSize();
+}
+
+
+TestArena::Scope::Scope( TestArena &arena )
+    : m_previousPool( currentPool() )
+{
+  currentPools()->set( arena.m_pool );
+}
+
+
+TestArena::Scope::~Scope()
+{
+  currentPools()->set( m_previousPool );
+}
+
+
+bool 
+TestArena::isActive()
+{
+  return currentPool() != NULL;
+}
+
+
+void *
+TestArena::allocate( size_t size )
+{
+  size_t totalSize = sizeof(TestAllocationHeader) + size;
+  TestArenaPool *pool = currentPool();
+
+  TestAllocationHeader *header;
+  if ( pool != NULL )
+    header = (TestAllocationHeader *)pool->allocate( totalSize );
+  else
+    header = (TestAllocationHeader *)::operator new( totalSize );
+
+  header->m_pool = pool;
+  return header + 1;
+}
+
+
+void 
+TestArena::deallocate( void *memory )
+{
+  if ( memory == NULL )
+    return;
+
+  TestAllocationHeader *header = (TestAllocationHeader *)memory - 1;
+  TestArenaPool *pool = header->m_pool;
+  if ( pool == NULL )
+    ::operator delete( header );
+  else if ( pool->release() )
+    delete pool;
+}
+
+
+void *
+ArenaTestAllocation::operator new( size_t size )
+{
+  return TestArena::allocate( size );
+}
+
+
+void 
+ArenaTestAllocation::operator delete( void *memory )
+{
+  TestArena::deallocate( memory );
+}
+
+
+CPPUNIT_NS_END
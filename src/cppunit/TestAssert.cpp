@@ -1,9 +1,104 @@
+#include <cppunit/AllocationScope.h>
 #include <cppunit/TestAssert.h>
 #include <cppunit/portability/FloatingPoint.h>
+#include <cppunit/tools/SequenceDiff.h>
 
 CPPUNIT_NS_BEGIN
 
 
+std::string
+renderValue( int value )
+{
+  char buffer[64];
+#ifdef __STDC_SECURE_LIB__ // Use secure version with visual studio 2005 to avoid warning.
+  sprintf_s( buffer, sizeof(buffer), "%d", value );
+#else
+  sprintf( buffer, "%d", value );
+#endif
+  return buffer;
+}
+
+
+std::string
+renderValue( unsigned int value )
+{
+  char buffer[64];
+#ifdef __STDC_SECURE_LIB__
+  sprintf_s( buffer, sizeof(buffer), "%u", value );
+#else
+  sprintf( buffer, "%u", value );
+#endif
+  return buffer;
+}
+
+
+std::string
+renderValue( long value )
+{
+  char buffer[64];
+#ifdef __STDC_SECURE_LIB__
+  sprintf_s( buffer, sizeof(buffer), "%ld", value );
+#else
+  sprintf( buffer, "%ld", value );
+#endif
+  return buffer;
+}
+
+
+std::string
+renderValue( unsigned long value )
+{
+  char buffer[64];
+#ifdef __STDC_SECURE_LIB__
+  sprintf_s( buffer, sizeof(buffer), "%lu", value );
+#else
+  sprintf( buffer, "%lu", value );
+#endif
+  return buffer;
+}
+
+
+std::string
+renderValue( float value )
+{
+  char buffer[64];
+#ifdef __STDC_SECURE_LIB__
+  sprintf_s( buffer, sizeof(buffer), "%g", (double)value );
+#else
+  sprintf( buffer, "%g", (double)value );
+#endif
+  return buffer;
+}
+
+
+
+void 
+assertEquals( const std::string &expected,
+              const std::string &actual,
+              SourceLine sourceLine,
+              const std::string &message )
+{
+  Asserter::countAssertion();
+  if ( assertion_traits<std::string>::equal( expected, actual ) )
+    return;
+
+  AllocationCountingPause pause;
+  // A diff of short strings would only repeat them.
+  AdditionalMessage details;
+  if ( expected.length() > CPPUNIT_WRAP_COLUMN  ||  
+       actual.length() > CPPUNIT_WRAP_COLUMN  ||
+       expected.find( '\n' ) != std::string::npos  ||  
+       actual.find( '\n' ) != std::string::npos )
+    details.addDetail( AdditionalMessage( describeStringDifference( expected, actual ) ) );
+  details.addDetail( AdditionalMessage( message ) );
+
+  Asserter::failNotEqual( assertion_traits<std::string>::toString( expected ),
+                          assertion_traits<std::string>::toString( actual ),
+                          sourceLine,
+                          details );
+}
+
+
 void 
 assertDoubleEquals( double expected,
                     double actual,
@@ -11,10 +106,6 @@ assertDoubleEquals( double expected,
                     SourceLine sourceLine,
                     const std::string &message )
 {
-  AdditionalMessage msg( "Delta   : " + 
-                         assertion_traits<double>::toString(delta) );
-  msg.addDetail( AdditionalMessage(message) );
-
   bool equal;
   if ( floatingPointIsFinite(expected)  &&  floatingPointIsFinite(actual) )
       equal = fabs( expected - actual ) <= delta;
@@ -34,12 +125,61 @@ assertDoubleEquals( double expected,
     }
   }
 
-  Asserter::failNotEqualIf( !equal,
-                            assertion_traits<double>::toString(expected),
-                            assertion_traits<double>::toString(actual),
-                            sourceLine, 
-                            msg, 
-                            "double equality assertion failed" );
+  Asserter::countAssertion();
+  if ( equal )
+    return;
+
+  // The message is only built on failure, so that passing does not allocate.
+  AllocationCountingPause pause;
+  AdditionalMessage msg( "Delta   : " + 
+                         assertion_traits<double>::toString(delta) );
+  msg.addDetail( AdditionalMessage(message) );
+
+  Asserter::failNotEqual( assertion_traits<double>::toString(expected),
+                          assertion_traits<double>::toString(actual),
+                          sourceLine, 
+                          msg, 
+                          "double equality assertion failed" );
+}
+
+
+void 
+expectEquals( const std::string &expected,
+              const std::string &actual,
+              const SourceLine &sourceLine,
+              const std::string &message )
+{
+  // Only compares strings: the whole check is bookkeeping of the framework.
+  AllocationCountingPause pause;
+  ExpectationScope scope;
+  assertEquals( expected, actual, sourceLine, message );
+}
+
+
+void 
+expectDoubleEquals( double expected,
+                    double actual,
+                    double delta,
+                    const SourceLine &sourceLine,
+                    const std::string &message )
+{
+  AllocationCountingPause pause;
+  ExpectationScope scope;
+  assertDoubleEquals( expected, actual, delta, sourceLine, message );
+}
+
+
+void 
+expectIf( bool isMet,
+          const Message &message,
+          const SourceLine &sourceLine )
+{
+  Asserter::countAssertion();
+  if ( isMet )
+    return;
+
+  ExpectationScope scope;
+  Asserter::fail( message, sourceLine );
 }
 
 
@@ -1,8 +1,13 @@
 #include <cppunit/Portability.h>
+#include <cppunit/AllocationScope.h>
 #include <cppunit/Exception.h>
+#include <cppunit/ExpectationCollector.h>
 #include <cppunit/Protector.h>
 #include <cppunit/TestCase.h>
 #include <cppunit/TestResult.h>
+#include <cppunit/extensions/TestNamer.h>
+#include <cppunit/portability/Stream.h>
+#include <cppunit/tools/PeakMemory.h>
 #include <stdexcept>
 
 #if CPPUNIT_USE_TYPEINFO_NAME
@@ -29,6 +34,8 @@ public:
 
   bool operator()() const
   {
+    // Counts the allocations of the method for the scope of the test.
+    AllocationScope allocations;
     (m_target->*m_method)();
     return true;
   }
@@ -39,6 +46,61 @@ private:
 };
 
 
+/*! \brief Measures the peak memory of a test (Implementation).
+ *
+ * Implementation detail.
+ */
+class TestPeakMemory
+{
+public:
+  TestPeakMemory( TestResult *result )
+     : m_budget( result->peakMemoryBudget() )
+     , m_isTracked( m_budget > 0  ||  result->tracksPeakMemory() )
+     , m_isReset( false )
+     , m_startKilobytes( -1 )
+  {
+    if ( m_isTracked )
+    {
+      m_isReset = PeakMemory::reset();
+      m_startKilobytes = PeakMemory::kilobytes();
+    }
+  }
+
+  void report( TestResult *result,
+               Test *test ) const
+  {
+    if ( !m_isTracked )
+      return;
+
+    long peakKilobytes = PeakMemory::kilobytes();
+    if ( peakKilobytes < 0 )
+      return;
+
+    // If the peak can not be reset, it is the one of the process: only the
+    // test that raised it is over budget.
+    bool isPeakOfTest = m_isReset  ||  peakKilobytes > m_startKilobytes;
+    if ( m_budget > 0  &&  isPeakOfTest  &&  peakKilobytes > m_budget )
+    {
+      OStringStream peak;
+      peak  <<  "Peak memory: "  <<  peakKilobytes  <<  " kB";
+      OStringStream budget;
+      budget  <<  "Budget     : "  <<  m_budget  <<  " kB";
+      result->addFailure( test, 
+                          new Exception( Message( "memory budget exceeded",
+                                                  peak.str(),
+                                                  budget.str() ) ) );
+    }
+    result->addPeakMemory( test, peakKilobytes );
+  }
+
+private:
+  long m_budget;
+  bool m_isTracked;
+  bool m_isReset;
+  long m_startKilobytes;
+};
+
+
 /** Constructs a test case.
  *  \param name the name of the TestCase.
  **/
@@ -48,6 +110,17 @@ TestCase::TestCase( const std::string &name )
 }
 
 
+/** Constructs a test case named by the namer of its fixture.
+ *  \param namer Namer of the fixture.
+ *  \param testMethodName Name of the test method.
+ **/
+TestCase::TestCase( const TestNamer &namer, 
+                    const char *testMethodName )
+    : m_name( namer.getTestNameFor( testMethodName ) )
+{
+}
+
+
 /// Run the test and catch any exceptions that are triggered by it 
 void 
 TestCase::run( TestResult *result )
@@ -84,18 +157,48 @@ TestCase::run( TestResult *result )
     result->addError( this, new Exception( Message( "setUp() failed" ) ) );
   }
 */
+  ExpectationCollector expectations;
+  CurrentExpectationCollector currentExpectations( &expectations );
+
+  // Only the allocations of setUp(), runTest() and tearDown() are counted.
+  AllocationScope allocations;
+  AllocationCountingPause pause;
+
+  TestPeakMemory peakMemory( result );
+  bool hasRunTest = false;
   if ( result->protect( TestCaseMethodFunctor( this, &TestCase::setUp ),
                         this,
                        "setUp() failed" ) )
   {
-    result->protect( TestCaseMethodFunctor( this, &TestCase::runTest ),
-                     this );
+    hasRunTest = result->protect( TestCaseMethodFunctor( this, &TestCase::runTest ),
+                                  this );
   }
+  expectations.reportFailures( result, this );
 
   result->protect( TestCaseMethodFunctor( this, &TestCase::tearDown ),
                    this,
                    "tearDown() failed" );
+  expectations.endTest( result, this );
+
+  int assertionCount = expectations.assertionCount();
+  if ( hasRunTest  &&  assertionCount == 0  &&  
+       result->failsTestsWithoutAssertions() )
+  {
+    result->addFailure( this, 
+                        new Exception( Message( "no assertion checked",
+                                                "The test passed without "
+                                                "checking any assertion" ) ) );
+  }
+  peakMemory.report( result, this );
+  result->addAssertions( this, assertionCount );
+  if ( AllocationScope::isCountingInstalled() )
+  {
+    result->addAllocations( this, 
+                            allocations.allocationCount(),
+                            allocations.allocatedByteCount() );
+  }
 
+  currentExpectations.restore();
   result->endTest( this );
 }
 
@@ -130,7 +233,15 @@ TestCase::~TestCase()
 std::string 
 TestCase::getName() const
 { 
-  return m_name; 
+  return getNameRef(); 
+}
+
+
+/// Returns a reference on the name of the test case
+const std::string &
+TestCase::getNameRef() const
+{
+  return m_name;
 }
   
 
@@ -4,7 +4,7 @@ CPPUNIT_NS_BEGIN
 
 
 TestCaseDecorator::TestCaseDecorator( TestCase *test )
-    : TestCase( test->getName() ),
+    : TestCase(),
       m_test( test )
 { 
 }
@@ -23,6 +23,13 @@ TestCaseDecorator::getName() const
 }
 
 
+const std::string &
+TestCaseDecorator::getNameRef() const
+{ 
+  return m_test->getNameRef(); 
+}
+
+
 void 
 TestCaseDecorator::setUp()
 {
@@ -1,3 +1,4 @@
+#include <cppunit/SuiteFixture.h>
 #include <cppunit/TestComposite.h>
 #include <cppunit/TestResult.h>
 
@@ -20,7 +21,16 @@ void
 TestComposite::run( TestResult *result )
 {
   doStartSuite( result );
-  doRunChildTests( result );
+
+  SuiteFixture *fixture = getSuiteFixture();
+  if ( fixture == NULL )
+    doRunChildTests( result );
+  else if ( fixture->setUp( result, this ) )
+  {
+    doRunChildTests( result );
+    fixture->tearDown( result, this );
+  }
+
   doEndSuite( result );
 }
 
@@ -45,6 +55,13 @@ TestComposite::getName() const
 }
 
 
+const std::string &
+TestComposite::getNameRef() const
+{
+  return m_name;
+}
+
+
 void 
 TestComposite::doStartSuite( TestResult *controller )
 {
@@ -0,0 +1,518 @@
+#include <cppunit/extensions/TestDataTable.h>
+#include <cppunit/tools/StringTools.h>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CPPUNIT_HAVE_SYS_MMAN_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Read-only view of the content of a file (Implementation).
+ *
+ * The file is mapped in memory if the platform supports it, otherwise it is
+ * read in a buffer.
+ */
+class MappedFile
+{
+public:
+  /*! Maps the specified file.
+   * \exception std::runtime_error if the file can not be read.
+   */
+  MappedFile( const std::string &fileName )
+      : m_data( NULL )
+      , m_size( 0 )
+      , m_handle( NULL )
+  {
+#if defined(CPPUNIT_HAVE_SYS_MMAN_H)
+    int file = ::open( fileName.c_str(), O_RDONLY );
+    if ( file < 0 )
+      throw std::runtime_error( "can not open test data file: " + fileName );
+
+    struct stat status;
+    if ( ::fstat( file, &status ) != 0 )
+    {
+      ::close( file );
+      throw std::runtime_error( "can not read test data file: " + fileName );
+    }
+
+    m_size = status.st_size;
+    if ( m_size > 0 )
+    {
+      void *data = ::mmap( NULL, m_size, PROT_READ, MAP_PRIVATE, file, 0 );
+      if ( data == MAP_FAILED )
+      {
+        ::close( file );
+        throw std::runtime_error( "can not map test data file: " + fileName );
+      }
+      m_data = (const char *)data;
+    }
+    ::close( file );
+
+#elif defined(_WIN32)
+    HANDLE file = ::CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                 NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if ( file == INVALID_HANDLE_VALUE )
+      throw std::runtime_error( "can not open test data file: " + fileName );
+
+    m_size = ::GetFileSize( file, NULL );
+    if ( m_size > 0 )
+    {
+      m_handle = ::CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+      if ( m_handle != NULL )
+        m_data = (const char *)::MapViewOfFile( m_handle, FILE_MAP_READ, 0, 0, 0 );
+      if ( m_data == NULL )
+      {
+        if ( m_handle != NULL )
+          ::CloseHandle( m_handle );
+        ::CloseHandle( file );
+        throw std::runtime_error( "can not map test data file: " + fileName );
+      }
+    }
+    ::CloseHandle( file );
+
+#else
+    FILE *file = fopen( fileName.c_str(), "rb" );
+    if ( file == NULL )
+      throw std::runtime_error( "can not open test data file: " + fileName );
+
+    std::string content;
+    char buffer[4096];
+    size_t count;
+    while ( (count = fread( buffer, 1, sizeof(buffer), file )) > 0 )
+      content.append( buffer, count );
+    bool hasError = ferror( file ) != 0;
+    fclose( file );
+    if ( hasError )
+      throw std::runtime_error( "can not read test data file: " + fileName );
+
+    m_size = content.size();
+    if ( m_size > 0 )
+    {
+      char *data = (char *)malloc( m_size );
+      memcpy( data, content.data(), m_size );
+      m_data = data;
+    }
+#endif
+  }
+
+  ~MappedFile()
+  {
+    if ( m_data == NULL )
+      return;
+#if defined(CPPUNIT_HAVE_SYS_MMAN_H)
+    ::munmap( (void *)m_data, m_size );
+#elif defined(_WIN32)
+    ::UnmapViewOfFile( m_data );
+    ::CloseHandle( m_handle );
+#else
+    free( (void *)m_data );
+#endif
+  }
+
+  const char *begin() const
+  {
+    return m_data;
+  }
+
+  const char *end() const
+  {
+    return m_data + m_size;
+  }
+
+private:
+  const char *m_data;
+  size_t m_size;
+  void *m_handle;
+};
+
+
+TestDataTable::~TestDataTable()
+{
+}
+
+
+MappedTestDataTable::MappedTestDataTable( const std::string &fileName )
+    : m_fileName( fileName )
+    , m_file( NULL )
+{
+}
+
+
+MappedTestDataTable::~MappedTestDataTable()
+{
+  delete m_file;
+}
+
+
+int
+MappedTestDataTable::getRowCount()
+{
+  indexRows();
+  return m_rows.size();
+}
+
+
+void
+MappedTestDataTable::getRow( int index,
+                             TestDataRow &row )
+{
+  indexRows();
+  if ( index < 0  ||  index >= int(m_rows.size()) )
+    throw std::out_of_range( "MappedTestDataTable::getRow(): index out of range" );
+
+  row = TestDataRow();
+  parseRow( m_rows[ index ].first, m_rows[ index ].second, row );
+}
+
+
+std::string
+MappedTestDataTable::getFileName() const
+{
+  return m_fileName;
+}
+
+
+void
+MappedTestDataTable::indexRows()
+{
+  if ( m_file != NULL )
+    return;
+
+  MappedFile *file = new MappedFile( m_fileName );
+  try
+  {
+    findRows( file->begin(), file->end(), m_rows );
+  }
+  catch ( ... )
+  {
+    m_rows.clear();
+    delete file;
+    throw;
+  }
+  m_file = file;
+}
+
+
+/*! \brief Returns the end of the line starting at \a begin (Implementation).
+ */
+static const char *
+findEndOfLine( const char *begin,
+               const char *end )
+{
+  const char *endOfLine = (const char *)memchr( begin, '\n', end - begin );
+  return endOfLine == NULL ? end : endOfLine;
+}
+
+
+CsvTestDataTable::CsvTestDataTable( const std::string &fileName )
+    : MappedTestDataTable( fileName )
+{
+}
+
+
+void
+CsvTestDataTable::findRows( const char *begin,
+                            const char *end,
+                            RowRanges &rows ) const
+{
+  const char *line = begin;
+  while ( line < end )
+  {
+    const char *endOfLine = findEndOfLine( line, end );
+    const char *endOfRow = endOfLine;
+    if ( endOfRow > line  &&  endOfRow[-1] == '\r' )
+      --endOfRow;
+    if ( endOfRow > line  &&  *line != '#' )
+      rows.push_back( RowRange( line, endOfRow ) );
+    line = endOfLine + 1;
+  }
+}
+
+
+void
+CsvTestDataTable::parseRow( const char *begin,
+                            const char *end,
+                            TestDataRow &row ) const
+{
+  std::string *fields[] = { &row.m_key, &row.m_parameters, &row.m_expected };
+  const int fieldCount = sizeof(fields) / sizeof(fields[0]);
+
+  const char *current = begin;
+  for ( int fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex )
+  {
+    std::string &field = *fields[ fieldIndex ];
+    if ( current < end  &&  *current == '"' )
+    {
+      ++current;
+      while ( true )
+      {
+        if ( current == end )
+          throw std::runtime_error( "unterminated quoted field in CSV row: " +
+                                    std::string( begin, end ) );
+        if ( *current == '"' )
+        {
+          if ( current + 1 == end  ||  current[1] != '"' )
+            break;
+          ++current;
+        }
+        field += *current++;
+      }
+      ++current;
+    }
+    else
+    {
+      const char *endOfField = current;
+      while ( endOfField < end  &&  *endOfField != ',' )
+        ++endOfField;
+      field.assign( current, endOfField );
+      current = endOfField;
+    }
+
+    if ( current < end )
+    {
+      if ( *current != ','  ||  fieldIndex + 1 == fieldCount )
+        throw std::runtime_error( "invalid CSV row: " + std::string( begin, end ) );
+      ++current;
+    }
+  }
+}
+
+
+/*! \brief Finds the first occurrence of \a text in [begin,end) (Implementation).
+ * \return Position of \a text, or \a end if not found.
+ */
+static const char *
+findText( const char *begin,
+          const char *end,
+          const char *text )
+{
+  size_t length = strlen( text );
+  while ( begin < end )
+  {
+    const char *found = (const char *)memchr( begin, text[0], end - begin );
+    if ( found == NULL  ||  size_t(end - found) < length )
+      return end;
+    if ( memcmp( found, text, length ) == 0 )
+      return found;
+    begin = found + 1;
+  }
+  return end;
+}
+
+
+/*! \brief Tests if an element name ends at the specified position (Implementation).
+ */
+static bool
+isEndOfElementName( const char *position,
+                    const char *end )
+{
+  return position < end  &&  strchr( " \t\r\n/>", *position ) != NULL;
+}
+
+
+/*! \brief Decodes the predefined XML entities and character references (Implementation).
+ * \exception std::runtime_error if an entity is not supported.
+ */
+static std::string
+decodeXmlText( const char *begin,
+               const char *end )
+{
+  std::string text;
+  text.reserve( end - begin );
+  while ( begin < end )
+  {
+    const char *ampersand = (const char *)memchr( begin, '&', end - begin );
+    if ( ampersand == NULL )
+      ampersand = end;
+    text.append( begin, ampersand );
+    if ( ampersand == end )
+      break;
+
+    const char *semicolon = (const char *)memchr( ampersand, ';', end - ampersand );
+    if ( semicolon == NULL )
+      throw std::runtime_error( "unterminated XML entity in test data" );
+    std::string entity( ampersand + 1, semicolon );
+    if ( entity == "lt" )
+      text += '<';
+    else if ( entity == "gt" )
+      text += '>';
+    else if ( entity == "amp" )
+      text += '&';
+    else if ( entity == "quot" )
+      text += '"';
+    else if ( entity == "apos" )
+      text += '\'';
+    else if ( entity.length() > 1  &&  entity[0] == '#' )
+    {
+      long code = entity[1] == 'x' ? strtol( entity.c_str() + 2, NULL, 16 )
+                                   : strtol( entity.c_str() + 1, NULL, 10 );
+      if ( code <= 0  ||  code > 255 )
+        throw std::runtime_error( "unsupported XML character reference in test data: &" +
+                                  entity + ";" );
+      text += char(code);
+    }
+    else
+      throw std::runtime_error( "unsupported XML entity in test data: &" + entity + ";" );
+    begin = semicolon + 1;
+  }
+  return text;
+}
+
+
+/*! \brief Returns the decoded content of the child element \a name (Implementation).
+ */
+static std::string
+getXmlElementText( const char *begin,
+                   const char *end,
+                   const std::string &name )
+{
+  std::string startTag( "<" + name );
+  const char *element = begin;
+  while ( true )
+  {
+    element = findText( element, end, startTag.c_str() );
+    if ( element == end )
+      return "";
+    element += startTag.length();
+    if ( isEndOfElementName( element, end ) )
+      break;
+  }
+
+  const char *content = (const char *)memchr( element, '>', end - element );
+  if ( content == NULL )
+    throw std::runtime_error( "invalid XML element in test data: " + name );
+  if ( content[-1] == '/' )
+    return "";
+  ++content;
+
+  std::string endTag( "</" + name + ">" );
+  const char *contentEnd = findText( content, end, endTag.c_str() );
+  if ( contentEnd == end )
+    throw std::runtime_error( "missing XML end tag in test data: " + endTag );
+  return decodeXmlText( content, contentEnd );
+}
+
+
+XmlTestDataTable::XmlTestDataTable( const std::string &fileName )
+    : MappedTestDataTable( fileName )
+{
+}
+
+
+void
+XmlTestDataTable::findRows( const char *begin,
+                            const char *end,
+                            RowRanges &rows ) const
+{
+  const char *current = begin;
+  while ( true )
+  {
+    const char *row = findText( current, end, "<row" );
+    if ( row == end )
+      break;
+    current = row + 4;
+    if ( !isEndOfElementName( current, end ) )
+      continue;
+
+    const char *startTagEnd = (const char *)memchr( current, '>', end - current );
+    if ( startTagEnd == NULL )
+      throw std::runtime_error( "unterminated row element in XML test data" );
+    if ( startTagEnd[-1] == '/' )
+    {
+      current = startTagEnd + 1;
+      rows.push_back( RowRange( row, current ) );
+      continue;
+    }
+
+    const char *endTag = findText( startTagEnd, end, "</row>" );
+    if ( endTag == end )
+      throw std::runtime_error( "missing </row> in XML test data" );
+    current = endTag + 6;
+    rows.push_back( RowRange( row, current ) );
+  }
+}
+
+
+void
+XmlTestDataTable::parseRow( const char *begin,
+                            const char *end,
+                            TestDataRow &row ) const
+{
+  const char *startTagEnd = (const char *)memchr( begin, '>', end - begin );
+  const char *key = begin;
+  do
+    key = findText( key + 1, startTagEnd, "key=" );
+  while ( key != startTagEnd  &&  strchr( " \t\r\n", key[-1] ) == NULL );
+  if ( key != startTagEnd )
+  {
+    char quote = key[4];
+    const char *value = key + 5;
+    const char *valueEnd = value < startTagEnd
+        ? (const char *)memchr( value, quote, startTagEnd - value )
+        : NULL;
+    if ( (quote != '"'  &&  quote != '\'')  ||  valueEnd == NULL )
+      throw std::runtime_error( "invalid key attribute in XML test data" );
+    row.m_key = decodeXmlText( value, valueEnd );
+  }
+
+  row.m_parameters = getXmlElementText( startTagEnd, end, "parameters" );
+  row.m_expected = getXmlElementText( startTagEnd, end, "expected" );
+}
+
+
+BinaryTestDataTable::BinaryTestDataTable( const std::string &fileName,
+                                          int recordSize,
+                                          int parametersSize )
+    : MappedTestDataTable( fileName )
+    , m_recordSize( recordSize )
+    , m_parametersSize( parametersSize )
+{
+  if ( recordSize <= 0  ||  parametersSize < 0  ||  parametersSize > recordSize )
+    throw std::invalid_argument( "BinaryTestDataTable: invalid record size" );
+}
+
+
+void
+BinaryTestDataTable::findRows( const char *begin,
+                               const char *end,
+                               RowRanges &rows ) const
+{
+  if ( (end - begin) % m_recordSize != 0 )
+    throw std::runtime_error( "size of binary test data file " + getFileName() +
+                              " is not a multiple of " +
+                              StringTools::toString( m_recordSize ) );
+
+  rows.reserve( (end - begin) / m_recordSize );
+  for ( const char *record = begin; record < end; record += m_recordSize )
+    rows.push_back( RowRange( record, record + m_recordSize ) );
+}
+
+
+void
+BinaryTestDataTable::parseRow( const char *begin,
+                               const char *end,
+                               TestDataRow &row ) const
+{
+  row.m_parameters.assign( begin, begin + m_parametersSize );
+  row.m_expected.assign( begin + m_parametersSize, end );
+}
+
+
+CPPUNIT_NS_END
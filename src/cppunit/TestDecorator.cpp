@@ -36,6 +36,13 @@ TestDecorator::getName() const
 }
 
 
+const std::string &
+TestDecorator::getNameRef() const
+{ 
+  return m_test->getNameRef(); 
+}
+
+
 int 
 TestDecorator::getChildTestCount() const
 {
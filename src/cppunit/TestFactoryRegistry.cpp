@@ -1,12 +1,29 @@
 #include <cppunit/config/SourcePrefix.h>
+#include <cppunit/Mutex.h>
+#include <cppunit/extensions/StaticTestSuiteFactory.h>
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/portability/CppUnitMap.h>
+#include <cppunit/portability/CppUnitVector.h>
+#include <cppunit/TestArena.h>
 #include <cppunit/TestSuite.h>
 #include <assert.h>
 
 
 CPPUNIT_NS_BEGIN
 
+/* Protects the list of registries and the factories of each registry: the
+ * static constructors of test plug-ins opened concurrently (see
+ * PlugInManager::loadConcurrently()) register factories. Created on first use
+ * and never destroyed, so that it outlives every static registration.
+ */
+static Mutex &
+registriesMutex()
+{
+  static Mutex *mutex = new Mutex();
+  return *mutex;
+}
+
+
 /*! \brief (INTERNAL) List of all TestFactoryRegistry.
  */
 class TestFactoryRegistryList
@@ -71,6 +88,7 @@ public:
     if ( !isValid() )         // release mode
       return NULL;            // => force CRASH
 
+    MutexLock lock( registriesMutex() );
     return getInstance()->getInternalRegistry( name );
   }
 
@@ -96,6 +114,8 @@ TestFactoryRegistry::~TestFactoryRegistry()
 TestFactoryRegistry &
 TestFactoryRegistry::getRegistry( const std::string &name )
 {
+  if ( TestFactoryRegistryList::isValid() )
+    StaticTestSuiteFactory::registerPendingFactories();
   return *TestFactoryRegistryList::getRegistry( name );
 }
 
@@ -111,6 +131,7 @@ TestFactoryRegistry::registerFactory( const std::string &,
 void 
 TestFactoryRegistry::registerFactory( TestFactory *factory )
 {
+  MutexLock lock( registriesMutex() );
   m_factories.insert( factory );
 }
 
@@ -118,6 +139,7 @@ TestFactoryRegistry::registerFactory( TestFactory *factory )
 void 
 TestFactoryRegistry::unregisterFactory( TestFactory *factory )
 {
+  MutexLock lock( registriesMutex() );
   m_factories.erase( factory );
 }
 
@@ -132,7 +154,7 @@ TestFactoryRegistry::addRegistry( const std::string &name )
 Test *
 TestFactoryRegistry::makeTest()
 {
-  TestSuite *suite = new TestSuite( m_name );
+  TestSuite *suite = CPPUNIT_TEST_NEW( TestSuite, ( m_name ) );
   addTestToSuite( suite );
   return suite;
 }
@@ -141,13 +163,18 @@ TestFactoryRegistry::makeTest()
 void 
 TestFactoryRegistry::addTestToSuite( TestSuite *suite )
 {
-  for ( Factories::iterator it = m_factories.begin(); 
-        it != m_factories.end(); 
-        ++it )
+  // Suites of test plug-ins loaded since this registry was retrieved.
+  StaticTestSuiteFactory::registerPendingFactories();
+
+  // Copied so that the factories, such as other registries, run unlocked.
+  CppUnitVector<TestFactory *> factories;
   {
-    TestFactory *factory = *it;
-    suite->addTest( factory->makeTest() );
+    MutexLock lock( registriesMutex() );
+    factories.assign( m_factories.begin(), m_factories.end() );
   }
+
+  for ( unsigned int index = 0; index < factories.size(); ++index )
+    suite->addTest( factories[ index ]->makeTest() );
 }
 
 
@@ -0,0 +1,337 @@
+#include <cppunit/TestFilter.h>
+#include <stdexcept>
+
+#if defined(CPPUNIT_HAVE_REGEX_H)
+#include <sys/types.h>
+#include <regex.h>
+#endif
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief (INTERNAL) Compiled pattern of a TestFilter.
+ */
+class TestFilterPattern
+{
+public:
+  virtual ~TestFilterPattern()
+  {
+  }
+
+  /*! Indicates if the pattern matches the specified test path.
+   */
+  virtual bool matches( const std::string &testPath ) const =0;
+
+  /*! Indicates if the pattern may match the path of a test below the specified
+   * suite.
+   */
+  virtual bool mayMatchBelow( const std::string &suitePath ) const =0;
+};
+
+
+/*! \brief (INTERNAL) Glob pattern compiled into a sequence of tokens.
+ */
+class GlobTestFilterPattern : public TestFilterPattern
+{
+public:
+  GlobTestFilterPattern( const std::string &pattern )
+      : m_isAnchored( !pattern.empty()  &&  pattern[0] == '/' )
+  {
+    unsigned int index = 0;
+    while ( index < pattern.length() )
+    {
+      Token token;
+      if ( pattern[index] == '*' )
+      {
+        token.m_kind = star;
+        if ( index + 1 < pattern.length()  &&  pattern[index + 1] == '*' )
+        {
+          token.m_kind = doubleStar;
+          ++index;
+        }
+        while ( index + 1 < pattern.length()  &&  pattern[index + 1] == '*' )
+          ++index;  // '***' is the same as '**'.
+        ++index;
+      }
+      else if ( pattern[index] == '?' )
+      {
+        token.m_kind = anyCharacter;
+        ++index;
+      }
+      else
+      {
+        token.m_kind = literal;
+        while ( index < pattern.length()  &&
+                pattern[index] != '*'  &&
+                pattern[index] != '?' )
+          token.m_literal += pattern[index++];
+      }
+
+      m_tokens.push_back( token );
+    }
+  }
+
+  bool matches( const std::string &testPath ) const
+  {
+    if ( m_isAnchored )
+      return matchFrom( 0, testPath, 0, false );
+
+    for ( unsigned int start = 1; start < testPath.length(); ++start )
+    {
+      if ( testPath[start - 1] == '/'  &&
+           matchFrom( 0, testPath, start, false ) )
+        return true;
+    }
+    return false;
+  }
+
+  bool mayMatchBelow( const std::string &suitePath ) const
+  {
+    if ( !m_isAnchored )
+      return true;
+    return matchFrom( 0, suitePath + "/", 0, true );
+  }
+
+private:
+  enum TokenKind
+  {
+    literal,
+    anyCharacter,
+    star,
+    doubleStar
+  };
+
+  struct Token
+  {
+    TokenKind m_kind;
+    std::string m_literal;
+  };
+
+  /*! Matches the tokens starting at \a tokenIndex against \a text starting at
+   * \a position. If \a isPartial is \c true, reaching the end of \a text is a
+   * match: the remaining tokens may match the path of a child test.
+   */
+  bool matchFrom( unsigned int tokenIndex,
+                  const std::string &text,
+                  unsigned int position,
+                  bool isPartial ) const
+  {
+    while ( tokenIndex < m_tokens.size() )
+    {
+      const Token &token = m_tokens[ tokenIndex ];
+      switch ( token.m_kind )
+      {
+      case literal:
+        {
+          unsigned int remaining = text.length() - position;
+          if ( isPartial  &&  remaining < token.m_literal.length() )
+            return text.compare( position, remaining,
+                                 token.m_literal, 0, remaining ) == 0;
+          if ( text.compare( position, token.m_literal.length(),
+                             token.m_literal ) != 0 )
+            return false;
+          position += token.m_literal.length();
+          break;
+        }
+      case anyCharacter:
+        if ( position == text.length() )
+          return isPartial;
+        if ( text[position] == '/' )
+          return false;
+        ++position;
+        break;
+      default:  // star & doubleStar
+        for ( unsigned int end = position; ; ++end )
+        {
+          if ( matchFrom( tokenIndex + 1, text, end, isPartial ) )
+            return true;
+          if ( end == text.length() )
+            return false;
+          if ( token.m_kind == star  &&  text[end] == '/' )
+            return false;
+        }
+      }
+      ++tokenIndex;
+    }
+
+    return position == text.length();
+  }
+
+private:
+  typedef CppUnitVector<Token> Tokens;
+  Tokens m_tokens;
+  bool m_isAnchored;
+};
+
+
+#if defined(CPPUNIT_HAVE_REGEX_H)
+
+/*! \brief (INTERNAL) POSIX extended regular expression.
+ */
+class RegexTestFilterPattern : public TestFilterPattern
+{
+public:
+  RegexTestFilterPattern( const std::string &expression )
+  {
+    int error = ::regcomp( &m_regex, expression.c_str(), REG_EXTENDED | REG_NOSUB );
+    if ( error != 0 )
+    {
+      char message[256];
+      ::regerror( error, &m_regex, message, sizeof(message) );
+      throw std::invalid_argument( "TestFilter: invalid regular expression '" +
+                                   expression + "': " + message );
+    }
+  }
+
+  ~RegexTestFilterPattern()
+  {
+    ::regfree( &m_regex );
+  }
+
+  bool matches( const std::string &testPath ) const
+  {
+    return ::regexec( &m_regex, testPath.c_str(), 0, NULL, 0 ) == 0;
+  }
+
+  bool mayMatchBelow( const std::string & ) const
+  {
+    return true;
+  }
+
+private:
+  regex_t m_regex;
+};
+
+#endif
+
+
+TestFilter::TestFilter()
+{
+}
+
+
+TestFilter::~TestFilter()
+{
+  deletePatterns( m_includes );
+  deletePatterns( m_excludes );
+}
+
+
+void
+TestFilter::addInclude( const std::string &pattern )
+{
+  addPattern( m_includes, pattern );
+}
+
+
+void
+TestFilter::addIncludePath( const std::string &testPath )
+{
+  m_includePaths.insert( testPath );
+}
+
+
+void
+TestFilter::addExclude( const std::string &pattern )
+{
+  addPattern( m_excludes, pattern );
+}
+
+
+bool
+TestFilter::isEmpty() const
+{
+  return m_includes.empty()  &&  m_includePaths.empty()  &&  m_excludes.empty();
+}
+
+
+bool
+TestFilter::isIncluded( const std::string &testPath ) const
+{
+  if ( m_includes.empty()  &&  m_includePaths.empty() )
+    return true;
+  return m_includePaths.find( testPath ) != m_includePaths.end()  ||
+         matchesAny( m_includes, testPath );
+}
+
+
+bool
+TestFilter::isExcluded( const std::string &testPath ) const
+{
+  return matchesAny( m_excludes, testPath );
+}
+
+
+bool
+TestFilter::mayIncludeBelow( const std::string &suitePath ) const
+{
+  if ( m_includes.empty()  &&  m_includePaths.empty() )
+    return true;
+
+  std::string prefix( suitePath + "/" );
+  TestPaths::const_iterator itPath = m_includePaths.lower_bound( prefix );
+  if ( itPath != m_includePaths.end()  &&
+       (*itPath).compare( 0, prefix.length(), prefix ) == 0 )
+    return true;
+
+  for ( Patterns::const_iterator it = m_includes.begin();
+        it != m_includes.end();
+        ++it )
+  {
+    if ( (*it)->mayMatchBelow( suitePath ) )
+      return true;
+  }
+  return false;
+}
+
+
+void
+TestFilter::addPattern( Patterns &patterns,
+                        const std::string &pattern )
+{
+  static const std::string regexPrefix( "regex:" );
+
+  if ( pattern.empty() )
+    throw std::invalid_argument( "TestFilter: empty pattern" );
+
+  if ( pattern.compare( 0, regexPrefix.length(), regexPrefix ) == 0 )
+  {
+#if defined(CPPUNIT_HAVE_REGEX_H)
+    patterns.push_back( new RegexTestFilterPattern(
+                                 pattern.substr( regexPrefix.length() ) ) );
+#else
+    throw std::invalid_argument( "TestFilter: regular expressions are not "
+                                 "supported on this platform: " + pattern );
+#endif
+  }
+  else
+    patterns.push_back( new GlobTestFilterPattern( pattern ) );
+}
+
+
+bool
+TestFilter::matchesAny( const Patterns &patterns,
+                        const std::string &testPath )
+{
+  for ( Patterns::const_iterator it = patterns.begin();
+        it != patterns.end();
+        ++it )
+  {
+    if ( (*it)->matches( testPath ) )
+      return true;
+  }
+  return false;
+}
+
+
+void
+TestFilter::deletePatterns( Patterns &patterns )
+{
+  for ( Patterns::iterator it = patterns.begin(); it != patterns.end(); ++it )
+    delete *it;
+  patterns.clear();
+}
+
+
+CPPUNIT_NS_END
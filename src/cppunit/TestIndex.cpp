@@ -0,0 +1,131 @@
+#include <cppunit/TestIndex.h>
+#include <cppunit/TestPath.h>
+#include <stdexcept>
+
+
+CPPUNIT_NS_BEGIN
+
+
+TestIndex::TestIndex( Test *root )
+{
+  addTest( root, -1 );
+}
+
+
+TestIndex::~TestIndex()
+{
+}
+
+
+void
+TestIndex::addTest( Test *test,
+                    int parentIndex )
+{
+  int index = m_entries.size();
+  m_entries.push_back( Entry() );
+
+  Entry &entry = m_entries.back();
+  entry.m_test = test;
+  entry.m_parentIndex = parentIndex;
+  if ( parentIndex >= 0 )
+    entry.m_path = m_entries[ parentIndex ].m_path;
+  entry.m_path += '/';
+  entry.m_path += test->getNameRef();
+
+  m_indexesById[ test->getId() ] = index;
+
+  int childCount = test->getChildTestCount();
+  for ( int childIndex =0; childIndex < childCount; ++childIndex )
+    addTest( test->getChildTestAt( childIndex ), index );
+}
+
+
+Test *
+TestIndex::getRootTest() const
+{
+  return m_entries[0].m_test;
+}
+
+
+int
+TestIndex::getTestCount() const
+{
+  return m_entries.size();
+}
+
+
+Test *
+TestIndex::getTestAt( int index ) const
+{
+  if ( index < 0  ||  index >= getTestCount() )
+    throw std::out_of_range( "TestIndex::getTestAt(): index out of range" );
+  return m_entries[ index ].m_test;
+}
+
+
+int
+TestIndex::indexOf( TestId id ) const
+{
+  IndexesById::const_iterator it = m_indexesById.find( id );
+  if ( it == m_indexesById.end() )
+    return -1;
+  return (*it).second;
+}
+
+
+bool
+TestIndex::contains( const Test *test ) const
+{
+  int index = indexOf( test->getId() );
+  return index >= 0  &&  m_entries[ index ].m_test == test;
+}
+
+
+Test *
+TestIndex::findTest( TestId id ) const
+{
+  int index = indexOf( id );
+  return index >= 0 ? m_entries[ index ].m_test : NULL;
+}
+
+
+Test *
+TestIndex::getParentTest( const Test *test ) const
+{
+  int parentIndex = m_entries[ checkedIndexOf( test ) ].m_parentIndex;
+  return parentIndex >= 0 ? m_entries[ parentIndex ].m_test : NULL;
+}
+
+
+const std::string &
+TestIndex::getPath( const Test *test ) const
+{
+  return m_entries[ checkedIndexOf( test ) ].m_path;
+}
+
+
+TestPath
+TestIndex::makeTestPath( const Test *test ) const
+{
+  TestPath path;
+  int index = checkedIndexOf( test );
+  while ( index >= 0 )
+  {
+    path.insert( m_entries[ index ].m_test, 0 );
+    index = m_entries[ index ].m_parentIndex;
+  }
+  return path;
+}
+
+
+int
+TestIndex::checkedIndexOf( const Test *test ) const
+{
+  if ( !contains( test ) )
+    throw std::invalid_argument( "TestIndex: test <" + test->getNameRef() +
+                                 "> is not part of the indexed hierarchy" );
+  return indexOf( test->getId() );
+}
+
+
+CPPUNIT_NS_END
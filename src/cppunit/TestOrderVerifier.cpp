@@ -0,0 +1,296 @@
+#include <cppunit/SuiteFixture.h>
+#include <cppunit/Test.h>
+#include <cppunit/TestFailure.h>
+#include <cppunit/TestListener.h>
+#include <cppunit/TestOrderVerifier.h>
+#include <cppunit/TestResult.h>
+#include <algorithm>
+#include <istream>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Collects the tests that failed during a run (Implementation).
+ */
+class FailedTestCollector : public TestListener
+{
+public:
+  void addFailure( const TestFailure &failure )
+  {
+    m_failedTests.insert( failure.failedTest() );
+  }
+
+  bool hasFailed( Test *test ) const
+  {
+    return m_failedTests.find( test ) != m_failedTests.end();
+  }
+
+private:
+  CppUnitSet<Test *> m_failedTests;
+};
+
+
+static const char *const parallelSafeValue = "parallel-safe";
+static const char *const orderDependentValue = "order-dependent";
+
+
+TestOrderVerifier::TestOrderVerifier( int permutationCount,
+                                      unsigned int seed )
+    : m_permutationCount( permutationCount )
+    , m_random( seed )
+{
+}
+
+
+TestOrderVerifier::~TestOrderVerifier()
+{
+}
+
+
+void
+TestOrderVerifier::verify( Test *test,
+                           const std::string &parentPath )
+{
+  std::string path = parentPath + "/" + test->getNameRef();
+
+  Tests tests;
+  Tests suites;
+  int childCount = test->getChildTestCount();
+  for ( int index = 0; index < childCount; ++index )
+  {
+    Test *child = test->getChildTestAt( index );
+    if ( child->getChildTestCount() == 0 )
+      tests.push_back( child );
+    else
+      suites.push_back( child );
+  }
+
+  if ( !tests.empty() )
+    verifySuite( test, tests, path );
+
+  for ( Tests::iterator it = suites.begin(); it != suites.end(); ++it )
+    verify( *it, path );
+}
+
+
+int
+TestOrderVerifier::getSuiteCount() const
+{
+  return m_suitePaths.size();
+}
+
+
+std::string
+TestOrderVerifier::getSuitePathAt( int index ) const
+{
+  return m_suitePaths[ index ];
+}
+
+
+bool
+TestOrderVerifier::isSuiteOrderIndependentAt( int index ) const
+{
+  return m_suiteIndependence[ index ];
+}
+
+
+int
+TestOrderVerifier::getDependencyCount() const
+{
+  return m_dependencies.size();
+}
+
+
+const TestOrderDependency &
+TestOrderVerifier::getDependencyAt( int index ) const
+{
+  return m_dependencies[ index ];
+}
+
+
+void
+TestOrderVerifier::printDependencies( OStream &stream ) const
+{
+  for ( unsigned int index = 0; index < m_dependencies.size(); ++index )
+  {
+    const TestOrderDependency &dependency = m_dependencies[ index ];
+    stream  <<  dependency.m_suitePath  <<  ": "  <<  dependency.m_dependentTest
+            <<  ( dependency.m_succeedsAlone ? " fails" : " only succeeds" );
+    if ( dependency.m_precedingTest.empty() )
+      stream  <<  " depending on the tests run before it\n";
+    else
+      stream  <<  " when run after "  <<  dependency.m_precedingTest  <<  "\n";
+  }
+}
+
+
+void
+TestOrderVerifier::writeProperties( OStream &stream ) const
+{
+  for ( unsigned int index = 0; index < m_suitePaths.size(); ++index )
+  {
+    stream  <<  m_suitePaths[ index ]  <<  "="
+            <<  ( m_suiteIndependence[ index ] ? parallelSafeValue
+                                               : orderDependentValue )
+            <<  "\n";
+  }
+}
+
+
+void
+TestOrderVerifier::readParallelSafeSuites( std::istream &stream,
+                                           CppUnitSet<std::string> &suitePaths )
+{
+  std::string line;
+  while ( std::getline( stream, line ) )
+  {
+    if ( !line.empty()  &&  line[ line.length() - 1 ] == '\r' )
+      line.erase( line.length() - 1 );
+    if ( line.empty()  ||  line[0] == '#' )
+      continue;
+
+    std::string::size_type separator = line.rfind( '=' );
+    if ( separator != std::string::npos  &&
+         line.substr( separator + 1 ) == parallelSafeValue )
+      suitePaths.insert( line.substr( 0, separator ) );
+  }
+}
+
+
+void
+TestOrderVerifier::verifySuite( Test *suite,
+                                const Tests &tests,
+                                const std::string &suitePath )
+{
+  int dependencyCount = m_dependencies.size();
+  m_suitePaths.push_back( suitePath );
+  m_suiteIndependence.push_back( false );
+
+  Results succeedsAlone;
+  for ( unsigned int index = 0; index < tests.size(); ++index )
+  {
+    Results succeeded;
+    if ( !runInOrder( suite, Tests( 1, tests[ index ] ), succeeded ) )
+      return;     // the suite fixture can not be set up
+    succeedsAlone.push_back( succeeded[0] );
+  }
+
+  // The first order is the declared order, then random permutations of it.
+  CppUnitVector<int> order;
+  for ( unsigned int testIndex = 0; testIndex < tests.size(); ++testIndex )
+    order.push_back( testIndex );
+
+  for ( int permutation = 0; permutation <= m_permutationCount; ++permutation )
+  {
+    for ( int last = int(order.size()) - 1;  permutation > 0  &&  last > 0; --last )
+      std::swap( order[ last ], order[ nextRandom( last + 1 ) ] );
+
+    Tests orderedTests;
+    for ( unsigned int orderIndex = 0; orderIndex < order.size(); ++orderIndex )
+      orderedTests.push_back( tests[ order[ orderIndex ] ] );
+
+    Results succeeded;
+    if ( !runInOrder( suite, orderedTests, succeeded ) )
+      return;
+
+    for ( unsigned int position = 0; position < order.size(); ++position )
+    {
+      if ( succeeded[ position ] != succeedsAlone[ order[ position ] ] )
+        findPrecedingTests( suite, orderedTests, position,
+                            succeedsAlone[ order[ position ] ], suitePath );
+    }
+  }
+
+  m_suiteIndependence.back() = int(m_dependencies.size()) == dependencyCount;
+}
+
+
+bool
+TestOrderVerifier::runInOrder( Test *suite,
+                               const Tests &tests,
+                               Results &succeeded )
+{
+  TestResult result;
+  FailedTestCollector failedTests;
+  result.addListener( &failedTests );
+
+  SuiteFixture *fixture = suite->getSuiteFixture();
+  if ( fixture != NULL  &&  !fixture->setUp( &result, suite ) )
+    return false;
+
+  for ( Tests::const_iterator it = tests.begin(); it != tests.end(); ++it )
+    (*it)->run( &result );
+
+  if ( fixture != NULL )
+    fixture->tearDown( &result, suite );
+
+  for ( Tests::const_iterator itResult = tests.begin(); itResult != tests.end(); ++itResult )
+    succeeded.push_back( !failedTests.hasFailed( *itResult ) );
+  return true;
+}
+
+
+void
+TestOrderVerifier::findPrecedingTests( Test *suite,
+                                       const Tests &order,
+                                       int dependentIndex,
+                                       bool succeedsAlone,
+                                       const std::string &suitePath )
+{
+  Test *dependentTest = order[ dependentIndex ];
+  bool found = false;
+  for ( int index = 0; index < dependentIndex; ++index )
+  {
+    Tests pair;
+    pair.push_back( order[ index ] );
+    pair.push_back( dependentTest );
+
+    Results succeeded;
+    if ( runInOrder( suite, pair, succeeded )  &&  succeeded[1] != succeedsAlone )
+    {
+      addDependency( suitePath, order[ index ]->getName(),
+                     dependentTest->getName(), succeedsAlone );
+      found = true;
+    }
+  }
+
+  if ( !found )
+    addDependency( suitePath, "", dependentTest->getName(), succeedsAlone );
+}
+
+
+void
+TestOrderVerifier::addDependency( const std::string &suitePath,
+                                  const std::string &precedingTest,
+                                  const std::string &dependentTest,
+                                  bool succeedsAlone )
+{
+  for ( unsigned int index = 0; index < m_dependencies.size(); ++index )
+  {
+    const TestOrderDependency &dependency = m_dependencies[ index ];
+    if ( dependency.m_suitePath == suitePath  &&
+         dependency.m_precedingTest == precedingTest  &&
+         dependency.m_dependentTest == dependentTest )
+      return;
+  }
+
+  TestOrderDependency dependency;
+  dependency.m_suitePath = suitePath;
+  dependency.m_precedingTest = precedingTest;
+  dependency.m_dependentTest = dependentTest;
+  dependency.m_succeedsAlone = succeedsAlone;
+  m_dependencies.push_back( dependency );
+}
+
+
+unsigned int
+TestOrderVerifier::nextRandom( unsigned int bound )
+{
+  // Linear congruential generator, so that the orders only depend on the seed.
+  m_random = m_random * 1103515245u + 12345u;
+  return (m_random >> 16) % bound;
+}
+
+
+CPPUNIT_NS_END
@@ -53,7 +53,7 @@ TestPath::TestPath( Test *searchRoot,
     bool childFound = false;
     for ( int childIndex =0; childIndex < parentTest->getChildTestCount(); ++childIndex )
     {
-      if ( parentTest->getChildTestAt( childIndex )->getName() == testNames[index] )
+      if ( parentTest->getChildTestAt( childIndex )->getNameRef() == testNames[index] )
       {
         childFound = true;
         parentTest = parentTest->getChildTestAt( childIndex );
@@ -193,7 +193,7 @@ TestPath::toString() const
   {
     if ( index > 0 )
       asString += '/';
-    asString += getTestAt(index)->getName();
+    asString += getTestAt(index)->getNameRef();
   }
 
   return asString;
@@ -215,7 +215,7 @@ TestPath::findActualRoot( Test *searchRoot,
 
   Test *root = isRelative ? searchRoot->findTest( testNames[0] )  // throw if bad test name
                           : searchRoot;
-  if ( root->getName() != testNames[0] )
+  if ( root->getNameRef() != testNames[0] )
     throw std::invalid_argument( "TestPath::TestPath(): searchRoot does not match path root name" );
 
   return root;
@@ -0,0 +1,253 @@
+#include <cppunit/SuiteFixture.h>
+#include <cppunit/TestFilter.h>
+#include <cppunit/TestPlan.h>
+#include <cppunit/TestResult.h>
+#include <stdexcept>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/*! \brief Tears down the suite fixture and ends a suite (Implementation).
+ */
+static void
+endSuite( TestResult *result,
+          Test *suite )
+{
+  SuiteFixture *fixture = suite->getSuiteFixture();
+  if ( fixture != NULL )
+    fixture->tearDown( result, suite );
+  result->endSuite( suite );
+}
+
+
+/*! \brief Indicates if a test below the specified test is selected by a
+ *         filter (Implementation).
+ */
+static bool
+hasIncludedTestBelow( Test *test,
+                      const std::string &testPath,
+                      const TestFilter &filter )
+{
+  int childCount = test->getChildTestCount();
+  if ( childCount == 0  ||  !filter.mayIncludeBelow( testPath ) )
+    return false;
+
+  for ( int childIndex = 0; childIndex < childCount; ++childIndex )
+  {
+    Test *child = test->getChildTestAt( childIndex );
+    std::string childPath = testPath + "/" + child->getNameRef();
+    if ( filter.isExcluded( childPath ) )
+      continue;
+    if ( filter.isIncluded( childPath )  ||  
+         hasIncludedTestBelow( child, childPath, filter ) )
+      return true;
+  }
+  return false;
+}
+
+
+TestPlan::TestPlan( Test *root )
+    : m_root( root )
+{
+  addTest( root, -1, 0 );
+}
+
+
+TestPlan::TestPlan( Test *root,
+                    const TestFilter &filter,
+                    const std::string &parentPath )
+    : m_root( root )
+{
+  if ( filter.isEmpty() )
+    addTest( root, -1, 0 );
+  else
+    addFilteredTest( root, -1, 0, parentPath + "/" + root->getNameRef(),
+                     false, filter );
+}
+
+
+TestPlan::~TestPlan()
+{
+}
+
+
+void
+TestPlan::addTest( Test *test,
+                   int parentIndex,
+                   int depth )
+{
+  int index = m_entries.size();
+  addEntry( test, parentIndex, depth );
+  if ( !m_entries[ index ].m_isSuite )
+    return;
+
+  int testCaseCount = 0;
+  int childCount = test->getChildTestCount();
+  for ( int childIndex = 0; childIndex < childCount; ++childIndex )
+  {
+    int childEntryIndex = m_entries.size();
+    addTest( test->getChildTestAt( childIndex ), index, depth + 1 );
+    testCaseCount += m_entries[ childEntryIndex ].m_testCaseCount;
+  }
+
+  m_entries[ index ].m_testCaseCount = testCaseCount;
+  m_entries[ index ].m_endIndex = m_entries.size();
+}
+
+
+bool
+TestPlan::addFilteredTest( Test *test,
+                           int parentIndex,
+                           int depth,
+                           const std::string &testPath,
+                           bool isIncluded,
+                           const TestFilter &filter )
+{
+  bool isRoot = parentIndex < 0;
+  bool isExcluded = filter.isExcluded( testPath );
+  if ( isExcluded  &&  !( isRoot  &&  test->canBeFlattened() ) )
+    return false;
+
+  isIncluded = isIncluded  ||  filter.isIncluded( testPath );
+
+  int index = m_entries.size();
+  addEntry( test, parentIndex, depth );
+  if ( !m_entries[ index ].m_isSuite )
+  {
+    // A test that runs its children itself is run as a whole.
+    if ( isIncluded  ||  hasIncludedTestBelow( test, testPath, filter ) )
+      return true;
+    m_entries.pop_back();
+    if ( isRoot  &&  test->getChildTestCount() > 0 )
+      throw std::invalid_argument( "No test of " + testPath + 
+                                   " is selected by the filter" );
+    return false;
+  }
+
+  int testCaseCount = 0;
+  if ( !isExcluded  &&
+       ( isIncluded  ||  filter.mayIncludeBelow( testPath ) ) )
+  {
+    int childCount = test->getChildTestCount();
+    for ( int childIndex = 0; childIndex < childCount; ++childIndex )
+    {
+      Test *child = test->getChildTestAt( childIndex );
+      int childEntryIndex = m_entries.size();
+      if ( addFilteredTest( child, index, depth + 1,
+                            testPath + "/" + child->getNameRef(),
+                            isIncluded, filter ) )
+        testCaseCount += m_entries[ childEntryIndex ].m_testCaseCount;
+    }
+  }
+
+  if ( getEntryCount() == index + 1  &&  !isRoot )
+  {
+    m_entries.pop_back();
+    return false;
+  }
+
+  m_entries[ index ].m_testCaseCount = testCaseCount;
+  m_entries[ index ].m_endIndex = m_entries.size();
+  return true;
+}
+
+
+void
+TestPlan::addEntry( Test *test,
+                    int parentIndex,
+                    int depth )
+{
+  TestPlanEntry entry;
+  entry.m_test = test;
+  entry.m_id = test->getId();
+  entry.m_parentIndex = parentIndex;
+  entry.m_depth = depth;
+  entry.m_endIndex = m_entries.size() + 1;
+  entry.m_isSuite = test->canBeFlattened();
+  entry.m_testCaseCount = entry.m_isSuite ? 0 : test->countTestCases();
+  m_entries.push_back( entry );
+}
+
+
+Test *
+TestPlan::getRootTest() const
+{
+  return m_root;
+}
+
+
+int
+TestPlan::countTestCases() const
+{
+  if ( m_entries.empty() )
+    return 0;
+  return m_entries[0].m_testCaseCount;
+}
+
+
+int
+TestPlan::getEntryCount() const
+{
+  return m_entries.size();
+}
+
+
+const TestPlanEntry &
+TestPlan::getEntryAt( int index ) const
+{
+  if ( index < 0  ||  index >= getEntryCount() )
+    throw std::out_of_range( "TestPlan::getEntryAt(): index out of range" );
+  return m_entries[ index ];
+}
+
+
+void
+TestPlan::run( TestResult *result ) const
+{
+  CppUnitVector<int> openSuites;
+
+  int entryCount = m_entries.size();
+  int index = 0;
+  while ( index < entryCount )
+  {
+    const TestPlanEntry &entry = m_entries[ index ];
+    while ( !openSuites.empty()  &&
+            index >= m_entries[ openSuites.back() ].m_endIndex )
+    {
+      endSuite( result, m_entries[ openSuites.back() ].m_test );
+      openSuites.pop_back();
+    }
+
+    // A composite checks shouldStop() before running each of its children.
+    if ( entry.m_parentIndex >= 0  &&  result->shouldStop() )
+      break;
+
+    if ( entry.m_isSuite )
+    {
+      result->startSuite( entry.m_test );
+      SuiteFixture *fixture = entry.m_test->getSuiteFixture();
+      if ( fixture != NULL  &&  !fixture->setUp( result, entry.m_test ) )
+      {
+        // The children can not run without their shared resources.
+        result->endSuite( entry.m_test );
+        index = entry.m_endIndex;
+        continue;
+      }
+      openSuites.push_back( index );
+    }
+    else
+      entry.m_test->run( result );
+
+    index = entry.m_isSuite ? index + 1 : entry.m_endIndex;
+  }
+
+  while ( !openSuites.empty() )
+  {
+    endSuite( result, m_entries[ openSuites.back() ].m_test );
+    openSuites.pop_back();
+  }
+}
+
+
+CPPUNIT_NS_END
@@ -1,6 +1,7 @@
 #include <cppunit/Test.h>
 #include <cppunit/TestFailure.h>
 #include <cppunit/TestListener.h>
+#include <cppunit/TestPlan.h>
 #include <cppunit/TestResult.h>
 #include <cppunit/tools/Algorithm.h>
 #include <cppunit/portability/Stream.h>
@@ -12,10 +13,34 @@
 CPPUNIT_NS_BEGIN
 
 
+/*! \brief Protects with the protector chain of another result (Implementation).
+ */
+class SharedProtectorChain : public Protector
+{
+public:
+  SharedProtectorChain( ProtectorChain *chain )
+      : m_chain( chain )
+  {
+  }
+
+  bool protect( const Functor &functor,
+                const ProtectorContext &context )
+  {
+    return m_chain->protect( functor, context );
+  }
+
+private:
+  ProtectorChain *m_chain;
+};
+
+
 TestResult::TestResult( SynchronizationObject *syncObject )
     : SynchronizedObject( syncObject )
     , m_protectorChain( new ProtectorChain() )
     , m_stop( false )
+    , m_failsTestsWithoutAssertions( false )
+    , m_tracksPeakMemory( false )
+    , m_peakMemoryBudget( 0 )
 { 
   m_protectorChain->push( new DefaultProtector() );
 }
@@ -76,6 +101,31 @@ TestResult::startTest( Test *test )
 }
 
   
+void 
+TestResult::addAssertions( Test *test, 
+                           int assertionCount )
+{ 
+  ExclusiveZone zone( m_syncObject ); 
+  for ( TestListeners::iterator it = m_listeners.begin();
+        it != m_listeners.end(); 
+        ++it )
+    (*it)->addAssertions( test, assertionCount );
+}
+
+
+void 
+TestResult::addAllocations( Test *test, 
+                            long allocationCount,
+                            long allocatedByteCount )
+{ 
+  ExclusiveZone zone( m_syncObject ); 
+  for ( TestListeners::iterator it = m_listeners.begin();
+        it != m_listeners.end(); 
+        ++it )
+    (*it)->addAllocations( test, allocationCount, allocatedByteCount );
+}
+
+
 void 
 TestResult::endTest( Test *test )
 { 
@@ -91,6 +141,11 @@ void
 TestResult::startSuite( Test *test )
 {
   ExclusiveZone zone( m_syncObject ); 
+  long budget = test->getPeakMemoryBudget();
+  if ( budget <= 0  &&  !m_suitePeakMemoryBudgets.empty() )
+    budget = m_suitePeakMemoryBudgets.back();
+  m_suitePeakMemoryBudgets.push_back( budget );
+
   for ( TestListeners::iterator it = m_listeners.begin();
         it != m_listeners.end(); 
         ++it )
@@ -102,6 +157,9 @@ void
 TestResult::endSuite( Test *test )
 {
   ExclusiveZone zone( m_syncObject ); 
+  if ( !m_suitePeakMemoryBudgets.empty() )
+    m_suitePeakMemoryBudgets.pop_back();
+
   for ( TestListeners::iterator it = m_listeners.begin();
         it != m_listeners.end(); 
         ++it )
@@ -117,6 +175,90 @@ TestResult::shouldStop() const
 }
 
 
+void 
+TestResult::setFailsTestsWithoutAssertions( bool failsTests )
+{ 
+  ExclusiveZone zone( m_syncObject );
+  m_failsTestsWithoutAssertions = failsTests; 
+}
+
+
+bool 
+TestResult::failsTestsWithoutAssertions() const
+{ 
+  ExclusiveZone zone( m_syncObject );
+  return m_failsTestsWithoutAssertions; 
+}
+
+
+void 
+TestResult::addPeakMemory( Test *test, 
+                           long peakKilobytes )
+{ 
+  ExclusiveZone zone( m_syncObject ); 
+  for ( TestListeners::iterator it = m_listeners.begin();
+        it != m_listeners.end(); 
+        ++it )
+    (*it)->addPeakMemory( test, peakKilobytes );
+}
+
+
+void 
+TestResult::setTracksPeakMemory( bool tracksPeakMemory )
+{ 
+  ExclusiveZone zone( m_syncObject );
+  m_tracksPeakMemory = tracksPeakMemory; 
+}
+
+
+bool 
+TestResult::tracksPeakMemory() const
+{ 
+  ExclusiveZone zone( m_syncObject );
+  return m_tracksPeakMemory; 
+}
+
+
+void 
+TestResult::setPeakMemoryBudget( long kilobytes )
+{ 
+  ExclusiveZone zone( m_syncObject );
+  m_peakMemoryBudget = kilobytes; 
+}
+
+
+long 
+TestResult::peakMemoryBudget() const
+{ 
+  ExclusiveZone zone( m_syncObject );
+  if ( !m_suitePeakMemoryBudgets.empty()  &&  
+       m_suitePeakMemoryBudgets.back() > 0 )
+    return m_suitePeakMemoryBudgets.back();
+  return m_peakMemoryBudget; 
+}
+
+
+void 
+TestResult::copySettings( const TestResult &other )
+{
+  if ( &other == this )
+    return;
+
+  bool failsTests = other.failsTestsWithoutAssertions();
+  bool tracksPeakMemory = other.tracksPeakMemory();
+  long peakMemoryBudget = other.peakMemoryBudget();
+
+  ExclusiveZone zone( m_syncObject );
+  m_failsTestsWithoutAssertions = failsTests;
+  m_tracksPeakMemory = tracksPeakMemory;
+  m_peakMemoryBudget = peakMemoryBudget;
+
+  while ( m_protectorChain->count() > 0 )
+    m_protectorChain->pop();
+  m_protectorChain->push( new SharedProtectorChain( other.m_protectorChain ) );
+}
+
+
 void 
 TestResult::stop()
 { 
@@ -150,6 +292,16 @@ TestResult::runTest( Test *test )
 }
 
 
+void 
+TestResult::runTestPlan( const TestPlan &plan )
+{
+  Test *test = plan.getRootTest();
+  startTestRun( test );
+  plan.run( this );
+  endTestRun( test );
+}
+
+
 void 
 TestResult::startTestRun( Test *test )
 {
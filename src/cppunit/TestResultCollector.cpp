@@ -37,6 +37,14 @@ TestResultCollector::reset()
   freeFailures();
   m_testErrors = 0;
   m_tests.clear();
+  m_testAssertionCounts.clear();
+  m_assertionCount = 0;
+  m_testAllocationCounts.clear();
+  m_testAllocatedByteCounts.clear();
+  m_allocationCount = 0;
+  m_allocatedByteCount = 0;
+  m_testPeakMemories.clear();
+  m_peakMemory = -1;
 }
 
 
@@ -60,6 +68,44 @@ TestResultCollector::addFailure( const TestFailure &failure )
 }
 
 
+void 
+TestResultCollector::addAssertions( Test *test, 
+                                    int assertionCount )
+{
+  ExclusiveZone zone( m_syncObject ); 
+  m_testAssertionCounts[ test ] += assertionCount;
+  m_assertionCount += assertionCount;
+}
+
+
+void 
+TestResultCollector::addAllocations( Test *test, 
+                                     long allocationCount,
+                                     long allocatedByteCount )
+{
+  ExclusiveZone zone( m_syncObject ); 
+  m_testAllocationCounts[ test ] += allocationCount;
+  m_testAllocatedByteCounts[ test ] += allocatedByteCount;
+  m_allocationCount += allocationCount;
+  m_allocatedByteCount += allocatedByteCount;
+}
+
+
+void 
+TestResultCollector::addPeakMemory( Test *test, 
+                                    long peakKilobytes )
+{
+  ExclusiveZone zone( m_syncObject ); 
+  CppUnitMap<Test *, long>::iterator it = m_testPeakMemories.find( test );
+  if ( it == m_testPeakMemories.end() )
+    m_testPeakMemories[ test ] = peakKilobytes;
+  else if ( peakKilobytes > it->second )
+    it->second = peakKilobytes;
+  if ( peakKilobytes > m_peakMemory )
+    m_peakMemory = peakKilobytes;
+}
+
+
 /// Gets the number of run tests.
 int 
 TestResultCollector::runTests() const
@@ -113,5 +159,81 @@ TestResultCollector::tests() const
 }
 
 
+int 
+TestResultCollector::assertionCount() const
+{
+  ExclusiveZone zone( m_syncObject );
+  return m_assertionCount;
+}
+
+
+int 
+TestResultCollector::assertionCount( Test *test ) const
+{
+  ExclusiveZone zone( m_syncObject );
+  CppUnitMap<Test *, int>::const_iterator it = m_testAssertionCounts.find( test );
+  if ( it == m_testAssertionCounts.end() )
+    return 0;
+  return it->second;
+}
+
+
+long 
+TestResultCollector::allocationCount() const
+{
+  ExclusiveZone zone( m_syncObject );
+  return m_allocationCount;
+}
+
+
+long 
+TestResultCollector::allocationCount( Test *test ) const
+{
+  ExclusiveZone zone( m_syncObject );
+  CppUnitMap<Test *, long>::const_iterator it = m_testAllocationCounts.find( test );
+  if ( it == m_testAllocationCounts.end() )
+    return 0;
+  return it->second;
+}
+
+
+long 
+TestResultCollector::allocatedByteCount() const
+{
+  ExclusiveZone zone( m_syncObject );
+  return m_allocatedByteCount;
+}
+
+
+long 
+TestResultCollector::allocatedByteCount( Test *test ) const
+{
+  ExclusiveZone zone( m_syncObject );
+  CppUnitMap<Test *, long>::const_iterator it = m_testAllocatedByteCounts.find( test );
+  if ( it == m_testAllocatedByteCounts.end() )
+    return 0;
+  return it->second;
+}
+
+
+long 
+TestResultCollector::peakMemory() const
+{
+  ExclusiveZone zone( m_syncObject );
+  return m_peakMemory;
+}
+
+
+long 
+TestResultCollector::peakMemory( Test *test ) const
+{
+  ExclusiveZone zone( m_syncObject );
+  CppUnitMap<Test *, long>::const_iterator it = m_testPeakMemories.find( test );
+  if ( it == m_testPeakMemories.end() )
+    return -1;
+  return it->second;
+}
+
+
 CPPUNIT_NS_END
 
@@ -1,7 +1,11 @@
 #include <cppunit/config/SourcePrefix.h>
 #include <cppunit/TestRunner.h>
+#include <cppunit/TestFilter.h>
+#include <cppunit/TestOrderVerifier.h>
 #include <cppunit/TestPath.h>
+#include <cppunit/TestPlan.h>
 #include <cppunit/TestResult.h>
+#include <memory>
 
 
 CPPUNIT_NS_BEGIN
@@ -31,6 +35,15 @@ TestRunner::WrappingSuite::getName() const
 }
 
 
+const std::string &
+TestRunner::WrappingSuite::getNameRef() const
+{
+  if ( hasOnlyOneTest() )
+    return getUniqueChildTest()->getNameRef();
+  return TestSuite::getNameRef();
+}
+
+
 Test *
 TestRunner::WrappingSuite::doGetChildTestAt( int index ) const
 {
@@ -50,6 +63,22 @@ TestRunner::WrappingSuite::run( TestResult *result )
 }
 
 
+bool 
+TestRunner::WrappingSuite::canBeFlattened() const
+{
+  return !hasOnlyOneTest();
+}
+
+
+Test *
+TestRunner::WrappingSuite::getRunTest()
+{
+  if ( hasOnlyOneTest() )
+    return getUniqueChildTest();
+  return this;
+}
+
+
 bool 
 TestRunner::WrappingSuite::hasOnlyOneTest() const
 {
@@ -92,8 +121,60 @@ TestRunner::run( TestResult &controller,
 {
   TestPath path = m_suite->resolveTestPath( testPath );
   Test *testToRun = path.getChildTest();
+  if ( testToRun == m_suite )
+    testToRun = m_suite->getRunTest();
+
+  TestPlan plan( testToRun );
+  controller.runTestPlan( plan );
+}
+
 
-  controller.runTest( testToRun );
+void 
+TestRunner::run( TestResult &controller,
+                 const TestFilter &filter,
+                 const std::string &testPath )
+{
+  std::auto_ptr<TestPlan> plan( makeTestPlan( filter, testPath ) );
+  controller.runTestPlan( *plan );
+}
+
+
+TestPlan *
+TestRunner::makeTestPlan( const TestFilter &filter,
+                          const std::string &testPath )
+{
+  TestPath path = m_suite->resolveTestPath( testPath );
+  Test *testToRun = path.getChildTest();
+  if ( testToRun == m_suite )
+    testToRun = m_suite->getRunTest();
+
+  path.up();
+  std::string parentPath;
+  if ( path.isValid() )
+    parentPath = path.toString();
+
+  return new TestPlan( testToRun, filter, parentPath );
+}
+
+
+void 
+TestRunner::verifyOrderIndependence( TestOrderVerifier &verifier,
+                                     const std::string &testPath )
+{
+  TestPath path = m_suite->resolveTestPath( testPath );
+  Test *testToVerify = path.getChildTest();
+  if ( testToVerify == m_suite )
+    testToVerify = m_suite->getRunTest();
+
+  // Suites are named by their full path, even if testPath is relative.
+  TestPath testToVerifyPath;
+  std::string parentPath;
+  if ( m_suite->findTestPath( testToVerify, testToVerifyPath ) )
+  {
+    testToVerifyPath.up();
+    parentPath = testToVerifyPath.toString();
+  }
+  verifier.verify( testToVerify, parentPath );
 }
 
 
@@ -1,13 +1,26 @@
 #include <cppunit/config/SourcePrefix.h>
+#include <cppunit/TestArena.h>
 #include <cppunit/TestSuite.h>
 #include <cppunit/TestResult.h>
+#if CPPUNIT_HAVE_RTTI
+#include <typeinfo>
+#endif
+#include "Thread.h"
 
 CPPUNIT_NS_BEGIN
 
+/// Changed each time a test is added to or removed from any TestSuite.
+static volatile long structureStamp;
+
+
 
 /// Default constructor
 TestSuite::TestSuite( std::string name )
     : TestComposite( name )
+    , m_suiteFixture( NULL )
+    , m_peakMemoryBudget( 0 )
+    , m_testCaseCount( 0 )
+    , m_testCaseCountStamp( -1 )
 {
 }
 
@@ -28,6 +41,7 @@ TestSuite::deleteContents()
     delete getChildTestAt( index );
 
   m_tests.clear();
+  atomicIncrement( structureStamp );
 }
 
 
@@ -36,6 +50,26 @@ void
 TestSuite::addTest( Test *test )
 { 
   m_tests.push_back( test ); 
+  atomicIncrement( structureStamp );
+}
+
+
+int 
+TestSuite::countTestCases() const
+{
+  long stamp = atomicLoad( structureStamp );
+  {
+    MutexLock lock( m_countLock );
+    if ( m_testCaseCountStamp == stamp )
+      return m_testCaseCount;
+  }
+
+  // Counted without the lock: a nested suite counts its own tests.
+  int count = TestComposite::countTestCases();
+  MutexLock lock( m_countLock );
+  m_testCaseCount = count;
+  m_testCaseCountStamp = stamp;
+  return count;
 }
 
 
@@ -60,5 +94,46 @@ TestSuite::doGetChildTestAt( int index ) const
 }
 
 
+bool 
+TestSuite::canBeFlattened() const
+{
+#if CPPUNIT_HAVE_RTTI
+  // A suite created in a TestArena is still a plain TestSuite.
+  return typeid( *this ) == typeid( TestSuite )  ||  
+         typeid( *this ) == typeid( ArenaTest<TestSuite> );
+#else
+  return true;
+#endif
+}
+
+
+void 
+TestSuite::setSuiteFixture( SuiteFixture *fixture )
+{
+  m_suiteFixture = fixture;
+}
+
+
+SuiteFixture *
+TestSuite::getSuiteFixture() const
+{
+  return m_suiteFixture;
+}
+
+
+void 
+TestSuite::setPeakMemoryBudget( long kilobytes )
+{
+  m_peakMemoryBudget = kilobytes;
+}
+
+
+long 
+TestSuite::getPeakMemoryBudget() const
+{
+  return m_peakMemoryBudget;
+}
+
+
 CPPUNIT_NS_END
 
@@ -2,6 +2,7 @@
 #include <cppunit/extensions/TestFixtureFactory.h>
 #include <cppunit/extensions/TestNamer.h>
 #include <cppunit/extensions/TestSuiteBuilderContext.h>
+#include <stdlib.h>
 
 
 CPPUNIT_NS_BEGIN
@@ -44,6 +45,13 @@ TestSuiteBuilderContextBase::getTestNameFor(
 }
 
 
+const TestNamer &
+TestSuiteBuilderContextBase::getTestNamer() const
+{
+  return m_namer;
+}
+
+
 TestFixture *
 TestSuiteBuilderContextBase::makeTestFixture() const
 {
@@ -55,6 +63,9 @@ void
 TestSuiteBuilderContextBase::addProperty( const std::string &key, 
                                           const std::string &value )
 {
+  if ( key == "max_rss_mb" )
+    m_suite.setPeakMemoryBudget( ::atol( value.c_str() ) * 1024 );
+
   Properties::iterator it = m_properties.begin();
   for ( ; it != m_properties.end(); ++it )
   {
@@ -82,4 +93,11 @@ TestSuiteBuilderContextBase::getStringProperty( const std::string &key ) const
 }
 
 
+void 
+TestSuiteBuilderContextBase::setSuiteFixture( SuiteFixture *fixture )
+{
+  m_suite.setSuiteFixture( fixture );
+}
+
+
 CPPUNIT_NS_END
@@ -0,0 +1,188 @@
+#include <cppunit/Exception.h>
+#include <cppunit/ExpectationCollector.h>
+#include <cppunit/Message.h>
+#include <cppunit/Mutex.h>
+#include <cppunit/Protector.h>
+#include <cppunit/TestThreadContext.h>
+#include <cppunit/extensions/TypeInfoHelper.h>
+#include <stdexcept>
+
+
+CPPUNIT_NS_BEGIN
+
+
+/// Shared by the copies of a context.
+struct TestThreadContext::State
+{
+  Mutex m_lock;
+  ExpectationCollector *m_collector;   ///< NULL once the test ended.
+  int m_referenceCount;
+  int m_runningTaskCount;
+};
+
+
+TestThreadContext::TestThreadContext()
+    : m_state( NULL )
+{
+}
+
+
+TestThreadContext::TestThreadContext( ExpectationCollector *collector )
+    : m_state( new State() )
+{
+  m_state->m_collector = collector;
+  m_state->m_referenceCount = 1;
+  m_state->m_runningTaskCount = 0;
+}
+
+
+TestThreadContext::TestThreadContext( const TestThreadContext &copy )
+    : m_state( copy.m_state )
+{
+  if ( m_state != NULL )
+  {
+    MutexLock lock( m_state->m_lock );
+    ++m_state->m_referenceCount;
+  }
+}
+
+
+TestThreadContext::~TestThreadContext()
+{
+  release();
+}
+
+
+TestThreadContext &
+TestThreadContext::operator =( const TestThreadContext &copy )
+{
+  if ( copy.m_state != m_state )
+  {
+    TestThreadContext other( copy );
+    release();
+    m_state = other.m_state;
+    other.m_state = NULL;
+  }
+  return *this;
+}
+
+
+void 
+TestThreadContext::release()
+{
+  if ( m_state == NULL )
+    return;
+
+  bool isLastReference;
+  {
+    MutexLock lock( m_state->m_lock );
+    isLastReference = --m_state->m_referenceCount == 0;
+  }
+  if ( isLastReference )
+    delete m_state;
+  m_state = NULL;
+}
+
+
+TestThreadContext 
+TestThreadContext::current()
+{
+  ExpectationCollector *collector = ExpectationCollector::current();
+  if ( collector == NULL )
+    return TestThreadContext();
+  return collector->threadContext();
+}
+
+
+bool 
+TestThreadContext::isValid() const
+{
+  if ( m_state == NULL )
+    return false;
+
+  MutexLock lock( m_state->m_lock );
+  return m_state->m_collector != NULL;
+}
+
+
+bool 
+TestThreadContext::run( const Functor &task ) const
+{
+  if ( m_state != NULL )
+  {
+    MutexLock lock( m_state->m_lock );
+    ++m_state->m_runningTaskCount;
+  }
+
+  ExpectationCollector failures;
+  CurrentExpectationCollector currentFailures( &failures );
+  bool succeeded = false;
+  try
+  {
+    succeeded = task();
+  }
+  catch ( Exception &failure )
+  {
+    failures.addFailure( failure.message(), failure.sourceLine() );
+  }
+  catch ( std::exception &e )
+  {
+    std::string shortDescription( "uncaught exception of type " );
+#if CPPUNIT_USE_TYPEINFO_NAME
+    shortDescription += TypeInfoHelper::getClassName( typeid(e) );
+#else
+    shortDescription += "std::exception (or derived).";
+#endif
+    failures.addError( Message( shortDescription, e.what() ) );
+  }
+  catch ( ... )
+  {
+    failures.addError( Message( "uncaught exception of unknown type" ) );
+  }
+  currentFailures.restore();
+
+  failures.endThreads();
+  if ( failures.failureCount() > 0 )
+    succeeded = false;
+  reportFailures( failures );
+  return succeeded;
+}
+
+
+void 
+TestThreadContext::reportFailures( ExpectationCollector &failures ) const
+{
+  if ( m_state == NULL )
+    return;
+
+  MutexLock lock( m_state->m_lock );
+  --m_state->m_runningTaskCount;
+  if ( m_state->m_collector != NULL )
+    m_state->m_collector->adoptFailures( failures );
+}
+
+
+int 
+TestThreadContext::runningTaskCount() const
+{
+  if ( m_state == NULL )
+    return 0;
+
+  MutexLock lock( m_state->m_lock );
+  return m_state->m_runningTaskCount;
+}
+
+
+int 
+TestThreadContext::detach()
+{
+  if ( m_state == NULL )
+    return 0;
+
+  MutexLock lock( m_state->m_lock );
+  m_state->m_collector = NULL;
+  return m_state->m_runningTaskCount;
+}
+
+
+CPPUNIT_NS_END
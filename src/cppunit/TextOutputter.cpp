@@ -107,7 +107,8 @@ void
 TextOutputter::printHeader()
 {
   if ( m_result->wasSuccessful() )
-    m_stream << "\nOK (" << m_result->runTests () << " tests)\n" ;
+    m_stream << "\nOK (" << m_result->runTests () << " tests, " 
+             << m_result->assertionCount() << " assertions)\n" ;
   else
   {
     m_stream << "\n";
@@ -132,6 +133,7 @@ TextOutputter::printStatistics()
   m_stream  <<  "Run:  "  <<  m_result->runTests()
             <<  "   Failures: "  <<  m_result->testFailures()
             <<  "   Errors: "  <<  m_result->testErrors()
+            <<  "   Assertions: "  <<  m_result->assertionCount()
             <<  "\n";
 }
 
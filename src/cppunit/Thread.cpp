@@ -0,0 +1,394 @@
+#include "Thread.h"
+
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/time.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOGDI
+#define NOUSER
+#define NOKERNEL
+#define NOSOUND
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+
+CPPUNIT_NS_BEGIN
+
+
+Thread::Thread()
+    : m_handle( NULL )
+{
+}
+
+
+#if defined(CPPUNIT_HAVE_PTHREAD_H)
+
+extern "C" {
+static void *
+runThread( void *thread )
+{
+  ((Thread *)thread)->run();
+  return NULL;
+}
+}
+
+
+Thread::~Thread()
+{
+  delete (pthread_t *)m_handle;
+}
+
+
+bool
+Thread::start()
+{
+  pthread_t *handle = new pthread_t;
+  if ( ::pthread_create( handle, NULL, &runThread, this ) != 0 )
+  {
+    delete handle;
+    return false;
+  }
+
+  m_handle = handle;
+  return true;
+}
+
+
+void
+Thread::join()
+{
+  if ( m_handle == NULL )
+    return;
+
+  ::pthread_join( *(pthread_t *)m_handle, NULL );
+  delete (pthread_t *)m_handle;
+  m_handle = NULL;
+}
+
+
+void
+Thread::yield()
+{
+  ::sched_yield();
+}
+
+
+double
+Thread::currentTime()
+{
+  struct timeval now;
+  ::gettimeofday( &now, NULL );
+  return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+
+ThreadLocalPointer::ThreadLocalPointer()
+{
+  pthread_key_t *key = new pthread_key_t;
+  ::pthread_key_create( key, NULL );
+  m_key = key;
+}
+
+
+ThreadLocalPointer::~ThreadLocalPointer()
+{
+  ::pthread_key_delete( *(pthread_key_t *)m_key );
+  delete (pthread_key_t *)m_key;
+}
+
+
+void *
+ThreadLocalPointer::get() const
+{
+  return ::pthread_getspecific( *(pthread_key_t *)m_key );
+}
+
+
+void
+ThreadLocalPointer::set( void *value )
+{
+  ::pthread_setspecific( *(pthread_key_t *)m_key, value );
+}
+
+
+#elif defined(_WIN32)
+
+static DWORD WINAPI
+runThread( LPVOID thread )
+{
+  ((Thread *)thread)->run();
+  return 0;
+}
+
+
+Thread::~Thread()
+{
+  if ( m_handle != NULL )
+    ::CloseHandle( (HANDLE)m_handle );
+}
+
+
+bool
+Thread::start()
+{
+  m_handle = ::CreateThread( NULL, 0, &runThread, this, 0, NULL );
+  return m_handle != NULL;
+}
+
+
+void
+Thread::join()
+{
+  if ( m_handle == NULL )
+    return;
+
+  ::WaitForSingleObject( (HANDLE)m_handle, INFINITE );
+  ::CloseHandle( (HANDLE)m_handle );
+  m_handle = NULL;
+}
+
+
+void
+Thread::yield()
+{
+  ::Sleep( 0 );
+}
+
+
+double
+Thread::currentTime()
+{
+  return ::GetTickCount() / 1000.0;
+}
+
+
+ThreadLocalPointer::ThreadLocalPointer()
+    : m_key( new DWORD( ::TlsAlloc() ) )
+{
+}
+
+
+ThreadLocalPointer::~ThreadLocalPointer()
+{
+  ::TlsFree( *(DWORD *)m_key );
+  delete (DWORD *)m_key;
+}
+
+
+void *
+ThreadLocalPointer::get() const
+{
+  return ::TlsGetValue( *(DWORD *)m_key );
+}
+
+
+void
+ThreadLocalPointer::set( void *value )
+{
+  ::TlsSetValue( *(DWORD *)m_key, value );
+}
+
+
+#else   // no thread support
+
+Thread::~Thread()
+{
+}
+
+
+bool
+Thread::start()
+{
+  return false;
+}
+
+
+void
+Thread::join()
+{
+}
+
+
+void
+Thread::yield()
+{
+}
+
+
+double
+Thread::currentTime()
+{
+  return double(::time( NULL ));
+}
+
+
+ThreadLocalPointer::ThreadLocalPointer()
+    : m_key( NULL )
+{
+}
+
+
+ThreadLocalPointer::~ThreadLocalPointer()
+{
+}
+
+
+void *
+ThreadLocalPointer::get() const
+{
+  return m_key;
+}
+
+
+void
+ThreadLocalPointer::set( void *value )
+{
+  m_key = value;
+}
+
+#endif
+
+
+#if defined(__ATOMIC_SEQ_CST)   // gcc >= 4.7 and clang
+
+long
+atomicIncrement( volatile long &counter )
+{
+  return __atomic_add_fetch( &counter, 1, __ATOMIC_SEQ_CST );
+}
+
+
+long
+atomicDecrement( volatile long &counter )
+{
+  return __atomic_sub_fetch( &counter, 1, __ATOMIC_SEQ_CST );
+}
+
+
+long
+atomicLoad( const volatile long &counter )
+{
+  return __atomic_load_n( &counter, __ATOMIC_ACQUIRE );
+}
+
+
+void
+atomicStore( volatile long &counter, long value )
+{
+  __atomic_store_n( &counter, value, __ATOMIC_RELEASE );
+}
+
+
+#elif defined(_WIN32)
+
+long
+atomicIncrement( volatile long &counter )
+{
+  return ::InterlockedIncrement( (volatile LONG *)&counter );
+}
+
+
+long
+atomicDecrement( volatile long &counter )
+{
+  return ::InterlockedDecrement( (volatile LONG *)&counter );
+}
+
+
+long
+atomicLoad( const volatile long &counter )
+{
+  return ::InterlockedCompareExchange( (volatile LONG *)&counter, 0, 0 );
+}
+
+
+void
+atomicStore( volatile long &counter, long value )
+{
+  ::InterlockedExchange( (volatile LONG *)&counter, value );
+}
+
+
+#elif defined(CPPUNIT_HAVE_PTHREAD_H)
+
+/// Lock of the counters, initialized before any constructor runs.
+static pthread_mutex_t counterLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+long
+atomicIncrement( volatile long &counter )
+{
+  ::pthread_mutex_lock( &counterLock );
+  long value = ++counter;
+  ::pthread_mutex_unlock( &counterLock );
+  return value;
+}
+
+
+long
+atomicDecrement( volatile long &counter )
+{
+  ::pthread_mutex_lock( &counterLock );
+  long value = --counter;
+  ::pthread_mutex_unlock( &counterLock );
+  return value;
+}
+
+
+long
+atomicLoad( const volatile long &counter )
+{
+  ::pthread_mutex_lock( &counterLock );
+  long value = counter;
+  ::pthread_mutex_unlock( &counterLock );
+  return value;
+}
+
+
+void
+atomicStore( volatile long &counter, long value )
+{
+  ::pthread_mutex_lock( &counterLock );
+  counter = value;
+  ::pthread_mutex_unlock( &counterLock );
+}
+
+
+#else   // no thread support
+
+long
+atomicIncrement( volatile long &counter )
+{
+  return ++counter;
+}
+
+
+long
+atomicDecrement( volatile long &counter )
+{
+  return --counter;
+}
+
+
+long
+atomicLoad( const volatile long &counter )
+{
+  return counter;
+}
+
+
+void
+atomicStore( volatile long &counter, long value )
+{
+  counter = value;
+}
+
+#endif
+
+
+CPPUNIT_NS_END
@@ -0,0 +1,112 @@
+#ifndef CPPUNIT_THREAD_H
+#define CPPUNIT_THREAD_H
+
+#include <cppunit/Portability.h>
+
+CPPUNIT_NS_BEGIN
+
+/*! \brief Thread of the platform that calls run() (Implementation).
+ *
+ * Implementation detail.
+ * \internal POSIX threads are used if available, Win32 threads on Windows.
+ * On other platforms start() always fails: the caller is expected to call
+ * run() itself when start() returns \c false.
+ */
+class Thread
+{
+public:
+  Thread();
+
+  /// Destructor. The thread must have been joined if it was started.
+  virtual ~Thread();
+
+  /*! Starts a thread that calls run().
+   * \return \c true if the thread was started, \c false otherwise.
+   */
+  bool start();
+
+  /*! Waits for the end of a thread started by start().
+   */
+  void join();
+
+  /*! Gives the processor to another thread.
+   */
+  static void yield();
+
+  /*! Returns the wall clock time, in seconds since an arbitrary origin.
+   */
+  static double currentTime();
+
+  /*! Called on the thread once started.
+   */
+  virtual void run() =0;
+
+private:
+  /// Prevents the use of the copy constructor.
+  Thread( const Thread &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const Thread &copy );
+
+private:
+  void *m_handle;
+};
+
+
+/*! \brief Pointer that has a value of its own on each thread (Implementation).
+ *
+ * Implementation detail.
+ * \internal Thread-specific data of POSIX threads, or thread local storage on
+ * Windows. On other platforms there is only one thread and the pointer is a
+ * plain pointer.
+ */
+class ThreadLocalPointer
+{
+public:
+  /// Constructs a pointer that is \c NULL on every thread.
+  ThreadLocalPointer();
+
+  /// Destructor.
+  ~ThreadLocalPointer();
+
+  /// Returns the value of the pointer on the calling thread.
+  void *get() const;
+
+  /// Sets the value of the pointer on the calling thread.
+  void set( void *value );
+
+private:
+  /// Prevents the use of the copy constructor.
+  ThreadLocalPointer( const ThreadLocalPointer &copy );
+
+  /// Prevents the use of the copy operator.
+  void operator =( const ThreadLocalPointer &copy );
+
+private:
+  void *m_key;
+};
+
+
+/*! \brief Atomic operations on a counter shared by threads (Implementation).
+ *
+ * Implementation detail.
+ * \internal The counters are plain \c long, so that a static counter is
+ * zero before any constructor runs. The atomic builtins of the compiler are
+ * used if available, the interlocked functions on Windows, a lock of POSIX
+ * threads otherwise. Without thread support the operations are plain.
+ */
+/// Increments a counter and returns its new value.
+long atomicIncrement( volatile long &counter );
+
+/// Decrements a counter and returns its new value.
+long atomicDecrement( volatile long &counter );
+
+/// Returns the value of a counter.
+long atomicLoad( const volatile long &counter );
+
+/// Sets the value of a counter.
+void atomicStore( volatile long &counter, long value );
+
+CPPUNIT_NS_END
+
+#endif // CPPUNIT_THREAD_H
@@ -3,6 +3,8 @@
 
 #if CPPUNIT_HAVE_RTTI
 
+#include <cppunit/Mutex.h>
+#include <cppunit/portability/CppUnitMap.h>
 #include <string>
 
 #if CPPUNIT_HAVE_GCC_ABI_DEMANGLE
@@ -14,8 +16,16 @@
 CPPUNIT_NS_BEGIN
 
 
-std::string 
-TypeInfoHelper::getClassName( const std::type_info &info )
+/*! \brief Class names already extracted, by raw type name (Implementation).
+ * \internal Keyed by the text of the raw name, not its address: the same
+ *           type may have a type_info in each shared library, and the
+ *           type_info of an unloaded plug-in may have its address reused.
+ */
+typedef CppUnitMap<std::string, std::string, std::less<std::string> > ClassNames;
+
+
+static std::string 
+extractClassName( const std::type_info &info )
 {
 #if defined(CPPUNIT_HAVE_GCC_ABI_DEMANGLE)  &&  CPPUNIT_HAVE_GCC_ABI_DEMANGLE
 
@@ -49,6 +59,21 @@ TypeInfoHelper::getClassName( const std::type_info &info )
 }
 
 
+std::string 
+TypeInfoHelper::getClassName( const std::type_info &info )
+{
+  static Mutex mutex;
+  static ClassNames classNames;
+
+  MutexLock lock( mutex );
+  ClassNames::iterator it = classNames.find( info.name() );
+  if ( it == classNames.end() )
+    it = classNames.insert( ClassNames::value_type( info.name(), 
+                                                    extractClassName( info ) ) ).first;
+  return it->second;
+}
+
+
 CPPUNIT_NS_END
 
 #endif // CPPUNIT_HAVE_RTTI
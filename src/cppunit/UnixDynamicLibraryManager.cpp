@@ -13,7 +13,8 @@ CPPUNIT_NS_BEGIN
 DynamicLibraryManager::LibraryHandle 
 DynamicLibraryManager::doLoadLibrary( const std::string &libraryName )
 {
-  return ::dlopen( libraryName.c_str(), RTLD_NOW | RTLD_GLOBAL );
+  int binding = m_symbolResolution == resolveOnFirstCall ? RTLD_LAZY : RTLD_NOW;
+  return ::dlopen( libraryName.c_str(), binding | RTLD_GLOBAL );
 }
 
 